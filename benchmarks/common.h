@@ -0,0 +1,60 @@
+/// Shared setup for the benchmark programs in this directory.
+///
+/// Each benchmark is a function template over the word type and we register it for all of `u8`, `u16`, `u32` & `u64`
+/// with a set of sizes. Inputs are built from fixed seeds so every run times the same work.
+///
+/// SPDX-FileCopyrightText:  2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+/// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <gf2/namespace.h>
+
+// Registers the benchmark function template `fn` for each word type with the sizes set up by `sizes`.
+#define GF2_BENCHMARK_WORDS(fn, sizes)                  \
+    BENCHMARK_TEMPLATE(fn, u8)->Apply(sizes);           \
+    BENCHMARK_TEMPLATE(fn, u16)->Apply(sizes);          \
+    BENCHMARK_TEMPLATE(fn, u32)->Apply(sizes);          \
+    BENCHMARK_TEMPLATE(fn, u64)->Apply(sizes)
+
+namespace bench {
+
+// The seed for all the random inputs.
+inline constexpr std::uint64_t seed = 42;
+
+// Bit-vector lengths from 1k to 1M bits.
+inline void
+vector_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+}
+
+// Square bit-matrix sizes from 64 x 64 up to 2048 x 2048.
+inline void
+matrix_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(4)->Range(64, 2048)->Unit(benchmark::kMicrosecond);
+}
+
+// Smaller sizes for the bit-by-bit baselines from `examples/naive.h` (and what they are compared against).
+inline void
+naive_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(4)->Range(256, 16384)->Unit(benchmark::kMicrosecond);
+}
+
+// Returns a random invertible `n x n` bit-matrix (about 29% of random square bit-matrices are invertible).
+template<Unsigned Word>
+BitMatrix<Word>
+invertible_matrix(usize n) {
+    for (auto s = seed;; ++s) {
+        auto A = BitMatrix<Word>::random(n, n, 0.5, s);
+        if (!A.LU().is_singular()) return A;
+    }
+}
+
+// Records the number of bits processed per second as well as the time.
+inline void
+set_bits_processed(benchmark::State& state, usize bits) {
+    state.counters["bits"] = benchmark::Counter(static_cast<double>(bits * static_cast<usize>(state.iterations())),
+                                                benchmark::Counter::kIsRate);
+}
+
+} // namespace bench
@@ -0,0 +1,125 @@
+/// Benchmarks for bit-matrix products, nearest-row searches & transposes.
+///
+/// SPDX-FileCopyrightText:  2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+/// SPDX-License-Identifier: MIT
+#include "common.h"
+
+// The matrix-vector product `M * v`.
+template<Unsigned Word>
+static void
+BM_dot_Mv(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto M = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    auto v = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(dot(M, v));
+    bench::set_bits_processed(state, n * n);
+}
+GF2_BENCHMARK_WORDS(BM_dot_Mv, bench::matrix_sizes);
+
+// The vector-matrix product `v * M`.
+template<Unsigned Word>
+static void
+BM_dot_vM(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto M = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    auto v = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(dot(v, M));
+    bench::set_bits_processed(state, n * n);
+}
+GF2_BENCHMARK_WORDS(BM_dot_vM, bench::matrix_sizes);
+
+// The matrix-matrix product `A * B`.
+template<Unsigned Word>
+static void
+BM_dot_MM(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto A = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    auto B = BitMatrix<Word>::random(n, n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(dot(A, B));
+}
+GF2_BENCHMARK_WORDS(BM_dot_MM, bench::matrix_sizes);
+
+// The matrix-matrix product `A * B` spread over the threads of `gf2::par`.
+template<Unsigned Word>
+static void
+BM_dot_MM_par(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto A = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    auto B = BitMatrix<Word>::random(n, n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(dot(par, A, B));
+}
+GF2_BENCHMARK_WORDS(BM_dot_MM_par, bench::matrix_sizes);
+
+// The 10 rows of a square bit-matrix nearest to a query bit-vector.
+template<Unsigned Word>
+static void
+BM_k_nearest(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto M = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    auto q = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(k_nearest(q, M, 10));
+    bench::set_bits_processed(state, n * n);
+}
+GF2_BENCHMARK_WORDS(BM_k_nearest, bench::matrix_sizes);
+
+// The Hamming distances from a query bit-vector to every row of a square bit-matrix.
+template<Unsigned Word>
+static void
+BM_distances(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto M = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    auto q = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(distances(q, M));
+    bench::set_bits_processed(state, n * n);
+}
+GF2_BENCHMARK_WORDS(BM_distances, bench::matrix_sizes);
+
+// Transposing a square bit-matrix.
+template<Unsigned Word>
+static void
+BM_transposed(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto M = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    for (auto _ : state) benchmark::DoNotOptimize(M.transposed());
+    bench::set_bits_processed(state, n * n);
+}
+GF2_BENCHMARK_WORDS(BM_transposed, bench::matrix_sizes);
+
+// Filling a bit-matrix with fair random bits.
+template<Unsigned Word>
+static void
+BM_random_matrix(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    for (auto _ : state) benchmark::DoNotOptimize(BitMatrix<Word>::random(n, n, 0.5, bench::seed));
+    bench::set_bits_processed(state, n * n);
+}
+GF2_BENCHMARK_WORDS(BM_random_matrix, bench::matrix_sizes);
+
+// The product of two fixed-size `N x N` bit-matrices that live on the stack.
+template<usize N, Unsigned Word>
+static void
+BM_fixed_dot_MM(benchmark::State& state) {
+    auto A = BitMatrixN<N, N, Word>::random(0.5, bench::seed);
+    auto B = BitMatrixN<N, N, Word>::random(0.5, bench::seed + 1);
+    for (auto _ : state) {
+        A = A * B;
+        benchmark::DoNotOptimize(A);
+    }
+}
+BENCHMARK_TEMPLATE(BM_fixed_dot_MM, 8, u8);
+BENCHMARK_TEMPLATE(BM_fixed_dot_MM, 32, u32);
+BENCHMARK_TEMPLATE(BM_fixed_dot_MM, 64, u64);
+
+// Transposing a fixed-size `N x N` bit-matrix.
+template<usize N, Unsigned Word>
+static void
+BM_fixed_transposed(benchmark::State& state) {
+    auto M = BitMatrixN<N, N, Word>::random(0.5, bench::seed);
+    for (auto _ : state) {
+        M = M.transposed();
+        benchmark::DoNotOptimize(M);
+    }
+}
+BENCHMARK_TEMPLATE(BM_fixed_transposed, 8, u8);
+BENCHMARK_TEMPLATE(BM_fixed_transposed, 32, u32);
+BENCHMARK_TEMPLATE(BM_fixed_transposed, 64, u64);
@@ -0,0 +1,215 @@
+/// Benchmarks for characteristic polynomials, bit-polynomial arithmetic, GF(2^m) fields & CRCs.
+///
+/// SPDX-FileCopyrightText:  2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+/// SPDX-License-Identifier: MIT
+#include "common.h"
+
+#include <naive.h>
+
+// Characteristic polynomials are expensive so we stop at smaller sizes than the other matrix benchmarks.
+static void
+charpoly_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(2)->Range(32, 512)->Unit(benchmark::kMicrosecond);
+}
+
+// Register lengths for the LFSR stream benchmarks.
+static void
+lfsr_sizes(benchmark::internal::Benchmark* b) {
+    b->Arg(31)->Arg(64)->Arg(127)->Arg(521)->Unit(benchmark::kMicrosecond);
+}
+
+// Span lengths for the GF(2^m) batch benchmarks.
+static void
+gf2m_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(256, 65536);
+}
+
+// Buffer sizes in bytes for the CRC benchmarks.
+static void
+crc_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(64)->Range(64, 16 << 20);
+}
+
+// Degrees of the moduli for the Frobenius power benchmarks.
+static void
+frobenius_sizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1024)->Arg(4096)->Arg(16384)->Unit(benchmark::kMillisecond);
+}
+
+// The characteristic polynomial of a square bit-matrix.
+template<Unsigned Word>
+static void
+BM_characteristic_polynomial(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto A = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    for (auto _ : state) benchmark::DoNotOptimize(A.characteristic_polynomial());
+}
+GF2_BENCHMARK_WORDS(BM_characteristic_polynomial, charpoly_sizes);
+
+// Evaluating the characteristic polynomial of a square bit-matrix at the matrix itself.
+template<Unsigned Word>
+static void
+BM_matrix_polynomial(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto A = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    auto p = A.characteristic_polynomial();
+    for (auto _ : state) benchmark::DoNotOptimize(p(A));
+}
+GF2_BENCHMARK_WORDS(BM_matrix_polynomial, charpoly_sizes);
+
+// The same evaluation using Horner's method.
+template<Unsigned Word>
+static void
+BM_naive_matrix_polynomial(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto A = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    auto p = A.characteristic_polynomial();
+    for (auto _ : state) benchmark::DoNotOptimize(naive::horner(p, A));
+}
+GF2_BENCHMARK_WORDS(BM_naive_matrix_polynomial, charpoly_sizes);
+
+// Squaring a bit-polynomial of the given degree.
+template<Unsigned Word>
+static void
+BM_squared(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto p = BitPolynomial<Word>::seeded_random(n, bench::seed);
+    for (auto _ : state) benchmark::DoNotOptimize(p.squared());
+    bench::set_bits_processed(state, n);
+}
+GF2_BENCHMARK_WORDS(BM_squared, bench::vector_sizes);
+
+// Computing `x^N mod P(x)` for a huge power `N` & a polynomial `P` of the given degree.
+template<Unsigned Word>
+static void
+BM_reduce_x_to_the(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto P = BitPolynomial<Word>::seeded_random(n, bench::seed);
+    for (auto _ : state) benchmark::DoNotOptimize(P.reduce_x_to_the(1'000'000'007));
+}
+GF2_BENCHMARK_WORDS(BM_reduce_x_to_the, bench::naive_sizes);
+
+// Computing `x^N mod P(x)` for a moderate power `N = 16 * deg P` with the library method.
+template<Unsigned Word>
+static void
+BM_reduce_x_to_the_16d(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto P = BitPolynomial<Word>::seeded_random(n, bench::seed);
+    for (auto _ : state) benchmark::DoNotOptimize(P.reduce_x_to_the(16 * n));
+}
+GF2_BENCHMARK_WORDS(BM_reduce_x_to_the_16d, bench::naive_sizes);
+
+// The same moderate power with the shift-and-add iteration from `examples/naive.h`.
+template<Unsigned Word>
+static void
+BM_naive_reduce_x_to_the_16d(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto P = BitPolynomial<Word>::seeded_random(n, bench::seed);
+    for (auto _ : state) benchmark::DoNotOptimize(naive::reduce_x_to_the(16 * n, P));
+}
+GF2_BENCHMARK_WORDS(BM_naive_reduce_x_to_the_16d, bench::naive_sizes);
+
+// Filling a bit-vector from a linear feedback shift register of the given degree a word at a time.
+template<Unsigned Word>
+static void
+BM_lfsr_fill(benchmark::State& state) {
+    auto L = static_cast<usize>(state.range(0));
+    Lfsr<Word> lfsr{BitPolynomial<Word>::seeded_random(L, bench::seed)};
+    auto v = BitVector<Word>::zeros(1 << 20);
+    for (auto _ : state) {
+        lfsr.fill(v);
+        benchmark::DoNotOptimize(v.store());
+    }
+    bench::set_bits_processed(state, v.size());
+}
+GF2_BENCHMARK_WORDS(BM_lfsr_fill, lfsr_sizes);
+
+// The same fill stepping the register one bit at a time.
+template<Unsigned Word>
+static void
+BM_lfsr_next(benchmark::State& state) {
+    auto L = static_cast<usize>(state.range(0));
+    Lfsr<Word> lfsr{BitPolynomial<Word>::seeded_random(L, bench::seed)};
+    auto v = BitVector<Word>::zeros(1 << 20);
+    for (auto _ : state) {
+        for (auto i = 0uz; i < v.size(); ++i) v.set(i, lfsr.next());
+        benchmark::DoNotOptimize(v.store());
+    }
+    bench::set_bits_processed(state, v.size());
+}
+GF2_BENCHMARK_WORDS(BM_lfsr_next, lfsr_sizes);
+
+// Computing `x^(2^d) mod P(x)` for a dense modulus of degree `d` by modular compositions, starting from a new context.
+template<Unsigned Word>
+static void
+BM_frobenius(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto P = BitPolynomial<Word>::seeded_random(n, bench::seed);
+    for (auto _ : state) {
+        ModContext<Word> ctx{P};
+        benchmark::DoNotOptimize(ctx.frobenius(n));
+    }
+}
+GF2_BENCHMARK_WORDS(BM_frobenius, frobenius_sizes);
+
+// The same power by `d` repeated modular squarings.
+template<Unsigned Word>
+static void
+BM_x_to_the_2_to_the(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto P = BitPolynomial<Word>::seeded_random(n, bench::seed);
+    for (auto _ : state) {
+        ModContext<Word> ctx{P};
+        benchmark::DoNotOptimize(ctx.x_to_the_2_to_the(n));
+    }
+}
+GF2_BENCHMARK_WORDS(BM_x_to_the_2_to_the, frobenius_sizes);
+
+// Element-wise products of two spans of elements of GF(2^m) with one full word per element, m = BITS<Word>.
+template<Unsigned Word>
+static void
+BM_gf2m_mul(benchmark::State& state) {
+    auto              n = static_cast<usize>(state.range(0));
+    auto              F = GF2m<Word>::of_degree(BITS<Word>);
+    Xoshiro256pp      rng{bench::seed};
+    std::vector<Word> a(n), b(n), out(n);
+    for (auto i = 0uz; i < n; ++i) {
+        a[i] = static_cast<Word>(rng());
+        b[i] = static_cast<Word>(rng());
+    }
+    for (auto _ : state) {
+        F.mul(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(n) * state.iterations());
+}
+GF2_BENCHMARK_WORDS(BM_gf2m_mul, gf2m_sizes);
+
+// Returns a buffer of random bytes for the CRC benchmarks.
+static std::vector<std::byte>
+random_bytes(usize n) {
+    Xoshiro256pp           rng{bench::seed};
+    std::vector<std::byte> result(n);
+    for (auto& b : result) b = static_cast<std::byte>(rng());
+    return result;
+}
+
+// CRC-32 of a buffer with the slicing tables and, on targets with a carry-less multiply, the folded lanes.
+static void
+BM_crc32(benchmark::State& state) {
+    auto data = random_bytes(static_cast<usize>(state.range(0)));
+    auto crc = CrcEngine<>::crc32();
+    for (auto _ : state) benchmark::DoNotOptimize(crc.checksum(data));
+    state.SetBytesProcessed(static_cast<std::int64_t>(data.size()) * state.iterations());
+}
+BENCHMARK(BM_crc32)->Apply(crc_sizes);
+
+// The same CRC computed a bit at a time.
+static void
+BM_naive_crc32(benchmark::State& state) {
+    auto       data = random_bytes(static_cast<usize>(state.range(0)));
+    CrcOptions options{.init = 0xFFFF'FFFF, .xor_out = 0xFFFF'FFFF, .reflect_in = true, .reflect_out = true};
+    for (auto _ : state) benchmark::DoNotOptimize(naive::crc(data, 32, 0x04C1'1DB7, options));
+    state.SetBytesProcessed(static_cast<std::int64_t>(data.size()) * state.iterations());
+}
+BENCHMARK(BM_naive_crc32)->Apply(crc_sizes);
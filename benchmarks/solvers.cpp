@@ -0,0 +1,75 @@
+/// Benchmarks for the dense solvers: `gf2::BitLU`, `gf2::BitGauss` & the echelon forms they are built on.
+///
+/// SPDX-FileCopyrightText:  2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+/// SPDX-License-Identifier: MIT
+#include "common.h"
+
+// The LU decomposition of a square bit-matrix.
+template<Unsigned Word>
+static void
+BM_BitLU(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto A = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    for (auto _ : state) benchmark::DoNotOptimize(A.LU());
+}
+GF2_BENCHMARK_WORDS(BM_BitLU, bench::matrix_sizes);
+
+// Solving `A * x = b` with an existing LU decomposition of an invertible `A`.
+template<Unsigned Word>
+static void
+BM_BitLU_solve(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto lu = bench::invertible_matrix<Word>(n).LU();
+    auto b = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(lu(b));
+}
+GF2_BENCHMARK_WORDS(BM_BitLU_solve, bench::matrix_sizes);
+
+// Setting up a Gaussian elimination solver for `A * x = b` & getting a solution.
+template<Unsigned Word>
+static void
+BM_BitGauss(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto A = bench::invertible_matrix<Word>(n);
+    auto b = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(BitGauss<Word>{A, b}());
+}
+GF2_BENCHMARK_WORDS(BM_BitGauss, bench::matrix_sizes);
+
+// The reduced row echelon form of a square bit-matrix.
+template<Unsigned Word>
+static void
+BM_reduced_echelon_form(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto A = BitMatrix<Word>::random(n, n, 0.5, bench::seed);
+    for (auto _ : state) {
+        auto B = A;
+        benchmark::DoNotOptimize(B.to_reduced_echelon_form());
+    }
+}
+GF2_BENCHMARK_WORDS(BM_reduced_echelon_form, bench::matrix_sizes);
+
+// Inverting a batch of 1024 small `n x n` bit-matrices one at a time.
+template<Unsigned Word>
+static void
+BM_inverse_each(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    std::vector<BitMatrix<Word>> in;
+    for (auto i = 0uz; i < 1024; ++i) in.push_back(BitMatrix<Word>::random(n, n, 0.5, bench::seed + i));
+    for (auto _ : state)
+        for (auto const& m : in) benchmark::DoNotOptimize(m.inverse());
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(in.size()));
+}
+BENCHMARK_TEMPLATE(BM_inverse_each, u64)->Arg(16)->Arg(32)->Arg(64)->Arg(128);
+
+// Inverting the same batch with the bit-sliced `gf2::batch::inverse`.
+template<Unsigned Word>
+static void
+BM_batch_inverse(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    std::vector<BitMatrix<Word>> in, out(1024, BitMatrix<Word>::zeros(n, n));
+    for (auto i = 0uz; i < 1024; ++i) in.push_back(BitMatrix<Word>::random(n, n, 0.5, bench::seed + i));
+    for (auto _ : state) benchmark::DoNotOptimize(batch::inverse(std::span<BitMatrix<Word> const>{in}, std::span{out}));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(in.size()));
+}
+BENCHMARK_TEMPLATE(BM_batch_inverse, u64)->Arg(16)->Arg(32)->Arg(64)->Arg(128);
@@ -0,0 +1,95 @@
+/// Benchmarks for bit-vector operations: random fill, dot products, Hamming distances & convolutions.
+///
+/// SPDX-FileCopyrightText:  2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+/// SPDX-License-Identifier: MIT
+#include "common.h"
+
+#include <naive.h>
+
+// Filling a bit-vector with fair random bits.
+template<Unsigned Word>
+static void
+BM_fill_random(benchmark::State& state) {
+    auto            n = static_cast<usize>(state.range(0));
+    BitVector<Word> v{n};
+    Xoshiro256pp    rng{bench::seed};
+    for (auto _ : state) {
+        fill_random(v, rng);
+        benchmark::DoNotOptimize(v.store());
+    }
+    bench::set_bits_processed(state, n);
+}
+GF2_BENCHMARK_WORDS(BM_fill_random, bench::vector_sizes);
+
+// Filling a bit-vector with biased random bits.
+template<Unsigned Word>
+static void
+BM_fill_random_biased(benchmark::State& state) {
+    auto            n = static_cast<usize>(state.range(0));
+    BitVector<Word> v{n};
+    Xoshiro256pp    rng{bench::seed};
+    for (auto _ : state) {
+        fill_random(v, rng, 0.3);
+        benchmark::DoNotOptimize(v.store());
+    }
+    bench::set_bits_processed(state, n);
+}
+GF2_BENCHMARK_WORDS(BM_fill_random_biased, bench::vector_sizes);
+
+// The dot product of two bit-vectors.
+template<Unsigned Word>
+static void
+BM_dot_vv(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto u = BitVector<Word>::random(n, 0.5, bench::seed);
+    auto v = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(dot(u, v));
+    bench::set_bits_processed(state, n);
+}
+GF2_BENCHMARK_WORDS(BM_dot_vv, bench::vector_sizes);
+
+// The Hamming distance between two bit-vectors with the fused XOR-popcount kernel.
+template<Unsigned Word>
+static void
+BM_hamming_distance(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto u = BitVector<Word>::random(n, 0.5, bench::seed);
+    auto v = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(hamming_distance(u, v));
+    bench::set_bits_processed(state, n);
+}
+GF2_BENCHMARK_WORDS(BM_hamming_distance, bench::vector_sizes);
+
+// The same distance as `count_ones(u ^ v)` for comparison with `BM_hamming_distance`.
+template<Unsigned Word>
+static void
+BM_count_ones_xor(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto u = BitVector<Word>::random(n, 0.5, bench::seed);
+    auto v = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(count_ones(u ^ v));
+    bench::set_bits_processed(state, n);
+}
+GF2_BENCHMARK_WORDS(BM_count_ones_xor, bench::vector_sizes);
+
+// The convolution of two bit-vectors of the same length.
+template<Unsigned Word>
+static void
+BM_convolve(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto u = BitVector<Word>::random(n, 0.5, bench::seed);
+    auto v = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(convolve(u, v));
+}
+GF2_BENCHMARK_WORDS(BM_convolve, bench::naive_sizes);
+
+// The element-by-element convolution from `examples/naive.h` for comparison with `BM_convolve`.
+template<Unsigned Word>
+static void
+BM_naive_convolve(benchmark::State& state) {
+    auto n = static_cast<usize>(state.range(0));
+    auto u = BitVector<Word>::random(n, 0.5, bench::seed);
+    auto v = BitVector<Word>::random(n, 0.5, bench::seed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(naive::convolve(u, v));
+}
+GF2_BENCHMARK_WORDS(BM_naive_convolve, bench::naive_sizes);
@@ -206,6 +206,20 @@ convolve(const gf2::BitVector<Word>& a, const gf2::BitVector<Word>& b) {
     return retval;
 }
 
+/// Evaluates the bit-polynomial p(x) at a square bit-matrix M using Horner's method with one product per degree.
+template<Unsigned Word>
+gf2::BitMatrix<Word>
+horner(const gf2::BitPolynomial<Word>& p, const gf2::BitMatrix<Word>& M) {
+    auto n = M.rows();
+    if (p.is_zero()) return gf2::BitMatrix<Word>{n, n};
+    auto result = gf2::BitMatrix<Word>::identity(n);
+    for (auto d = p.degree(); d > 0; --d) {
+        result = gf2::dot(M, result);
+        if (p[d - 1]) result.add_identity();
+    }
+    return result;
+}
+
 /// Computes the polynomial r(x) := x^n mod p(x) for exponent n, where p(x) is a bit-polynomial.
 /// This uses the simplest (and slowest) iterative approach.
 template<Unsigned Word>
@@ -243,10 +257,36 @@ reduce_x_to_the(usize n, const gf2::BitPolynomial<Word>& P) {
 
     // Larger powers: Use an iteration which writes x*r(x) mod p(x) in terms of r(x) mod p(x).
     auto r = p;
-    for (auto i = d; i < n; ++i) r = r[d - 1] ? p ^ (r >> 1) : (r >> 1);
+    for (auto i = d; i < n; ++i) {
+        bool carry = r[d - 1];
+        r >>= 1;
+        if (carry) r ^= p;
+    }
 
     // Done
     return gf2::BitPolynomial<Word>{r};
 }
 
+
+/// Returns the CRC of a span of bytes computed a bit at a time for the generator `x^w + p(x)` of width `w <= 64`.
+/// Here `poly` holds the coefficients of `p(x)` & `options` are the other parameters as in `gf2::CrcEngine`.
+inline std::uint64_t
+crc(std::span<std::byte const> bytes, std::size_t w, std::uint64_t poly, gf2::CrcOptions const& options = {}) {
+    auto top = std::uint64_t{1} << (w - 1);
+    auto mask = top | (top - 1);
+    auto reflect = [&](std::uint64_t v) { return gf2::reverse_bits(v) >> (64 - w); };
+    auto r = options.init & mask;
+    for (auto b : bytes) {
+        auto byte = static_cast<unsigned>(b);
+        for (auto k = 0; k < 8; ++k) {
+            bool bit = (byte >> (options.reflect_in ? k : 7 - k)) & 1;
+            bool out = (r & top) != 0;
+            r = (r << 1) & mask;
+            if (out != bit) r ^= poly & mask;
+        }
+    }
+    if (options.reflect_out) r = reflect(r);
+    return r ^ (options.xor_out & mask);
+}
+
 } // namespace naive
\ No newline at end of file
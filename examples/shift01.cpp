@@ -42,8 +42,8 @@ main() {
         // Do the two different style shifts.
         auto n_right = naive::shift_right(v, n_shift);
         auto n_left = naive::shift_left(v, n_shift);
-        auto o_right = v >> n_shift;
-        auto o_left = v << n_shift;
+        vector_type o_right = v >> n_shift;
+        vector_type o_left = v << n_shift;
 
         // Check that the results match.
         gf2_assert_eq(n_right, o_right, "Mismatch on right shift: len = {:L}, shift = {:L}.", n_size, n_shift);
@@ -0,0 +1,437 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Batched inverses, solves, ranks and products for many independent small bit-matrices at once. <br>
+/// See the [Batch](docs/pages/Batch.md) page for more details.
+
+#include <gf2/BitMatrix.h>
+#include <gf2/BitMatrixN.h>
+#include <gf2/MemoryScope.h>
+#include <gf2/ThreadPool.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace gf2::batch {
+
+/// The number of bit-matrices that the batched eliminations work on together.
+///
+/// The matrices are bit-sliced in blocks of this size: one 64-bit word holds the same element of every matrix in the
+/// block, so each word-level row operation is applied to all of them in one go.
+inline constexpr usize LANES = 64;
+
+namespace details {
+
+// A block of up to 64 bit-matrices of the same size stored bit-sliced. Word `(i, j)` holds element `(i, j)` of every
+// matrix in the block with matrix `l` in bit `l`. The rows are `stride` words apart so there is room for the extra
+// columns of an augmented system.
+class SlicedBlock {
+public:
+    SlicedBlock(usize rows, usize stride) :
+        m_stride{stride}, m_words(rows * stride, u64{0}, memory_resource()) {}
+
+    u64*       row(usize i) { return m_words.data() + i * m_stride; }
+    u64 const* row(usize i) const { return m_words.data() + i * m_stride; }
+
+    // Returns bits `[64 c, 64 c + 64)` of a row of a bit-matrix as one 64-bit word.
+    template<Unsigned Word>
+    static u64 chunk(BitSpan<Word const> const& src, usize c) {
+        constexpr usize per = BITS<u64> / BITS<Word>;
+        u64             result = 0;
+        for (auto t = 0uz; t < per && c * per + t < src.words(); ++t)
+            result |= static_cast<u64>(src.word(c * per + t)) << (t * BITS<Word>);
+        return result;
+    }
+
+    // Writes `bits` into bits `[64 c, 64 c + 64)` of a row of a bit-matrix.
+    template<Unsigned Word>
+    static void set_chunk(BitSpan<Word> dst, usize c, u64 bits) {
+        constexpr usize per = BITS<u64> / BITS<Word>;
+        for (auto t = 0uz; t < per && c * per + t < dst.words(); ++t)
+            dst.set_word(c * per + t, static_cast<Word>(bits >> (t * BITS<Word>)));
+    }
+
+    // Slices `src[first, first + count)` into the columns starting at `col0`, 64 columns at a time with one transpose
+    // of a 64 x 64 tile of bits for each row and chunk of columns.
+    template<Unsigned Word>
+    void load(std::span<BitMatrix<Word> const> src, usize first, usize count, usize col0) {
+        auto nr = src[first].rows();
+        auto nc = src[first].cols();
+        for (auto i = 0uz; i < nr; ++i) {
+            for (auto c = 0uz; c * BITS<u64> < nc; ++c) {
+                BitMatrixN<LANES, LANES, u64> tile;
+                for (auto l = 0uz; l < count; ++l) tile.row(l).store()[0] = chunk(src[first + l].row(i), c);
+                auto sliced = tile.transposed();
+                auto dst = row(i) + col0 + c * BITS<u64>;
+                for (auto b = 0uz; b < BITS<u64> && c * BITS<u64> + b < nc; ++b) dst[b] = sliced.row(b).store()[0];
+            }
+        }
+    }
+
+    // Writes the `nr x nc` sub-matrix with its columns starting at `col0` back out to `dst[first, first + count)`.
+    template<Unsigned Word>
+    void store(std::span<BitMatrix<Word>> dst, usize first, usize count, usize nr, usize nc, usize col0) const {
+        for (auto i = 0uz; i < nr; ++i) {
+            for (auto c = 0uz; c * BITS<u64> < nc; ++c) {
+                BitMatrixN<LANES, LANES, u64> tile;
+                auto                          src = row(i) + col0 + c * BITS<u64>;
+                for (auto b = 0uz; b < BITS<u64> && c * BITS<u64> + b < nc; ++b) tile.row(b).store()[0] = src[b];
+                auto unsliced = tile.transposed();
+                for (auto l = 0uz; l < count; ++l) set_chunk(dst[first + l].row(i), c, unsliced.row(l).store()[0]);
+            }
+        }
+    }
+
+    // Gauss-Jordan elimination on the `n x n` left part of the block, applied to all `width` columns of each row.
+    //
+    // For each column `c` we first add later rows into row `c` in the lanes where its diagonal element is zero. Then
+    // row `c` is added to every other row in the lanes where that row has a one in column `c`. The rows are zero
+    // before column `c` so only the words from there on are touched. Returns the mask of the lanes that are singular.
+    u64 gauss_jordan(usize n, usize width) {
+        u64 singular = 0;
+        for (auto c = 0uz; c < n; ++c) {
+            auto pc = row(c);
+            for (auto r = c + 1; r < n && ~pc[c] != 0; ++r) {
+                auto src = row(r);
+                auto mask = ~pc[c] & src[c];
+                if (mask != 0) add_masked(pc, src, mask, c, width);
+            }
+            singular |= ~pc[c];
+            for (auto r = 0uz; r < n; ++r) {
+                auto dst = row(r);
+                if (r != c && dst[c] != 0) add_masked(dst, pc, dst[c], c, width);
+            }
+        }
+        return singular;
+    }
+
+    // Row reduction on an `nr x nc` block that returns the rank of each lane.
+    //
+    // The pivot rows are different in each lane so we keep a mask per row of the lanes where it is already a pivot.
+    // For column `c`, the first unused row with a one in a lane becomes that lane's pivot. We gather the pivot rows of
+    // all the lanes into one row and add it to the other unused rows in the lanes where they have a one in column `c`.
+    std::array<usize, LANES> row_reduce(usize nr, usize nc) {
+        std::array<usize, LANES> ranks{};
+        std::pmr::vector<u64>    used(nr, u64{0}, memory_resource());
+        std::pmr::vector<u64>    pick(nr, u64{0}, memory_resource());
+        std::pmr::vector<u64>    pivot(nc, u64{0}, memory_resource());
+        for (auto c = 0uz; c < nc; ++c) {
+            u64 found = 0;
+            for (auto r = 0uz; r < nr; ++r) {
+                pick[r] = row(r)[c] & ~used[r] & ~found;
+                found |= pick[r];
+            }
+            if (found == 0) continue;
+
+            std::fill(pivot.begin() + static_cast<std::ptrdiff_t>(c), pivot.end(), u64{0});
+            for (auto r = 0uz; r < nr; ++r)
+                if (pick[r] != 0) add_masked(pivot.data(), row(r), pick[r], c, nc);
+            for (auto r = 0uz; r < nr; ++r) {
+                used[r] |= pick[r];
+                auto mask = row(r)[c] & ~used[r];
+                if (mask != 0) add_masked(row(r), pivot.data(), mask, c, nc);
+            }
+            for (auto lanes = found; lanes != 0; lanes &= lanes - 1)
+                ranks[static_cast<usize>(std::countr_zero(lanes))]++;
+        }
+        return ranks;
+    }
+
+private:
+    usize                 m_stride;
+    std::pmr::vector<u64> m_words;
+
+    // Adds the words `[j0, j1)` of `src` into `dst` in the lanes picked out by `mask`.
+    static void add_masked(u64* dst, u64 const* src, u64 mask, usize j0, usize j1) {
+        for (auto j = j0; j < j1; ++j) dst[j] ^= src[j] & mask;
+    }
+};
+
+// Checks that all the matrices in a batch are `rows x cols`.
+template<Unsigned Word>
+bool
+all_sized(std::span<BitMatrix<Word> const> ms, usize rows, usize cols) {
+    return std::ranges::all_of(ms, [&](auto const& m) { return m.rows() == rows && m.cols() == cols; });
+}
+
+template<Unsigned Word>
+bool
+all_sized(std::span<BitMatrix<Word>> ms, usize rows, usize cols) {
+    return std::ranges::all_of(ms, [&](auto const& m) { return m.rows() == rows && m.cols() == cols; });
+}
+
+} // namespace details
+
+/// Inverts each of a batch of square bit-matrices into the matching slot of a preallocated output.
+///
+/// The matrices must all be the same size and each output must already have that size. Returns a bit-vector whose
+/// element `i` is set if `in[i]` is invertible. The outputs for the singular matrices are left with unspecified
+/// values.
+///
+/// The matrices are bit-sliced in blocks of `gf2::batch::LANES` and each block is inverted by a single branch-free
+/// Gauss-Jordan elimination that works on all of them at once. The blocks are spread over the threads of the
+/// executor, which is either the `gf2::par` tag or a `gf2::ThreadPool`. There are no allocations per matrix.
+///
+/// # Panics
+/// Panics if the sizes of the inputs and outputs do not all match.
+///
+/// # Example
+/// ```
+/// std::vector<BitMatrix<u8>> in, out;
+/// for (auto i = 0uz; i < 100; ++i) {
+///     in.push_back(BitMatrix<u8>::random(20, 20, 0.5, i + 1));
+///     out.push_back(BitMatrix<u8>::zeros(20, 20));
+/// }
+/// auto ok = batch::inverse(par, std::span<BitMatrix<u8> const>{in}, std::span{out});
+/// for (auto i = 0uz; i < in.size(); ++i) {
+///     assert_eq(ok[i], in[i].inverse().has_value());
+///     if (ok[i]) assert_eq(out[i], in[i].inverse().value());
+/// }
+/// ```
+template<Executor Exec, Unsigned Word>
+BitVector<>
+inverse(Exec&& exec, std::span<BitMatrix<Word> const> in, std::span<BitMatrix<Word>> out) {
+    gf2_assert_eq(in.size(), out.size(), "There are {} inputs but {} outputs", in.size(), out.size());
+    auto ok = BitVector<>::zeros(in.size());
+    if (in.empty()) return ok;
+    auto n = in[0].rows();
+    gf2_assert(details::all_sized(in, n, n), "All the inputs should be square and {} x {}", n, n);
+    gf2_assert(details::all_sized(out, n, n), "All the outputs should be {} x {}", n, n);
+
+    // Each chunk covers whole blocks so the bits of `ok` it sets are in words of its own.
+    ::gf2::details::for_each_chunk(exec, in.size(), LANES, [&](usize begin, usize end) {
+        for (auto first = begin; first < end; first += LANES) {
+            auto count = std::min(LANES, end - first);
+            details::SlicedBlock block{n, 2 * n};
+            block.load(in, first, count, 0);
+            for (auto i = 0uz; i < n; ++i) block.row(i)[n + i] = MAX<u64>;
+            auto singular = block.gauss_jordan(n, 2 * n);
+            block.store(out, first, count, n, n, n);
+            ok.set_word(first / LANES, static_cast<usize>(~singular));
+        }
+    });
+    return ok;
+}
+
+/// Inverts each of a batch of square bit-matrices into the matching slot of a preallocated output.
+///
+/// See the executor overload for the details.
+///
+/// # Example
+/// ```
+/// std::vector<BitMatrix<>> in{BitMatrix<>::identity(3), BitMatrix<>::ones(3, 3)};
+/// std::vector<BitMatrix<>> out(2, BitMatrix<>::zeros(3, 3));
+/// auto ok = batch::inverse(std::span<BitMatrix<> const>{in}, std::span{out});
+/// assert_eq(ok.to_string(), "10");
+/// assert_eq(out[0], BitMatrix<>::identity(3));
+/// ```
+template<Unsigned Word>
+BitVector<>
+inverse(std::span<BitMatrix<Word> const> in, std::span<BitMatrix<Word>> out) {
+    return inverse(seq, in, out);
+}
+
+/// Solves each of a batch of square systems `A[i] * x[i] = b[i]` into the matching slot of a preallocated output.
+///
+/// The matrices must all be `n x n` and the right-hand sides and outputs must all have `n` elements. Returns a
+/// bit-vector whose element `i` is set if `A[i]` is invertible so `x[i]` is the unique solution. The outputs for the
+/// singular matrices are left with unspecified values.
+///
+/// Each block of `gf2::batch::LANES` systems is solved by one branch-free Gauss-Jordan elimination on the bit-sliced
+/// augmented matrices `[A | b]`.
+///
+/// # Panics
+/// Panics if the sizes of the inputs and outputs do not all match.
+///
+/// # Example
+/// ```
+/// std::vector<BitMatrix<>> A;
+/// std::vector<BitVector<>> b, x;
+/// for (auto i = 0uz; i < 70; ++i) {
+///     A.push_back(BitMatrix<>::random(16, 16, 0.5, i + 1));
+///     b.push_back(BitVector<>::random(16, 0.5, i + 100));
+///     x.push_back(BitVector<>::zeros(16));
+/// }
+/// auto ok = batch::x_for(par, std::span<BitMatrix<> const>{A}, std::span<BitVector<> const>{b}, std::span{x});
+/// for (auto i = 0uz; i < A.size(); ++i) {
+///     assert_eq(ok[i], A[i].inverse().has_value());
+///     if (ok[i]) assert_eq(dot(A[i], x[i]), b[i]);
+/// }
+/// ```
+template<Executor Exec, Unsigned Word>
+BitVector<>
+x_for(Exec&& exec, std::span<BitMatrix<Word> const> A, std::span<BitVector<Word> const> b,
+      std::span<BitVector<Word>> x) {
+    gf2_assert_eq(A.size(), b.size(), "There are {} matrices but {} right-hand sides", A.size(), b.size());
+    gf2_assert_eq(A.size(), x.size(), "There are {} matrices but {} outputs", A.size(), x.size());
+    auto ok = BitVector<>::zeros(A.size());
+    if (A.empty()) return ok;
+    auto n = A[0].rows();
+    gf2_assert(details::all_sized(A, n, n), "All the matrices should be square and {} x {}", n, n);
+    gf2_assert(std::ranges::all_of(b, [&](auto const& v) { return v.size() == n; }), "All b's should have size {}", n);
+    gf2_assert(std::ranges::all_of(x, [&](auto const& v) { return v.size() == n; }), "All x's should have size {}", n);
+
+    ::gf2::details::for_each_chunk(exec, A.size(), LANES, [&](usize begin, usize end) {
+        for (auto first = begin; first < end; first += LANES) {
+            auto count = std::min(LANES, end - first);
+            details::SlicedBlock block{n, n + 1};
+            block.load(A, first, count, 0);
+            for (auto l = 0uz; l < count; ++l)
+                b[first + l].for_each_set_bit([&](usize i) { block.row(i)[n] |= u64{1} << l; });
+            auto singular = block.gauss_jordan(n, n + 1);
+            for (auto l = 0uz; l < count; ++l) {
+                auto& xl = x[first + l];
+                xl.set_all(false);
+                for (auto i = 0uz; i < n; ++i)
+                    if ((block.row(i)[n] >> l) & 1) xl.set(i);
+            }
+            ok.set_word(first / LANES, static_cast<usize>(~singular));
+        }
+    });
+    return ok;
+}
+
+/// Solves each of a batch of square systems `A[i] * x[i] = b[i]` into the matching slot of a preallocated output.
+///
+/// See the executor overload for the details.
+///
+/// # Example
+/// ```
+/// std::vector<BitMatrix<>> A{BitMatrix<>::identity(3)};
+/// std::vector<BitVector<>> b{BitVector<>::from_string("101").value()};
+/// std::vector<BitVector<>> x{BitVector<>::zeros(3)};
+/// auto ok = batch::x_for(std::span<BitMatrix<> const>{A}, std::span<BitVector<> const>{b}, std::span{x});
+/// assert(ok[0]);
+/// assert_eq(x[0], b[0]);
+/// ```
+template<Unsigned Word>
+BitVector<>
+x_for(std::span<BitMatrix<Word> const> A, std::span<BitVector<Word> const> b, std::span<BitVector<Word>> x) {
+    return x_for(seq, A, b, x);
+}
+
+/// Writes the rank of each of a batch of bit-matrices into the matching slot of a preallocated output.
+///
+/// The matrices must all have the same dimensions but need not be square. Each block of `gf2::batch::LANES` matrices
+/// is reduced in one bit-sliced elimination that keeps track of where the pivots are in each of them.
+///
+/// # Panics
+/// Panics if the sizes of the inputs and outputs do not all match.
+///
+/// # Example
+/// ```
+/// std::vector<BitMatrix<u16>> in;
+/// for (auto i = 0uz; i < 100; ++i) in.push_back(BitMatrix<u16>::random(30, 20, 0.2, i + 1));
+/// std::vector<usize> ranks(in.size());
+/// batch::rank(par, std::span<BitMatrix<u16> const>{in}, std::span{ranks});
+/// for (auto i = 0uz; i < in.size(); ++i) assert_eq(ranks[i], in[i].rank());
+/// ```
+template<Executor Exec, Unsigned Word>
+void
+rank(Exec&& exec, std::span<BitMatrix<Word> const> in, std::span<usize> out) {
+    gf2_assert_eq(in.size(), out.size(), "There are {} inputs but {} outputs", in.size(), out.size());
+    if (in.empty()) return;
+    auto nr = in[0].rows();
+    auto nc = in[0].cols();
+    gf2_assert(details::all_sized(in, nr, nc), "All the inputs should be {} x {}", nr, nc);
+
+    ::gf2::details::for_each_chunk(exec, in.size(), LANES, [&](usize begin, usize end) {
+        for (auto first = begin; first < end; first += LANES) {
+            auto count = std::min(LANES, end - first);
+            if (nr == 0 || nc == 0) {
+                std::fill_n(out.begin() + static_cast<std::ptrdiff_t>(first), count, 0uz);
+                continue;
+            }
+            details::SlicedBlock block{nr, nc};
+            block.load(in, first, count, 0);
+            auto ranks = block.row_reduce(nr, nc);
+            std::copy_n(ranks.begin(), count, out.begin() + static_cast<std::ptrdiff_t>(first));
+        }
+    });
+}
+
+/// Writes the rank of each of a batch of bit-matrices into the matching slot of a preallocated output.
+///
+/// See the executor overload for the details.
+///
+/// # Example
+/// ```
+/// std::vector<BitMatrix<>> in{BitMatrix<>::identity(4), BitMatrix<>::ones(4, 4), BitMatrix<>::zeros(4, 4)};
+/// std::vector<usize> ranks(3);
+/// batch::rank(std::span<BitMatrix<> const>{in}, std::span{ranks});
+/// assert_eq(ranks, (std::vector<usize>{4, 1, 0}));
+/// ```
+template<Unsigned Word>
+void
+rank(std::span<BitMatrix<Word> const> in, std::span<usize> out) {
+    rank(seq, in, out);
+}
+
+/// Writes the products `A[i] * B[i]` of a batch of pairs of bit-matrices into the matching slot of a preallocated
+/// output.
+///
+/// Each output must already have the right size. Row `r` of a product is the sum of the rows of `B[i]` picked out by
+/// row `r` of `A[i]` and is accumulated in place, so no temporaries are allocated. A product works a whole row of
+/// words at a time so there is nothing to gain by bit-slicing it.
+///
+/// # Panics
+/// Panics if the sizes of the inputs and outputs do not all match.
+///
+/// # Example
+/// ```
+/// std::vector<BitMatrix<u8>> A, B, C;
+/// for (auto i = 0uz; i < 10; ++i) {
+///     A.push_back(BitMatrix<u8>::random(12, 20, 0.5, i + 1));
+///     B.push_back(BitMatrix<u8>::random(20, 9, 0.5, i + 50));
+///     C.push_back(BitMatrix<u8>::zeros(12, 9));
+/// }
+/// batch::dot(par, std::span<BitMatrix<u8> const>{A}, std::span<BitMatrix<u8> const>{B}, std::span{C});
+/// for (auto i = 0uz; i < A.size(); ++i) assert_eq(C[i], dot(A[i], B[i]));
+/// ```
+template<Executor Exec, Unsigned Word>
+void
+dot(Exec&& exec, std::span<BitMatrix<Word> const> A, std::span<BitMatrix<Word> const> B,
+    std::span<BitMatrix<Word>> out) {
+    gf2_assert_eq(A.size(), B.size(), "There are {} left-hand and {} right-hand matrices", A.size(), B.size());
+    gf2_assert_eq(A.size(), out.size(), "There are {} inputs but {} outputs", A.size(), out.size());
+    ::gf2::details::for_each_chunk(exec, A.size(), LANES, [&](usize begin, usize end) {
+        for (auto i = begin; i < end; ++i) {
+            auto const& a = A[i];
+            auto const& b = B[i];
+            auto&       c = out[i];
+            gf2_assert_eq(a.cols(), b.rows(), "Incompatible dimensions: {} != {}", a.cols(), b.rows());
+            gf2_assert(c.rows() == a.rows() && c.cols() == b.cols(), "Output {} has the wrong size", i);
+            c.set_all(false);
+            for (auto r = 0uz; r < a.rows(); ++r) {
+                auto dst = c.row(r);
+                a.row(r).for_each_set_bit([&](usize k) { dst ^= b.row(k); });
+            }
+        }
+    });
+}
+
+/// Writes the products `A[i] * B[i]` of a batch of pairs of bit-matrices into the matching slot of a preallocated
+/// output.
+///
+/// See the executor overload for the details.
+///
+/// # Example
+/// ```
+/// std::vector<BitMatrix<>> A{BitMatrix<>::identity(3)}, B{BitMatrix<>::ones(3, 2)};
+/// std::vector<BitMatrix<>> C{BitMatrix<>::zeros(3, 2)};
+/// batch::dot(std::span<BitMatrix<> const>{A}, std::span<BitMatrix<> const>{B}, std::span{C});
+/// assert_eq(C[0], B[0]);
+/// ```
+template<Unsigned Word>
+void
+dot(std::span<BitMatrix<Word> const> A, std::span<BitMatrix<Word> const> B, std::span<BitMatrix<Word>> out) {
+    dot(seq, A, B, out);
+}
+
+} // namespace gf2::batch
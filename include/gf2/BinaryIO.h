@@ -0,0 +1,657 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// A compact binary file format for bit-vectors and bit-matrices with streaming writers and memory-mapped views. <br>
+/// See the [BinaryIO](docs/pages/BinaryIO.md) page for more details.
+///
+/// On POSIX systems the mapped views use `mmap`. Elsewhere (or if `GF2_NO_MMAP` is defined) they read the whole file
+/// into memory instead, which keeps the same interface but is no longer zero-copy.
+
+#include <gf2/BitMatrix.h>
+#include <gf2/BitSpan.h>
+#include <gf2/BitVector.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(GF2_NO_MMAP) && __has_include(<sys/mman.h>)
+    #define GF2_HAS_MMAP 1
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace gf2 {
+
+/// The size in bytes of the header at the start of a `gf2` binary file. The payload of words starts right after it.
+inline constexpr usize BINARY_HEADER_BYTES = 32;
+
+namespace details {
+
+static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big,
+              "The binary file format needs a little or big endian platform.");
+
+// The header of a binary file. On disk every field is stored little endian whatever the platform:
+//
+// | Bytes   | Field                                                                         |
+// | ------- | ----------------------------------------------------------------------------- |
+// | 0 - 3   | The magic string "GF2B".                                                      |
+// | 4       | The format version (currently 1).                                             |
+// | 5       | The kind of object: 'V' for a bit-vector or 'M' for a bit-matrix.             |
+// | 6       | The number of bytes in each word of the payload.                              |
+// | 7       | The byte order of the words in the payload: 0 for little or 1 for big endian. |
+// | 8 - 15  | The number of rows (1 for a bit-vector).                                      |
+// | 16 - 23 | The number of columns (the number of elements for a bit-vector).              |
+// | 24 - 31 | The number of payload words per row.                                          |
+//
+// The payload is `rows * stride` words with row `i` in words `[i * stride, (i + 1) * stride)`.
+struct BinaryHeader {
+    char  kind = 'V';
+    u8    word_bytes = 0;
+    bool  big_endian = false;
+    usize rows = 0;
+    usize cols = 0;
+    usize stride = 0;
+
+    static constexpr std::array<char, 4> magic{'G', 'F', '2', 'B'};
+    static constexpr u8                  version = 1;
+
+    // Returns the header for an object of the given kind and shape with the native word layout for `Word`.
+    template<Unsigned Word>
+    static BinaryHeader native(char kind, usize rows, usize cols) {
+        return {kind, sizeof(Word), std::endian::native == std::endian::big, rows, cols, words_needed<Word>(cols)};
+    }
+
+    // Returns `true` if the payload can be used in-place as words of type `Word`.
+    template<Unsigned Word>
+    bool is_native() const {
+        return word_bytes == sizeof(Word) && big_endian == (std::endian::native == std::endian::big);
+    }
+
+    // The number of bytes in the payload.
+    usize payload_bytes() const { return rows * stride * word_bytes; }
+
+    // Packs the header into its 32 bytes.
+    std::array<unsigned char, BINARY_HEADER_BYTES> encode() const {
+        std::array<unsigned char, BINARY_HEADER_BYTES> bytes{};
+        std::copy(magic.begin(), magic.end(), bytes.begin());
+        bytes[4] = version;
+        bytes[5] = static_cast<unsigned char>(kind);
+        bytes[6] = word_bytes;
+        bytes[7] = big_endian ? 1 : 0;
+        auto put = [&](usize at, usize value) {
+            for (auto k = 0uz; k < 8; ++k) bytes[at + k] = static_cast<unsigned char>((value >> (8 * k)) & 0xFF);
+        };
+        put(8, rows);
+        put(16, cols);
+        put(24, stride);
+        return bytes;
+    }
+
+    // Unpacks & checks a header, throwing a `std::runtime_error` if it isn't a valid one.
+    static BinaryHeader decode(unsigned char const* bytes) {
+        if (!std::equal(magic.begin(), magic.end(), bytes)) throw std::runtime_error("Not a gf2 binary file.");
+        if (bytes[4] != version) throw std::runtime_error("Unsupported gf2 binary file version.");
+        auto get = [&](usize at) {
+            usize value = 0;
+            for (auto k = 0uz; k < 8; ++k) value |= usize{bytes[at + k]} << (8 * k);
+            return value;
+        };
+        BinaryHeader h{static_cast<char>(bytes[5]), bytes[6], bytes[7] == 1, get(8), get(16), get(24)};
+        if (h.kind != 'V' && h.kind != 'M') throw std::runtime_error("Unknown object kind in gf2 binary file.");
+        if (h.word_bytes != 1 && h.word_bytes != 2 && h.word_bytes != 4 && h.word_bytes != 8)
+            throw std::runtime_error("Unsupported word size in gf2 binary file.");
+        if (bytes[7] > 1) throw std::runtime_error("Unknown byte order in gf2 binary file.");
+        if (h.kind == 'V' && h.rows != 1) throw std::runtime_error("A gf2 binary bit-vector must have one row.");
+
+        // The stride must match the columns, worked out so that a huge column count can't overflow.
+        auto word_bits = 8uz * h.word_bytes;
+        if (h.stride != h.cols / word_bits + (h.cols % word_bits != 0 ? 1 : 0))
+            throw std::runtime_error("Inconsistent row stride in gf2 binary file.");
+
+        // The payload size must fit in a `usize` (the bytes in a row are no more than `cols / 8 + word_bytes`).
+        auto row_bytes = h.stride * h.word_bytes;
+        if (row_bytes != 0 && h.rows > std::numeric_limits<usize>::max() / row_bytes)
+            throw std::runtime_error("The dimensions in the gf2 binary file are too large.");
+        return h;
+    }
+
+    // Reads & checks the header at the current position of a stream.
+    static BinaryHeader read(std::istream& is) {
+        std::array<unsigned char, BINARY_HEADER_BYTES> bytes;
+        if (!is.read(reinterpret_cast<char*>(bytes.data()), BINARY_HEADER_BYTES))
+            throw std::runtime_error("Failed to read the header of a gf2 binary file.");
+        return decode(bytes.data());
+    }
+
+    // Writes the header at the current position of a stream.
+    void write(std::ostream& os) const {
+        auto bytes = encode();
+        if (!os.write(reinterpret_cast<char const*>(bytes.data()), BINARY_HEADER_BYTES))
+            throw std::runtime_error("Failed to write the header of a gf2 binary file.");
+    }
+};
+
+// Writes the bits of any bit-store as `words()` native words.
+// Stores that start on a word boundary go straight out of their words except for the last one which may hold bits
+// that are past the end of the store. Others are shifted into place word by word through a small buffer.
+template<BitStore Store>
+void
+write_store_words(std::ostream& os, Store const& store) {
+    using word_type = typename Store::word_type;
+    auto n_words = store.words();
+    if (n_words == 0) return;
+    if (store.offset() == 0) {
+        os.write(reinterpret_cast<char const*>(store.store()), std::streamsize((n_words - 1) * sizeof(word_type)));
+        auto last = store.word(n_words - 1);
+        os.write(reinterpret_cast<char const*>(&last), sizeof(word_type));
+    } else {
+        constexpr usize              chunk = 512;
+        std::array<word_type, chunk> buffer;
+        for (auto i = 0uz; i < n_words; i += chunk) {
+            auto n = std::min(chunk, n_words - i);
+            for (auto k = 0uz; k < n; ++k) buffer[k] = store.word(i + k);
+            os.write(reinterpret_cast<char const*>(buffer.data()), std::streamsize(n * sizeof(word_type)));
+        }
+    }
+    if (!os) throw std::runtime_error("Failed to write the payload of a gf2 binary file.");
+}
+
+// Clears the bits past the last of `cols` columns in a row held in the words at `row`.
+template<Unsigned Word>
+void
+mask_row_tail(Word* row, usize cols) {
+    if (auto tail = cols % BITS<Word>; tail != 0)
+        row[words_needed<Word>(cols) - 1] &= static_cast<Word>(MAX<Word> >> (BITS<Word> - tail));
+}
+
+// Reads one row of the payload described by `h` into the `words_needed<Word>(h.cols)` words at `dst`.
+// Payloads with the native layout are read straight into place. Anything else is first put in little endian byte
+// order, at which point byte `k` holds elements `8k` to `8k + 7` whatever the word size, and then regrouped.
+template<Unsigned Word>
+void
+read_row_words(std::istream& is, BinaryHeader const& h, Word* dst, std::pmr::vector<unsigned char>& scratch) {
+    auto n_words = words_needed<Word>(h.cols);
+    auto row_bytes = h.stride * h.word_bytes;
+    if (h.is_native<Word>()) {
+        if (!is.read(reinterpret_cast<char*>(dst), std::streamsize(row_bytes)))
+            throw std::runtime_error("Truncated payload in gf2 binary file.");
+    } else {
+        scratch.resize(row_bytes);
+        if (!is.read(reinterpret_cast<char*>(scratch.data()), std::streamsize(row_bytes)))
+            throw std::runtime_error("Truncated payload in gf2 binary file.");
+        if (h.big_endian)
+            for (auto at = 0uz; at < row_bytes; at += h.word_bytes)
+                std::reverse(scratch.data() + at, scratch.data() + at + h.word_bytes);
+        for (auto w = 0uz; w < n_words; ++w) {
+            Word word = 0;
+            for (auto b = 0uz; b < sizeof(Word) && w * sizeof(Word) + b < row_bytes; ++b)
+                word = static_cast<Word>(word | (Word(scratch[w * sizeof(Word) + b]) << (8 * b)));
+            dst[w] = word;
+        }
+    }
+
+    // Bits past the last column must be zero whatever the file says.
+    mask_row_tail(dst, h.cols);
+}
+
+// A read-only view of the bytes of a whole file that keeps them alive for as long as it lives.
+// With `mmap` the pages are mapped into memory on demand. Otherwise the file is read into a buffer.
+class MappedFile {
+public:
+    explicit MappedFile(std::filesystem::path const& path) {
+#if defined(GF2_HAS_MMAP)
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Failed to open '" + path.string() + "' for mapping.");
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to query the size of '" + path.string() + "'.");
+        }
+        m_size = static_cast<usize>(info.st_size);
+        if (m_size > 0) {
+            auto addr = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Failed to map '" + path.string() + "' into memory.");
+            }
+            m_data = static_cast<unsigned char const*>(addr);
+        }
+        ::close(fd);
+#else
+        std::ifstream file{path, std::ios::binary | std::ios::ate};
+        if (!file) throw std::runtime_error("Failed to open '" + path.string() + "' for reading.");
+        m_size = static_cast<usize>(file.tellg());
+        m_buffer.resize((m_size + sizeof(u64) - 1) / sizeof(u64));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(m_buffer.data()), std::streamsize(m_size)))
+            throw std::runtime_error("Failed to read '" + path.string() + "'.");
+        m_data = reinterpret_cast<unsigned char const*>(m_buffer.data());
+#endif
+    }
+
+    ~MappedFile() { release(); }
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+#if !defined(GF2_HAS_MMAP)
+            m_buffer = std::move(other.m_buffer);
+#endif
+        }
+        return *this;
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    unsigned char const* data() const { return m_data; }
+    usize                size() const { return m_size; }
+
+private:
+    unsigned char const* m_data = nullptr;
+    usize                m_size = 0;
+#if !defined(GF2_HAS_MMAP)
+    // The buffer is made of 64-bit words so the payload after the 32 byte header is aligned for any word type.
+    std::vector<u64> m_buffer;
+#endif
+
+    void release() {
+#if defined(GF2_HAS_MMAP)
+        if (m_data != nullptr) ::munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+};
+
+// Throws a `std::runtime_error` unless the file described by `h` can be read as a bit-vector.
+inline void
+check_single_row(BinaryHeader const& h) {
+    if (h.rows == 0) throw std::runtime_error("The gf2 binary file holds a bit-matrix with no rows.");
+    if (h.rows > 1) throw std::runtime_error("The gf2 binary file holds a bit-matrix with more than one row.");
+}
+
+} // namespace details
+
+/// @name Binary Writers & Readers
+/// @{
+
+/// Writes any bit-store (a bit-vector, bit-array, or bit-span) to a binary stream in the `gf2` binary format.
+///
+/// The payload is the words of the store in the native word size and byte order of this platform, both of which are
+/// recorded in the header. Open file streams with `std::ios::binary`.
+///
+/// # Panics
+/// This method throws a `std::runtime_error` if the stream fails.
+///
+/// # Example
+/// ```
+/// std::stringstream ss;
+/// auto v = BitVector<u16>::random(100);
+/// write_binary(ss, v);
+/// assert_eq(ss.str().size(), BINARY_HEADER_BYTES + 7 * sizeof(u16));
+/// assert_eq(read_binary_vector<u16>(ss), v);
+/// ```
+template<BitStore Store>
+void
+write_binary(std::ostream& os, Store const& store) {
+    using word_type = typename Store::word_type;
+    details::BinaryHeader::native<word_type>('V', 1, store.size()).write(os);
+    details::write_store_words(os, store);
+}
+
+/// Writes a bit-matrix to a binary stream in the `gf2` binary format.
+///
+/// Row `i` is written as the `words_needed(cols())` words that hold its elements, so the padding words that the
+/// in-memory store may use are not written.
+///
+/// # Panics
+/// This method throws a `std::runtime_error` if the stream fails.
+///
+/// # Example
+/// ```
+/// std::stringstream ss;
+/// auto m = BitMatrix<u8>::random(10, 20);
+/// write_binary(ss, m);
+/// assert_eq(ss.str().size(), BINARY_HEADER_BYTES + 10 * 3);
+/// assert_eq(read_binary_matrix<u8>(ss), m);
+/// ```
+template<Unsigned Word>
+void
+write_binary(std::ostream& os, BitMatrix<Word> const& m) {
+    details::BinaryHeader::native<Word>('M', m.rows(), m.cols()).write(os);
+    for (auto i = 0uz; i < m.rows(); ++i) details::write_store_words(os, m.row(i));
+}
+
+/// Reads a bit-vector in the `gf2` binary format from a stream.
+///
+/// Files written with a different word size or byte order are converted as they are read. A bit-matrix file with a
+/// single row can also be read as a bit-vector.
+///
+/// # Panics
+/// This method throws a `std::runtime_error` if the stream does not hold a valid bit-vector.
+///
+/// # Example
+/// ```
+/// std::stringstream ss;
+/// auto v = BitVector<u64>::random(1000);
+/// write_binary(ss, v);
+/// auto w = read_binary_vector<u8>(ss);
+/// assert_eq(w.to_string(), v.to_string());
+/// ```
+///
+/// # Example
+/// ```
+/// std::stringstream ss;
+/// write_binary(ss, BitMatrix<u8>::zeros(0, 5));
+/// std::string message;
+/// try {
+///     read_binary_vector<u8>(ss);
+/// } catch (std::runtime_error const& e) { message = e.what(); }
+/// assert_eq(message, "The gf2 binary file holds a bit-matrix with no rows.");
+/// ```
+///
+/// # Example
+/// ```
+/// std::stringstream ss;
+/// write_binary(ss, BitMatrix<u8>::zeros(2, 9));
+/// auto bytes = ss.str();
+/// for (auto k = 8uz; k < 16; ++k) bytes[k] = char(0xFF);
+/// std::stringstream bad{bytes};
+/// bool threw = false;
+/// try {
+///     read_binary_matrix<u8>(bad);
+/// } catch (std::runtime_error const&) { threw = true; }
+/// assert(threw);
+/// ```
+template<Unsigned Word = usize>
+BitVector<Word>
+read_binary_vector(std::istream& is) {
+    auto h = details::BinaryHeader::read(is);
+    details::check_single_row(h);
+    auto                            result = BitVector<Word>::zeros(h.cols);
+    std::pmr::vector<unsigned char> scratch{memory_resource()};
+    if (h.cols > 0) details::read_row_words(is, h, result.store(), scratch);
+    return result;
+}
+
+/// Reads a bit-matrix in the `gf2` binary format from a stream.
+///
+/// Files written with a different word size or byte order are converted as they are read. A bit-vector file is read
+/// as a bit-matrix with one row.
+///
+/// # Panics
+/// This method throws a `std::runtime_error` if the stream does not hold a valid bit-matrix.
+///
+/// # Example
+/// ```
+/// std::stringstream ss;
+/// auto m = BitMatrix<u32>::random(40, 70);
+/// write_binary(ss, m);
+/// auto n = read_binary_matrix<u16>(ss);
+/// assert_eq(n.to_compact_binary_string(), m.to_compact_binary_string());
+/// ```
+template<Unsigned Word = usize>
+BitMatrix<Word>
+read_binary_matrix(std::istream& is) {
+    auto                            h = details::BinaryHeader::read(is);
+    auto                            result = BitMatrix<Word>::zeros(h.rows, h.cols);
+    std::pmr::vector<unsigned char> scratch{memory_resource()};
+    if (result.is_empty()) {
+        // Skip over any payload of a degenerate matrix.
+        is.ignore(std::streamsize(h.payload_bytes()));
+        return result;
+    }
+    for (auto i = 0uz; i < h.rows; ++i) {
+        auto row = result.row(i);
+        details::read_row_words(is, h, row.store(), scratch);
+    }
+    return result;
+}
+
+/// @}
+
+/// Writes a bit-matrix to a binary stream one row at a time so that the whole matrix never has to be in memory.
+///
+/// The header is written when the writer is created so the dimensions are fixed up front. Then each call to
+/// `write_row` appends one row. A file is complete once `rows()` rows have been written.
+///
+/// # Example
+/// ```
+/// std::stringstream ss;
+/// BitMatrixWriter<> writer{ss, 3, 5};
+/// writer.write_row(BitVector<>::from_string("10000").value());
+/// writer.write_row(BitVector<>::from_string("01000").value());
+/// assert(!writer.is_complete());
+/// writer.write_row(BitVector<>::from_string("00111").value());
+/// assert(writer.is_complete());
+/// assert_eq(read_binary_matrix(ss).to_compact_binary_string(), "10000 01000 00111");
+/// ```
+template<Unsigned Word = usize>
+class BitMatrixWriter {
+public:
+    /// Creates a writer for an `m x n` bit-matrix on the stream `os` and writes the header.
+    ///
+    /// # Panics
+    /// This method throws a `std::runtime_error` if the stream fails.
+    BitMatrixWriter(std::ostream& os, usize m, usize n) : m_os{os}, m_rows{m}, m_cols{n} {
+        details::BinaryHeader::native<Word>('M', m, n).write(m_os);
+    }
+
+    /// Appends the next row which can be any bit-store with `cols()` elements.
+    ///
+    /// # Panics
+    /// We check that the row has the right size and that there is room for it unless `NDEBUG` is defined. This method
+    /// throws a `std::runtime_error` if the stream fails.
+    template<BitStore Store>
+        requires std::same_as<typename Store::word_type, Word>
+    void write_row(Store const& row) {
+        gf2_assert_eq(row.size(), m_cols, "Row has {} elements but the bit-matrix has {} columns!", row.size(), m_cols);
+        gf2_assert(m_written < m_rows, "All {} rows have already been written!", m_rows);
+        details::write_store_words(m_os, row);
+        ++m_written;
+    }
+
+    /// Returns the number of rows in the bit-matrix being written.
+    constexpr usize rows() const { return m_rows; }
+
+    /// Returns the number of columns in the bit-matrix being written.
+    constexpr usize cols() const { return m_cols; }
+
+    /// Returns the number of rows written so far.
+    constexpr usize rows_written() const { return m_written; }
+
+    /// Returns `true` once all the rows have been written.
+    constexpr bool is_complete() const { return m_written == m_rows; }
+
+private:
+    std::ostream& m_os;
+    usize         m_rows;
+    usize         m_cols;
+    usize         m_written = 0;
+};
+
+/// A read-only, zero-copy view of a bit-matrix held in a `gf2` binary file.
+///
+/// The file is mapped into memory so opening it costs nothing beyond checking the header, whatever its size. Rows are
+/// `gf2::BitSpan` views straight into the mapped pages, which the operating system reads in as they are touched.
+/// The view keeps the mapping alive, so it must outlive any row spans taken from it.
+///
+/// The payload is used in place so the file must have been written with the word size `sizeof(Word)` and the byte
+/// order of this platform. Convert other files with `gf2::read_binary_matrix`.
+///
+/// # Panics
+/// The constructor throws a `std::runtime_error` if the file can't be mapped, doesn't hold a valid bit-matrix or
+/// bit-vector, is too short, or has a different word layout.
+///
+/// # Example
+/// ```
+/// auto path = std::filesystem::temp_directory_path() / "gf2_mapped_matrix_doc.bin";
+/// auto m = BitMatrix<>::random(50, 300);
+/// {
+///     std::ofstream file{path, std::ios::binary};
+///     write_binary(file, m);
+/// }
+/// MappedBitMatrix<> view{path};
+/// assert_eq(view.rows(), 50);
+/// assert_eq(view.cols(), 300);
+/// assert_eq(view.row(7), m.row(7));
+/// assert_eq(view.get(3, 200), m.get(3, 200));
+/// assert_eq(view.to_matrix(), m);
+/// std::filesystem::remove(path);
+/// ```
+template<Unsigned Word = usize>
+class MappedBitMatrix {
+public:
+    /// The read-only row type is a `BitSpan` of const words.
+    using row_type = BitSpan<const Word>;
+
+    /// The underlying unsigned word type used to store the bits.
+    using word_type = Word;
+
+    /// Maps the `gf2` binary file at `path` into memory.
+    explicit MappedBitMatrix(std::filesystem::path const& path) : m_file{path} {
+        if (m_file.size() < BINARY_HEADER_BYTES) throw std::runtime_error("File is too short for a gf2 binary file.");
+        m_header = details::BinaryHeader::decode(m_file.data());
+        if (!m_header.is_native<Word>())
+            throw std::runtime_error("The gf2 binary file has a different word layout -- use read_binary_matrix.");
+        if (m_file.size() - BINARY_HEADER_BYTES < m_header.payload_bytes())
+            throw std::runtime_error("Truncated payload in gf2 binary file.");
+        m_words = reinterpret_cast<Word const*>(m_file.data() + BINARY_HEADER_BYTES);
+    }
+
+    /// Returns the number of rows in the bit-matrix.
+    constexpr usize rows() const { return m_header.rows; }
+
+    /// Returns the number of columns in the bit-matrix.
+    constexpr usize cols() const { return m_header.cols; }
+
+    /// Returns `true` if the bit-matrix has no elements.
+    constexpr bool is_empty() const { return rows() == 0 || cols() == 0; }
+
+    /// Returns a read-only view of row `i` straight into the mapped file.
+    ///
+    /// # Panics
+    /// In debug mode, this method panics if `i` is out of bounds.
+    row_type row(usize i) const {
+        gf2_debug_assert(i < rows(), "Row index {} out of bounds [0,{})", i, rows());
+        return row_type{m_words + i * m_header.stride, 0, cols()};
+    }
+
+    /// Returns the element at row `i` and column `j`.
+    ///
+    /// # Panics
+    /// In debug mode, this method panics if either index is out of bounds.
+    bool get(usize i, usize j) const {
+        gf2_debug_assert(j < cols(), "Column index {} out of bounds [0,{})", j, cols());
+        return row(i).get(j);
+    }
+
+    /// Returns an in-memory copy of the bit-matrix.
+    ///
+    /// Any bits the file has past the last column are dropped, so the copy is a valid bit-matrix even if the file was
+    /// not written by this library.
+    ///
+    /// # Example
+    /// ```
+    /// auto path = std::filesystem::temp_directory_path() / "gf2_mapped_matrix_tail_doc.bin";
+    /// {
+    ///     std::ofstream file{path, std::ios::binary};
+    ///     write_binary(file, BitMatrix<u8>::zeros(2, 3));
+    ///     file.seekp(BINARY_HEADER_BYTES);
+    ///     file.put(char(0xFF));
+    /// }
+    /// MappedBitMatrix<u8> view{path};
+    /// auto m = view.to_matrix();
+    /// assert_eq(m.to_compact_binary_string(), "111 000");
+    /// std::filesystem::remove(path);
+    /// ```
+    BitMatrix<Word> to_matrix() const {
+        auto result = BitMatrix<Word>::zeros(rows(), cols());
+        if (result.is_empty()) return result;
+        for (auto i = 0uz; i < rows(); ++i) {
+            auto dst = result.row(i).store();
+            std::copy_n(m_words + i * m_header.stride, m_header.stride, dst);
+            details::mask_row_tail(dst, cols());
+        }
+        return result;
+    }
+
+    /// Returns the header of the mapped file.
+    constexpr details::BinaryHeader const& header() const { return m_header; }
+
+private:
+    details::MappedFile   m_file;
+    details::BinaryHeader m_header;
+    Word const*           m_words = nullptr;
+};
+
+/// A read-only, zero-copy view of a bit-vector held in a `gf2` binary file.
+///
+/// This is the bit-vector counterpart of `gf2::MappedBitMatrix` and has the same requirements on the file. A bit-matrix
+/// file with a single row can be mapped as a bit-vector too.
+///
+/// # Panics
+/// The constructor throws a `std::runtime_error` if the file can't be mapped, doesn't hold a valid bit-vector, is too
+/// short, or has a different word layout.
+///
+/// # Example
+/// ```
+/// auto path = std::filesystem::temp_directory_path() / "gf2_mapped_vector_doc.bin";
+/// auto v = BitVector<u32>::random(1000);
+/// {
+///     std::ofstream file{path, std::ios::binary};
+///     write_binary(file, v);
+/// }
+/// MappedBitVector<u32> view{path};
+/// assert_eq(view.size(), 1000);
+/// assert_eq(view.span(), v);
+/// assert_eq(view.span().count_ones(), v.count_ones());
+/// assert_eq(view.to_vector(), v);
+/// std::filesystem::remove(path);
+/// ```
+template<Unsigned Word = usize>
+class MappedBitVector {
+public:
+    /// The underlying unsigned word type used to store the bits.
+    using word_type = Word;
+
+    /// Maps the `gf2` binary file at `path` into memory.
+    explicit MappedBitVector(std::filesystem::path const& path) : m_matrix{path} {
+        details::check_single_row(m_matrix.header());
+    }
+
+    /// Returns the number of elements in the bit-vector.
+    constexpr usize size() const { return m_matrix.cols(); }
+
+    /// Returns a read-only view of the bit-vector straight into the mapped file.
+    BitSpan<const Word> span() const { return m_matrix.row(0); }
+
+    /// Returns an in-memory copy of the bit-vector.
+    BitVector<Word> to_vector() const { return BitVector<Word>::from(span()); }
+
+private:
+    MappedBitMatrix<Word> m_matrix;
+};
+
+} // namespace gf2
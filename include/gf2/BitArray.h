@@ -689,7 +689,7 @@ public:
     /// v.copy(BitVector<u8>::alternating(10));
     /// assert_eq(v.to_string(), "1010101010");
     /// ```
-    template<BitStore Src>
+    template<BitExpression Src>
     constexpr auto copy(Src const& src) {
         gf2::copy(src, *this);
         return *this;
@@ -1004,6 +1004,45 @@ public:
     /// ```
     constexpr auto unset_bits() const { return gf2::unset_bits(*this); }
 
+    /// Calls `f(i)` for the index `i` of each set bit in the bit-array in increasing order.
+    ///
+    /// This is faster than the `set_bits()` iterator as it reads each word once and peels off its set bits.
+    ///
+    /// # Example
+    /// ```
+    /// auto v = BitArray<10, u8>::alternating();
+    /// std::vector<usize> indices;
+    /// v.for_each_set_bit([&](usize i) { indices.push_back(i); });
+    /// assert_eq(indices, (std::vector<usize>{0, 2, 4, 6, 8}));
+    /// ```
+    template<typename F>
+        requires std::invocable<F&, usize>
+    constexpr void for_each_set_bit(F&& f) const {
+        gf2::for_each_set_bit(*this, std::forward<F>(f));
+    }
+
+    /// Writes the indices of the set bits in the bit-array to `out` in increasing order and returns how many it wrote.
+    ///
+    /// At most `out.size()` indices are written.
+    ///
+    /// # Example
+    /// ```
+    /// auto v = BitArray<10, u8>::alternating();
+    /// std::array<usize, 8> out{};
+    /// assert_eq(v.to_indices(out), 5);
+    /// assert_eq(out[4], 8);
+    /// ```
+    constexpr usize to_indices(std::span<usize> out) const { return gf2::to_indices(*this, out); }
+
+    /// Returns the indices of the set bits in the bit-array as a new `std::vector` in increasing order.
+    ///
+    /// # Example
+    /// ```
+    /// auto v = BitArray<10, u8>::alternating();
+    /// assert_eq(v.to_indices(), (std::vector<usize>{0, 2, 4, 6, 8}));
+    /// ```
+    constexpr std::vector<usize> to_indices() const { return gf2::to_indices(*this); }
+
     /// Returns a const iterator over all the *words* underlying the v.
     ///
     /// You can use this iterator to iterate over the words in the bit-array and read the `Word` value of each word.
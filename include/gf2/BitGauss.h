@@ -8,6 +8,8 @@
 
 #include <gf2/BitMatrix.h>
 
+#include <atomic>
+
 namespace gf2 {
 
 /// The `BitGauss` class is a Gaussian elimination solver for systems of linear equations over GF(2). <br>
@@ -26,6 +28,11 @@ namespace gf2 {
 ///
 /// For underdetermined systems, the "indexing" is something convenient and consistent across runs but not unique.
 ///
+/// The elimination is done once, on construction, and the solver keeps the row operations as a matrix `T` with
+/// $T \cdot A$ in reduced row echelon form. A new right-hand side is then just a product with `T`, so the same solver
+/// can be pointed at many `b` vectors with `set_rhs`, asked for particular solutions with `x_for`, or handed a whole
+/// bit-matrix of right-hand sides at once.
+///
 /// # Note
 /// The `BitLU` class provides another, often more efficient, way to solve systems of linear equations over GF(2).
 /// It also provides the `BitLU::inverse` method for computing the inverse of a matrix.
@@ -45,12 +52,54 @@ template<Unsigned Word>
 class BitGauss {
 private:
     BitMatrix<Word>    m_A;         // The reduced row echelon form of the matrix `A`.
-    BitVector<Word>    m_b;         // The equivalent reduced row echelon form of the vector `b`.
+    BitMatrix<Word>    m_T;         // The row operations that reduced `A`, so `m_T * A == m_A`.
+    BitVector<Word>    m_b;         // The equivalent reduced row echelon form of the vector `b`, i.e. `m_T * b`.
     usize              m_rank;      // The rank of the matrix `A`.
     usize              m_solutions; // The number of solutions to the system.
     std::vector<usize> m_free;      // The indices of the free variables in the system.
+    std::vector<usize> m_pivots;    // Row `r` of the reduced matrix has its leading one in column `m_pivots[r]`.
 
 public:
+    /// Constructs a new `BitGauss` object for the matrix `A` ready to solve `A.x = b` for any number of `b` vectors.
+    ///
+    /// The right-hand side starts out as the zero vector so the system is the (always consistent) homogeneous one until
+    /// you call `set_rhs`. The `x_for` methods don't use the stored right-hand side at all.
+    ///
+    /// # Panics
+    /// Constructor panics if the `A` matrix is not square.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::ones(3, 3);
+    /// BitGauss solver{A};
+    /// assert_eq(solver.rank(), 1);
+    /// assert_eq(solver.solution_count(), 4);
+    /// assert_eq(solver.x_for(BitVector<>::ones(3)).value().to_string(), "100");
+    /// assert_eq(solver.x_for(BitVector<>::from_string("110").value()).has_value(), false);
+    /// ```
+    explicit BitGauss(BitMatrix<Word> const& A) {
+        gf2_assert(A.is_square(), "Matrix is {} x {} but it should be square!", A.rows(), A.cols());
+        auto n = A.rows();
+
+        // Augment A with the identity on the right so the reduction records the row operations it performs.
+        auto augmented = A;
+        augmented.append_cols(BitMatrix<Word>::identity(n));
+        auto has_pivot = augmented.to_reduced_echelon_form();
+        m_A = augmented.sub_matrix(0, n, 0, n);
+        m_T = augmented.sub_matrix(0, n, n, 2 * n);
+
+        // Pivots past column n land in the identity half and just tidy up T -- they don't count towards the rank.
+        for (auto j = 0uz; j < n; ++j) {
+            if (has_pivot[j])
+                m_pivots.push_back(j);
+            else
+                m_free.push_back(j);
+        }
+        m_rank = m_pivots.size();
+        m_b = BitVector<Word>::zeros(n);
+        count_solutions();
+    }
+
     /// Constructs a new `BitGauss` object where we are solving the system of linear equations `A.x = b`.
     ///
     /// # Panics
@@ -68,53 +117,36 @@ public:
     /// assert_eq(solver.solution_count(), 4);
     /// ```
     template<BitStore Rhs>
-    BitGauss(BitMatrix<Word> const& A, Rhs const& b)
         requires std::same_as<typename Rhs::word_type, Word>
-    {
-        gf2_assert(A.is_square(), "Matrix is {} x {} but it should be square!", A.rows(), A.cols());
-        gf2_assert(A.rows() == b.size(), "Matrix has {} rows but the RHS vector has {} elements.", A.rows(), b.size());
-
-        // Copy A & augment it with b on the right.
-        m_A = A;
-        m_A.append_col(b);
-
-        // Reduce the augmented matrix to reduced row echelon form.
-        auto has_pivot = m_A.to_reduced_echelon_form();
-
-        // Grab the last column of the reduced augmented matrix as a standalone vector, removing it from the matrix.
-        m_b = m_A.remove_col().value();
-
-        // Also pop the last element of the `has_pivot` bit-vector as it corresponds to the column that we just removed.
-        has_pivot.pop();
-
-        // The rank is the number of columns with a pivot (it is also the number if non-zero rows in the reduced
-        // matrix).
-        m_rank = has_pivot.count_ones();
-
-        // Any columns without a pivot are free variables.
-        for (auto i = 0uz; i < has_pivot.size(); ++i) {
-            if (!has_pivot[i]) m_free.push_back(i);
-        }
-
-        // Check that all zero rows in the reduced matrix are matched by zero elements in the equivalent reduced right
-        // hand side vector (this is consistency). Zero rows are at the bottom from `rank` to the end.
-        auto consistent = true;
-        for (auto i = m_rank; i < m_A.rows(); ++i) {
-            if (m_b[i]) {
-                consistent = false;
-                break;
-            }
-        }
+    BitGauss(BitMatrix<Word> const& A, Rhs const& b) : BitGauss(A) {
+        set_rhs(b);
+    }
 
-        // The number of solutions we can index into is either 0 or 2^f where f is the number of free variables.
-        // However, for practical reasons we limit the number of solutions to `min(2^f, 2^63)`.
-        m_solutions = 0;
-        if (consistent) {
-            auto f = m_free.size();
-            auto b_max = static_cast<usize>(BITS<Word> - 1);
-            auto f_max = std::min(f, b_max);
-            m_solutions = 1uz << f_max;
-        }
+    /// Points the solver at a new right-hand side `b` without redoing the elimination.
+    ///
+    /// After this call `is_consistent`, `solution_count` and the `operator()` methods all refer to the system `A.x = b`.
+    /// The cost is one bit-matrix, bit-vector product.
+    ///
+    /// # Panics
+    /// Panics if `b` doesn't have one element for each row of `A`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::ones(3, 3);
+    /// BitGauss solver{A};
+    /// solver.set_rhs(BitVector<>::from_string("110").value());
+    /// assert_eq(solver.is_consistent(), false);
+    /// solver.set_rhs(BitVector<>::zeros(3));
+    /// assert_eq(solver.is_consistent(), true);
+    /// assert_eq(solver(3).value().to_string(), "011");
+    /// ```
+    template<BitStore Rhs>
+        requires std::same_as<typename Rhs::word_type, Word>
+    void set_rhs(Rhs const& b) {
+        gf2_assert(m_A.rows() == b.size(), "Matrix has {} rows but the RHS vector has {} elements.", m_A.rows(),
+                   b.size());
+        m_b = dot(m_T, b);
+        count_solutions();
     }
 
     /// Returns the rank of the matrix `A`.
@@ -227,7 +259,7 @@ public:
     /// ```
     std::optional<BitVector<Word>> operator()(usize i_solution) const {
         if (!is_consistent()) { return std::nullopt; }
-        if (i_solution > solution_count()) { return std::nullopt; }
+        if (i_solution >= solution_count()) { return std::nullopt; }
 
         // We start with a zero vector and then set the free variable slots to the fixed bit pattern for `i`.
         auto x = BitVector<Word>::zeros(m_b.size());
@@ -241,15 +273,239 @@ public:
         return x;
     }
 
+    /// Returns the solution of `A.x = b` with all the free variables set to zero or `std::nullopt` if there is none.
+    ///
+    /// This ignores the stored right-hand side, so one solver can be used for any number of `b` vectors. Each call is a
+    /// single bit-matrix, bit-vector product with the stored row operations followed by filling in the pivot variables.
+    ///
+    /// # Panics
+    /// Panics if `b` doesn't have one element for each row of `A`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::random(100, 100, 0.5, 42);
+    /// BitGauss solver{A};
+    /// for (auto seed = u64{1}; seed < 20; ++seed) {
+    ///     auto b = dot(A, BitVector<>::random(100, 0.5, seed));
+    ///     assert_eq(dot(A, solver.x_for(b).value()), b);
+    /// }
+    /// ```
+    template<BitStore Rhs>
+        requires std::same_as<typename Rhs::word_type, Word>
+    std::optional<BitVector<Word>> x_for(Rhs const& b) const {
+        gf2_assert(m_A.rows() == b.size(), "Matrix has {} rows but the RHS vector has {} elements.", m_A.rows(),
+                   b.size());
+        auto c = dot(m_T, b);
+        if (c.span(m_rank, c.size()).any()) return std::nullopt;
+
+        auto x = BitVector<Word>::zeros(c.size());
+        for (auto r = 0uz; r < m_rank; ++r)
+            if (c[r]) x.set(m_pivots[r]);
+        return x;
+    }
+
+    /// Returns a bit-matrix `X` with `A.X = B` or `std::nullopt` if any column of `B` is not in the column space of `A`.
+    ///
+    /// Each column of `B` is a separate right-hand side and column `j` of `X` is what `x_for` would return for it. All
+    /// the right-hand sides are solved in a single bit-matrix product with the stored row operations.
+    ///
+    /// # Panics
+    /// Panics if `B` doesn't have one row for each row of `A`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::random(100, 100, 0.5, 42);
+    /// auto X0 = BitMatrix<>::random(100, 300, 0.5, 7);
+    /// auto B = dot(A, X0);
+    /// BitGauss solver{A};
+    /// auto X = solver.x_for(B).value();
+    /// assert_eq(dot(A, X), B);
+    /// for (auto j = 0uz; j < B.cols(); j += 37) assert_eq(X.col(j), solver.x_for(B.col(j)).value());
+    /// auto I = BitMatrix<>::identity(3);
+    /// assert_eq(BitGauss{BitMatrix<>::ones(3, 3)}.x_for(I).has_value(), false);
+    /// ```
+    std::optional<BitMatrix<Word>> x_for(BitMatrix<Word> const& B) const {
+        gf2_assert(m_A.rows() == B.rows(), "Matrix has {} rows but the RHS matrix has {} rows.", m_A.rows(), B.rows());
+        auto C = dot(m_T, B);
+        for (auto r = m_rank; r < C.rows(); ++r)
+            if (C.row(r).any()) return std::nullopt;
+
+        auto X = BitMatrix<Word>::zeros(C.rows(), C.cols());
+        for (auto r = 0uz; r < m_rank; ++r) {
+            auto dst = X.row(m_pivots[r]);
+            copy(C.row(r), dst);
+        }
+        return X;
+    }
+
+    /// Returns a bit-matrix whose rows are a basis for the null space of `A`, i.e. all the solutions of `A.x = 0`.
+    ///
+    /// Row `k` goes with the `k`th free variable: it has a one in that free slot, zeros in the other free slots, and
+    /// the pivot variables that the free one forces. For a consistent system, `solver(i)` is `solver(0)` plus the sum
+    /// of the rows picked out by the set bits of `i`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::random(40, 40, 0.5, 11);
+    /// A.row(7).set_all(false);
+    /// A.row(19) = A.row(3);
+    /// BitGauss solver{A};
+    /// auto N = solver.null_space();
+    /// assert_eq(N.rows(), solver.free_count());
+    /// assert_eq(N.cols(), 40);
+    /// for (auto k = 0uz; k < N.rows(); ++k) assert_eq(dot(A, N.row(k)).none(), true);
+    /// assert_eq(N.rank(), N.rows());
+    /// ```
+    BitMatrix<Word> null_space() const {
+        auto result = BitMatrix<Word>::zeros(m_free.size(), m_A.cols());
+        for (auto k = 0uz; k < m_free.size(); ++k) {
+            auto f = m_free[k];
+            result.set(k, f);
+            for (auto r = 0uz; r < m_rank; ++r)
+                if (m_A(r, f)) result.set(k, m_pivots[r]);
+        }
+        return result;
+    }
+
+    /// Calls `f` on each of the `solution_count()` solutions of `A.x = b` in Gray-code order and returns the number
+    /// of calls made.
+    ///
+    /// The solutions are walked in the order `solver(g(0)), solver(g(1)), ...` where `g(t) = t ^ (t >> 1)` is the
+    /// Gray code. Consecutive Gray codes differ in a single bit, so each step is one XOR of a `null_space()` row into
+    /// the current solution instead of a full back substitution.
+    ///
+    /// The visitor is called as `f(x)` or, if it takes two arguments, as `f(i, x)` where `x == solver(i).value()`.
+    /// The solution is only valid for the duration of the call. If `f` returns a `bool` then returning `false` stops
+    /// the enumeration early. An inconsistent system has no solutions and `f` is never called.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::ones(3, 3);
+    /// auto solver = A.solver_for(BitVector<>::ones(3));
+    /// std::vector<std::string> xs;
+    /// auto n = solver.for_each_solution([&](usize i, BitVector<> const& x) {
+    ///     assert_eq(x, solver(i).value());
+    ///     xs.push_back(x.to_string());
+    /// });
+    /// assert_eq(n, 4);
+    /// assert_eq(xs, (std::vector<std::string>{"100", "010", "111", "001"}));
+    /// auto m = solver.for_each_solution([&](BitVector<> const& x) { return x.to_string() != "111"; });
+    /// assert_eq(m, 3);
+    /// ```
+    template<typename F>
+        requires std::invocable<F&, BitVector<Word> const&> || std::invocable<F&, usize, BitVector<Word> const&>
+    usize for_each_solution(F&& f) const {
+        if (!is_consistent()) return 0;
+        auto N = null_space();
+        return visit_solutions(N, 0, m_solutions, f, nullptr);
+    }
+
+    /// Calls `f` on each of the `solution_count()` solutions of `A.x = b` using an executor and returns the number of
+    /// calls made.
+    ///
+    /// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The range of solution indices is split into
+    /// contiguous blocks of Gray-code steps and each block is walked on its own thread, so `f` will be called from
+    /// several threads at once and in no particular order. Use the two-argument form `f(i, x)` to tell which solution
+    /// is which.
+    ///
+    /// If `f` returns `false` the other threads stop at their next step, so a few more calls may be made after the one
+    /// that asked to stop.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::random(64, 64, 0.5, 5);
+    /// for (auto r = 0uz; r < 16; ++r) A.row(r).set_all(false);
+    /// auto b = dot(A, BitVector<>::random(64, 0.5, 9));
+    /// BitGauss solver{A, b};
+    /// auto count = solver.solution_count();
+    /// std::vector<std::atomic<bool>> seen(count);
+    /// ThreadPool pool{4};
+    /// auto n = solver.for_each_solution(pool, [&](usize i, BitVector<> const& x) {
+    ///     if (dot(A, x) == b) seen[i] = true;
+    /// });
+    /// assert_eq(n, count);
+    /// assert_eq(std::ranges::all_of(seen, [](auto const& s) { return s.load(); }), true);
+    /// ```
+    template<Executor Exec, typename F>
+        requires std::invocable<F&, BitVector<Word> const&> || std::invocable<F&, usize, BitVector<Word> const&>
+    usize for_each_solution(Exec&& exec, F&& f) const {
+        if (!is_consistent()) return 0;
+        auto N = null_space();
+        auto grain = std::max(m_solutions / (4 * details::concurrency(exec)), usize{1});
+        std::atomic<bool>  stop{false};
+        std::atomic<usize> calls{0};
+        details::for_each_chunk(exec, m_solutions, grain, [&](usize begin, usize end) {
+            calls.fetch_add(visit_solutions(N, begin, end, f, &stop), std::memory_order_relaxed);
+        });
+        return calls.load();
+    }
+
 private:
+    // Sets the number of solutions to the system of equations with the current reduced right-hand side.
+    void count_solutions() {
+        // The system is consistent if the zero rows at the bottom of the reduced matrix are matched by zeros in the
+        // reduced right hand side vector.
+        auto consistent = m_b.span(m_rank, m_b.size()).none();
+
+        // The number of solutions we can index into is either 0 or 2^f where f is the number of free variables.
+        // However, for practical reasons we limit the number of solutions to `min(2^f, 2^63)`.
+        m_solutions = 0;
+        if (consistent) {
+            auto f = m_free.size();
+            auto b_max = static_cast<usize>(BITS<Word> - 1);
+            auto f_max = std::min(f, b_max);
+            m_solutions = 1uz << f_max;
+        }
+    }
+
     // Helper function that performs back substitution to solve for the non-free variables in `x`.
+    //
+    // In reduced row echelon form, row `r` has one in its pivot column and no ones in any other pivot column. So once
+    // the pivot slots of `x` are cleared, each pivot variable is a single word-level dot product with the free ones.
     void back_substitute_into(BitVector<Word>& x) const {
-        // Iterate from the bottom up, starting at the first non-zero row, solving for the non-free variables in `x`.
-        for (auto i = m_rank; i--;) {
-            auto j = m_A[i].first_set().value();
-            x.set(j, m_b[i]);
-            for (auto k = j + 1; k < x.size(); ++k)
-                if (m_A(i, k)) { x.set(j, x[j] ^ x[k]); }
+        for (auto j : m_pivots) x.set(j, false);
+        for (auto r = 0uz; r < m_rank; ++r) x.set(m_pivots[r], m_b[r] ^ dot(m_A.row(r), x));
+    }
+
+    // Walks the solutions with the Gray-code steps `t` in `[begin, end)` and returns the number of calls made to `f`.
+    //
+    // The block starts from the solution for the Gray code of `begin`, built from the particular solution and the rows
+    // of the null-space basis `N`. Going from step `t - 1` to step `t` flips the free variable at the lowest set bit of
+    // `t`. If `stop` is set, it is checked before each step and raised when `f` asks to stop.
+    template<typename F>
+    usize visit_solutions(BitMatrix<Word> const& N, usize begin, usize end, F& f, std::atomic<bool>* stop) const {
+        auto x = BitVector<Word>::zeros(m_b.size());
+        for (auto r = 0uz; r < m_rank; ++r)
+            if (m_b[r]) x.set(m_pivots[r]);
+        auto g = begin ^ (begin >> 1);
+        for (auto k = 0uz; g != 0; ++k, g >>= 1)
+            if (g & 1) x ^= N.row(k);
+
+        for (auto t = begin; t < end; ++t) {
+            if (stop && stop->load(std::memory_order_relaxed)) return t - begin;
+            if (t != begin) x ^= N.row(static_cast<usize>(std::countr_zero(t)));
+            if (!call_visitor(f, t ^ (t >> 1), x)) {
+                if (stop) stop->store(true, std::memory_order_relaxed);
+                return t - begin + 1;
+            }
+        }
+        return end - begin;
+    }
+
+    // Calls the visitor as `f(i, x)` or `f(x)` and returns `false` if it asked to stop.
+    template<typename F>
+    static bool call_visitor(F& f, usize i, BitVector<Word> const& x) {
+        auto call = [&] {
+            if constexpr (std::invocable<F&, usize, BitVector<Word> const&>)
+                return f(i, x);
+            else
+                return f(x);
+        };
+        if constexpr (std::is_void_v<decltype(call())>) {
+            call();
+            return true;
+        } else {
+            return static_cast<bool>(call());
         }
     }
 };
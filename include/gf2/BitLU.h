@@ -7,6 +7,7 @@
 /// See the [BitLU](docs/pages/BitLU.md) page for more details.
 
 #include <gf2/BitMatrix.h>
+#include <gf2/instrument.h>
 
 namespace gf2 {
 
@@ -42,9 +43,11 @@ public:
     ///
     /// The construction works even if `A` is singular, though the solver methods will not.
     ///
-    /// If `A` is `n x n`, then the construction takes O(n^3) operations. There are block iterative methods that can
-    /// reduce that to a sub-cubic count but they are not implemented here. Of course, the method works on whole words
-    /// or bit elements at a time so is very efficient even without those enhancements.
+    /// If `A` is `n x n`, then the construction takes O(n^3) bit operations but works on whole words at a time. The
+    /// columns are factored in narrow panels (eight columns at a time). Within a panel, the eliminations only touch
+    /// the one word that holds the panel. The combined effect of those eliminations on the columns to the right is
+    /// then applied using a Gray-code table of the panel rows, so each row below the panel needs just one table lookup
+    /// and one row XOR instead of up to eight.
     ///
     /// # Panics
     /// Constructor panics if the `A` matrix is not square. There are generalisations of the LU decomposition for
@@ -59,43 +62,50 @@ public:
     /// lu.permute(PA);
     /// assert_eq(PA, LU);
     /// ```
-    BitLU(BitMatrix<Word> const& A) : m_lu(A), m_swaps(A.rows(), 0uz), m_rank(A.rows()) {
-        // Only handle square matrices
-        gf2_assert(A.is_square(), "Matrix is {} x {} but it should be square!", A.rows(), A.cols());
-
-        // Iterate through the bit-matrix.
-        auto nr = m_lu.rows();
-        auto nc = m_lu.cols();
-        for (auto j = 0uz; j < nr; ++j) {
-
-            // Initialize this element of the row swap instruction vector.
-            m_swaps[j] = j;
-
-            // Find a non-zero element on or below the diagonal in column -- a pivot.
-            auto p = j;
-            while (p < nr && !m_lu.get(p, j)) ++p;
+    ///
+    /// # Example (checks `LU = PA` for singular matrices and matrices that are not a whole number of panels)
+    /// ```
+    /// for (auto n : {1uz, 7uz, 9uz, 63uz, 65uz, 200uz}) {
+    ///     auto A = BitMatrix<u64>::random(n, n);
+    ///     A.row(n / 2).set_all(false);
+    ///     auto lu = A.LU();
+    ///     assert(lu.is_singular());
+    ///     auto PA = A;
+    ///     lu.permute(PA);
+    ///     assert_eq(PA, lu.L() * lu.U());
+    /// }
+    /// ```
+    BitLU(BitMatrix<Word> const& A) : BitLU(seq, A) {}
 
-            // Perhaps no such element exists in this column? If so the matrix is singular!
-            if (p >= nr) {
-                m_rank--;
-                continue;
-            }
+    /// Constructs the LU decomposition object for a square matrix `A` using the given executor.
+    ///
+    /// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The updates of the rows below each panel are
+    /// spread over its threads in blocks of rows. Otherwise this is the same as `BitLU(A)`.
+    ///
+    /// # Panics
+    /// Constructor panics if the `A` matrix is not square.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<u16>::random(300, 300);
+    /// ThreadPool pool{4};
+    /// auto lu = BitLU{pool, A};
+    /// assert_eq(lu.LU(), A.LU().LU());
+    /// assert_eq(lu.swaps(), A.LU().swaps());
+    /// ```
+    template<Executor Exec>
+    BitLU(Exec&& exec, BitMatrix<Word> const& A) : m_lu(A), m_swaps(A.rows(), 0uz), m_rank(A.rows()) {
+        gf2_probe("BitLU::BitLU");
 
-            // If necessary, swap the pivot row  into place & record the rows swap instruction
-            if (p != j) {
-                m_lu.swap_rows(j, p);
-                m_swaps[j] = p;
-            }
+        // Only handle square matrices
+        gf2_assert(A.is_square(), "Matrix is {} x {} but it should be square!", A.rows(), A.cols());
 
-            // At this point m_lu(j,j) == 1
-            for (auto i = j + 1; i < nr; ++i) {
-                if (m_lu.get(i, j)) {
-                    for (auto k = j + 1; k < nc; ++k) {
-                        auto tmp = m_lu.get(i, k) ^ m_lu.get(j, k);
-                        m_lu.set(i, k, tmp);
-                    }
-                }
-            }
+        // Work through the columns a panel of `PANEL` at a time (the panels never straddle a word boundary).
+        auto n = m_lu.rows();
+        for (auto j0 = 0uz; j0 < n; j0 += PANEL) {
+            auto j1 = std::min(j0 + PANEL, n);
+            factor_panel(j0, j1);
+            update_trailing(exec, j0, j1);
         }
     }
 
@@ -297,5 +307,113 @@ public:
         // We just solve the system A.A_inv = I for A_inv
         return operator()(BitMatrix<Word>::identity(m_lu.rows()));
     }
+
+private:
+    // Device matrices factor on the device and hand over the packed LU matrix, the row swaps and the rank.
+    friend class DeviceMatrix<Word>;
+    BitLU(BitMatrix<Word> lu, std::vector<usize> swaps, usize rank) :
+        m_lu{std::move(lu)}, m_swaps{std::move(swaps)}, m_rank{rank} {}
+
+    // The number of columns we factor together before updating the trailing columns with a Gray-code table.
+    static constexpr usize PANEL = std::min<usize>(8, BITS<Word>);
+
+    // Returns a pointer to the first word of row `r` in the packed LU matrix.
+    constexpr Word* row_data(usize r) { return m_lu.row_data(r); }
+
+    // XOR's the bits in row `src` from column `begin` onwards into row `dst` a word at a time.
+    constexpr void add_suffix(usize src, usize dst, usize begin) {
+        auto [w0, b0] = index_and_offset<Word>(begin);
+        auto s = row_data(src);
+        auto d = row_data(dst);
+        d[w0] = static_cast<Word>(d[w0] ^ (s[w0] & with_set_bits<Word>(b0, BITS<Word>)));
+        for (auto w = w0 + 1; w < m_lu.stride(); ++w) d[w] ^= s[w];
+    }
+
+    // Factors the columns `[j0, j1)` where those columns all lie in the same word.
+    //
+    // The eliminations only update the bits in the panel, the other columns to the right are left for
+    // `update_trailing`. After this, the panel bits in any row below the pivot for column `j` are exactly the
+    // multipliers in `L` for that row.
+    constexpr void factor_panel(usize j0, usize j1) {
+        auto n = m_lu.rows();
+        auto w = word_index<Word>(j0);
+        for (auto j = j0; j < j1; ++j) {
+
+            // Initialize this element of the row swap instruction vector.
+            m_swaps[j] = j;
+
+            // Find a non-zero element on or below the diagonal in column -- a pivot.
+            auto p = j;
+            while (p < n && !m_lu.get(p, j)) ++p;
+
+            // Perhaps no such element exists in this column? If so the matrix is singular!
+            if (p >= n) {
+                m_rank--;
+                continue;
+            }
+
+            // If necessary, swap the pivot row into place & record the rows swap instruction.
+            if (p != j) {
+                m_lu.swap_rows(j, p);
+                m_swaps[j] = p;
+            }
+
+            // Eliminate below the pivot in the remaining columns of the panel -- a single masked word per row.
+            if (j + 1 == j1) continue;
+            auto mask = with_set_bits<Word>(bit_offset<Word>(j + 1), bit_offset<Word>(j1 - 1) + 1);
+            auto [jw, jm] = index_and_mask<Word>(j);
+            auto pivot = row_data(j)[w] & mask;
+            gf2_count_words(n - j - 1, 2 * (n - j - 1) * sizeof(Word));
+            for (auto i = j + 1; i < n; ++i) {
+                auto r = row_data(i);
+                if (r[jw] & jm) r[w] = static_cast<Word>(r[w] ^ pivot);
+            }
+        }
+    }
+
+    // Applies the eliminations from the panel `[j0, j1)` to all the columns from `j1` onwards.
+    template<Executor Exec>
+    void update_trailing(Exec&& exec, usize j0, usize j1) {
+        auto n = m_lu.rows();
+        if (j1 >= n) return;
+
+        // First bring the panel rows up to date working down through the panel -- row `r` picks up the final
+        // version of each earlier pivot row that it was eliminated by.
+        for (auto r = j0 + 1; r < j1; ++r) {
+            for (auto j = j0; j < r; ++j)
+                if (m_lu.get(r, j)) add_suffix(j, r, j1);
+        }
+
+        // Build a Gray-code table with all the combinations of those panel rows restricted to the columns from `j1`.
+        auto k = j1 - j0;
+        auto [tw, tb] = index_and_offset<Word>(j1);
+        auto len = m_lu.stride() - tw;
+        auto table = std::pmr::vector<Word>((1uz << k) * len, Word{0}, memory_resource());
+        for (auto g = 1uz; g < (1uz << k); ++g) {
+            auto code = g ^ (g >> 1);
+            auto prev = (g - 1) ^ ((g - 1) >> 1);
+            auto src = row_data(j0 + static_cast<usize>(std::countr_zero(g))) + tw;
+            auto dst = table.data() + code * len;
+            auto old = table.data() + prev * len;
+            gf2_count_words(len, 3 * len * sizeof(Word));
+            dst[0] = old[0] ^ (src[0] & with_set_bits<Word>(tb, BITS<Word>));
+            for (auto l = 1uz; l < len; ++l) dst[l] = old[l] ^ src[l];
+        }
+
+        // Every row below the panel then needs just one table lookup indexed by its multipliers in the panel.
+        auto [w, b] = index_and_offset<Word>(j0);
+        auto index_mask = (1uz << k) - 1;
+        auto grain = std::max(1uz, 4096 / len);
+        details::for_each_chunk(exec, n - j1, grain, [&](usize begin, usize end) {
+            for (auto i = j1 + begin; i < j1 + end; ++i) {
+                auto r = row_data(i);
+                auto code = static_cast<usize>(r[w] >> b) & index_mask;
+                if (code == 0) continue;
+                auto src = table.data() + code * len;
+                gf2_count_words(len, 3 * len * sizeof(Word));
+                for (auto l = 0uz; l < len; ++l) r[tw + l] ^= src[l];
+            }
+        });
+    }
 };
 } // namespace gf2
\ No newline at end of file
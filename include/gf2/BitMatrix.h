@@ -8,8 +8,13 @@
 
 #include <gf2/BitPolynomial.h>
 #include <gf2/BitVector.h>
+#include <gf2/MemoryScope.h>
 #include <gf2/RNG.h>
+#include <gf2/ThreadPool.h>
+#include <gf2/instrument.h>
 
+#include <array>
+#include <new>
 #include <string>
 #include <optional>
 #include <regex>
@@ -20,11 +25,76 @@ namespace gf2 {
 // clang-format off
 template<Unsigned Word> class BitGauss;
 template<Unsigned Word> class BitLU;
+template<Unsigned Word> class DeviceMatrix;
 // clang-format on
 
-/// A dynamically-sized matrix over GF(2) stored as a vector of bit-vectors representing the rows of the matrix. The row
-/// elements are compactly stored in standard vectors of primitive unsigned words whose type is given by the template
-/// parameter `Word`.
+namespace details {
+
+// A minimal allocator that hands out memory aligned to a cache line.
+// The words of a `BitMatrix` live in a buffer allocated this way so that each (padded) row starts on a cache line.
+// The memory comes from the `gf2::memory_resource()` that was current when the allocator was created. Just like
+// `std::pmr::polymorphic_allocator`, copies of a container start out on the resource that is current at the time, moves
+// carry the resource along, and assignments never change the resource of the container assigned to.
+template<typename T, usize Alignment = 64>
+struct CacheAlignedAllocator {
+    using value_type = T;
+
+    // Rebinding is needed by the standard containers.
+    template<typename U>
+    struct rebind {
+        using other = CacheAlignedAllocator<U, Alignment>;
+    };
+
+    CacheAlignedAllocator() noexcept : m_resource(gf2::memory_resource()) {}
+
+    template<typename U>
+    CacheAlignedAllocator(CacheAlignedAllocator<U, Alignment> const& other) noexcept : m_resource(other.resource()) {}
+
+    T* allocate(usize n) {
+        gf2_count_allocation(n * sizeof(T));
+        return static_cast<T*>(m_resource->allocate(n * sizeof(T), Alignment));
+    }
+
+    void deallocate(T* p, usize n) noexcept { m_resource->deallocate(p, n * sizeof(T), Alignment); }
+
+    CacheAlignedAllocator select_on_container_copy_construction() const { return CacheAlignedAllocator{}; }
+
+    std::pmr::memory_resource* resource() const noexcept { return m_resource; }
+
+    template<typename U>
+    bool operator==(CacheAlignedAllocator<U, Alignment> const& other) const noexcept {
+        return m_resource == other.resource() || m_resource->is_equal(*other.resource());
+    }
+
+private:
+    std::pmr::memory_resource* m_resource;
+};
+
+// The lazy bit-matrix expressions (see `gf2::BitMatrixBinaryExpr`) produce the words of a bit-matrix one at a time.
+// Word `k` is word `k` of the row-major buffer of the bit-matrix they evaluate to, padding words included.
+template<typename Expr>
+concept LazyBitMatrixExpression = requires(const Expr expr) {
+    typename Expr::word_type;
+    requires Unsigned<typename Expr::word_type>;
+    { expr.rows() } -> std::same_as<usize>;
+    { expr.cols() } -> std::same_as<usize>;
+    { expr.stride() } -> std::same_as<usize>;
+    { expr.word(usize{}) } -> std::same_as<typename Expr::word_type>;
+};
+
+} // namespace details
+
+// Forward declaration of the lazy expressions that a bit-matrix can take over the storage of.
+template<typename Op, typename Lhs, typename Rhs>
+class BitMatrixBinaryExpr;
+
+/// A dynamically-sized matrix over GF(2) stored in row-major order in a single contiguous buffer of primitive unsigned
+/// words whose type is given by the template parameter `Word`.
+///
+/// Each row occupies `stride()` words in that buffer where the stride is padded so that the rows of any bit-matrix with
+/// more than a handful of columns start on a cache line boundary. The padding bits are always zero.
+///
+/// The rows are accessed as `gf2::BitSpan` views into the buffer so all the usual `BitStore` functions work on them.
 ///
 /// # Note
 /// Bit-matrices are stored by row, so it is always more efficient to arrange computations to operate on rows instead of
@@ -32,12 +102,28 @@ template<Unsigned Word> class BitLU;
 template<Unsigned Word = usize>
 class BitMatrix {
 private:
-    /// We store each *row* in a bit-matrix as a bit-vector.
-    std::vector<BitVector<Word>> m_rows;
+    // The words of the bit-matrix in row-major order -- row `i` starts at word `i * m_stride`.
+    std::vector<Word, details::CacheAlignedAllocator<Word>> m_data;
+
+    // The dimensions of the bit-matrix.
+    usize m_rows = 0;
+    usize m_cols = 0;
+
+    // The number of words used to store each row (including any padding words).
+    usize m_stride = 0;
+
+    // The LU decomposition works directly on the words of its bit-matrix.
+    friend class BitLU<Word>;
+
+    // Device matrices use the same layout & transfer words straight into the buffer.
+    friend class DeviceMatrix<Word>;
 
 public:
-    // The row type is a `BitVector` ...
-    using row_type = BitVector<Word>;
+    /// The row type is a read-write `BitSpan` into the underlying store of words.
+    using row_type = BitSpan<Word>;
+
+    /// The read-only row type is a `BitSpan` of const words.
+    using const_row_type = BitSpan<const Word>;
 
     /// The underlying unsigned word type used to store the bits.
     using word_type = Word;
@@ -52,7 +138,7 @@ public:
     /// BitMatrix m;
     /// assert_eq(m.to_compact_binary_string(), "");
     /// ```
-    constexpr BitMatrix() : m_rows{} {}
+    constexpr BitMatrix() = default;
 
     /// Constructs the `n x n` square bit-matrix with all the elements set to 0.
     ///
@@ -63,7 +149,7 @@ public:
     /// BitMatrix m{3};
     /// assert_eq(m.to_compact_binary_string(), "000 000 000");
     /// ```
-    constexpr BitMatrix(usize n) : m_rows{} {
+    constexpr BitMatrix(usize n) {
         if (n > 0) resize(n, n);
     }
 
@@ -76,7 +162,7 @@ public:
     /// BitMatrix m{3, 4};
     /// assert_eq(m.to_compact_binary_string(), "0000 0000 0000");
     /// ```
-    constexpr BitMatrix(usize m, usize n) : m_rows{} {
+    constexpr BitMatrix(usize m, usize n) {
         if (m > 0 && n > 0) resize(m, n);
     }
 
@@ -91,14 +177,15 @@ public:
     /// BitMatrix m{rows};
     /// assert_eq(m.to_compact_binary_string(), "000 111");
     /// ```
-    constexpr BitMatrix(std::vector<row_type> const& rows) : m_rows{rows} {
-        gf2_assert(check_rows(m_rows), "Not all rows have the same size!");
+    constexpr BitMatrix(std::vector<BitVector<Word>> const& rows) {
+        gf2_assert(check_rows(rows), "Not all rows have the same size!");
+        copy_rows(rows);
     }
 
-    /// Construct a bit-matrix by *moving* the given rows.
+    /// Construct a bit-matrix from the given rows which are consumed in the process.
     ///
     /// Use `std::move(rows)` in the constructor argument to get this version.
-    /// The input rows are moved into the bit-matrix so they are no longer valid after this constructor.
+    /// The rows are copied into the contiguous store of the bit-matrix and the input is left empty.
     ///
     /// # Panics
     /// We check that all the rows have the same size unless `NDEBUG` is defined.
@@ -109,10 +196,48 @@ public:
     /// BitMatrix m{std::move(rows)};
     /// assert_eq(m.to_compact_binary_string(), "000 111");
     /// ```
-    constexpr BitMatrix(std::vector<BitVector<Word>>&& rows) : m_rows{std::move(rows)} {
-        gf2_assert(check_rows(m_rows), "Not all rows have the same size!");
+    constexpr BitMatrix(std::vector<BitVector<Word>>&& rows) {
+        gf2_assert(check_rows(rows), "Not all rows have the same size!");
+        copy_rows(rows);
+        rows.clear();
+    }
+
+    /// Constructs a bit-matrix by evaluating a lazy bit-matrix expression like `A ^ (B & C)` in a single pass.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::identity(3);
+    /// auto B = BitMatrix<>::ones(3, 3);
+    /// BitMatrix m = A ^ ~B ^ A;
+    /// assert_eq(m.to_compact_binary_string(), "000 000 000");
+    /// ```
+    template<typename Expr>
+        requires details::LazyBitMatrixExpression<Expr> && std::same_as<typename Expr::word_type, Word>
+    constexpr BitMatrix(Expr const& expr) {
+        resize(expr.rows(), expr.cols());
+        for (auto k = 0uz; k < m_data.size(); ++k) m_data[k] = expr.word(k);
     }
 
+    /// Constructs a bit-matrix from an expression with a temporary bit-matrix operand, reusing the temporary's storage.
+    ///
+    /// An expression like `dot(A, B) ^ C` owns the result of `dot(A, B)`, so the sum is evaluated into that buffer
+    /// instead of a new one.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<u8>::random(100, 100);
+    /// auto B = BitMatrix<u8>::identity(100);
+    /// BitMatrix<u8> C = A ^ B;
+    /// auto data = C.data();
+    /// BitMatrix<u8> m = std::move(C) ^ A;
+    /// assert(m.data() == data);
+    /// assert_eq(m, B);
+    /// ```
+    template<typename Op, typename Lhs, typename Rhs>
+        requires BitMatrixBinaryExpr<Op, Lhs, Rhs>::owns_matrix &&
+                 std::same_as<typename BitMatrixBinaryExpr<Op, Lhs, Rhs>::word_type, Word>
+    constexpr BitMatrix(BitMatrixBinaryExpr<Op, Lhs, Rhs>&& expr) : BitMatrix{std::move(expr).evaluate_in_place()} {}
+
     /// @}
     /// @name Factory Constructors
     /// @{
@@ -143,8 +268,9 @@ public:
     /// assert_eq(m.to_compact_binary_string(), "1111 1111 1111");
     /// ```
     static constexpr BitMatrix ones(usize m, usize n) {
-        auto rows = std::vector{m, BitVector<Word>::ones(n)};
-        return BitMatrix{std::move(rows)};
+        BitMatrix result{m, n};
+        result.set_all();
+        return result;
     }
 
     /// Factory method to create the `m x m` square bit-matrix with all the elements set to 1.
@@ -164,10 +290,15 @@ public:
     /// assert_eq(m.to_compact_binary_string(), "1010 0101 1010");
     /// ```
     static constexpr BitMatrix alternating(usize m, usize n) {
-        auto rows = std::vector{m, BitVector<Word>::alternating(n)};
-        // Flip every other row.
-        for (auto i = 1uz; i < m; i += 2) rows[i].flip_all();
-        return BitMatrix{std::move(rows)};
+        BitMatrix result{m, n};
+        auto      alt = BitVector<Word>::alternating(n);
+        for (auto i = 0uz; i < result.rows(); ++i) {
+            auto r = result.row(i);
+            r.copy(alt);
+            // Flip every other row.
+            if (i % 2 == 1) r.flip_all();
+        }
+        return result;
     }
 
     /// Factory method to create the `m x m` square bit-matrix with alternating elements.
@@ -191,11 +322,9 @@ public:
     template<BitStore Lhs, BitStore Rhs>
         requires std::same_as<typename Lhs::word_type, Word> && std::same_as<typename Rhs::word_type, Word>
     static constexpr BitMatrix from_outer_product(Lhs const& u, Rhs const& v) {
-        BitMatrix result;
-        for (auto i = 0uz; i < u.size(); ++i) {
-            row_type row = u.get(i) ? row_type(v) : row_type(v.size());
-            result.m_rows.push_back(std::move(row));
-        }
+        BitMatrix result{u.size(), v.size()};
+        for (auto i = 0uz; i < result.rows(); ++i)
+            if (u.get(i)) result.row(i).copy(v);
         return result;
     }
 
@@ -211,10 +340,11 @@ public:
     template<BitStore Lhs, BitStore Rhs>
         requires std::same_as<typename Lhs::word_type, Word> && std::same_as<typename Rhs::word_type, Word>
     static constexpr BitMatrix from_outer_sum(Lhs const& u, Rhs const& v) {
-        BitMatrix result;
-        for (auto i = 0uz; i < u.size(); ++i) {
-            result.m_rows.push_back(v);
-            if (u.get(i)) result.m_rows.back().flip_all();
+        BitMatrix result{u.size(), v.size()};
+        for (auto i = 0uz; i < result.rows(); ++i) {
+            auto r = result.row(i);
+            r.copy(v);
+            if (u.get(i)) r.flip_all();
         }
         return result;
     }
@@ -247,6 +377,9 @@ public:
     /// The default call `BitMatrix<>::random(m, n)` produces a random bit-matrix with each bit being 1 with probability
     /// 0.5 and where the RNG is seeded from entropy.
     ///
+    /// Each row is filled from its own stream of random words, so this gives the very same matrix as the parallel
+    /// version `BitMatrix::random(gf2::par, m, n, p, seed)`.
+    ///
     /// @param m The number of rows in the bit-matrix to generate.
     /// @param n The number of columns in the bit-matrix to generate.
     /// @param p The probability of the elements being 1 (defaults to a fair coin, i.e. 50-50).
@@ -262,34 +395,70 @@ public:
     /// assert(u == v);
     /// ```
     static BitMatrix random(usize m, usize n, double p = 0.5, std::uint64_t seed = 0) {
-        // Keep a single static RNG per thread for all calls to this method, seeded with entropy on the first call.
-        thread_local RNG rng;
+        return random(seq, m, n, p, seed);
+    }
 
-        // Edge case handling ...
-        if (p < 0) return BitMatrix::zeros(m, n);
+    /// Factory method to generate a bit-matrix of size `m x n` where the rows are filled in parallel.
+    ///
+    /// Row `i` is filled by a fast `gf2::Xoshiro256pp` engine whose seed is the first word of the counter-based
+    /// `gf2::Philox4x32{seed, i}` stream. The rows therefore don't depend on each other, so for a given non-zero seed
+    /// the result is the same whatever the executor and however many threads it uses.
+    /// If you set the seed to 0 then a seed is drawn from a per-thread RNG seeded with entropy.
+    ///
+    /// # Example
+    /// ```
+    /// ThreadPool pool{3};
+    /// auto u = BitMatrix<>::random(gf2::par, 300, 200, 0.5, 42);
+    /// auto v = BitMatrix<>::random(pool, 300, 200, 0.5, 42);
+    /// auto w = BitMatrix<>::random(300, 200, 0.5, 42);
+    /// assert(u == v);
+    /// assert(u == w);
+    /// ```
+    template<Executor Exec>
+    static BitMatrix random(Exec&& exec, usize m, usize n, double p = 0.5, std::uint64_t seed = 0) {
+        auto scaled_p = details::scaled_probability(p);
+        if (!scaled_p) return BitMatrix::ones(m, n);
 
-        // Scale p by 2^64 to remove floating point arithmetic from the main loop below.
-        // If we determine p rounds to 1 then we can just set all elements to 1 and return early.
-        p = p * 0x1p64 + 0.5;
-        if (p >= 0x1p64) return BitMatrix::ones(m, n);
+        // No seed? Draw one from a per-thread RNG that is seeded with entropy on first use.
+        thread_local RNG rng;
+        if (seed == 0) seed = rng();
 
-        // p does not round to 1 so we use a 64-bit URNG and check each draw against the 64-bit scaled p.
-        auto scaled_p = static_cast<std::uint64_t>(p);
+        auto result = BitMatrix::zeros(m, n);
+        details::for_each_chunk(exec, m, result.row_grain(), [&](usize begin, usize end) {
+            for (auto i = begin; i < end; ++i) {
+                Xoshiro256pp stream{Philox4x32{seed, i}()};
+                auto         row = result.row(i);
+                details::fill_random_words(row, stream, *scaled_p);
+            }
+        });
+        return result;
+    }
 
-        // If a seed was provided, set the RNG's seed to it. Otherwise, we carry on from where we left off.
-        std::uint64_t old_seed = rng.seed();
-        if (seed != 0) rng.set_seed(seed);
+    /// Factory method to generate a bit-matrix of size `m x n` with bits drawn row by row from the passed engine.
+    ///
+    /// The engine can be any type that satisfies the `gf2::RandomEngine` concept.
+    /// Each bit is 1 with probability `p` and if `p < 0` the bit-matrix is all zeros, if `p > 1` it is all ones.
+    ///
+    /// # Example
+    /// ```
+    /// Xoshiro256pp a{42}, b{42};
+    /// auto u = BitMatrix<>::random(30, 20, a);
+    /// auto v = BitMatrix<>::random(30, 20, b);
+    /// assert(u == v);
+    /// std::mt19937_64 mt{42};
+    /// auto w = BitMatrix<u8>::random(30, 20, mt, 0.25);
+    /// assert(w.count_ones() < 300);
+    /// ```
+    template<RandomEngine Engine>
+    static BitMatrix random(usize m, usize n, Engine& rng, double p = 0.5) {
+        auto scaled_p = details::scaled_probability(p);
+        if (!scaled_p) return BitMatrix::ones(m, n);
 
         auto result = BitMatrix::zeros(m, n);
         for (auto i = 0uz; i < m; ++i) {
-            for (auto j = 0uz; j < n; ++j) {
-                if (rng.u64() < scaled_p) result.set(i, j, true);
-            }
+            auto row = result.row(i);
+            details::fill_random_words(row, rng, *scaled_p);
         }
-
-        // Restore the old seed if necessary.
-        if (seed != 0) rng.set_seed(old_seed);
-
         return result;
     }
 
@@ -403,7 +572,7 @@ public:
         // Edge case:
         if (top_row.size() == 0) return BitMatrix{};
         auto result = BitMatrix::zero(top_row.size());
-        result.m_rows[0].copy(top_row);
+        result.row(0).copy(top_row);
         result.set_sub_diagonal(1);
         return result;
     }
@@ -511,7 +680,7 @@ public:
         for (auto i = 0uz; i < r; ++i) {
             auto begin = i * c;
             auto end = begin + c;
-            result.m_rows[i].copy(v.span(begin, end));
+            result.row(i).copy(v.span(begin, end));
         }
         return result;
     }
@@ -548,7 +717,7 @@ public:
         usize     iv = 0;
         for (auto j = 0uz; j < c; ++j) {
             for (auto i = 0uz; i < r; ++i) {
-                if (v.get(iv)) result.m_rows[i].set(j);
+                if (v.get(iv)) result.set(i, j);
                 iv++;
             }
         }
@@ -602,7 +771,7 @@ public:
         usize n_cols = 0;
         for (auto i = 0uz; i < n_rows; ++i) {
             // Attempt to parse the current token as a row for the bit-matrix.
-            auto r = row_type::from_string(tokens[i]);
+            auto r = BitVector<Word>::from_string(tokens[i]);
 
             // Parse failure?
             if (!r) return std::nullopt;
@@ -616,7 +785,7 @@ public:
                 // Subsequent rows better have the same number of elements!
                 if (r->size() != n_cols) return std::nullopt;
             }
-            result.m_rows[i] = *r;
+            result.row(i).copy(*r);
         }
         return result;
     }
@@ -626,10 +795,10 @@ public:
     /// @{
 
     /// Returns the number of rows in the bit-matrix.
-    constexpr usize rows() const { return m_rows.size(); }
+    constexpr usize rows() const { return m_rows; }
 
     /// Returns the number of columns in the bit-matrix.
-    constexpr usize cols() const { return m_rows.size() > 0 ? m_rows[0].size() : 0; }
+    constexpr usize cols() const { return m_cols; }
 
     /// Returns the totalnumber of elements in the bit-matrix.
     constexpr usize size() const { return rows() * cols(); }
@@ -677,11 +846,8 @@ public:
     /// ```
     constexpr bool is_identity() const {
         if (!is_square()) return false;
-        for (auto i = 0uz; i < rows(); ++i) {
-            row_type r = m_rows[i];
-            r.flip(i);
-            if (r.any()) return false;
-        }
+        for (auto i = 0uz; i < rows(); ++i)
+            if (!get(i, i) || row(i).count_ones() != 1) return false;
         return true;
     }
 
@@ -718,8 +884,9 @@ public:
     /// assert_eq(m.count_ones(), 9);
     /// ```
     constexpr usize count_ones() const {
+        // The padding bits are always zero so we can just count the set bits in all the stored words.
         usize count = 0;
-        for (const auto& row : m_rows) count += row.count_ones();
+        for (auto word : m_data) count += gf2::count_ones(word);
         return count;
     }
 
@@ -784,8 +951,8 @@ public:
     /// assert_eq(m.any(), false);
     /// ```
     constexpr bool any() const {
-        for (const auto& row : m_rows)
-            if (row.any()) return true;
+        for (auto word : m_data)
+            if (word != 0) return true;
         return false;
     }
 
@@ -803,8 +970,8 @@ public:
     /// assert_eq(m.all(), true);
     /// ```
     constexpr bool all() const {
-        for (const auto& row : m_rows)
-            if (!row.all()) return false;
+        for (auto i = 0uz; i < rows(); ++i)
+            if (!row(i).all()) return false;
         return true;
     }
 
@@ -821,11 +988,7 @@ public:
     /// m.clear();
     /// assert_eq(m.none(), true);
     /// ```
-    constexpr bool none() const {
-        for (const auto& row : m_rows)
-            if (!row.none()) return false;
-        return true;
-    }
+    constexpr bool none() const { return !any(); }
 
     /// @}
     /// @name Individual Element Access
@@ -846,7 +1009,8 @@ public:
     constexpr bool get(usize r, usize c) const {
         gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
         gf2_debug_assert(c < cols(), "Column index {} out of bounds [0,{})", c, cols());
-        return m_rows[r].get(c);
+        auto [w, mask] = index_and_mask<Word>(c);
+        return m_data[r * m_stride + w] & mask;
     }
 
     /// Returns the value of the bit at row `r` and column `c` as a `bool`.
@@ -864,7 +1028,8 @@ public:
     constexpr bool operator()(usize r, usize c) const {
         gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
         gf2_debug_assert(c < cols(), "Column index {} out of bounds [0,{})", c, cols());
-        return m_rows[r].get(c);
+        auto [w, mask] = index_and_mask<Word>(c);
+        return m_data[r * m_stride + w] & mask;
     }
 
     /// Sets the bit at row `r` and column `c` to the bool value `val`.
@@ -882,7 +1047,12 @@ public:
     constexpr void set(usize r, usize c, bool val = true) {
         gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
         gf2_debug_assert(c < cols(), "Column index {} out of bounds [0,{})", c, cols());
-        m_rows[r].set(c, val);
+        auto [w, mask] = index_and_mask<Word>(c);
+        if (val) {
+            m_data[r * m_stride + w] |= mask;
+        } else {
+            m_data[r * m_stride + w] &= ~mask;
+        }
     }
 
     /// Returns the bit at row `r` and column `c` as a `BitRef` reference which can be used to set the bit.
@@ -900,7 +1070,8 @@ public:
     constexpr BitRef<row_type> operator()(usize r, usize c) {
         gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
         gf2_debug_assert(c < cols(), "Column index {} out of bounds [0,{})", c, cols());
-        return m_rows[r][c];
+        auto r_span = row(r);
+        return BitRef<row_type>{&r_span, c};
     }
 
     /// Flips the bit at row `r` and column `c`.
@@ -917,14 +1088,15 @@ public:
     constexpr void flip(usize r, usize c) {
         gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
         gf2_debug_assert(c < cols(), "Column index {} out of bounds [0,{})", c, cols());
-        m_rows[r].flip(c);
+        auto [w, mask] = index_and_mask<Word>(c);
+        m_data[r * m_stride + w] ^= mask;
     }
 
     /// @}
     /// @name Row Access
     /// @{
 
-    /// Returns a read-only reference to the row at index `r`.
+    /// Returns a read-only bit-span view of the row at index `r`.
     ///
     /// # Panics
     /// In debug mode, this method will panic if `r` is out of bounds.
@@ -936,12 +1108,14 @@ public:
     /// assert_eq(m.row(1).to_binary_string(), "010");
     /// assert_eq(m.row(2).to_binary_string(), "001");
     /// ```
-    constexpr const row_type& row(usize r) const {
+    constexpr const_row_type row(usize r) const {
         gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
-        return m_rows[r];
+        return const_row_type{row_data(r), 0, m_cols};
     }
 
-    /// Returns a read-write reference to the row at index `r`.
+    /// Returns a read-write bit-span view of the row at index `r`.
+    ///
+    /// The view is only valid until the bit-matrix is resized or has rows or columns added or removed.
     ///
     /// # Panics
     /// In debug mode, this method will panic if `r` is out of bounds.
@@ -953,13 +1127,16 @@ public:
     /// assert_eq(m.row(0).to_binary_string(), "110");
     /// assert_eq(m.row(1).to_binary_string(), "010");
     /// assert_eq(m.row(2).to_binary_string(), "001");
+    /// auto r = m.row(2);
+    /// r ^= m.row(1);
+    /// assert_eq(m.to_compact_binary_string(), "110 010 011");
     /// ```
-    constexpr row_type& row(usize r) {
+    constexpr row_type row(usize r) {
         gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
-        return m_rows[r];
+        return row_type{row_data(r), 0, m_cols};
     }
 
-    /// Returns a read-only reference to the row at index `r`.
+    /// Returns a read-only bit-span view of the row at index `r`.
     ///
     /// # Panics
     /// In debug mode, this method will panic if `r` is out of bounds.
@@ -971,12 +1148,9 @@ public:
     /// assert_eq(m[1].to_binary_string(), "010");
     /// assert_eq(m[2].to_binary_string(), "001");
     /// ```
-    constexpr const row_type& operator[](usize r) const {
-        gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
-        return m_rows[r];
-    }
+    constexpr const_row_type operator[](usize r) const { return row(r); }
 
-    /// Returns a read-write reference to the row at index `r`.
+    /// Returns a read-write bit-span view of the row at index `r`.
     ///
     /// # Panics
     /// In debug mode, this method will panic if `r` is out of bounds.
@@ -989,10 +1163,41 @@ public:
     /// assert_eq(m[1].to_binary_string(), "010");
     /// assert_eq(m[2].to_binary_string(), "001");
     /// ```
-    constexpr row_type& operator[](usize r) {
-        gf2_debug_assert(r < rows(), "Row index {} out of bounds [0,{})", r, rows());
-        return m_rows[r];
-    }
+    constexpr row_type operator[](usize r) { return row(r); }
+
+    /// Returns the number of words used to store each row, including any padding words at the end of the row.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u64>::zeros(3, 1000);
+    /// assert_eq(m.stride(), 16);
+    /// auto n = BitMatrix<u8>::zeros(3, 17);
+    /// assert_eq(n.stride(), 4);
+    /// ```
+    constexpr usize stride() const { return m_stride; }
+
+    /// Returns a read-only pointer to the contiguous store of words that holds the bit-matrix in row-major order.
+    ///
+    /// Row `i` starts at word `i * stride()` and any padding bits at the end of a row are always zero.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u8>::identity(3);
+    /// assert_eq(m.data()[0], 0b001);
+    /// assert_eq(m.data()[2 * m.stride()], 0b100);
+    /// ```
+    constexpr const Word* data() const { return m_data.data(); }
+
+    /// Returns the allocator of the contiguous store of words -- its `resource()` is where the words live.
+    ///
+    /// That is the `gf2::memory_resource()` that was current when the bit-matrix was created (see `gf2::MemoryScope`).
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u8>::identity(3);
+    /// assert(m.get_allocator().resource() == memory_resource());
+    /// ```
+    constexpr auto get_allocator() const { return m_data.get_allocator(); }
 
     /// @}
     /// @name Column Access
@@ -1018,8 +1223,13 @@ public:
     constexpr BitVector<Word> col(usize c) const {
         gf2_debug_assert(c < cols(), "Column {} out of bounds [0, {})", c, cols());
         auto result = BitVector<Word>::zeros(rows());
+
+        // Gather the bits straight from the row words into the words of the result without any branches.
+        auto [w, offset] = index_and_offset<Word>(c);
+        auto dst = result.store();
         for (auto r = 0uz; r < rows(); ++r) {
-            if (get(r, c)) { result.set(r); }
+            auto bit = static_cast<Word>((row_data(r)[w] >> offset) & 1);
+            dst[r / BITS<Word>] |= static_cast<Word>(bit << (r % BITS<Word>));
         }
         return result;
     }
@@ -1039,7 +1249,11 @@ public:
     /// assert_eq(m.to_compact_binary_string(), "111 111 111");
     /// ```
     constexpr void set_all(bool value = true) {
-        for (auto& row : m_rows) row.set_all(value);
+        if (!value) {
+            std::fill(m_data.begin(), m_data.end(), Word{0});
+            return;
+        }
+        for (auto i = 0uz; i < rows(); ++i) row(i).set_all(true);
     }
 
     /// Flips all the elements of the bit-matrix.
@@ -1051,7 +1265,7 @@ public:
     /// assert_eq(m.to_compact_binary_string(), "111 111 111");
     /// ```
     constexpr void flip_all() {
-        for (auto& row : m_rows) row.flip_all();
+        for (auto i = 0uz; i < rows(); ++i) row(i).flip_all();
     }
 
     /// @}
@@ -1193,9 +1407,10 @@ public:
         // Resizes to zero in either dimension is taken as a zap the lot instruction
         if (r == 0 || c == 0) r = c = 0;
 
-        // Rows, then columns
-        m_rows.resize(r);
-        for (auto& row : m_rows) row.resize(c);
+        // Columns, then rows (any added words are zeros).
+        resize_cols(c);
+        m_rows = r;
+        m_data.resize(m_rows * m_stride);
     }
 
     /// Removes all the elements from the bit-matrix.
@@ -1242,15 +1457,17 @@ public:
         requires std::same_as<typename Store::word_type, Word>
     constexpr BitMatrix& append_row(Store const& row) {
         gf2_assert_eq(row.size(), cols(), "Row has {} elements but bit-matrix has {} columns!", row.size(), cols());
-        m_rows.push_back(row);
+        m_data.resize((m_rows + 1) * m_stride);
+        m_rows++;
+        this->row(m_rows - 1).copy(row);
         return *this;
     }
 
-    /// Appends a single row onto the end of the bit-matrix by moving it and returns a reference to the this for
+    /// Appends a single row onto the end of the bit-matrix, consuming it, and returns a reference to the this for
     /// chaining.
     ///
-    /// Use `std::move(row)` in the method argument to guarantee this version. The input row is moved into the
-    /// matrix and is no longer valid after this call.
+    /// Use `std::move(row)` in the method argument to guarantee this version. The bits are copied into the contiguous
+    /// store of the bit-matrix and the input row should not be used after this call.
     ///
     /// # Panics
     /// The row must have the same number of elements as the bit-matrix has columns.
@@ -1264,9 +1481,7 @@ public:
     template<BitStore Store>
         requires std::same_as<typename Store::word_type, Word>
     constexpr BitMatrix& append_row(Store&& row) {
-        gf2_assert_eq(row.size(), cols(), "Row has {} elements but bit-matrix has {} columns!", row.size(), cols());
-        m_rows.push_back(std::move(row));
-        return *this;
+        return append_row(std::as_const(row));
     }
 
     /// Appends all the rows from the `src` bit-matrix onto the end of this bit-matrix by copying them and returns a
@@ -1284,15 +1499,16 @@ public:
     /// ```
     constexpr BitMatrix& append_rows(BitMatrix<Word> const& src) {
         gf2_assert_eq(src.cols(), cols(), "Source has {} columns but bit-matrix has {} columns!", src.cols(), cols());
-        m_rows.insert(m_rows.end(), src.m_rows.begin(), src.m_rows.end());
+        m_data.insert(m_data.end(), src.m_data.begin(), src.m_data.end());
+        m_rows += src.m_rows;
         return *this;
     }
 
-    /// Appends all the rows from the `src` bit-matrix onto the end of this bit-matrix by moving them  and returns a
+    /// Appends all the rows from the `src` bit-matrix onto the end of this bit-matrix, consuming it, and returns a
     /// reference to the this for chaining.
     ///
-    /// Use `std::move(src)` in the method argument to guarantee this version. The source bit-matrix is moved into
-    /// this matrix and is no longer valid after this call.
+    /// Use `std::move(src)` in the method argument to guarantee this version. If this bit-matrix is empty we simply
+    /// take over the store of `src`. The source bit-matrix should not be used after this call.
     ///
     /// # Panics
     /// The source bit-matrix must have the same number of columns as this bit-matrix.
@@ -1305,9 +1521,11 @@ public:
     /// ```
     constexpr BitMatrix& append_rows(BitMatrix<Word>&& src) {
         gf2_assert_eq(src.cols(), cols(), "Source has {} columns but bit-matrix has {} columns!", src.cols(), cols());
-        m_rows.insert(m_rows.end(), std::make_move_iterator(src.m_rows.begin()),
-                      std::make_move_iterator(src.m_rows.end()));
-        return *this;
+        if (m_rows == 0) {
+            *this = std::move(src);
+            return *this;
+        }
+        return append_rows(std::as_const(src));
     }
 
     /// Appends a single column `col` onto the right of the bit-matrix so `M` -> `M|col`  and returns a
@@ -1327,7 +1545,9 @@ public:
         requires std::same_as<typename Store::word_type, Word>
     constexpr BitMatrix& append_col(Store const& col) {
         gf2_assert_eq(col.size(), rows(), "Column has {} elements but bit-matrix has {} rows!", col.size(), rows());
-        for (auto i = 0uz; i < rows(); ++i) m_rows[i].push(col.get(i));
+        auto c = cols();
+        resize_cols(c + 1);
+        for (auto i = 0uz; i < rows(); ++i) set(i, c, col.get(i));
         return *this;
     }
 
@@ -1346,7 +1566,9 @@ public:
     /// ```
     constexpr BitMatrix& append_cols(BitMatrix<Word> const& src) {
         gf2_assert_eq(src.rows(), rows(), "Source has {} rows but bit-matrix has {} rows!", src.rows(), rows());
-        for (auto i = 0uz; i < rows(); ++i) m_rows[i].append(src.m_rows[i]);
+        auto c = cols();
+        resize_cols(c + src.cols());
+        for (auto i = 0uz; i < rows(); ++i) row(i).span(c, cols()).copy(src.row(i));
         return *this;
     }
 
@@ -1365,9 +1587,10 @@ public:
     /// ```
     constexpr std::optional<BitVector<Word>> remove_row() {
         if (rows() == 0) return std::nullopt;
-        auto row = std::move(m_rows.back());
-        m_rows.pop_back();
-        return row;
+        auto result = BitVector<Word>::from(row(m_rows - 1));
+        m_rows--;
+        m_data.resize(m_rows * m_stride);
+        return result;
     }
 
     /// Removes `k` rows off the end of the bit-matrix and returns them as a new bit-matrix or `std::nullopt` if the
@@ -1382,10 +1605,9 @@ public:
     /// ```
     constexpr std::optional<BitMatrix<Word>> remove_rows(usize k) {
         if (rows() < k) return std::nullopt;
-        auto begin = m_rows.end() - static_cast<std::ptrdiff_t>(k);
-        auto end = m_rows.end();
-        auto result = BitMatrix<Word>(std::vector<row_type>(begin, end));
-        m_rows.erase(begin, end);
+        auto result = sub_matrix(rows() - k, rows(), 0, cols());
+        m_rows -= k;
+        m_data.resize(m_rows * m_stride);
         return result;
     }
 
@@ -1402,7 +1624,7 @@ public:
     constexpr std::optional<BitVector<Word>> remove_col() {
         if (cols() == 0) return std::nullopt;
         auto result = col(cols() - 1);
-        for (auto i = 0uz; i < rows(); ++i) m_rows[i].pop();
+        resize_cols(cols() - 1);
         return result;
     }
 
@@ -1441,7 +1663,7 @@ public:
 
         // Create the sub-matrix.
         BitMatrix result{r, c};
-        for (auto i = 0uz; i < r; ++i) result.m_rows[i].copy(m_rows[i + r_start].span(c_start, c_end));
+        for (auto i = 0uz; i < result.rows(); ++i) result.row(i).copy(row(i + r_start).span(c_start, c_end));
 
         return result;
     }
@@ -1462,7 +1684,7 @@ public:
         auto c = src.cols();
         gf2_assert(top + r <= rows(), "Too many rows for the replacement sub-matrix to fit");
         gf2_assert(left + c <= cols(), "Too many columns for the replacement sub-matrix to fit");
-        for (auto i = 0uz; i < r; ++i) m_rows[top + i].span(left, left + c).copy(src.m_rows[i]);
+        for (auto i = 0uz; i < r; ++i) row(top + i).span(left, left + c).copy(src.row(i));
     }
 
     /// @}
@@ -1488,7 +1710,7 @@ public:
         auto nc = cols();
         for (auto i = 0uz; i < rows(); ++i) {
             auto first = i + 1;
-            if (first < nc) result.m_rows[i].span(first, nc).set_all(false);
+            if (first < nc) result.row(i).span(first, nc).set_all(false);
         }
         return result;
     }
@@ -1512,7 +1734,7 @@ public:
         auto c = cols();
         for (auto i = 0uz; i < rows(); ++i) {
             auto len = std::min(i, c);
-            if (len > 0) result.m_rows[i].span(0, len).set_all(false);
+            if (len > 0) result.row(i).span(0, len).set_all(false);
         }
         return result;
     }
@@ -1599,7 +1821,7 @@ public:
     constexpr void swap_rows(usize i, usize j) {
         gf2_debug_assert(i < rows(), "Row index {} out of bounds [0,{})", i, rows());
         gf2_debug_assert(j < rows(), "Row index {} out of bounds [0,{})", j, rows());
-        std::swap(m_rows[i], m_rows[j]);
+        if (i != j) std::swap_ranges(row_data(i), row_data(i) + m_stride, row_data(j));
     }
 
     /// Swaps columns `i` and `j` of the bit-matrix.
@@ -1616,7 +1838,7 @@ public:
     constexpr void swap_cols(usize i, usize j) {
         gf2_debug_assert(i < cols(), "Column index {} out of bounds [0,{})", i, cols());
         gf2_debug_assert(j < cols(), "Column index {} out of bounds [0,{})", j, cols());
-        for (auto k = 0uz; k < rows(); ++k) m_rows[k].swap(i, j);
+        for (auto k = 0uz; k < rows(); ++k) row(k).swap(i, j);
     }
 
     /// Adds the identity bit-matrix to the bit-matrix.
@@ -1641,7 +1863,9 @@ public:
 
     /// Returns a new bit-matrix that is the transpose of this one.
     ///
-    /// **Note:** This method isn't particularly efficient as it works by iterating over all elements of the bit-matrix.
+    /// The bit-matrix is worked through in square tiles of `W x W` bits, where `W` is the number of bits in a `Word`.
+    /// Each tile is transposed in registers using the classic butterfly of swap-and-mask steps and the tiles are
+    /// visited by recursively halving the tile grid, so the method is cache friendly for large bit-matrices.
     ///
     /// # Example
     /// ```
@@ -1650,21 +1874,25 @@ public:
     /// assert_eq(m.to_compact_binary_string(), "11 00 00");
     /// auto n = m.transposed();
     /// assert_eq(n.to_compact_binary_string(), "100 100");
+    /// auto p = BitMatrix<u8>::random(19, 45);
+    /// auto q = p.transposed();
+    /// assert_eq(q.rows(), 45);
+    /// assert_eq(q.cols(), 19);
+    /// assert(q.get(44, 18) == p.get(18, 44));
+    /// assert(q.get(7, 11) == p.get(11, 7));
+    /// assert_eq(q.transposed(), p);
     /// ```
     constexpr BitMatrix transposed() const {
-        auto      r = rows();
-        auto      c = cols();
-        BitMatrix result{c, r};
-        for (auto i = 0uz; i < r; ++i) {
-            for (auto j = 0uz; j < c; ++j) {
-                if (get(i, j)) { result.set(j, i); }
-            }
-        }
+        BitMatrix result{cols(), rows()};
+        if (!result.is_empty()) transpose_tiles(result, 0, tiles_needed(rows()), 0, words_needed<Word>(cols()));
         return result;
     }
 
     /// Transposes a *square* bit-matrix in place.
     ///
+    /// The work is done on `W x W` bit tiles, where `W` is the number of bits in a `Word`. Tiles on the diagonal are
+    /// transposed in place and each off-diagonal pair of tiles is transposed and swapped.
+    ///
     /// # Panics
     /// This method will panic if the bit-matrix is not square.
     ///
@@ -1675,15 +1903,29 @@ public:
     /// assert_eq(m.to_compact_binary_string(), "111 000 000");
     /// m.transpose();
     /// assert_eq(m.to_compact_binary_string(), "100 100 100");
+    /// auto p = BitMatrix<u8>::random(21, 21);
+    /// auto q = p;
+    /// q.transpose();
+    /// assert_eq(q, p.transposed());
     /// ```
     constexpr void transpose() {
         gf2_assert(is_square(), "`transpose()` requires a square matrix");
-        for (auto i = 0uz; i < rows(); ++i) {
-            for (auto j = 0uz; j < i; ++j) {
-                if (get(i, j) != get(j, i)) {
-                    flip(i, j);
-                    flip(j, i);
-                }
+        auto n_tiles = tiles_needed(rows());
+        tile_type a, b;
+        for (auto i = 0uz; i < n_tiles; ++i) {
+            // Diagonal tile.
+            load_tile(i, i, a);
+            transpose_tile(a);
+            store_tile(i, i, a);
+
+            // Pairs of tiles on either side of the diagonal.
+            for (auto j = i + 1; j < n_tiles; ++j) {
+                load_tile(i, j, a);
+                load_tile(j, i, b);
+                transpose_tile(a);
+                transpose_tile(b);
+                store_tile(j, i, a);
+                store_tile(i, j, b);
             }
         }
     }
@@ -1694,8 +1936,16 @@ public:
 
     /// Returns a new bit-matrix that is this one raised to some power `n` or `2^n`.
     ///
-    /// We efficiently compute `M^e` by using a square and multiply algorithm where by default `e = n`.
+    /// By default `e = n`, and we compute `M^e` with a sliding-window square-and-multiply algorithm.
+    /// It precomputes the odd powers `M, M^3, ..., M^(2^k - 1)` for a window size `k` that grows with the number of
+    /// bits in `n`. It then scans the bits of `n` from the top, doing one multiplication for each window of up to `k`
+    /// bits that ends in a one, instead of one for every set bit.
+    ///
     /// If the second argument `n_is_log2 = true` then we consider `e = 2^n` instead.
+    /// For huge `n` it pays to first reduce `x^e` modulo the characteristic polynomial `c(x)` of the matrix. We then
+    /// evaluate that remainder at `M`, which is the same thing by the Cayley-Hamilton theorem. We go that way when `n`
+    /// exceeds the number of rows, because the polynomial evaluation then needs fewer matrix products than the `n`
+    /// squarings.
     ///
     /// # Panics
     /// This method will panic if the bit-matrix is not square.
@@ -1709,37 +1959,74 @@ public:
     /// auto p2 = m.to_the(2, true);
     /// auto o2 = m * o1;
     /// assert_eq(p2, o2);
+    /// auto p3 = m.to_the(1'000'003);
+    /// auto o3 = m.to_the(1'000'000) * m.to_the(3);
+    /// assert_eq(p3, o3);
+    /// auto s = BitMatrix<>::random(20, 20);
+    /// auto p4 = s.to_the(30, true);
+    /// auto o4 = s;
+    /// for (auto i = 0; i < 30; ++i) o4 = o4 * o4;
+    /// assert_eq(p4, o4);
     /// ```
     constexpr BitMatrix to_the(usize n, bool n_is_log2 = false) const {
         gf2_assert(is_square(), "Bit-matrix is {} x {} but it should be square!", rows(), cols());
 
         // Perhaps we just need lots of square steps?  Note that 2^0 = 1 so M^(2^0) = M.
         if (n_is_log2) {
-            auto result = *this;
-            for (auto i = 0uz; i < n; ++i) result = dot(result, result);
+            // Lots of squarings? Then M^(2^n) = r(M) where r(x) = x^(2^n) mod c(x) has degree less than rows().
+            if (n > rows()) return characteristic_polynomial().reduce_x_to_the(n, true)(*this);
+            // The squares ping-pong between two buffers so the loop does not allocate after the first step.
+            auto      result = *this;
+            BitMatrix scratch;
+            for (auto i = 0uz; i < n; ++i) {
+                dot(result, result, scratch);
+                std::swap(result, scratch);
+            }
             return result;
         }
 
         // Otherwise we need square & multiply steps but we first handle the edge case:
         if (n == 0) return BitMatrix::identity(rows());
 
-        // OK n != 0: Note that if e.g. n = 0b00010111 then std::bit_floor(n) = 0b00010000.
-        usize n_bit = std::bit_floor(n);
-
-        // Start with a copy of this bit-matrix which takes care of the most significant binary digit in n.
-        auto result = *this;
-        n_bit >>= 1;
+        // Pick a window size: the table of odd powers costs 2^(k-1) products & each window saves up to k - 1 of them.
+        auto n_bits = std::bit_width(n);
+        auto k = n_bits <= 8 ? 1uz : n_bits <= 24 ? 3uz : 4uz;
 
-        // More to go?
-        while (n_bit) {
-            // Always square and then multiply if necessary (i.e. if current bit in n is set).
-            result = dot(result, result);
-            if (n & n_bit) result = dot(result, *this);
+        // The odd powers: odd[i] = M^(2i + 1) for i = 0, ..., 2^(k-1) - 1.
+        std::pmr::vector<BitMatrix> odd{{*this}, memory_resource()};
+        if (k > 1) {
+            auto m2 = dot(*this, *this);
+            for (auto i = 1uz; i < (1uz << (k - 1)); ++i) odd.push_back(dot(odd.back(), m2));
+        }
 
-            // On to the next bit position in n.
-            n_bit >>= 1;
+        // Scan the bits of n from the top. If bit i is set then the window is the longest run of bits from i down to
+        // some j > i - k with bit j set. We square once per bit in the window & then multiply by the odd power.
+        // The products ping-pong between `result` and `scratch` so they reuse the same two buffers.
+        std::optional<BitMatrix> result;
+        BitMatrix                scratch;
+        auto                     times = [&](BitMatrix const& rhs) {
+            dot(*result, rhs, scratch);
+            std::swap(*result, scratch);
+        };
+        auto i = n_bits;
+        while (i > 0) {
+            if (((n >> (i - 1)) & 1) == 0) {
+                times(*result);
+                --i;
+                continue;
+            }
+            auto j = i > k ? i - k : 0uz;
+            while (((n >> j) & 1) == 0) ++j;
+            auto w = (n >> j) & ((1uz << (i - j)) - 1);
+            if (result) {
+                for (auto s = j; s < i; ++s) times(*result);
+                times(odd[w >> 1]);
+            } else {
+                result = odd[w >> 1];
+            }
+            i = j;
         }
-        return result;
+        return *std::move(result);
     }
 
     /// @}
@@ -1754,7 +2041,14 @@ public:
     /// A bit-matrix is in echelon form if the first 1 in any row is to the right of the first 1 in the preceding row.
     /// It is a generalization of an upper triangular form -- the result is a matrix with a "staircase" shape.
     ///
-    /// The transformation is Gaussian elimination.
+    /// The transformation is Gaussian elimination done with the "Method of Four Russians" for inversion (M4RI):
+    ///
+    /// - The pivot search scans a whole word of columns down the remaining rows at once so zero columns are skipped.
+    /// - Up to eight consecutive pivot columns are found at a time. We build a Gray code ordered table of all the
+    ///   `XOR` combinations of those pivot rows, and then each of the other rows is cleared in all of those columns
+    ///   by a single table lookup and row addition instead of one row addition per pivot.
+    /// - Row additions start at the word holding the first pivot column as the words to its left are already zero.
+    ///
     /// Any all zero rows are moved to the bottom of the matrix.
     /// The echelon form is not unique.
     ///
@@ -1769,43 +2063,32 @@ public:
     /// assert_eq(has_pivot.to_string(), "111");
     /// assert_eq(m.to_compact_binary_string(), "100 010 001");
     /// ```
-    BitVector<Word> to_echelon_form() {
-        gf2_assert(!is_empty(), "Bit-matrix must not be empty");
-
-        // We return a bit-vector that shows which columns have a pivot -- start by assuming none.
-        auto has_pivot = BitVector<Word>::zeros(cols());
+    BitVector<Word> to_echelon_form() { return to_echelon_form(seq); }
 
-        // The current row of the echelon form we are working on.
-        auto r = 0uz;
-        auto nr = rows();
-
-        // Iterate over each column.
-        for (auto j = 0uz; j < cols(); ++j) {
-            // Find a non-zero entry in this column below the diagonal (a "pivot").
-            auto p = r;
-            while (p < nr && !get(p, j)) p++;
-
-            // Did we find a pivot in this column?
-            if (p < nr) {
-                // Mark this column as having a pivot.
-                has_pivot.set(j);
-
-                // If necessary, swap the current row with the row that has the pivot.
-                if (p != r) swap_rows(p, r);
-
-                // Below the working row make sure column j is zero by elimination if necessary.
-                auto row_r = m_rows[r];
-                for (auto i = r + 1; i < nr; ++i)
-                    if (get(i, j)) m_rows[i] ^= row_r;
-
-                // Move to the next row. If we've reached the end of the matrix, we're done.
-                r += 1;
-                if (r == nr) break;
-            }
-        }
-
-        // Return the bit-vector that shows which columns have a pivot.
-        return has_pivot;
+    /// Transforms an arbitrary shaped, non-empty, bit-matrix to row-echelon form (in-place) using the given executor.
+    ///
+    /// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The table sweeps for each block of pivots are
+    /// spread over its threads in blocks of rows. Otherwise this is the same as `to_echelon_form()`.
+    ///
+    /// # Panics
+    /// This method will panic if the bit-matrix is empty.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(300, 200);
+    /// auto m1 = m;
+    /// auto m2 = m;
+    /// ThreadPool pool{3};
+    /// assert_eq(m1.to_echelon_form(pool), m.to_echelon_form());
+    /// assert_eq(m2.to_echelon_form(par), m.to_echelon_form());
+    /// assert_eq(m1, m);
+    /// assert_eq(m2, m);
+    /// ```
+    template<Executor Exec>
+    BitVector<Word> to_echelon_form(Exec&& exec) {
+        gf2_probe("BitMatrix::to_echelon_form");
+        gf2_assert(!is_empty(), "Bit-matrix must not be empty");
+        return eliminate(exec, false, false);
     }
 
     /// Transforms the bit-matrix to reduced row-echelon form (in-place).
@@ -1827,25 +2110,170 @@ public:
     /// assert_eq(pivots.to_string(), "111");
     /// assert_eq(m.to_compact_binary_string(), "100 010 001");
     /// ```
-    BitVector<Word> to_reduced_echelon_form() {
-        // Start with the echelon form.
-        auto has_pivot = to_echelon_form();
-
-        // Iterate over each row from the bottom up - Gauss Jordan elimination.
-        for (auto r = rows(); r--;) {
-            // Find the first set bit in the current row if there is one.
-            if (auto p = m_rows[r].first_set()) {
-                // Clear out everything in column p *above* row r (already cleared out below the pivot).
-                auto row_r = m_rows[r];
-                for (auto i = 0uz; i < r; ++i)
-                    if (get(i, *p)) m_rows[i] ^= row_r;
-            }
+    BitVector<Word> to_reduced_echelon_form() { return to_reduced_echelon_form(seq); }
+
+    /// Transforms the bit-matrix to reduced row-echelon form (in-place) using the given executor.
+    ///
+    /// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The table sweeps for each block of pivots are
+    /// spread over its threads in blocks of rows. Otherwise this is the same as `to_reduced_echelon_form()`.
+    ///
+    /// # Panics
+    /// This method will panic if the bit-matrix is empty.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u32>::random(200, 300);
+    /// auto m1 = m;
+    /// assert_eq(m1.to_reduced_echelon_form(par), m.to_reduced_echelon_form());
+    /// assert_eq(m1, m);
+    /// ```
+    template<Executor Exec>
+    BitVector<Word> to_reduced_echelon_form(Exec&& exec) {
+        gf2_probe("BitMatrix::to_reduced_echelon_form");
+        gf2_assert(!is_empty(), "Bit-matrix must not be empty");
+        return eliminate(exec, true, false);
+    }
+
+    /// @}
+    /// @name Rank, kernel & image
+    /// @{
+
+    /// Returns the rank of the bit-matrix (the number of linearly independent rows or columns).
+    ///
+    /// This runs the forward elimination of `to_echelon_form()` on a copy but stops as soon as the rank is known. Once
+    /// the rank reaches `min(rows(), cols())` the final clearing sweep is skipped altogether, and we stop as soon as
+    /// the remaining rows are all zero.
+    ///
+    /// An empty bit-matrix has rank 0.
+    ///
+    /// # Example
+    /// ```
+    /// assert_eq(BitMatrix<>::identity(10).rank(), 10);
+    /// assert_eq(BitMatrix<>::ones(10, 20).rank(), 1);
+    /// assert_eq(BitMatrix<>::zeros(10, 20).rank(), 0);
+    /// assert_eq(BitMatrix<>{}.rank(), 0);
+    /// auto m = BitMatrix<u8>::random(50, 70);
+    /// auto e = m;
+    /// assert_eq(m.rank(), e.to_echelon_form().count_ones());
+    /// ```
+    usize rank() const { return rank(seq); }
+
+    /// Returns the rank of the bit-matrix using the given executor.
+    ///
+    /// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The table sweeps for each block of pivots are
+    /// spread over its threads in blocks of rows. Otherwise this is the same as `rank()`.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(300, 200);
+    /// ThreadPool pool{3};
+    /// assert_eq(m.rank(pool), m.rank());
+    /// assert_eq(m.rank(par), m.rank());
+    /// ```
+    template<Executor Exec>
+    usize rank(Exec&& exec) const {
+        gf2_probe("BitMatrix::rank");
+        if (is_empty()) return 0;
+        auto m = *this;
+        return m.eliminate(exec, false, true).count_ones();
+    }
+
+    /// Returns a bit-matrix whose rows are a basis for the kernel (null space) of this bit-matrix.
+    ///
+    /// The kernel is the set of vectors $x$ with $A \cdot x = 0$. It has dimension `cols() - rank()` and each row of the
+    /// result has `cols()` elements. There is one basis vector for each non-pivot column $f$ of the reduced echelon
+    /// form: it has a one in slot $f$ and in each pivot slot whose row of the reduced form has a one in column $f$.
+    ///
+    /// If the kernel is just the zero vector, the result is an empty bit-matrix. A bit-matrix with no rows sends every
+    /// vector to zero, so its kernel basis is the identity.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::from_string("110 011").value();
+    /// auto K = A.kernel();
+    /// assert_eq(K.to_compact_binary_string(), "111");
+    /// assert(BitMatrix<>::identity(5).kernel().is_empty());
+    /// auto B = BitMatrix<u32>::random(40, 60);
+    /// auto N = B.kernel();
+    /// assert_eq(N.rows(), 60 - B.rank());
+    /// assert_eq(N.rank(), N.rows());
+    /// assert(dot(B, N.transposed()).none());
+    /// ```
+    BitMatrix kernel() const {
+        auto n = cols();
+        if (n == 0) return BitMatrix{};
+        if (rows() == 0) return identity(n);
+
+        auto reduced = *this;
+        auto has_pivot = reduced.to_reduced_echelon_form();
+
+        // Row r of the reduced form has its pivot in the r'th pivot column.
+        auto pivots = has_pivot.to_indices();
+
+        auto result = zeros(n - pivots.size(), n);
+        auto k = 0uz;
+        for (auto f = 0uz; f < n; ++f) {
+            if (has_pivot[f]) continue;
+            result.set(k, f);
+            for (auto r = 0uz; r < pivots.size(); ++r)
+                if (reduced.get(r, f)) result.set(k, pivots[r]);
+            ++k;
         }
+        return result;
+    }
 
-        // Return the bit-vector that shows which columns have a pivot.
-        return has_pivot;
+    /// Returns a bit-matrix whose rows are a basis for the kernel (null space) of this bit-matrix.
+    ///
+    /// This is another name for `kernel()`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::from_string("110 011").value();
+    /// assert_eq(A.null_space(), A.kernel());
+    /// ```
+    BitMatrix null_space() const { return kernel(); }
+
+    /// Returns a bit-matrix whose rows are a basis for the image (column space) of this bit-matrix.
+    ///
+    /// The image is the set of vectors $A \cdot x$, which is the span of the columns of $A$. The basis we return is the
+    /// set of columns of $A$ that hold the pivots of its echelon form, so it has `rank()` rows each with `rows()`
+    /// elements. If the image is just the zero vector, the result is an empty bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::from_string("101 011").value();
+    /// assert_eq(A.image().to_compact_binary_string(), "10 01");
+    /// assert(BitMatrix<>::zeros(3, 4).image().is_empty());
+    /// auto B = BitMatrix<u16>::random(60, 40);
+    /// auto I = B.image();
+    /// assert_eq(I.rows(), B.rank());
+    /// assert_eq(I.rank(), I.rows());
+    /// ```
+    BitMatrix image() const {
+        if (is_empty()) return BitMatrix{};
+
+        auto reduced = *this;
+        auto has_pivot = reduced.to_echelon_form();
+
+        // The columns of A are the rows of its transpose.
+        auto columns = transposed();
+        auto result = zeros(has_pivot.count_ones(), rows());
+        auto k = 0uz;
+        for (auto j : has_pivot.set_bits()) result.row(k++).copy(columns.row(j));
+        return result;
     }
 
+    /// Returns a bit-matrix whose rows are a basis for the image (column space) of this bit-matrix.
+    ///
+    /// This is another name for `image()`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::from_string("101 011").value();
+    /// assert_eq(A.column_space(), A.image());
+    /// ```
+    BitMatrix column_space() const { return image(); }
+
     /// @}
     /// @name Inversion
     /// @{
@@ -1858,6 +2286,8 @@ public:
     /// assert_eq(m.inverse().value().to_compact_binary_string(), "100 010 001");
     /// ```
     std::optional<BitMatrix> inverse() const {
+        gf2_probe("BitMatrix::inverse");
+
         // The bit-matrix must be square & non-empty.
         if (is_empty() || !is_square()) return std::nullopt;
 
@@ -1937,10 +2367,38 @@ public:
     /// ```
     BitLU<Word> LU() const { return BitLU<Word>{*this}; }
 
+    /// Returns the LU decomposition of the bit-matrix computed using the given executor.
+    ///
+    /// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`.
+    ///
+    /// # Panics
+    /// This method panics if the bit-matrix is not square.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(300, 300);
+    /// assert_eq(m.LU(par).LU(), m.LU().LU());
+    /// ```
+    template<Executor Exec>
+    BitLU<Word> LU(Exec&& exec) const {
+        return BitLU<Word>{exec, *this};
+    }
+
     /// @}
     /// @name Solving systems of linear equations
     /// @{
 
+    /// Returns a Gaussian elimination solver for this bit-matrix that can be reused for any number of r.h.s. vectors.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::identity(3);
+    /// auto solver = A.solver();
+    /// assert_eq(solver.x_for(BitVector<>::ones(3)).value().to_string(), "111");
+    /// assert_eq(solver.x_for(BitVector<>::zeros(3)).value().to_string(), "000");
+    /// ```
+    auto solver() const { return BitGauss<Word>{*this}; }
+
     /// Returns the Gaussian elimination solver for this bit-matrix and the passed r.h.s. vector `b`.
     ///
     /// # Example
@@ -1999,6 +2457,7 @@ public:
     /// assert_eq(p(m100).is_zero(), true);
     /// ```
     BitPolynomial<Word> characteristic_polynomial() const {
+        gf2_probe("BitMatrix::characteristic_polynomial");
         gf2_assert(is_square(), "Bit-matrix must be square not {} x {}", rows(), cols());
         return frobenius_matrix_characteristic_polynomial(frobenius_form());
     }
@@ -2101,7 +2560,11 @@ public:
     constexpr void operator^=(BitMatrix<Word> const& rhs) {
         gf2_assert(rows() == rhs.rows(), "Row dimensions do not match: {} != {}.", rows(), rhs.rows());
         gf2_assert(cols() == rhs.cols(), "Column dimensions do not match: {} != {}.", cols(), rhs.cols());
-        for (auto i = 0uz; i < rows(); ++i) row(i) ^= rhs.row(i);
+        if !consteval {
+            details::simd::xor_into(m_data.data(), rhs.m_data.data(), m_data.size());
+            return;
+        }
+        for (auto k = 0uz; k < m_data.size(); ++k) m_data[k] ^= rhs.m_data[k];
     }
 
     /// In-place `AND` with a bit-matrix `rhs`.
@@ -2120,7 +2583,11 @@ public:
     constexpr void operator&=(BitMatrix<Word> const& rhs) {
         gf2_assert(rows() == rhs.rows(), "Row dimensions do not match: {} != {}.", rows(), rhs.rows());
         gf2_assert(cols() == rhs.cols(), "Column dimensions do not match: {} != {}.", cols(), rhs.cols());
-        for (auto i = 0uz; i < rows(); ++i) row(i) &= rhs.row(i);
+        if !consteval {
+            details::simd::and_into(m_data.data(), rhs.m_data.data(), m_data.size());
+            return;
+        }
+        for (auto k = 0uz; k < m_data.size(); ++k) m_data[k] &= rhs.m_data[k];
     }
 
     /// In-place `OR` with a bit-matrix `rhs`.
@@ -2139,10 +2606,14 @@ public:
     constexpr void operator|=(BitMatrix<Word> const& rhs) {
         gf2_assert(rows() == rhs.rows(), "Row dimensions do not match: {} != {}.", rows(), rhs.rows());
         gf2_assert(cols() == rhs.cols(), "Column dimensions do not match: {} != {}.", cols(), rhs.cols());
-        for (auto i = 0uz; i < rows(); ++i) row(i) |= rhs.row(i);
+        if !consteval {
+            details::simd::or_into(m_data.data(), rhs.m_data.data(), m_data.size());
+            return;
+        }
+        for (auto k = 0uz; k < m_data.size(); ++k) m_data[k] |= rhs.m_data[k];
     }
 
-    /// The`XOR` of this with a bit-matrix `rhs` returning a new bit-matrix.
+    /// In-place `XOR` with a lazy bit-matrix expression `rhs` which is evaluated word-by-word straight into this one.
     ///
     /// # Panics
     /// This method panics if the dimensions do not match.
@@ -2151,40 +2622,34 @@ public:
     /// ```
     /// auto lhs = BitMatrix<>::identity(3);
     /// auto rhs = BitMatrix<>::identity(3);
-    /// rhs.flip_all();
-    /// auto result = lhs ^ rhs;
-    /// assert_eq(result.to_compact_binary_string(), "111 111 111");
+    /// lhs ^= ~rhs;
+    /// assert_eq(lhs.to_compact_binary_string(), "111 111 111");
     /// ```
-    constexpr auto operator^(BitMatrix<Word> const& rhs) const {
-        gf2_assert(rows() == rhs.rows(), "Row dimensions do not match: {} != {}.", rows(), rhs.rows());
-        gf2_assert(cols() == rhs.cols(), "Column dimensions do not match: {} != {}.", cols(), rhs.cols());
-        auto result = *this;
-        result ^= rhs;
-        return result;
+    template<typename Expr>
+        requires details::LazyBitMatrixExpression<Expr> && std::same_as<typename Expr::word_type, Word>
+    constexpr void operator^=(Expr const& rhs) {
+        combine_expr(rhs, details::XorWords{});
     }
 
-    /// The`AND` of this with a bit-matrix `rhs` returning a new bit-matrix.
+    /// In-place `AND` with a lazy bit-matrix expression `rhs` which is evaluated word-by-word straight into this one.
     ///
     /// # Panics
     /// This method panics if the dimensions do not match.
     ///
     /// # Example
     /// ```
-    /// auto lhs = BitMatrix<>::identity(3);
+    /// auto lhs = BitMatrix<>::ones(3, 3);
     /// auto rhs = BitMatrix<>::identity(3);
-    /// rhs.flip_all();
-    /// auto result = lhs & rhs;
-    /// assert_eq(result.to_compact_binary_string(), "000 000 000");
+    /// lhs &= ~rhs;
+    /// assert_eq(lhs.to_compact_binary_string(), "011 101 110");
     /// ```
-    constexpr auto operator&(BitMatrix<Word> const& rhs) const {
-        gf2_assert(rows() == rhs.rows(), "Row dimensions do not match: {} != {}.", rows(), rhs.rows());
-        gf2_assert(cols() == rhs.cols(), "Column dimensions do not match: {} != {}.", cols(), rhs.cols());
-        auto result = *this;
-        result &= rhs;
-        return result;
+    template<typename Expr>
+        requires details::LazyBitMatrixExpression<Expr> && std::same_as<typename Expr::word_type, Word>
+    constexpr void operator&=(Expr const& rhs) {
+        combine_expr(rhs, details::AndWords{});
     }
 
-    /// The`OR` of this with a bit-matrix `rhs` returning a new bit-matrix.
+    /// In-place `OR` with a lazy bit-matrix expression `rhs` which is evaluated word-by-word straight into this one.
     ///
     /// # Panics
     /// This method panics if the dimensions do not match.
@@ -2193,30 +2658,36 @@ public:
     /// ```
     /// auto lhs = BitMatrix<>::identity(3);
     /// auto rhs = BitMatrix<>::identity(3);
-    /// rhs.flip_all();
-    /// auto result = lhs | rhs;
-    /// assert_eq(result.to_compact_binary_string(), "111 111 111");
+    /// lhs |= ~rhs;
+    /// assert_eq(lhs.to_compact_binary_string(), "111 111 111");
     /// ```
-    constexpr auto operator|(BitMatrix<Word> const& rhs) const {
-        gf2_assert(rows() == rhs.rows(), "Row dimensions do not match: {} != {}.", rows(), rhs.rows());
-        gf2_assert(cols() == rhs.cols(), "Column dimensions do not match: {} != {}.", cols(), rhs.cols());
-        auto result = *this;
-        result |= rhs;
-        return result;
+    template<typename Expr>
+        requires details::LazyBitMatrixExpression<Expr> && std::same_as<typename Expr::word_type, Word>
+    constexpr void operator|=(Expr const& rhs) {
+        combine_expr(rhs, details::OrWords{});
     }
 
-    /// Returns a copy of this bit-matrix with all the elements flipped.
+    /// Assigns the value of a lazy bit-matrix expression to this bit-matrix in a single pass.
+    ///
+    /// The expression may refer to this bit-matrix -- each word of the result only depends on the matching words of
+    /// the operands.
     ///
     /// # Example
     /// ```
     /// auto m = BitMatrix<>::identity(3);
-    /// auto result = ~m;
-    /// assert_eq(result.to_compact_binary_string(), "011 101 110");
+    /// auto ones = BitMatrix<>::ones(3, 3);
+    /// m = m ^ ones;
+    /// assert_eq(m.to_compact_binary_string(), "011 101 110");
+    /// m = ~ones;
+    /// assert_eq(m.to_compact_binary_string(), "000 000 000");
     /// ```
-    constexpr auto operator~() {
-        auto result = *this;
-        result.flip_all();
-        return result;
+    template<typename Expr>
+        requires details::LazyBitMatrixExpression<Expr> && std::same_as<typename Expr::word_type, Word>
+    constexpr BitMatrix& operator=(Expr const& expr) {
+        // If the dimensions change then `expr` can't be reading from this bit-matrix so resizing is safe.
+        resize(expr.rows(), expr.cols());
+        for (auto k = 0uz; k < m_data.size(); ++k) m_data[k] = expr.word(k);
+        return *this;
     }
 
     /// @}
@@ -2253,7 +2724,7 @@ public:
     /// ```
     constexpr void operator-=(BitMatrix<Word> const& rhs) { operator^=(rhs); }
 
-    /// Returns a new bit-matrix that is `*this + rhs` which is `*this ^ rhs` in GF(2).
+    /// In-place addition with a lazy bit-matrix expression `rhs` -- in GF(2) addition is the same as `XOR`.
     ///
     /// # Panics
     /// This method panics if the dimensions do not match.
@@ -2262,17 +2733,16 @@ public:
     /// ```
     /// auto lhs = BitMatrix<>::identity(3);
     /// auto rhs = BitMatrix<>::identity(3);
-    /// rhs.flip_all();
-    /// auto result = lhs - rhs;
-    /// assert_eq(result.to_compact_binary_string(), "111 111 111");
+    /// lhs += ~rhs;
+    /// assert_eq(lhs.to_compact_binary_string(), "111 111 111");
     /// ```
-    constexpr auto operator+(BitMatrix<Word> const& rhs) const {
-        auto result = *this;
-        result += rhs;
-        return result;
+    template<typename Expr>
+        requires details::LazyBitMatrixExpression<Expr> && std::same_as<typename Expr::word_type, Word>
+    constexpr void operator+=(Expr const& rhs) {
+        operator^=(rhs);
     }
 
-    /// Returns a new bit-matrix that is `*this - rhs` which is `*this ^ rhs` in GF(2).
+    /// In-place difference with a lazy bit-matrix expression `rhs` -- in GF(2) subtraction is the same as `XOR`.
     ///
     /// # Panics
     /// This method panics if the dimensions do not match.
@@ -2281,14 +2751,13 @@ public:
     /// ```
     /// auto lhs = BitMatrix<>::identity(3);
     /// auto rhs = BitMatrix<>::identity(3);
-    /// rhs.flip_all();
-    /// auto result = lhs + rhs;
-    /// assert_eq(result.to_compact_binary_string(), "111 111 111");
+    /// lhs -= ~rhs;
+    /// assert_eq(lhs.to_compact_binary_string(), "111 111 111");
     /// ```
-    constexpr auto operator-(BitMatrix<Word> const& rhs) const {
-        auto result = *this;
-        result -= rhs;
-        return result;
+    template<typename Expr>
+        requires details::LazyBitMatrixExpression<Expr> && std::same_as<typename Expr::word_type, Word>
+    constexpr void operator-=(Expr const& rhs) {
+        operator^=(rhs);
     }
 
     /// @}
@@ -2322,7 +2791,7 @@ public:
         result.reserve(nr * per_row);
 
         for (auto i = 0uz; i < nr; ++i) {
-            result += m_rows[i].to_binary_string(bit_sep, row_prefix, row_suffix);
+            result += row(i).to_binary_string(bit_sep, row_prefix, row_suffix);
             if (i + 1 < nr) result += row_sep;
         }
         return result;
@@ -2404,7 +2873,7 @@ public:
 
         // Append each row to the result string.
         for (auto i = 0uz; i < nr; ++i) {
-            result += m_rows[i].to_hex_string();
+            result += row(i).to_hex_string();
             if (i + 1 < nr) result += row_sep;
         }
         return result;
@@ -2458,19 +2927,281 @@ public:
         // Edge case.
         if (&lhs == &rhs) return true;
 
-        // Check the active words for equality.
-        auto row_count = lhs.rows();
-        if (rhs.rows() != row_count) return false;
-        for (auto i = 0uz; i < row_count; ++i)
-            if (lhs.m_rows[i] != rhs.m_rows[i]) return false;
+        // Empty bit-matrices are all equal.
+        if (lhs.is_empty() && rhs.is_empty()) return true;
 
-        // Made it
-        return true;
+        // Otherwise the dimensions must match and then, as the padding bits are always zero, so must all the words.
+        if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) return false;
+        return lhs.m_data == rhs.m_data;
     }
 
 private:
+    // Returns a pointer to the first word of row `r`.
+    constexpr Word*       row_data(usize r) { return m_data.data() + r * m_stride; }
+    constexpr const Word* row_data(usize r) const { return m_data.data() + r * m_stride; }
+
+    // Combines the words of a lazy bit-matrix expression into this bit-matrix in a single pass.
+    template<typename Expr, typename Op>
+    constexpr void combine_expr(Expr const& rhs, Op op) {
+        gf2_assert(rows() == rhs.rows(), "Row dimensions do not match: {} != {}.", rows(), rhs.rows());
+        gf2_assert(cols() == rhs.cols(), "Column dimensions do not match: {} != {}.", cols(), rhs.cols());
+        for (auto k = 0uz; k < m_data.size(); ++k) m_data[k] = op(m_data[k], rhs.word(k));
+    }
+
+    // Returns the number of words we use to store a row with `c` columns.
+    // Wide rows are padded out to a whole number of cache lines. Narrow rows are padded to a power of two number of
+    // words so that no row straddles a cache line.
+    static constexpr usize stride_for(usize c) {
+        constexpr usize words_per_line = std::max(1uz, 64 / sizeof(Word));
+        auto            words = words_needed<Word>(c);
+        if (words == 0) return 0;
+        if (words >= words_per_line) return (words + words_per_line - 1) / words_per_line * words_per_line;
+        return std::bit_ceil(words);
+    }
+
+    // Changes the number of columns to `c` keeping the current rows & any bits that are still in range.
+    // Unlike `resize`, this leaves the number of rows alone even if `c` is zero.
+    constexpr void resize_cols(usize c) {
+        if (c == m_cols) return;
+
+        // If the stride does not change we only need to clear any bits that are now out of range.
+        auto stride = stride_for(c);
+        if (stride == m_stride) {
+            if (c < m_cols)
+                for (auto i = 0uz; i < rows(); ++i) row(i).span(c, m_cols).set_all(false);
+            m_cols = c;
+            return;
+        }
+
+        // Otherwise we copy the rows over to a new store.
+        auto data = decltype(m_data)(m_rows * stride, Word{0}, m_data.get_allocator());
+        auto n_copy = std::min(c, m_cols);
+        for (auto i = 0uz; i < rows(); ++i)
+            BitSpan<Word>{data.data() + i * stride, 0, n_copy}.copy(row(i).span(0, n_copy));
+        m_data = std::move(data);
+        m_cols = c;
+        m_stride = stride;
+    }
+
+    // Copies a vector of equal sized rows into a freshly sized store.
+    constexpr void copy_rows(std::vector<BitVector<Word>> const& rows) {
+        m_rows = rows.size();
+        m_cols = m_rows > 0 ? rows[0].size() : 0;
+        m_stride = stride_for(m_cols);
+        m_data.assign(m_rows * m_stride, Word{0});
+        for (auto i = 0uz; i < m_rows; ++i) std::copy_n(rows[i].store(), rows[i].words(), row_data(i));
+    }
+
+    // A square tile of bits with one word per row.
+    using tile_type = std::array<Word, BITS<Word>>;
+
+    // The number of tiles needed to cover `n` rows.
+    static constexpr usize tiles_needed(usize n) { return words_needed<Word>(n); }
+
+    // Copies the tile that starts in row `ti * W` and covers word `tj` of those rows into `tile`.
+    // Rows past the end of the bit-matrix are treated as zeros.
+    constexpr void load_tile(usize ti, usize tj, tile_type& tile) const {
+        auto r0 = ti * BITS<Word>;
+        for (auto k = 0uz; k < BITS<Word>; ++k) tile[k] = r0 + k < rows() ? row_data(r0 + k)[tj] : Word{0};
+    }
+
+    // Copies `tile` back into the tile that starts in row `ti * W` and covers word `tj` of those rows.
+    // Rows past the end of the bit-matrix are ignored.
+    constexpr void store_tile(usize ti, usize tj, tile_type const& tile) {
+        auto r0 = ti * BITS<Word>;
+        for (auto k = 0uz; k < BITS<Word> && r0 + k < rows(); ++k) row_data(r0 + k)[tj] = tile[k];
+    }
+
+    // Transposes a square `W x W` tile of bits in-place using the butterfly network of swap-and-mask steps.
+    // At each step we swap the top-right and bottom-left `j x j` blocks of all the `2j x 2j` sub-tiles at once.
+    static constexpr void transpose_tile(tile_type& tile) {
+        constexpr usize n = BITS<Word>;
+        auto            mask = static_cast<Word>(MAX<Word> >> (n / 2));
+        for (auto j = n / 2; j != 0; j >>= 1, mask = static_cast<Word>(mask ^ (mask << j))) {
+            for (auto k = 0uz; k < n; k = ((k | j) + 1) & ~j) {
+                auto t = static_cast<Word>(((tile[k] >> j) ^ tile[k | j]) & mask);
+                tile[k] = static_cast<Word>(tile[k] ^ (t << j));
+                tile[k | j] ^= t;
+            }
+        }
+    }
+
+    // Transposes the tiles in rows `[r0, r1)` and word columns `[c0, c1)` of the tile grid into `dst`.
+    // We recursively halve the longer side of the grid so that the working set shrinks until it fits in cache.
+    constexpr void transpose_tiles(BitMatrix& dst, usize r0, usize r1, usize c0, usize c1) const {
+        if (r1 - r0 > 1 && r1 - r0 >= c1 - c0) {
+            auto rm = r0 + (r1 - r0) / 2;
+            transpose_tiles(dst, r0, rm, c0, c1);
+            transpose_tiles(dst, rm, r1, c0, c1);
+        } else if (c1 - c0 > 1) {
+            auto cm = c0 + (c1 - c0) / 2;
+            transpose_tiles(dst, r0, r1, c0, cm);
+            transpose_tiles(dst, r0, r1, cm, c1);
+        } else if (r0 < r1 && c0 < c1) {
+            tile_type tile;
+            load_tile(r0, c0, tile);
+            transpose_tile(tile);
+            dst.store_tile(c0, r0, tile);
+        }
+    }
+
+    // Returns the number of rows that makes a worthwhile block of row additions to hand to a thread.
+    constexpr usize row_grain() const { return std::max(1uz, 4096 / std::max(m_stride, 1uz)); }
+
+    // Adds (i.e. XOR's) row `src` into row `dst` a word at a time.
+    constexpr void add_row(usize src, usize dst) {
+        auto s = row_data(src);
+        auto d = row_data(dst);
+        if !consteval {
+            details::simd::xor_into(d, s, m_stride);
+            return;
+        }
+        for (auto k = 0uz; k < m_stride; ++k) d[k] ^= s[k];
+    }
+
+    // Adds row `src` into row `dst` starting from word `w0` -- used in elimination where `src` is zero before that word.
+    constexpr void add_row_from(usize src, usize dst, usize w0) {
+        auto s = row_data(src) + w0;
+        auto d = row_data(dst) + w0;
+        if !consteval {
+            details::simd::xor_into(d, s, m_stride - w0);
+            return;
+        }
+        for (auto k = 0uz; k < m_stride - w0; ++k) d[k] ^= s[k];
+    }
+
+    // Returns the `len <= 8` bits of row `i` starting at column `c` packed into the low bits of a `usize`.
+    usize bits_at(usize i, usize c, usize len) const {
+        auto [w, off] = index_and_offset<Word>(c);
+        auto row = row_data(i);
+        auto bits = static_cast<usize>(row[w] >> off);
+        if (off + len > BITS<Word> && w + 1 < m_stride) bits |= static_cast<usize>(row[w + 1]) << (BITS<Word> - off);
+        return bits & ((1uz << len) - 1);
+    }
+
+    // The M4RI elimination engine behind `to_echelon_form`, `to_reduced_echelon_form`, and `rank`.
+    //
+    // We jump to the next pivot column with `find_pivot` and then look for pivots in up to `k` consecutive columns
+    // from there with `find_pivots`. The Gray code table of all the combinations of the pivot rows then clears those
+    // columns in every other row with one row addition each. If `reduce` is set the rows above the pivots are cleared
+    // too which gives the reduced echelon form. If `rank_only` is set we skip the final sweep once the rank is full.
+    template<Executor Exec>
+    BitVector<Word> eliminate(Exec&& exec, bool reduce, bool rank_only) {
+        auto nr = rows();
+        auto nc = cols();
+        auto full = std::min(nr, nc);
+        auto has_pivot = BitVector<Word>::zeros(nc);
+
+        // The table has 2^k slots of a full row each -- we pick k to balance building it against using it.
+        auto k = std::clamp<usize>(3 * static_cast<usize>(std::bit_width(full)) / 4, 1, 8);
+        auto table = std::pmr::vector<Word>((1uz << k) * m_stride, Word{0}, memory_resource());
+
+        // r is the current row of the echelon form. All the rows from r on are zero in the columns before c.
+        auto r = 0uz;
+        auto c = 0uz;
+        while (r < nr) {
+            auto pivot = find_pivot(r, c);
+            if (!pivot) break;
+            c = pivot->second;
+
+            // There is a pivot in column c so we find at least one.
+            auto len = find_pivots(r, c, std::min(k, nc - c));
+            for (auto l = 0uz; l < len; ++l) has_pivot.set(c + l);
+            auto r_end = r + len;
+            if (rank_only && r_end == full) break;
+
+            // The pivot rows are zero before column c so the table entries only need the words from w0 on.
+            // Walk through all 2^len combinations in Gray code order so each entry costs a single row `XOR`.
+            auto w0 = word_index<Word>(c);
+            auto n_words = m_stride - w0;
+            auto prev = 0uz;
+            for (auto i = 1uz; i < (1uz << len); ++i) {
+                auto code = i ^ (i >> 1);
+                auto dst = table.data() + code * m_stride + w0;
+                auto src = row_data(r + static_cast<usize>(std::countr_zero(i))) + w0;
+                std::copy_n(table.data() + prev * m_stride + w0, n_words, dst);
+                details::simd::xor_into(dst, src, n_words);
+                prev = code;
+            }
+
+            // Bit l of the bits of a row in the pivot columns says whether pivot row r + l is needed to clear them.
+            auto sweep = [&, c, len, w0, n_words](usize begin, usize end) {
+                for (auto i = begin; i < end; ++i) {
+                    if (auto code = bits_at(i, c, len); code != 0)
+                        details::simd::xor_into(row_data(i) + w0, table.data() + code * m_stride + w0, n_words);
+                }
+            };
+            details::for_each_chunk(exec, nr - r_end, row_grain(), [&, r_end](usize begin, usize end) {
+                sweep(r_end + begin, r_end + end);
+            });
+            if (reduce) details::for_each_chunk(exec, r, row_grain(), sweep);
+
+            r = r_end;
+            c += len;
+            if (c == nc) break;
+        }
+        return has_pivot;
+    }
+
+    // Looks for pivots in the `k` consecutive columns from `c` in the rows from `r` on, stopping at the first column
+    // without one. Returns the number `len` found. The pivot rows are swapped into rows `[r, r + len)` and reduced
+    // against each other so that they hold the `len x len` identity in those columns. Rows we pass over are cleared
+    // in the columns already pivoted on as we go. This is the only place where we add one pivot row at a time.
+    usize find_pivots(usize r, usize c, usize k) {
+        auto start = r;
+        for (auto j = c; j < c + k; ++j) {
+            auto found = false;
+            for (auto i = start; i < rows(); ++i) {
+                auto bits = bits_at(i, c, j - c + 1);
+                if (bits == 0) continue;
+
+                // Clear the earlier pivot columns in this row -- the pivot rows are the identity in those columns.
+                for (auto l = 0uz; l < j - c; ++l)
+                    if ((bits >> l) & 1) add_row_from(r + l, i, word_index<Word>(c + l));
+
+                // Is there a pivot in column j? If so move it into place & clear column j in the earlier pivot rows.
+                if (get(i, j)) {
+                    swap_rows(i, start);
+                    for (auto l = r; l < start; ++l)
+                        if (get(l, j)) add_row_from(start, l, word_index<Word>(j));
+                    ++start;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) break;
+        }
+        return start - r;
+    }
+
+    // Looks in rows `[r, rows())` for the pivot with the left-most set bit at or after column `j`.
+    // Returns that row & column, or `std::nullopt` if all those rows are zero from column `j` on.
+    // We scan a whole word of columns down the rows at a time so runs of zero columns are skipped quickly.
+    std::optional<std::pair<usize, usize>> find_pivot(usize r, usize j) const {
+        auto nr = rows();
+        auto w0 = word_index<Word>(j);
+        for (auto w = w0; w < words_needed<Word>(cols()); ++w) {
+            auto  lo = w == w0 ? bit_offset<Word>(j) : 0uz;
+            auto  mask = static_cast<Word>(MAX<Word> << lo);
+            auto  best_row = nr;
+            usize best_bit = BITS<Word>;
+            for (auto p = r; p < nr; ++p) {
+                auto word = static_cast<Word>(row_data(p)[w] & mask);
+                if (word == 0) continue;
+                auto bit = static_cast<usize>(std::countr_zero(word));
+                if (bit < best_bit) {
+                    best_row = p;
+                    best_bit = bit;
+                    if (bit == lo) break;
+                }
+            }
+            if (best_row < nr) return std::pair{best_row, w * BITS<Word> + best_bit};
+        }
+        return std::nullopt;
+    }
+
     // Runs a check to see that all the rows in a vector of rows have the same number of columns.
-    constexpr bool check_rows(std::vector<row_type> const& rows) const {
+    static constexpr bool check_rows(std::vector<BitVector<Word>> const& rows) {
         if (rows.empty()) return true;
         auto nc = rows[0].size();
         for (auto i = 1uz; i < rows.size(); ++i) {
@@ -2498,6 +3229,7 @@ private:
     //
     // NOTE: This method panics if the bit-matrix is not square.
     BitVector<Word> danilevsky_step(usize n) {
+        gf2_probe("BitMatrix::danilevsky_step");
         gf2_assert(n <= rows(), "No top-left {} x {} sub-matrix in a matrix with {} rows", n, n, rows());
 
         // Edge case: A 1 x 1 matrix is already in companion form.
@@ -2505,17 +3237,15 @@ private:
 
         // Step k of algorithm attempts to reduce row k to companion form.
         // By construction, rows k+1 or later are already in companion form.
+        // All the work is on rows of the top-left n x n sub-matrix so everything below is done a word at a time.
         auto k = n - 1;
         while (k > 0) {
             // If row k's sub-diagonal is all zeros we look for an earlier column with a 1.
             // If found, we swap that column here & then swap the equivalent rows to preserve similarity.
             if (!get(k, k - 1)) {
-                for (auto j = 0uz; j < k - 1; ++j) {
-                    if (get(k, j)) {
-                        swap_rows(j, k - 1);
-                        swap_cols(j, k - 1);
-                        break;
-                    }
+                if (auto j = row(k).span(0, k - 1).first_set(); j) {
+                    swap_rows(*j, k - 1);
+                    swap_cols(*j, k - 1);
                 }
             }
 
@@ -2524,27 +3254,29 @@ private:
 
             // Still no joy? The sub-diagonal is not all zeros so apply transform to make it so: self <- M^-1 * self *
             // M, where M is the identity matrix with the (k-1)'st row replaced by the k'th row of `self`. We can
-            // sparsely represent M as just a clone of that k'th row of `self`.
-            auto m = m_rows[k];
-
-            // Note the M^-1 is the same as M and self <- M^-1 * self just alters a few of our elements.
-            for (auto j = 0uz; j < n; ++j) set(k - 1, j, dot(m, col(j)));
+            // sparsely represent M as just a copy of the first n elements of that k'th row of `self`.
+            auto m = BitVector<Word>::from(row(k).span(0, n));
+
+            // M^-1 is the same as M, and self <- M * self replaces row k-1 by the sum of the rows picked out by m.
+            // Row k-1 is one of those (m[k-1] = 1) so we just add the others into it.
+            auto r = row(k - 1).span(0, n);
+            for (auto l = m.first_set(); l; l = m.next_set(*l)) {
+                if (*l != k - 1) r ^= row(*l).span(0, n);
+            }
 
-            // We also use the sparsity of M when computing self <- self * M.
+            // Then self <- self * M adds m to every row i < k with a 1 in column k-1, except that column itself is
+            // unchanged (it picks up the m[k-1] = 1 term instead).
+            m.set(k - 1, false);
             for (auto i = 0uz; i < k; ++i) {
-                for (auto j = 0uz; j < n; ++j) {
-                    auto tmp = get(i, k - 1) && m.get(j);
-                    if (j == k - 1) {
-                        set(i, j, tmp);
-                    } else {
-                        set(i, j, get(i, j) ^ tmp);
-                    }
+                if (get(i, k - 1)) {
+                    auto ri = row(i).span(0, n);
+                    ri ^= m;
                 }
             }
 
             // Now put row k into companion form of all zeros with one on the sub-diagonal.
             // All the rows below k are already in companion form.
-            m_rows[k].set_all(false);
+            row(k).set_all(false);
             set(k, k - 1);
 
             // Done with row k
@@ -2554,29 +3286,356 @@ private:
         // At this point, k == 0 OR the bit-matrix has non-removable zero on the sub-diagonal of row k.
         // Either way, the bottom-right (n-k) x (n-k) sub-matrix, starting at self[k][k], is in companion form.
         // We return the top row of that companion sub-matrix.
-        auto top_row = BitVector<Word>::zeros(n - k);
-        for (auto j = 0uz; j < n - k; ++j) top_row.set(j, get(k, k + j));
+        return BitVector<Word>::from(row(k).span(k, n));
+    }
+};
+
+/// Deduction guide so `BitMatrix m = A ^ B;` picks up the word type of the expression.
+template<typename Expr>
+    requires details::LazyBitMatrixExpression<Expr>
+BitMatrix(Expr const&) -> BitMatrix<typename Expr::word_type>;
+
+// --------------------------------------------------------------------------------------------------------------------
+// Lazy bit-matrix expressions ...
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace details {
+
+// Bit-matrices and the lazy expressions built from them can both be operands of the element-wise operators.
+template<typename T>
+struct is_bit_matrix : std::false_type {};
+template<Unsigned Word>
+struct is_bit_matrix<BitMatrix<Word>> : std::true_type {};
+
+template<typename T>
+concept BitMatrixOperand =
+    is_bit_matrix<std::remove_cvref_t<T>>::value || LazyBitMatrixExpression<std::remove_cvref_t<T>>;
+
+template<typename Lhs, typename Rhs>
+concept BitMatrixOperandPair =
+    BitMatrixOperand<Lhs> && BitMatrixOperand<Rhs> &&
+    std::same_as<typename std::remove_cvref_t<Lhs>::word_type, typename std::remove_cvref_t<Rhs>::word_type>;
+
+// Returns word `k` of the row-major buffer of a bit-matrix or of the bit-matrix a lazy expression evaluates to.
+template<typename Operand>
+constexpr auto
+matrix_word(Operand const& operand, usize k) {
+    if constexpr (is_bit_matrix<Operand>::value) {
+        return operand.data()[k];
+    } else {
+        return operand.word(k);
+    }
+}
+
+} // namespace details
+
+/// A lazy bit-matrix expression for the element-wise `XOR`, `AND`, or `OR` of two bit-matrices of the same shape.
+///
+/// This is the return type of `lhs ^ rhs`, `lhs & rhs`, and `lhs | rhs` (and of `lhs + rhs` and `lhs - rhs`) for
+/// bit-matrices. Nothing is computed until the expression is assigned to a bit-matrix, and then the whole chain is
+/// evaluated in one pass over the row-major buffer without any intermediate bit-matrices.
+///
+/// Operands that are lvalues are held by reference so they must outlive the expression. Temporary operands are moved
+/// into the expression.
+///
+/// # Example
+/// ```
+/// auto A = BitMatrix<>::identity(3);
+/// auto B = BitMatrix<>::ones(3, 3);
+/// auto e = (A ^ B) & B;
+/// assert_eq(e.rows(), 3);
+/// BitMatrix m = e;
+/// assert_eq(m.to_compact_binary_string(), "011 101 110");
+/// ```
+template<typename Op, typename Lhs, typename Rhs>
+class BitMatrixBinaryExpr {
+public:
+    /// The expression produces words of this type.
+    using word_type = typename std::remove_cvref_t<Lhs>::word_type;
+
+    /// Constructs the expression from its two operands.
+    ///
+    /// # Panics
+    /// This method panics if the dimensions of the operands do not match.
+    template<typename L, typename R>
+    constexpr BitMatrixBinaryExpr(L&& lhs, R&& rhs) : m_lhs(std::forward<L>(lhs)), m_rhs(std::forward<R>(rhs)) {
+        gf2_assert(m_lhs.rows() == m_rhs.rows(), "Row dimensions do not match: {} != {}.", m_lhs.rows(), m_rhs.rows());
+        gf2_assert(m_lhs.cols() == m_rhs.cols(), "Column dimensions do not match: {} != {}.", m_lhs.cols(),
+                   m_rhs.cols());
+    }
+
+    /// Returns the number of rows in the expression.
+    constexpr usize rows() const { return m_lhs.rows(); }
+
+    /// Returns the number of columns in the expression.
+    constexpr usize cols() const { return m_lhs.cols(); }
+
+    /// Returns the number of words used per row in the row-major buffer of the result.
+    constexpr usize stride() const { return m_lhs.stride(); }
+
+    /// Returns word `k` of the row-major buffer of the result.
+    constexpr word_type word(usize k) const {
+        return Op{}(details::matrix_word(m_lhs, k), details::matrix_word(m_rhs, k));
+    }
+
+    /// Returns a new bit-matrix holding the value of the expression.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrix<>::identity(3);
+    /// auto B = BitMatrix<>::ones(3, 3);
+    /// auto m = (A ^ B).evaluate();
+    /// A.set_all();
+    /// assert_eq(m.to_compact_binary_string(), "011 101 110");
+    /// ```
+    constexpr BitMatrix<word_type> evaluate() const { return BitMatrix<word_type>{*this}; }
+
+    /// Does the expression own a temporary bit-matrix operand whose storage can hold the result?
+    static constexpr bool owns_matrix =
+        std::same_as<Lhs, BitMatrix<word_type>> || std::same_as<Rhs, BitMatrix<word_type>>;
+
+    /// Evaluates the expression into the storage of the temporary bit-matrix operand it owns and returns that operand.
+    ///
+    /// The word-wise operations are all symmetric, so either operand will do.
+    constexpr BitMatrix<word_type> evaluate_in_place() &&
+        requires owns_matrix
+    {
+        if constexpr (std::same_as<Lhs, BitMatrix<word_type>>) {
+            return evaluate_into(std::move(m_lhs), m_rhs);
+        } else {
+            return evaluate_into(std::move(m_rhs), m_lhs);
+        }
+    }
+
+private:
+    Lhs m_lhs;
+    Rhs m_rhs;
+
+    // Folds the other operand into the owned bit-matrix a row at a time (the padding words stay zero).
+    template<typename Other>
+    static constexpr BitMatrix<word_type> evaluate_into(BitMatrix<word_type>&& dst, Other const& other) {
+        auto stride = dst.stride();
+        for (auto i = 0uz; i < dst.rows(); ++i) {
+            auto row = dst.row(i);
+            for (auto w = 0uz; w < row.words(); ++w) {
+                row.set_word(w, Op{}(row.word(w), details::matrix_word(other, i * stride + w)));
+            }
+        }
+        return std::move(dst);
+    }
+};
+
+/// A lazy bit-matrix expression for a bit-matrix with all its elements flipped -- the return type of `~M`.
+///
+/// # Example
+/// ```
+/// auto A = BitMatrix<>::identity(3);
+/// BitMatrix m = ~A;
+/// assert_eq(m.to_compact_binary_string(), "011 101 110");
+/// ```
+template<typename Arg>
+class BitMatrixNotExpr {
+public:
+    /// The expression produces words of this type.
+    using word_type = typename std::remove_cvref_t<Arg>::word_type;
+
+    /// Constructs the expression from its operand.
+    template<typename A>
+    explicit constexpr BitMatrixNotExpr(A&& arg) : m_arg(std::forward<A>(arg)) {
+        auto words = words_needed<word_type>(m_arg.cols());
+        auto tail = m_arg.cols() % BITS<word_type>;
+        m_last = words > 0 ? words - 1 : 0;
+        m_last_mask = tail != 0 ? static_cast<word_type>(MAX<word_type> >> (BITS<word_type> - tail)) : MAX<word_type>;
+    }
+
+    /// Returns the number of rows in the expression.
+    constexpr usize rows() const { return m_arg.rows(); }
+
+    /// Returns the number of columns in the expression.
+    constexpr usize cols() const { return m_arg.cols(); }
+
+    /// Returns the number of words used per row in the row-major buffer of the result.
+    constexpr usize stride() const { return m_arg.stride(); }
 
-        // Done
-        return top_row;
+    /// Returns word `k` of the row-major buffer of the result (the padding bits in each row stay unset).
+    constexpr word_type word(usize k) const {
+        auto w = k % stride();
+        if (w > m_last) return 0;
+        auto result = static_cast<word_type>(~details::matrix_word(m_arg, k));
+        return w == m_last ? static_cast<word_type>(result & m_last_mask) : result;
     }
+
+    /// Returns a new bit-matrix holding the value of the expression.
+    constexpr BitMatrix<word_type> evaluate() const { return BitMatrix<word_type>{*this}; }
+
+private:
+    Arg       m_arg;
+    usize     m_last;
+    word_type m_last_mask;
 };
 
+/// Returns a lazy expression for the element-wise `XOR` of two bit-matrices (or bit-matrix expressions).
+///
+/// # Panics
+/// This method panics if the dimensions do not match.
+///
+/// # Example
+/// ```
+/// auto lhs = BitMatrix<>::identity(3);
+/// auto rhs = BitMatrix<>::identity(3);
+/// rhs.flip_all();
+/// BitMatrix result = lhs ^ rhs;
+/// assert_eq(result.to_compact_binary_string(), "111 111 111");
+/// ```
+template<typename Lhs, typename Rhs>
+    requires details::BitMatrixOperandPair<Lhs, Rhs>
+constexpr auto
+operator^(Lhs&& lhs, Rhs&& rhs) {
+    using expr_type = BitMatrixBinaryExpr<details::XorWords, details::expr_operand<Lhs>, details::expr_operand<Rhs>>;
+    return expr_type{std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+
+/// Returns a lazy expression for the element-wise `AND` of two bit-matrices (or bit-matrix expressions).
+///
+/// # Panics
+/// This method panics if the dimensions do not match.
+///
+/// # Example
+/// ```
+/// auto lhs = BitMatrix<>::identity(3);
+/// auto rhs = BitMatrix<>::identity(3);
+/// rhs.flip_all();
+/// BitMatrix result = lhs & rhs;
+/// assert_eq(result.to_compact_binary_string(), "000 000 000");
+/// ```
+template<typename Lhs, typename Rhs>
+    requires details::BitMatrixOperandPair<Lhs, Rhs>
+constexpr auto
+operator&(Lhs&& lhs, Rhs&& rhs) {
+    using expr_type = BitMatrixBinaryExpr<details::AndWords, details::expr_operand<Lhs>, details::expr_operand<Rhs>>;
+    return expr_type{std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+
+/// Returns a lazy expression for the element-wise `OR` of two bit-matrices (or bit-matrix expressions).
+///
+/// # Panics
+/// This method panics if the dimensions do not match.
+///
+/// # Example
+/// ```
+/// auto lhs = BitMatrix<>::identity(3);
+/// auto rhs = BitMatrix<>::identity(3);
+/// rhs.flip_all();
+/// BitMatrix result = lhs | rhs;
+/// assert_eq(result.to_compact_binary_string(), "111 111 111");
+/// ```
+template<typename Lhs, typename Rhs>
+    requires details::BitMatrixOperandPair<Lhs, Rhs>
+constexpr auto
+operator|(Lhs&& lhs, Rhs&& rhs) {
+    using expr_type = BitMatrixBinaryExpr<details::OrWords, details::expr_operand<Lhs>, details::expr_operand<Rhs>>;
+    return expr_type{std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+
+/// Returns a lazy expression for a bit-matrix (or bit-matrix expression) with all its elements flipped.
+///
+/// # Example
+/// ```
+/// auto m = BitMatrix<>::identity(3);
+/// BitMatrix result = ~m;
+/// assert_eq(result.to_compact_binary_string(), "011 101 110");
+/// ```
+template<typename Arg>
+    requires details::BitMatrixOperand<Arg>
+constexpr auto
+operator~(Arg&& arg) {
+    return BitMatrixNotExpr<details::expr_operand<Arg>>{std::forward<Arg>(arg)};
+}
+
+/// Returns a lazy expression for the sum of two bit-matrices which is their `XOR` in GF(2).
+///
+/// # Panics
+/// This method panics if the dimensions do not match.
+///
+/// # Example
+/// ```
+/// auto lhs = BitMatrix<>::identity(3);
+/// auto rhs = BitMatrix<>::identity(3);
+/// rhs.flip_all();
+/// BitMatrix result = lhs + rhs;
+/// assert_eq(result.to_compact_binary_string(), "111 111 111");
+/// ```
+template<typename Lhs, typename Rhs>
+    requires details::BitMatrixOperandPair<Lhs, Rhs>
+constexpr auto
+operator+(Lhs&& lhs, Rhs&& rhs) {
+    return std::forward<Lhs>(lhs) ^ std::forward<Rhs>(rhs);
+}
+
+/// Returns a lazy expression for the difference of two bit-matrices which is their `XOR` in GF(2).
+///
+/// # Panics
+/// This method panics if the dimensions do not match.
+///
+/// # Example
+/// ```
+/// auto lhs = BitMatrix<>::identity(3);
+/// auto rhs = BitMatrix<>::identity(3);
+/// rhs.flip_all();
+/// BitMatrix result = lhs - rhs;
+/// assert_eq(result.to_compact_binary_string(), "111 111 111");
+/// ```
+template<typename Lhs, typename Rhs>
+    requires details::BitMatrixOperandPair<Lhs, Rhs>
+constexpr auto
+operator-(Lhs&& lhs, Rhs&& rhs) {
+    return std::forward<Lhs>(lhs) ^ std::forward<Rhs>(rhs);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // Matrix multiplication ...
 // -------------------------------------------------------------------------------------------------------------------
 
-/// Bit-matrix, bit-store multiplication, `M * v`, returning a new bit-vector.
+/// Bit-matrix, bit-store multiplication, `M * v`, into the bit-vector `dst`, resizing it as needed.
+///
+/// This reuses the words that `dst` already has, so repeated products into the same destination do not allocate.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible or if `dst` is `v`.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<u8>::random(300, 200);
+/// auto v = BitVector<u8>::random(200);
+/// auto dst = BitVector<u8>::zeros(300);
+/// auto words = dst.store();
+/// dot(M, v, dst);
+/// assert_eq(dst, dot(M, v));
+/// assert(dst.store() == words);
+/// ```
 template<Unsigned Word, BitStore Rhs>
     requires std::same_as<typename Rhs::word_type, Word>
-constexpr auto
-dot(BitMatrix<Word> const& lhs, Rhs const& rhs) {
+constexpr void
+dot(BitMatrix<Word> const& lhs, Rhs const& rhs, BitVector<Word>& dst) {
     gf2_assert_eq(lhs.cols(), rhs.size(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.size());
+    if constexpr (std::same_as<Rhs, BitVector<Word>>) {
+        gf2_assert(&rhs != &dst, "The destination of `M * v` must not be `v`.");
+    }
     auto n_rows = lhs.rows();
-    auto result = BitVector<Word>::zeros(n_rows);
+    dst.resize(n_rows);
+    dst.set_all(false);
     for (auto i = 0uz; i < n_rows; ++i) {
-        if (dot(lhs.row(i), rhs)) result.set(i, true);
+        if (dot(lhs.row(i), rhs)) dst.set(i, true);
     }
+}
+
+/// Bit-matrix, bit-store multiplication, `M * v`, returning a new bit-vector.
+template<Unsigned Word, BitStore Rhs>
+    requires std::same_as<typename Rhs::word_type, Word>
+constexpr auto
+dot(BitMatrix<Word> const& lhs, Rhs const& rhs) {
+    BitVector<Word> result;
+    dot(lhs, rhs, result);
     return result;
 }
 
@@ -2590,23 +3649,55 @@ operator*(BitMatrix<Word> const& lhs, Rhs const& rhs) {
 
 /// `Bit-vector, bit-matrix multiplication, `v * M`, returning a new bit-vector.
 ///
-/// **Note:** We store bit-matrices by rows so `dot(BitMatrix, BitVector)` will always be faster than this.
+/// In GF(2), `v * M` is just the sum of the rows of `M` picked out by the set bits of `v`. So we add whole rows into
+/// the result a word at a time and never extract a column. The cost is one row addition per set bit in `v`, which
+/// makes this about as fast as `M * v` for a dense `v` and much faster for a sparse one.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<u8>::random(100, 37);
+/// auto v = BitVector<u8>::random(100);
+/// assert_eq(dot(v, M), dot(M.transposed(), v));
+/// assert_eq(dot(BitVector<u8>::zeros(100), M), BitVector<u8>::zeros(37));
+/// ```
 template<Unsigned Word, BitStore Lhs>
     requires std::same_as<typename Lhs::word_type, Word>
 constexpr auto
 dot(Lhs const& lhs, BitMatrix<Word> const& rhs) {
+    BitVector<Word> result;
+    dot(lhs, rhs, result);
+    return result;
+}
+
+/// Bit-vector, bit-matrix multiplication, `v * M`, into the bit-vector `dst`, resizing it as needed.
+///
+/// This reuses the words that `dst` already has, so repeated products into the same destination do not allocate.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible or if `dst` is `v`.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<u8>::random(100, 300);
+/// auto v = BitVector<u8>::random(100);
+/// BitVector<u8> dst;
+/// dot(v, M, dst);
+/// assert_eq(dst, dot(M.transposed(), v));
+/// ```
+template<Unsigned Word, BitStore Lhs>
+    requires std::same_as<typename Lhs::word_type, Word>
+constexpr void
+dot(Lhs const& lhs, BitMatrix<Word> const& rhs, BitVector<Word>& dst) {
     gf2_assert_eq(lhs.size(), rhs.rows(), "Incompatible dimensions: {} != {}", lhs.size(), rhs.rows());
-    auto n_cols = rhs.cols();
-    auto result = BitVector<Word>::zeros(n_cols);
-    for (auto j = 0uz; j < n_cols; ++j) {
-        if (dot(lhs, rhs.col(j))) result.set(j, true);
+    if constexpr (std::same_as<Lhs, BitVector<Word>>) {
+        gf2_assert(&lhs != &dst, "The destination of `v * M` must not be `v`.");
     }
-    return result;
+    dst.resize(rhs.cols());
+    dst.set_all(false);
+    for_each_set_bit(lhs, [&](usize i) { dst ^= rhs.row(i); });
 }
 
 /// Operator form for bit-vector, bit-matrix multiplication, `v * M`, returning a new bit-vector.
-///
-/// **Note:** We store bit-matrices by rows so `dot(BitMatrix, BitVector)` will always be faster than this.
 template<Unsigned Word, BitStore Lhs>
     requires std::same_as<typename Lhs::word_type, Word>
 constexpr auto
@@ -2614,23 +3705,286 @@ operator*(Lhs const& lhs, BitMatrix<Word> const& rhs) {
     return dot(lhs, rhs);
 }
 
-/// Bit-matrix, bit-matrix multiplication, `M * N`, returning a new bit-matrix.
+/// Bit-matrices whose dimensions are all at least this size are multiplied using the "Method of Four Russians".
+///
+/// Below this size the overhead of building the lookup tables in `gf2::m4rm_dot` outweighs the savings and it is
+/// quicker to add one row of the right-hand matrix for each set bit of the left-hand matrix.
+inline constexpr usize M4RM_THRESHOLD = 256;
+
+/// Bit-matrix, bit-matrix multiplication, `M * N`, using the "Method of Four Russians" (M4RM).
+///
+/// The rows of `rhs` are taken in blocks of up to eight at a time. For each block we use a Gray code to build a
+/// table holding all the possible `XOR` combinations of those rows, one row `XOR` per table entry. The matching bits
+/// in each row of `lhs` then index straight into that table and the selected entry is added to the result row.
+/// All the work is therefore done by whole-word row additions instead of individual row-column dot products.
+///
+/// `gf2::dot(BitMatrix, BitMatrix)` calls here automatically for matrices that are large enough to benefit.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible.
+///
+/// # Example
+/// ```
+/// auto A = BitMatrix<u8>::random(50, 40);
+/// auto B = BitMatrix<u8>::random(40, 30);
+/// assert_eq(m4rm_dot(A, B), dot(A, B));
+/// auto M = BitMatrix<>::random(200, 200);
+/// auto v = BitVector<>::random(200);
+/// assert_eq(dot(m4rm_dot(M, M), v), dot(M, dot(M, v)));
+/// auto I = BitMatrix<>::identity(200);
+/// assert_eq(m4rm_dot(M, I), M);
+/// assert_eq(m4rm_dot(I, M), M);
+/// ```
 template<Unsigned Word>
 constexpr auto
-dot(BitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs) {
+m4rm_dot(BitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs) {
+    BitMatrix<Word> result;
+    m4rm_dot(lhs, rhs, result);
+    return result;
+}
+
+namespace details {
+
+// Returns this thread's scratch buffer for the Gray code tables of `gf2::m4rm_dot`, grown to at least `n` words.
+// The buffer only ever grows and it comes from the global heap as it outlives any `MemoryScope`.
+template<Unsigned Word>
+inline std::vector<Word>&
+m4rm_scratch(usize n) {
+    static thread_local std::vector<Word> scratch;
+    if (scratch.size() < n) scratch.resize(n);
+    return scratch;
+}
+
+} // namespace details
+
+/// Bit-matrix, bit-matrix multiplication, `M * N`, using the "Method of Four Russians" into the bit-matrix `dst`.
+///
+/// The product reuses the storage that `dst` already has and the table lives in a per-thread buffer that is kept
+/// between calls, so repeated products of the same size do not allocate.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible or if `dst` is one of the factors.
+///
+/// # Example
+/// ```
+/// auto A = BitMatrix<u8>::random(300, 280);
+/// auto B = BitMatrix<u8>::random(280, 260);
+/// BitMatrix<u8> dst;
+/// m4rm_dot(A, B, dst);
+/// assert_eq(dst, dot(A.transposed().transposed(), B));
+/// auto data = dst.data();
+/// m4rm_dot(B.transposed(), A.transposed(), dst);
+/// assert_eq(dst, dot(A, B).transposed());
+/// m4rm_dot(A, B, dst);
+/// assert(dst.data() == data);
+/// ```
+template<Unsigned Word>
+constexpr void
+m4rm_dot(BitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs, BitMatrix<Word>& dst) {
+    gf2_probe("gf2::m4rm_dot");
     gf2_assert_eq(lhs.cols(), rhs.rows(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.rows());
+    gf2_assert(&dst != &lhs && &dst != &rhs, "The destination of a product must not be one of its factors.");
 
     auto n_rows = lhs.rows();
+    auto n_inner = lhs.cols();
     auto n_cols = rhs.cols();
-    auto result = BitMatrix<Word>::zeros(n_rows, n_cols);
+    dst.resize(n_rows, n_cols);
+    dst.set_all(false);
+    if (dst.is_empty() || n_inner == 0) return;
+
+    // We work with blocks of k rows from `rhs` which needs a table with 2^k entries of a full row each. The rows of
+    // `rhs` and `dst` have the same number of columns so they have the same stride.
+    constexpr auto bits_per_word = BITS<Word>;
+    constexpr auto k = std::min<usize>(8, bits_per_word);
+    auto           stride = dst.stride();
+    auto&          table = details::m4rm_scratch<Word>((1uz << k) * stride);
+    std::fill_n(table.data(), stride, Word{0});
+
+    // Little lambda that extracts `len` bits from `row` starting at bit `begin` where we know that `len <= k`.
+    auto bits_at = [&](auto const& row, usize begin, usize len) -> usize {
+        auto [w, off] = index_and_offset<Word>(begin);
+        auto bits = static_cast<usize>(row.word(w) >> off);
+        if (off + len > bits_per_word && w + 1 < row.words())
+            bits |= static_cast<usize>(row.word(w + 1)) << (bits_per_word - off);
+        return bits & ((1uz << len) - 1);
+    };
+
+    for (auto block = 0uz; block < n_inner; block += k) {
+        auto len = std::min(k, n_inner - block);
+
+        // Walk through all 2^len combinations of the block rows in Gray code order.
+        // Each successive code differs in one bit so each table entry costs a single row `XOR`.
+        auto prev = 0uz;
+        for (auto i = 1uz; i < (1uz << len); ++i) {
+            auto code = i ^ (i >> 1);
+            auto entry = table.data() + code * stride;
+            std::copy_n(table.data() + prev * stride, stride, entry);
+            details::simd::xor_into(entry, rhs.data() + (block + static_cast<usize>(std::countr_zero(i))) * stride,
+                                    stride);
+            prev = code;
+        }
 
-    // Row access is cheap, columns expensive, so arrange things to pull out columns as few times as possible.
-    for (auto j = 0uz; j < n_cols; ++j) {
-        auto rhs_col = rhs.col(j);
+        // The bits in each `lhs` row for this block pick out the table entry to add into the matching `dst` row.
         for (auto i = 0uz; i < n_rows; ++i) {
-            if (dot(lhs.row(i), rhs_col)) result.set(i, j, true);
+            if (auto code = bits_at(lhs.row(i), block, len); code != 0)
+                details::simd::xor_into(dst.row(i).store(), table.data() + code * stride, stride);
         }
     }
+}
+
+/// Bit-matrices whose dimensions are all at least this size are multiplied using `gf2::strassen_dot`.
+///
+/// This is also the default size below which `gf2::strassen_dot` stops recursing and switches to a base kernel.
+inline constexpr usize STRASSEN_THRESHOLD = 2048;
+
+/// Bit-matrix, bit-matrix multiplication, `M * N`, using the recursive Strassen-Winograd algorithm.
+///
+/// The matrices are split into 2 x 2 blocks and the product is formed from just seven half-size block products at the
+/// cost of fifteen block additions. In GF(2) those additions are just `XOR`'s so they are very cheap.
+/// Odd dimensions are handled by padding with a zero row or column as needed.
+///
+/// The recursion stops once any dimension is at most `cutoff` and those products are computed by `gf2::m4rm_dot` or,
+/// for really small blocks, by the default `gf2::dot`.
+///
+/// `gf2::dot(BitMatrix, BitMatrix)` calls here automatically for matrices that are large enough to benefit.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible.
+///
+/// # Example
+/// ```
+/// auto A = BitMatrix<u8>::random(50, 37);
+/// auto B = BitMatrix<u8>::random(37, 29);
+/// assert_eq(strassen_dot(A, B, 4), dot(A, B));
+/// auto M = BitMatrix<>::random(300, 300);
+/// auto v = BitVector<>::random(300);
+/// assert_eq(dot(strassen_dot(M, M, 70), v), dot(M, dot(M, v)));
+/// ```
+template<Unsigned Word>
+constexpr BitMatrix<Word>
+strassen_dot(BitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs, usize cutoff = STRASSEN_THRESHOLD) {
+    gf2_probe("gf2::strassen_dot");
+    gf2_assert_eq(lhs.cols(), rhs.rows(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.rows());
+
+    auto m = lhs.rows();
+    auto k = lhs.cols();
+    auto n = rhs.cols();
+
+    // Small enough to pass to one of the base kernels?
+    auto n_min = std::min({m, k, n});
+    if (n_min <= std::max(cutoff, 1uz)) return n_min >= M4RM_THRESHOLD ? m4rm_dot(lhs, rhs) : dot(lhs, rhs);
+
+    // Odd dimensions? Pad with zeros, recurse, and then trim the result back down to size.
+    if (m % 2 != 0 || k % 2 != 0 || n % 2 != 0) {
+        auto A = lhs;
+        auto B = rhs;
+        A.resize(m + m % 2, k + k % 2);
+        B.resize(k + k % 2, n + n % 2);
+        return strassen_dot(A, B, cutoff).sub_matrix(0, m, 0, n);
+    }
+
+    // Split both matrices into 2 x 2 blocks.
+    auto mh = m / 2, kh = k / 2, nh = n / 2;
+    auto A11 = lhs.sub_matrix(0, mh, 0, kh), A12 = lhs.sub_matrix(0, mh, kh, k);
+    auto A21 = lhs.sub_matrix(mh, m, 0, kh), A22 = lhs.sub_matrix(mh, m, kh, k);
+    auto B11 = rhs.sub_matrix(0, kh, 0, nh), B12 = rhs.sub_matrix(0, kh, nh, n);
+    auto B21 = rhs.sub_matrix(kh, k, 0, nh), B22 = rhs.sub_matrix(kh, k, nh, n);
+
+    // Winograd's form of the algorithm (all additions & subtractions are XOR's in GF(2)).
+    BitMatrix<Word> S1 = A21 + A22;
+    BitMatrix<Word> S2 = S1 + A11;
+    BitMatrix<Word> S3 = A11 + A21;
+    BitMatrix<Word> S4 = A12 + S2;
+    BitMatrix<Word> T1 = B12 + B11;
+    BitMatrix<Word> T2 = B22 + T1;
+    BitMatrix<Word> T3 = B22 + B12;
+    BitMatrix<Word> T4 = T2 + B21;
+
+    // The seven recursive products.
+    auto P1 = strassen_dot(A11, B11, cutoff);
+    auto P2 = strassen_dot(A12, B21, cutoff);
+    auto P3 = strassen_dot(S4, B22, cutoff);
+    auto P4 = strassen_dot(A22, T4, cutoff);
+    auto P5 = strassen_dot(S1, T1, cutoff);
+    auto P6 = strassen_dot(S2, T2, cutoff);
+    auto P7 = strassen_dot(S3, T3, cutoff);
+
+    // Assemble the result blocks in-place to limit the number of temporaries.
+    BitMatrix<Word> C11 = P1 + P2;
+    P1 += P6; // U2
+    P7 += P1; // U3
+    P1 += P5; // U4
+    P1 += P3; // U5 = C12
+    P5 += P7; // U7 = C22
+    P7 += P4; // U6 = C21
+
+    auto result = BitMatrix<Word>::zeros(m, n);
+    result.replace_sub_matrix(0, 0, C11);
+    result.replace_sub_matrix(0, nh, P1);
+    result.replace_sub_matrix(mh, 0, P7);
+    result.replace_sub_matrix(mh, nh, P5);
+    return result;
+}
+
+/// Bit-matrix, bit-matrix multiplication, `M * N`, into the bit-matrix `dst`, resizing it as needed.
+///
+/// This reuses the storage that `dst` already has, so a loop of products of the same size, like the squarings in
+/// `BitMatrix::to_the`, stops allocating after its first step. The products that go to the recursive
+/// `gf2::strassen_dot` still need temporaries for the blocks and are moved into `dst`.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible or if `dst` is one of the factors.
+///
+/// # Example
+/// ```
+/// auto A = BitMatrix<u8>::random(30, 20);
+/// auto B = BitMatrix<u8>::random(20, 10);
+/// auto dst = BitMatrix<u8>::ones(30, 10);
+/// auto data = dst.data();
+/// dot(A, B, dst);
+/// assert_eq(dst, dot(A, B));
+/// assert(dst.data() == data);
+/// ```
+template<Unsigned Word>
+constexpr void
+dot(BitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs, BitMatrix<Word>& dst) {
+    gf2_probe("gf2::dot");
+    gf2_assert_eq(lhs.cols(), rhs.rows(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.rows());
+    gf2_assert(&dst != &lhs && &dst != &rhs, "The destination of a product must not be one of its factors.");
+
+    auto n_rows = lhs.rows();
+    auto n_cols = rhs.cols();
+
+    // Big enough to make Strassen's recursion or the table building in M4RM worthwhile?
+    auto n_min = std::min({n_rows, lhs.cols(), n_cols});
+    if (n_min >= STRASSEN_THRESHOLD) {
+        dst = strassen_dot(lhs, rhs);
+        return;
+    }
+    if (n_min >= M4RM_THRESHOLD) {
+        m4rm_dot(lhs, rhs, dst);
+        return;
+    }
+
+    dst.resize(n_rows, n_cols);
+    dst.set_all(false);
+
+    // Row i of the product is row i of `lhs` times `rhs` which is the sum of the rows of `rhs` picked out by its set bits.
+    for (auto i = 0uz; i < n_rows; ++i) {
+        auto row = dst.row(i);
+        lhs.row(i).for_each_set_bit([&](usize k) { row ^= rhs.row(k); });
+    }
+}
+
+/// Bit-matrix, bit-matrix multiplication, `M * N`, returning a new bit-matrix.
+///
+/// Large products are passed to the "Method of Four Russians" in `gf2::m4rm_dot` and really large ones to the
+/// recursive `gf2::strassen_dot`.
+template<Unsigned Word>
+constexpr auto
+dot(BitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs) {
+    BitMatrix<Word> result;
+    dot(lhs, rhs, result);
     return result;
 }
 
@@ -2641,6 +3995,332 @@ operator*(BitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs) {
     return dot(lhs, rhs);
 }
 
+/// Bit-matrix, bit-store multiplication, `M * v`, computed using the given executor.
+///
+/// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The rows of `M` are handed out to its threads in
+/// blocks that line up with the words of the result.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<u8>::random(1000, 300);
+/// auto v = BitVector<u8>::random(300);
+/// ThreadPool pool{4};
+/// assert_eq(dot(pool, M, v), dot(M, v));
+/// assert_eq(dot(par, M, v), dot(M, v));
+/// ```
+template<Executor Exec, Unsigned Word, BitStore Rhs>
+    requires std::same_as<typename Rhs::word_type, Word>
+auto
+dot(Exec&& exec, BitMatrix<Word> const& lhs, Rhs const& rhs) {
+    gf2_assert_eq(lhs.cols(), rhs.size(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.size());
+    auto n_rows = lhs.rows();
+    auto result = BitVector<Word>::zeros(n_rows);
+
+    // The blocks are a whole number of words long so no two threads ever write to the same word of `result`.
+    auto words_per_row = std::max(1uz, words_needed<Word>(lhs.cols()));
+    auto grain = std::max(1uz, 4096 / words_per_row / BITS<Word>) * BITS<Word>;
+    details::for_each_chunk(exec, n_rows, grain, [&](usize begin, usize end) {
+        for (auto i = begin; i < end; ++i) {
+            if (dot(lhs.row(i), rhs)) result.set(i, true);
+        }
+    });
+    return result;
+}
+
+/// Bit-matrix, bit-matrix multiplication, `M * N`, computed using the given executor.
+///
+/// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The product is split into a grid of blocks with at
+/// least as many blocks as there are threads. Each block is a whole number of words wide and is computed by `gf2::dot`
+/// on the matching rows of `M` and columns of `N`. We split by columns first as each block then builds its own much
+/// smaller "Four Russians" lookup tables.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible.
+///
+/// # Example
+/// ```
+/// auto A = BitMatrix<u8>::random(300, 200);
+/// auto B = BitMatrix<u8>::random(200, 250);
+/// ThreadPool pool{4};
+/// assert_eq(dot(pool, A, B), dot(A, B));
+/// assert_eq(dot(par, A, B), dot(A, B));
+/// assert_eq(dot(seq, A, B), dot(A, B));
+/// ```
+template<Executor Exec, Unsigned Word>
+auto
+dot(Exec&& exec, BitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs) {
+    gf2_assert_eq(lhs.cols(), rhs.rows(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.rows());
+
+    // Small products or only one thread? Then there is no point splitting things up.
+    auto n_rows = lhs.rows();
+    auto n_inner = lhs.cols();
+    auto n_cols = rhs.cols();
+    auto n_threads = details::concurrency(exec);
+    if (n_threads < 2 || std::min({n_rows, n_inner, n_cols}) < M4RM_THRESHOLD) return dot(lhs, rhs);
+
+    // Split the columns into strips of whole words and the rows into enough blocks to keep all the threads busy.
+    auto n_words = words_needed<Word>(n_cols);
+    auto n_strips = std::min(n_threads, n_words);
+    auto strip_words = (n_words + n_strips - 1) / n_strips;
+    n_strips = (n_words + strip_words - 1) / strip_words;
+    auto n_blocks = std::min((n_threads + n_strips - 1) / n_strips, n_rows);
+    auto block_rows = (n_rows + n_blocks - 1) / n_blocks;
+    n_blocks = (n_rows + block_rows - 1) / block_rows;
+
+    // Each thread computes whole blocks of the product which we then copy into place.
+    auto blocks = std::pmr::vector<BitMatrix<Word>>(n_blocks * n_strips, memory_resource());
+    details::for_each_chunk(exec, blocks.size(), 1, [&](usize begin, usize end) {
+        for (auto b = begin; b < end; ++b) {
+            auto r0 = (b / n_strips) * block_rows;
+            auto c0 = (b % n_strips) * strip_words * BITS<Word>;
+            auto r1 = std::min(r0 + block_rows, n_rows);
+            auto c1 = std::min(c0 + strip_words * BITS<Word>, n_cols);
+            blocks[b] = dot(lhs.sub_matrix(r0, r1, 0, n_inner), rhs.sub_matrix(0, n_inner, c0, c1));
+        }
+    });
+
+    auto result = BitMatrix<Word>::zeros(n_rows, n_cols);
+    for (auto b = 0uz; b < blocks.size(); ++b)
+        result.replace_sub_matrix((b / n_strips) * block_rows, (b % n_strips) * strip_words * BITS<Word>, blocks[b]);
+    return result;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Applying powers of a bit-matrix to bit-vectors ...
+// -------------------------------------------------------------------------------------------------------------------
+
+namespace details {
+
+// Returns r(x) := x^e mod c(x) where e = n or 2^n and c(x) is the characteristic polynomial of the square matrix M.
+// Small exponents e <= M.rows() are returned as x^e as the n matrix-vector products are then cheaper than c(x).
+template<Unsigned Word>
+BitPolynomial<Word>
+power_polynomial(BitMatrix<Word> const& M, usize n, bool n_is_log2) {
+    gf2_assert(M.is_square(), "Bit-matrix is {} x {} but it should be square!", M.rows(), M.cols());
+    if (n_is_log2 && n < BITS<usize> && (1uz << n) <= M.rows()) return power_polynomial(M, 1uz << n, false);
+    if (!n_is_log2 && n <= M.rows()) return BitPolynomial<Word>::x_to_the(n);
+    return M.characteristic_polynomial().reduce_x_to_the(n, n_is_log2);
+}
+
+} // namespace details
+
+/// Returns the bit-vector `M^e v` for a square bit-matrix `M` where `e = n` or `e = 2^n` depending on `n_is_log2`.
+///
+/// This never forms the bit-matrix `M^e`. By the Cayley-Hamilton theorem `M^e = r(M)` where `r(x) = x^e mod c(x)` for
+/// the characteristic polynomial `c(x)` of `M`, so `M^e v = r(M) v`, which `BitPolynomial::apply` computes with fewer
+/// than `n` matrix-vector products. An `n x n` matrix then costs `O(n^3)` for `c(x)` plus `O(n^2)` per product, where
+/// `M.to_the(e) * v` needs `O(log e)` full matrix products. That makes big jumps ahead for linear recurrences cheap.
+///
+/// If you already know a polynomial that annihilates `M` or `v`, such as the minimal polynomial `P(x)` of an LFSR, then
+/// `P.reduce_x_to_the(e).apply(M, v)` skips the characteristic polynomial.
+///
+/// # Panics
+/// This method panics if the matrix is not square or if its size does not match the size of `v`.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<>::random(50, 50);
+/// auto v = BitVector<>::random(50);
+/// assert_eq(power_apply(M, 0, v), v);
+/// assert_eq(power_apply(M, 7, v), M.to_the(7) * v);
+/// assert_eq(power_apply(M, 123'456'789, v), M.to_the(123'456'789) * v);
+/// assert_eq(power_apply(M, 100, v, true), M.to_the(100, true) * v);
+/// ```
+template<Unsigned Word, BitStore Rhs>
+    requires std::same_as<typename Rhs::word_type, Word>
+auto
+power_apply(BitMatrix<Word> const& M, usize n, Rhs const& v, bool n_is_log2 = false) {
+    return details::power_polynomial(M, n, n_is_log2).apply(M, v);
+}
+
+/// Returns the bit-matrix `M^e V` for a square bit-matrix `M` where `e = n` or `e = 2^n` depending on `n_is_log2`.
+///
+/// This is the batched form of `power_apply` for the vectors in the columns of `V`. The characteristic polynomial
+/// of `M` and the reduction of `x^e` are shared by them all.
+///
+/// # Panics
+/// This method panics if the matrix is not square or if its size does not match the number of rows of `V`.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<>::random(50, 50);
+/// auto V = BitMatrix<>::random(50, 20);
+/// assert_eq(power_apply(M, 3, V), M * M * M * V);
+/// assert_eq(power_apply(M, 1'000'000, V), M.to_the(1'000'000) * V);
+/// assert_eq(power_apply(M, 1'000'000, V).col(5), power_apply(M, 1'000'000, V.col(5)));
+/// ```
+template<Unsigned Word>
+auto
+power_apply(BitMatrix<Word> const& M, usize n, BitMatrix<Word> const& V, bool n_is_log2 = false) {
+    return details::power_polynomial(M, n, n_is_log2).apply(M, V);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Hamming distances from a query to the rows of a bit-matrix ...
+// -------------------------------------------------------------------------------------------------------------------
+
+namespace details {
+
+// Returns a block of rows of `M` worth handing to a thread for a scan against a query.
+template<Executor Exec, Unsigned Word>
+usize
+scan_grain(Exec const& exec, BitMatrix<Word> const& M) {
+    auto n_blocks = 4 * concurrency(exec);
+    return std::max((M.rows() + n_blocks - 1) / n_blocks, 4096 / std::max(M.stride(), 1uz));
+}
+
+// Pushes the (distance, row) pairs for rows `[begin, end)` of `M` that are among the `k` nearest to `q` and at most
+// `max_distance` away onto the max-heap `best`. Rows are visited in order so a later row only displaces the worst
+// candidate if it is strictly nearer, and its distance scan can give up as soon as it is not.
+template<Unsigned Word, BitStore Query>
+void
+nearest_rows(Query const& q, BitMatrix<Word> const& M, usize begin, usize end, usize k, usize max_distance,
+             std::vector<std::pair<usize, usize>>& best) {
+    for (auto i = begin; i < end; ++i) {
+        auto limit = max_distance;
+        if (best.size() == k) {
+            if (best.front().first == 0) return;
+            limit = best.front().first - 1;
+        }
+        auto d = details::hamming_distance(q, M.row(i), limit);
+        if (d > limit) continue;
+        if (best.size() == k) {
+            std::ranges::pop_heap(best);
+            best.pop_back();
+        }
+        best.emplace_back(d, i);
+        std::ranges::push_heap(best);
+    }
+}
+
+} // namespace details
+
+/// Returns the Hamming distances from the bit-store `q` to each row of the bit-matrix `M`.
+///
+/// Element `i` of the result is `hamming_distance(q, M.row(i))`. The rows of a bit-matrix are contiguous runs of
+/// words that start on word boundaries, so each one is a single pass of the fused XOR-popcount kernel.
+///
+/// # Panics
+/// This method panics if the size of `q` does not match the number of columns of `M`.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<>::random(100, 300);
+/// auto q = BitVector<>::random(300);
+/// auto d = distances(q, M);
+/// assert_eq(d.size(), 100);
+/// for (auto i = 0uz; i < M.rows(); ++i) assert_eq(d[i], count_ones(q ^ M.row(i)));
+/// ```
+template<Unsigned Word, BitStore Query>
+    requires std::same_as<typename Query::word_type, Word>
+std::vector<usize>
+distances(Query const& q, BitMatrix<Word> const& M) {
+    return distances(seq, q, M);
+}
+
+/// Returns the Hamming distances from the bit-store `q` to each row of the bit-matrix `M` using an executor.
+///
+/// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The rows are handed out to its threads in
+/// contiguous blocks.
+///
+/// # Panics
+/// This method panics if the size of `q` does not match the number of columns of `M`.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<>::random(5000, 200);
+/// auto q = BitVector<>::random(200);
+/// ThreadPool pool{4};
+/// assert_eq(distances(pool, q, M), distances(q, M));
+/// ```
+template<Executor Exec, Unsigned Word, BitStore Query>
+    requires std::same_as<typename Query::word_type, Word>
+std::vector<usize>
+distances(Exec&& exec, Query const& q, BitMatrix<Word> const& M) {
+    gf2_assert_eq(q.size(), M.cols(), "Query has {} elements but the matrix has {} columns.", q.size(), M.cols());
+    std::vector<usize> result(M.rows());
+    details::for_each_chunk(exec, M.rows(), details::scan_grain(exec, M), [&](usize begin, usize end) {
+        for (auto i = begin; i < end; ++i) result[i] = hamming_distance(q, M.row(i));
+    });
+    return result;
+}
+
+/// Returns the `k` rows of the bit-matrix `M` nearest to the bit-store `q` in Hamming distance.
+///
+/// The result is a vector of `(distance, row)` pairs sorted by distance, with ties going to the lower row index. It
+/// has fewer than `k` pairs if `M` has fewer than `k` rows at most `max_distance` away from `q`.
+///
+/// Once `k` candidates are in hand, the scan of each later row gives up as soon as its distance reaches that of the
+/// worst of them, so most rows of a large matrix cost only a fraction of a full pass.
+///
+/// # Panics
+/// This method panics if the size of `q` does not match the number of columns of `M`.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<>::random(1000, 256, 0.5, 1);
+/// auto q = BitVector<>::zeros(256);
+/// q.copy(M.row(321));
+/// q.flip(5);
+/// q.flip(77);
+/// auto nearest = k_nearest(q, M, 3);
+/// assert_eq(nearest.size(), 3);
+/// assert_eq(nearest[0], (std::pair{2uz, 321uz}));
+/// auto d = distances(q, M);
+/// std::vector<std::pair<usize, usize>> all;
+/// for (auto i = 0uz; i < d.size(); ++i) all.emplace_back(d[i], i);
+/// std::ranges::sort(all);
+/// all.resize(3);
+/// assert_eq(nearest, all);
+/// assert_eq(k_nearest(q, M, 10, 2).size(), 1);
+/// assert_eq(k_nearest(q, M, 0).size(), 0);
+/// ```
+template<Unsigned Word, BitStore Query>
+    requires std::same_as<typename Query::word_type, Word>
+std::vector<std::pair<usize, usize>>
+k_nearest(Query const& q, BitMatrix<Word> const& M, usize k, usize max_distance = std::numeric_limits<usize>::max()) {
+    return k_nearest(seq, q, M, k, max_distance);
+}
+
+/// Returns the `k` rows of the bit-matrix `M` nearest to the bit-store `q` in Hamming distance using an executor.
+///
+/// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. Each thread keeps its own `k` best candidates
+/// for a contiguous block of rows and those are merged at the end, so the result is the same as for `k_nearest(q, M,
+/// k, max_distance)`.
+///
+/// # Panics
+/// This method panics if the size of `q` does not match the number of columns of `M`.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<>::random(20'000, 128, 0.5, 2);
+/// auto q = BitVector<>::random(128, 0.5, 3);
+/// ThreadPool pool{4};
+/// assert_eq(k_nearest(pool, q, M, 25), k_nearest(q, M, 25));
+/// assert_eq(k_nearest(par, q, M, 25, 40), k_nearest(q, M, 25, 40));
+/// ```
+template<Executor Exec, Unsigned Word, BitStore Query>
+    requires std::same_as<typename Query::word_type, Word>
+std::vector<std::pair<usize, usize>>
+k_nearest(Exec&& exec, Query const& q, BitMatrix<Word> const& M, usize k,
+          usize max_distance = std::numeric_limits<usize>::max()) {
+    gf2_assert_eq(q.size(), M.cols(), "Query has {} elements but the matrix has {} columns.", q.size(), M.cols());
+    std::vector<std::pair<usize, usize>> result;
+    if (k == 0) return result;
+
+    std::mutex merge;
+    details::for_each_chunk(exec, M.rows(), details::scan_grain(exec, M), [&](usize begin, usize end) {
+        std::vector<std::pair<usize, usize>> best;
+        best.reserve(std::min(k, end - begin));
+        details::nearest_rows(q, M, begin, end, k, max_distance, best);
+        std::scoped_lock lock{merge};
+        result.insert(result.end(), best.begin(), best.end());
+    });
+    std::ranges::sort(result);
+    if (result.size() > k) result.resize(k);
+    return result;
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // Some utility methods to print multiple matrices & vectors side-by-side ...
 // -------------------------------------------------------------------------------------------------------------------
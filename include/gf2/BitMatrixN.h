@@ -0,0 +1,854 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Fixed-size bit-matrices over GF(2) with rows that are bit-arrays so they never allocate. <br>
+/// See the [BitMatrixN](docs/pages/BitMatrixN.md) page for more details.
+
+#include <gf2/BitArray.h>
+#include <gf2/BitMatrix.h>
+
+#include <array>
+#include <bit>
+#include <format>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace gf2 {
+
+/// A fixed-size `R x C` bit-matrix over GF(2) whose rows are `gf2::BitArray<C, Word>` bit-arrays.
+///
+/// The dimensions are template parameters so the whole matrix lives in a `std::array` of rows on the stack and never
+/// touches the heap. This is the type for the many small matrices of S-box and linear-layer analysis where a
+/// `gf2::BitMatrix` would spend more time in its allocator than in the arithmetic.
+///
+/// All the loops have bounds that are known at compile time so the compiler can unroll them and, for matrices that
+/// fit in a few dozen words, keep them in registers. Everything except the random fills and the conversions to and
+/// from `gf2::BitMatrix` is `constexpr`, including the products, `transposed`, `to_the`, `inverse`, `rank` and the
+/// `x_for` solver.
+///
+/// # Example
+/// ```
+/// constexpr auto A = BitMatrixN<3, 3>::from([](usize i, usize j) { return j >= i; });
+/// constexpr auto B = A.inverse();
+/// static_assert(B.has_value());
+/// static_assert(A * *B == BitMatrixN<3, 3>::identity());
+/// assert_eq(A.to_compact_binary_string(), "111 011 001");
+/// assert_eq(B->to_compact_binary_string(), "110 011 001");
+/// ```
+template<usize R, usize C, Unsigned Word = usize>
+    requires(R > 0 && C > 0)
+class BitMatrixN {
+private:
+    // The rows of the bit-matrix.
+    std::array<BitArray<C, Word>, R> m_rows;
+
+    // Bit-matrices of any size are friends so the products can get at each other's words.
+    template<usize R2, usize C2, Unsigned W2>
+        requires(R2 > 0 && C2 > 0)
+    friend class BitMatrixN;
+
+public:
+    /// The underlying unsigned word type used to store the bits.
+    using word_type = Word;
+
+    /// The type of a row.
+    using row_type = BitArray<C, Word>;
+
+    /// The type of a column.
+    using col_type = BitArray<R, Word>;
+
+    /// The number of words in each row.
+    static constexpr usize words_per_row = words_needed<Word>(C);
+
+    /// @name Constructors
+    /// @{
+
+    /// The default constructor creates the `R x C` zero bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// BitMatrixN<2, 3> m;
+    /// assert_eq(m.to_compact_binary_string(), "000 000");
+    /// ```
+    constexpr BitMatrixN() = default;
+
+    /// Factory method that returns the `R x C` zero bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// static_assert(BitMatrixN<4, 5, u8>::zeros().is_zero());
+    /// ```
+    static constexpr BitMatrixN zeros() { return BitMatrixN{}; }
+
+    /// Factory method that returns the `R x C` bit-matrix with all the elements set to 1.
+    ///
+    /// # Example
+    /// ```
+    /// static_assert(BitMatrixN<4, 9, u8>::ones().count_ones() == 36);
+    /// ```
+    static constexpr BitMatrixN ones() {
+        BitMatrixN result;
+        for (auto& row : result.m_rows) row = row_type::ones();
+        return result;
+    }
+
+    /// Factory method that returns the identity bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<3, 3>::identity();
+    /// assert_eq(m.to_compact_binary_string(), "100 010 001");
+    /// ```
+    static constexpr BitMatrixN identity()
+        requires(R == C)
+    {
+        BitMatrixN result;
+        for (auto i = 0uz; i < R; ++i) result.m_rows[i].set(i);
+        return result;
+    }
+
+    /// Factory method that sets element `(i, j)` to the value of `f(i, j)`.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<3, 4>::from([](usize i, usize j) { return (i + j) % 2 == 0; });
+    /// assert_eq(m.to_compact_binary_string(), "1010 0101 1010");
+    /// ```
+    static constexpr BitMatrixN from(std::invocable<usize, usize> auto f) {
+        BitMatrixN result;
+        for (auto i = 0uz; i < R; ++i)
+            for (auto j = 0uz; j < C; ++j)
+                if (f(i, j)) result.m_rows[i].set(j);
+        return result;
+    }
+
+    /// Factory method that copies a dynamically sized `gf2::BitMatrix` that must be `R x C`.
+    ///
+    /// # Panics
+    /// Panics if the dimensions of `src` don't match.
+    ///
+    /// # Example
+    /// ```
+    /// auto src = BitMatrix<u8>::random(5, 11);
+    /// auto m = BitMatrixN<5, 11, u8>::from(src);
+    /// assert_eq(m.to_matrix(), src);
+    /// ```
+    static BitMatrixN from(BitMatrix<Word> const& src) {
+        gf2_assert(src.rows() == R && src.cols() == C, "Source is {} x {} not {} x {}", src.rows(), src.cols(), R, C);
+        BitMatrixN result;
+        for (auto i = 0uz; i < R; ++i) result.m_rows[i].copy(src.row(i));
+        return result;
+    }
+
+    /// Factory method to generate a random bit-matrix where each element is 1 with probability `p`.
+    ///
+    /// Row `i` is filled from the same stream as row `i` of `BitMatrix::random(R, C, p, seed)`, so for a given non-zero
+    /// seed the two give the same matrix. A seed of 0 means draw one from entropy.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<40, 70, u8>::random(0.5, 42);
+    /// assert_eq(m.to_matrix(), BitMatrix<u8>::random(40, 70, 0.5, 42));
+    /// ```
+    static BitMatrixN random(double p = 0.5, u64 seed = 0) {
+        auto scaled_p = details::scaled_probability(p);
+        if (!scaled_p) return ones();
+
+        thread_local RNG rng;
+        if (seed == 0) seed = rng();
+
+        BitMatrixN result;
+        for (auto i = 0uz; i < R; ++i) {
+            Xoshiro256pp stream{Philox4x32{seed, i}()};
+            details::fill_random_words(result.m_rows[i], stream, *scaled_p);
+        }
+        return result;
+    }
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the number of rows `R`.
+    static constexpr usize rows() { return R; }
+
+    /// Returns the number of columns `C`.
+    static constexpr usize cols() { return C; }
+
+    /// Returns `true` if the bit-matrix is square.
+    static constexpr bool is_square() { return R == C; }
+
+    /// Returns the number of set elements.
+    ///
+    /// # Example
+    /// ```
+    /// static_assert(BitMatrixN<64, 64>::identity().count_ones() == 64);
+    /// ```
+    constexpr usize count_ones() const {
+        auto result = 0uz;
+        for (auto const& row : m_rows)
+            for (auto w = 0uz; w < words_per_row; ++w) result += static_cast<usize>(std::popcount(row.store()[w]));
+        return result;
+    }
+
+    /// Returns `true` if all the elements are 0.
+    ///
+    /// # Example
+    /// ```
+    /// BitMatrixN<3, 3> m;
+    /// assert(m.is_zero());
+    /// m.set(1, 2);
+    /// assert(!m.is_zero());
+    /// ```
+    constexpr bool is_zero() const { return *this == zeros(); }
+
+    /// Returns `true` if this is the identity bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// static_assert(BitMatrixN<7, 7, u8>::identity().is_identity());
+    /// static_assert(!BitMatrixN<7, 7, u8>::ones().is_identity());
+    /// ```
+    constexpr bool is_identity() const
+        requires(R == C)
+    {
+        return *this == identity();
+    }
+
+    /// @}
+    /// @name Element, Row & Column Access
+    /// @{
+
+    /// Returns the element at row `r` and column `c`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if either index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<3, 3>::identity();
+    /// assert(m.get(1, 1));
+    /// assert(!m.get(1, 2));
+    /// ```
+    constexpr bool get(usize r, usize c) const {
+        gf2_debug_assert(r < R, "Row {} out of bounds [0, {})", r, R);
+        return m_rows[r].get(c);
+    }
+
+    /// Sets the element at row `r` and column `c` to `val`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if either index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// BitMatrixN<2, 2> m;
+    /// m.set(0, 1);
+    /// assert_eq(m.to_compact_binary_string(), "01 00");
+    /// ```
+    constexpr void set(usize r, usize c, bool val = true) {
+        gf2_debug_assert(r < R, "Row {} out of bounds [0, {})", r, R);
+        m_rows[r].set(c, val);
+    }
+
+    /// Flips the element at row `r` and column `c`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if either index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// BitMatrixN<2, 2> m;
+    /// m.flip(1, 0);
+    /// assert_eq(m.to_compact_binary_string(), "00 10");
+    /// ```
+    constexpr void flip(usize r, usize c) {
+        gf2_debug_assert(r < R, "Row {} out of bounds [0, {})", r, R);
+        m_rows[r].flip(c);
+    }
+
+    /// Returns a read-only reference to row `r`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if the index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<3, 3>::identity();
+    /// assert_eq(m.row(2).to_string(), "001");
+    /// ```
+    constexpr row_type const& row(usize r) const {
+        gf2_debug_assert(r < R, "Row {} out of bounds [0, {})", r, R);
+        return m_rows[r];
+    }
+
+    /// Returns a reference to row `r`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if the index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// BitMatrixN<3, 3> m;
+    /// m.row(1).set_all();
+    /// assert_eq(m.to_compact_binary_string(), "000 111 000");
+    /// ```
+    constexpr row_type& row(usize r) {
+        gf2_debug_assert(r < R, "Row {} out of bounds [0, {})", r, R);
+        return m_rows[r];
+    }
+
+    /// Returns a read-only reference to row `r`.
+    constexpr row_type const& operator[](usize r) const { return row(r); }
+
+    /// Returns a reference to row `r`.
+    constexpr row_type& operator[](usize r) { return row(r); }
+
+    /// Returns a copy of column `c`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if the index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<3, 3>::from([](usize i, usize j) { return j >= i; });
+    /// assert_eq(m.col(1).to_string(), "110");
+    /// ```
+    constexpr col_type col(usize c) const {
+        gf2_debug_assert(c < C, "Column {} out of bounds [0, {})", c, C);
+        col_type result;
+        auto [w, offset] = index_and_offset<Word>(c);
+        for (auto r = 0uz; r < R; ++r) {
+            auto bit = static_cast<Word>((m_rows[r].store()[w] >> offset) & 1);
+            result.store()[r / BITS<Word>] |= static_cast<Word>(bit << (r % BITS<Word>));
+        }
+        return result;
+    }
+
+    /// Swaps rows `i` and `j`.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<3, 3>::identity();
+    /// m.swap_rows(0, 2);
+    /// assert_eq(m.to_compact_binary_string(), "001 010 100");
+    /// ```
+    constexpr void swap_rows(usize i, usize j) { std::swap(m_rows[i], m_rows[j]); }
+
+    /// @}
+    /// @name Transposing
+    /// @{
+
+    /// Returns the `C x R` transpose of this bit-matrix.
+    ///
+    /// The work is done in `W x W` tiles of bits where `W` is the number of bits in a `Word` (or a smaller power of two
+    /// for matrices that are smaller than that). Each tile is transposed in `log2(W)` butterfly steps of swap-and-mask
+    /// operations, so a 64 x 64 bit-matrix of 64-bit words takes six passes over 64 registers-worth of words.
+    ///
+    /// # Example
+    /// ```
+    /// constexpr auto m = BitMatrixN<2, 3>::from([](usize i, usize j) { return i == 0 || j == 2; });
+    /// static_assert(m.transposed().transposed() == m);
+    /// assert_eq(m.transposed().to_compact_binary_string(), "10 10 11");
+    /// auto p = BitMatrixN<19, 45, u8>::random();
+    /// assert_eq(p.transposed().to_matrix(), p.to_matrix().transposed());
+    /// ```
+    constexpr BitMatrixN<C, R, Word> transposed() const {
+        BitMatrixN<C, R, Word> result;
+        for (auto ti = 0uz; ti < words_needed<Word>(R); ++ti) {
+            for (auto tj = 0uz; tj < words_per_row; ++tj) {
+                std::array<Word, tile_size> tile{};
+                for (auto k = 0uz; k < tile_size && ti * tile_size + k < R; ++k)
+                    tile[k] = m_rows[ti * tile_size + k].store()[tj];
+                transpose_tile(tile);
+                for (auto k = 0uz; k < tile_size && tj * tile_size + k < C; ++k)
+                    result.m_rows[tj * tile_size + k].store()[ti] = tile[k];
+            }
+        }
+        return result;
+    }
+
+    /// @}
+    /// @name Powers & Inverses
+    /// @{
+
+    /// Returns this bit-matrix raised to the power `n`, by repeated squaring.
+    ///
+    /// # Example
+    /// ```
+    /// constexpr auto shift = BitMatrixN<8, 8, u8>::from([](usize i, usize j) { return j == i + 1; });
+    /// static_assert(shift.to_the(7).count_ones() == 1);
+    /// static_assert(shift.to_the(8).is_zero());
+    /// static_assert(shift.to_the(0).is_identity());
+    /// ```
+    constexpr BitMatrixN to_the(u64 n) const
+        requires(R == C)
+    {
+        auto result = identity();
+        auto square = *this;
+        while (n > 0) {
+            if (n & 1) result = result.dot(square);
+            n >>= 1;
+            if (n > 0) square = square.dot(square);
+        }
+        return result;
+    }
+
+    /// Returns the inverse of this bit-matrix or `std::nullopt` if it is singular.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<64, 64>::random(0.5, 42);
+    /// if (auto inv = m.inverse(); inv) assert((m * *inv).is_identity());
+    /// static_assert(!BitMatrixN<4, 4>::ones().inverse().has_value());
+    /// ```
+    constexpr std::optional<BitMatrixN> inverse() const
+        requires(R == C)
+    {
+        auto copy = *this;
+        auto result = identity();
+        auto rank = copy.eliminate([&](usize i, usize j) { std::swap(result.m_rows[i], result.m_rows[j]); },
+                                   [&](usize src, usize dst) { result.add_row(src, dst, 0); });
+        if (rank < R) return std::nullopt;
+        return result;
+    }
+
+    /// @}
+    /// @name Elimination & Linear Systems
+    /// @{
+
+    /// Transforms the bit-matrix to reduced row echelon form in place and returns its rank.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<3, 4>::from([](usize i, usize j) { return i == 0 || j == i; });
+    /// assert_eq(m.to_reduced_echelon_form(), 3);
+    /// assert_eq(m.to_compact_binary_string(), "1001 0100 0010");
+    /// ```
+    constexpr usize to_reduced_echelon_form() {
+        return eliminate([](usize, usize) {}, [](usize, usize) {});
+    }
+
+    /// Returns the rank of the bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// static_assert(BitMatrixN<5, 9>::ones().rank() == 1);
+    /// static_assert(BitMatrixN<9, 9>::identity().rank() == 9);
+    /// ```
+    constexpr usize rank() const {
+        auto copy = *this;
+        return copy.to_reduced_echelon_form();
+    }
+
+    /// Returns a solution `x` to the system `A * x = b` or `std::nullopt` if there isn't one.
+    ///
+    /// If the system is under determined the free variables are set to 0.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrixN<20, 30, u8>::random(0.5, 42);
+    /// auto b = BitArray<20, u8>::random(0.5, 7);
+    /// if (auto x = A.x_for(b); x) assert_eq(dot(A, *x), b);
+    /// constexpr auto I = BitMatrixN<3, 3>::identity();
+    /// static_assert(I.x_for(BitArray<3>::ones()).value() == BitArray<3>::ones());
+    /// ```
+    constexpr std::optional<BitArray<C, Word>> x_for(BitArray<R, Word> const& b) const {
+        auto copy = *this;
+        auto rhs = b;
+        auto rank = copy.eliminate([&](usize i, usize j) { rhs.swap(i, j); },
+                                   [&](usize src, usize dst) {
+                                       if (rhs.get(src)) rhs.flip(dst);
+                                   });
+
+        // The rows past the rank are zero so their entries in `rhs` must be too.
+        for (auto i = rank; i < R; ++i)
+            if (rhs.get(i)) return std::nullopt;
+
+        // Each non-zero row has a single one in its pivot column and fixes that element of the solution.
+        BitArray<C, Word> result;
+        for (auto i = 0uz; i < rank; ++i)
+            if (rhs.get(i)) result.set(copy.leading_bit(i));
+        return result;
+    }
+
+    /// @}
+    /// @name Element-wise Operations
+    /// @{
+
+    /// Adds (i.e. XOR's) another bit-matrix into this one.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<2, 2>::ones();
+    /// m ^= BitMatrixN<2, 2>::identity();
+    /// assert_eq(m.to_compact_binary_string(), "01 10");
+    /// ```
+    constexpr BitMatrixN& operator^=(BitMatrixN const& rhs) {
+        for (auto i = 0uz; i < R; ++i)
+            for (auto w = 0uz; w < words_per_row; ++w) m_rows[i].store()[w] ^= rhs.m_rows[i].store()[w];
+        return *this;
+    }
+
+    /// Adds another bit-matrix into this one, which is the same as XOR over GF(2).
+    constexpr BitMatrixN& operator+=(BitMatrixN const& rhs) { return operator^=(rhs); }
+
+    /// Subtracts another bit-matrix from this one, which is the same as XOR over GF(2).
+    constexpr BitMatrixN& operator-=(BitMatrixN const& rhs) { return operator^=(rhs); }
+
+    /// AND's another bit-matrix into this one.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<2, 2>::ones();
+    /// m &= BitMatrixN<2, 2>::identity();
+    /// assert_eq(m.to_compact_binary_string(), "10 01");
+    /// ```
+    constexpr BitMatrixN& operator&=(BitMatrixN const& rhs) {
+        for (auto i = 0uz; i < R; ++i)
+            for (auto w = 0uz; w < words_per_row; ++w) m_rows[i].store()[w] &= rhs.m_rows[i].store()[w];
+        return *this;
+    }
+
+    /// OR's another bit-matrix into this one.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<2, 2>::identity();
+    /// m |= BitMatrixN<2, 2>::from([](usize i, usize j) { return i == 0 && j == 1; });
+    /// assert_eq(m.to_compact_binary_string(), "11 01");
+    /// ```
+    constexpr BitMatrixN& operator|=(BitMatrixN const& rhs) {
+        for (auto i = 0uz; i < R; ++i)
+            for (auto w = 0uz; w < words_per_row; ++w) m_rows[i].store()[w] |= rhs.m_rows[i].store()[w];
+        return *this;
+    }
+
+    /// Returns the element-wise XOR of two bit-matrices.
+    friend constexpr BitMatrixN operator^(BitMatrixN lhs, BitMatrixN const& rhs) { return lhs ^= rhs; }
+
+    /// Returns the sum of two bit-matrices, which is the same as XOR over GF(2).
+    friend constexpr BitMatrixN operator+(BitMatrixN lhs, BitMatrixN const& rhs) { return lhs ^= rhs; }
+
+    /// Returns the difference of two bit-matrices, which is the same as XOR over GF(2).
+    friend constexpr BitMatrixN operator-(BitMatrixN lhs, BitMatrixN const& rhs) { return lhs ^= rhs; }
+
+    /// Returns the element-wise AND of two bit-matrices.
+    friend constexpr BitMatrixN operator&(BitMatrixN lhs, BitMatrixN const& rhs) { return lhs &= rhs; }
+
+    /// Returns the element-wise OR of two bit-matrices.
+    friend constexpr BitMatrixN operator|(BitMatrixN lhs, BitMatrixN const& rhs) { return lhs |= rhs; }
+
+    /// Equality operator which checks all the elements.
+    ///
+    /// # Example
+    /// ```
+    /// static_assert(BitMatrixN<3, 3>::identity() == BitMatrixN<3, 3>::identity());
+    /// static_assert(BitMatrixN<3, 3>::identity() != BitMatrixN<3, 3>::ones());
+    /// ```
+    friend constexpr bool operator==(BitMatrixN const& lhs, BitMatrixN const& rhs) {
+        for (auto i = 0uz; i < R; ++i)
+            for (auto w = 0uz; w < words_per_row; ++w)
+                if (lhs.m_rows[i].store()[w] != rhs.m_rows[i].store()[w]) return false;
+        return true;
+    }
+
+    /// @}
+    /// @name Products
+    /// @{
+
+    /// Returns the product of a bit-matrix with another whose number of rows is the same as our number of columns.
+    ///
+    /// Products with at least eight rows on the left use the "Method of Four Russians" with four rows of `rhs` at a
+    /// time: a sixteen-entry table of their combinations is built once and then each row of the result picks up one
+    /// entry of it. Smaller products add the rows of `rhs` picked out by masks, without any branches.
+    ///
+    /// You can also call the free function `gf2::dot(lhs, rhs)` or use `lhs * rhs`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrixN<64, 64>::random(0.5, 42);
+    /// auto B = BitMatrixN<64, 64>::random(0.5, 7);
+    /// assert_eq((A * B).to_matrix(), dot(A.to_matrix(), B.to_matrix()));
+    /// auto C = BitMatrixN<3, 70, u8>::random(0.5, 1);
+    /// auto D = BitMatrixN<70, 9, u8>::random(0.5, 2);
+    /// assert_eq((C * D).to_matrix(), dot(C.to_matrix(), D.to_matrix()));
+    /// ```
+    template<usize K>
+    constexpr BitMatrixN<R, K, Word> dot(BitMatrixN<C, K, Word> const& rhs) const {
+        using result_type = BitMatrixN<R, K, Word>;
+        constexpr usize n_words = result_type::words_per_row;
+        result_type     result;
+        if constexpr (R >= 8) {
+            // Four Russians: combinations of four rows of `rhs` at a time & one table look-up per row of the result.
+            // The words hold a multiple of four bits so a group of four columns never straddles two words.
+            std::array<std::array<Word, n_words>, 16> table{};
+            for (auto k = 0uz; k < C; k += 4) {
+                auto len = std::min(4uz, C - k);
+                for (auto t = 1uz; t < (1uz << len); ++t) {
+                    auto        src = rhs.m_rows[k + static_cast<usize>(std::countr_zero(t))].store();
+                    auto const& prev = table[t & (t - 1)];
+                    for (auto w = 0uz; w < n_words; ++w) table[t][w] = prev[w] ^ src[w];
+                }
+                auto [kw, koff] = index_and_offset<Word>(k);
+                for (auto i = 0uz; i < R; ++i) {
+                    auto bits = static_cast<usize>(m_rows[i].store()[kw] >> koff) & 15;
+                    auto dst = result.m_rows[i].store();
+                    for (auto w = 0uz; w < n_words; ++w) dst[w] ^= table[bits][w];
+                }
+            }
+        } else {
+            // Masked row additions: row i of the result is the sum of the rows of `rhs` picked out by row i of `this`.
+            for (auto i = 0uz; i < R; ++i) {
+                std::array<Word, n_words> acc{};
+                for (auto k = 0uz; k < C; ++k) {
+                    auto bit = static_cast<Word>((m_rows[i].store()[k / BITS<Word>] >> (k % BITS<Word>)) & 1);
+                    auto mask = static_cast<Word>(Word{0} - bit);
+                    auto src = rhs.m_rows[k].store();
+                    for (auto w = 0uz; w < n_words; ++w) acc[w] ^= static_cast<Word>(src[w] & mask);
+                }
+                auto dst = result.m_rows[i].store();
+                for (auto w = 0uz; w < n_words; ++w) dst[w] = acc[w];
+            }
+        }
+        return result;
+    }
+
+    /// Returns the product `M * v` of this bit-matrix with a bit-array.
+    ///
+    /// Element `i` is the parity of row `i` AND'ed with `v` a word at a time.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrixN<40, 70, u8>::random(0.5, 42);
+    /// auto v = BitArray<70, u8>::random(0.5, 7);
+    /// assert_eq(BitVector<u8>::from(A * v), dot(A.to_matrix(), v));
+    /// ```
+    constexpr BitArray<R, Word> dot(BitArray<C, Word> const& v) const {
+        BitArray<R, Word> result;
+        for (auto i = 0uz; i < R; ++i) {
+            Word sum = 0;
+            for (auto w = 0uz; w < words_per_row; ++w) sum ^= static_cast<Word>(m_rows[i].store()[w] & v.store()[w]);
+            auto bit = static_cast<Word>(std::popcount(sum) & 1);
+            result.store()[i / BITS<Word>] |= static_cast<Word>(bit << (i % BITS<Word>));
+        }
+        return result;
+    }
+
+    /// Returns the product `v * M` of a bit-array with this bit-matrix as the sum of the rows picked out by `v`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = BitMatrixN<40, 70, u8>::random(0.5, 42);
+    /// auto v = BitArray<40, u8>::random(0.5, 7);
+    /// assert_eq(BitVector<u8>::from(v * A), dot(v, A.to_matrix()));
+    /// ```
+    constexpr BitArray<C, Word> left_dot(BitArray<R, Word> const& v) const {
+        std::array<Word, words_per_row> acc{};
+        for (auto i = 0uz; i < R; ++i) {
+            auto bit = static_cast<Word>((v.store()[i / BITS<Word>] >> (i % BITS<Word>)) & 1);
+            auto mask = static_cast<Word>(Word{0} - bit);
+            for (auto w = 0uz; w < words_per_row; ++w) acc[w] ^= static_cast<Word>(m_rows[i].store()[w] & mask);
+        }
+        BitArray<C, Word> result;
+        for (auto w = 0uz; w < words_per_row; ++w) result.store()[w] = acc[w];
+        return result;
+    }
+
+    /// @}
+    /// @name Conversions
+    /// @{
+
+    /// Returns a copy of this bit-matrix as a dynamically sized `gf2::BitMatrix`.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<3, 3>::identity().to_matrix();
+    /// assert_eq(m, BitMatrix<>::identity(3));
+    /// ```
+    BitMatrix<Word> to_matrix() const {
+        auto result = BitMatrix<Word>::zeros(R, C);
+        for (auto i = 0uz; i < R; ++i) result.row(i).copy(m_rows[i]);
+        return result;
+    }
+
+    /// Returns the rows in binary separated by newlines.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<2, 2>::identity();
+    /// assert_eq(m.to_string(), "10\n01");
+    /// ```
+    std::string to_string() const { return to_matrix().to_string(); }
+
+    /// Returns the rows in binary separated by single spaces.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrixN<2, 2>::identity();
+    /// assert_eq(m.to_compact_binary_string(), "10 01");
+    /// ```
+    std::string to_compact_binary_string() const { return to_matrix().to_compact_binary_string(); }
+
+    /// @}
+
+private:
+    // Adds (i.e. XOR's) row `src` into row `dst` from word `w0` onwards.
+    constexpr void add_row(usize src, usize dst, usize w0) {
+        auto s = m_rows[src].store();
+        auto d = m_rows[dst].store();
+        for (auto w = w0; w < words_per_row; ++w) d[w] ^= s[w];
+    }
+
+    // Returns the column of the first set bit in the non-zero row `r`.
+    constexpr usize leading_bit(usize r) const {
+        auto w = 0uz;
+        while (m_rows[r].store()[w] == 0) ++w;
+        return w * BITS<Word> + static_cast<usize>(std::countr_zero(m_rows[r].store()[w]));
+    }
+
+    // Gauss-Jordan elimination to reduced row echelon form that returns the rank.
+    //
+    // The callbacks are told about each row swap `on_swap(i, j)` and row addition `on_add(src, dst)` so the caller can
+    // apply the same operations to the rows of something else, like the identity for an inverse or the right-hand
+    // side of a linear system. The pivot row is zero before its pivot word so additions start from there.
+    constexpr usize eliminate(auto&& on_swap, auto&& on_add) {
+        auto r = 0uz;
+        for (auto c = 0uz; c < C && r < R; ++c) {
+            auto [w, offset] = index_and_offset<Word>(c);
+            auto bit = static_cast<Word>(Word{1} << offset);
+            auto p = r;
+            while (p < R && (m_rows[p].store()[w] & bit) == 0) ++p;
+            if (p == R) continue;
+            if (p != r) {
+                std::swap(m_rows[p], m_rows[r]);
+                on_swap(p, r);
+            }
+            for (auto i = 0uz; i < R; ++i) {
+                if (i != r && (m_rows[i].store()[w] & bit) != 0) {
+                    add_row(r, i, w);
+                    on_add(r, i);
+                }
+            }
+            ++r;
+        }
+        return r;
+    }
+
+    // The transpose works on square tiles of this many rows & bits: all of a word unless the matrix is smaller.
+    // If the tile is narrower than a word the bits past it are zero so the butterfly steps for them can be skipped.
+    static constexpr usize tile_size = std::min<usize>(BITS<Word>, std::bit_ceil(std::max(R, C)));
+
+    // Transposes a square `tile_size x tile_size` tile of bits in-place using the butterfly network of swap-and-mask
+    // steps. At each step we swap the top-right and bottom-left `j x j` blocks of all the `2j x 2j` sub-tiles at once.
+    static constexpr void transpose_tile(std::array<Word, tile_size>& tile) {
+        constexpr usize n = BITS<Word>;
+        auto            j = n / 2;
+        auto            mask = static_cast<Word>(MAX<Word> >> j);
+        while (j >= tile_size) {
+            j >>= 1;
+            mask = static_cast<Word>(mask ^ (mask << j));
+        }
+        for (; j != 0; j >>= 1, mask = static_cast<Word>(mask ^ (mask << j))) {
+            for (auto k = 0uz; k < tile_size; k = ((k | j) + 1) & ~j) {
+                auto t = static_cast<Word>(((tile[k] >> j) ^ tile[k | j]) & mask);
+                tile[k] = static_cast<Word>(tile[k] ^ (t << j));
+                tile[k | j] ^= t;
+            }
+        }
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Fixed-size matrix products ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// Fixed-size bit-matrix, bit-matrix multiplication, `A * B`.
+///
+/// # Example
+/// ```
+/// constexpr auto A = BitMatrixN<2, 3>::from([](usize i, usize j) { return i <= j; });
+/// constexpr auto B = BitMatrixN<3, 2>::ones();
+/// static_assert(dot(A, B) == BitMatrixN<2, 2>::from([](usize i, usize) { return i == 0; }));
+/// ```
+template<usize R, usize K, usize C, Unsigned Word>
+constexpr BitMatrixN<R, C, Word>
+dot(BitMatrixN<R, K, Word> const& lhs, BitMatrixN<K, C, Word> const& rhs) {
+    return lhs.dot(rhs);
+}
+
+/// Operator form for fixed-size bit-matrix, bit-matrix multiplication, `A * B`.
+template<usize R, usize K, usize C, Unsigned Word>
+constexpr BitMatrixN<R, C, Word>
+operator*(BitMatrixN<R, K, Word> const& lhs, BitMatrixN<K, C, Word> const& rhs) {
+    return lhs.dot(rhs);
+}
+
+/// Fixed-size bit-matrix, bit-array multiplication, `A * v`.
+///
+/// # Example
+/// ```
+/// constexpr auto A = BitMatrixN<3, 3>::identity();
+/// constexpr auto v = BitArray<3>::unit(1);
+/// static_assert(dot(A, v) == v);
+/// ```
+template<usize R, usize C, Unsigned Word>
+constexpr BitArray<R, Word>
+dot(BitMatrixN<R, C, Word> const& lhs, BitArray<C, Word> const& rhs) {
+    return lhs.dot(rhs);
+}
+
+/// Operator form for fixed-size bit-matrix, bit-array multiplication, `A * v`.
+template<usize R, usize C, Unsigned Word>
+constexpr BitArray<R, Word>
+operator*(BitMatrixN<R, C, Word> const& lhs, BitArray<C, Word> const& rhs) {
+    return lhs.dot(rhs);
+}
+
+/// Bit-array, fixed-size bit-matrix multiplication, `v * A`.
+///
+/// # Example
+/// ```
+/// constexpr auto A = BitMatrixN<2, 3>::ones();
+/// constexpr auto v = BitArray<2>::ones();
+/// static_assert(dot(v, A) == BitArray<3>::zeros());
+/// ```
+template<usize R, usize C, Unsigned Word>
+constexpr BitArray<C, Word>
+dot(BitArray<R, Word> const& lhs, BitMatrixN<R, C, Word> const& rhs) {
+    return rhs.left_dot(lhs);
+}
+
+/// Operator form for bit-array, fixed-size bit-matrix multiplication, `v * A`.
+template<usize R, usize C, Unsigned Word>
+constexpr BitArray<C, Word>
+operator*(BitArray<R, Word> const& lhs, BitMatrixN<R, C, Word> const& rhs) {
+    return rhs.left_dot(lhs);
+}
+
+} // namespace gf2
+
+// --------------------------------------------------------------------------------------------------------------------
+// Specialises `std::formatter` to handle fixed-size bit-matrices ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// Specialise `std::formatter` for the `gf2::BitMatrixN<R, C, Word>` type with the same format specifiers as the one
+/// for `gf2::BitMatrix`.
+///
+/// # Example
+/// ```
+/// auto m = BitMatrixN<2, 2, u8>::identity();
+/// assert_eq(std::format("{}", m), "10\n01");
+/// assert_eq(std::format("{:p}", m), "\u25021 0\u2502\n\u25020 1\u2502");
+/// ```
+template<gf2::usize R, gf2::usize C, gf2::Unsigned Word>
+struct std::formatter<gf2::BitMatrixN<R, C, Word>> : std::formatter<gf2::BitMatrix<Word>> {
+    /// Push out a formatted bit-matrix using the formatter for the equivalent `gf2::BitMatrix`.
+    template<class FormatContext>
+    auto format(gf2::BitMatrixN<R, C, Word> const& rhs, FormatContext& ctx) const {
+        return std::formatter<gf2::BitMatrix<Word>>::format(rhs.to_matrix(), ctx);
+    }
+};
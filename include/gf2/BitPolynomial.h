@@ -7,7 +7,17 @@
 /// See the [BitPolynomial](docs/pages/BitPolynomial.md) page for more details.
 
 #include <gf2/BitVector.h>
+#include <gf2/ThreadPool.h>
+#include <gf2/instrument.h>
+
+#include <algorithm>
+#include <optional>
+#include <span>
 #include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace gf2 {
 
@@ -15,6 +25,118 @@ namespace gf2 {
 template<Unsigned Word>
 class BitMatrix;
 
+// Forward declaration of the class that does arithmetic modulo a fixed bit-polynomial.
+template<Unsigned Word>
+class ModContext;
+
+// Forward declaration of the streaming Berlekamp-Massey engine behind `BitPolynomial::minimal_polynomial`.
+template<Unsigned Word>
+class BerlekampMassey;
+
+// Forward declaration of the cache of matrix powers behind the evaluation of a polynomial at a bit-matrix.
+template<Unsigned Word>
+class MatrixPowers;
+
+/// Divisions where both the divisor and the quotient have at least this degree use Newton iteration.
+///
+/// Below this size the word-level long division in `BitPolynomial::divmod` is faster.
+inline constexpr usize FAST_DIVISION_THRESHOLD = 4096;
+
+/// Dense moduli of at least this degree are reduced with a precomputed power series inverse (Barrett reduction).
+///
+/// Below this size the table of the `x^{d+i} mod P(x)` in a `gf2::ModContext` is faster. Barrett reduction costs two
+/// polynomial products, so it only pays early on when `gf2::clmul` has hardware support. Without that, the cut-off is
+/// set by the `d^2` bits of memory the table takes.
+#if defined(__PCLMUL__) || defined(__ARM_FEATURE_AES)
+inline constexpr usize FAST_REDUCTION_THRESHOLD = 64;
+#else
+inline constexpr usize FAST_REDUCTION_THRESHOLD = 16384;
+#endif
+
+/// Bit sequences with at least this many elements get their minimal polynomial from a half-GCD.
+///
+/// Below this size the word-level Berlekamp-Massey iteration in `BitPolynomial::minimal_polynomial` is faster.
+inline constexpr usize FAST_MINIMAL_POLYNOMIAL_THRESHOLD = 16384;
+
+/// Inside the half-GCD, remainders with a degree below this use plain Euclidean steps instead of recursing.
+inline constexpr usize HALF_GCD_THRESHOLD = 256;
+
+namespace details {
+
+// Sets `dst` to the first `n` elements of `v` in reverse order (any missing elements are zeros).
+// If `v` holds the coefficients of p(x) then the result is x^{n-1} p(1/x) which is the usual "reversal" of p(x).
+// This reuses the storage of `dst` which must not be `v`.
+template<Unsigned Word>
+constexpr void
+reversed(BitVector<Word> const& v, usize n, BitVector<Word>& dst) {
+    gf2_debug_assert(&v != &dst, "The destination for the reversal must not be the source");
+
+    // Work a word at a time: reverse the order of the words & the bits in each word, then drop the padding.
+    auto n_words = words_needed<Word>(n);
+    dst.resize(n_words * BITS<Word>);
+    for (auto i = 0uz; i < n_words; ++i) {
+        auto w = i < v.words() ? v.word(i) : Word{0};
+        if (i == n_words - 1 && n % BITS<Word> != 0) w &= with_set_bits<Word>(0, static_cast<u8>(n % BITS<Word>));
+        dst.set_word(n_words - 1 - i, reverse_bits(w));
+    }
+    dst <<= n_words * BITS<Word> - n;
+    dst.resize(n);
+}
+
+// Returns a bit-vector holding the first `n` elements of `v` in reverse order (any missing elements are zeros).
+template<Unsigned Word>
+constexpr BitVector<Word>
+reversed(BitVector<Word> const& v, usize n) {
+    BitVector<Word> result;
+    reversed(v, n, result);
+    return result;
+}
+
+// Returns a bit-vector holding the first `n` elements of `v` padded with zeros if necessary.
+template<Unsigned Word>
+constexpr BitVector<Word>
+truncated(BitVector<Word> const& v, usize n) {
+    auto result = v.sub(0, std::min(n, v.size()));
+    result.resize(n);
+    return result;
+}
+
+// Returns g(x) where f(x) g(x) = 1 mod x^n -- `f` must have a non-zero constant term.
+//
+// Newton iteration doubles the number of correct terms at each step using g <- g (2 - f g) which in GF(2) is just
+// g <- f g^2 and squaring is a cheap riffle.
+template<Unsigned Word>
+BitVector<Word>
+inverse_series(BitVector<Word> const& f, usize n) {
+    auto g = BitVector<Word>::ones(1);
+    for (auto len = 1uz; len < n;) {
+        len = std::min(2 * len, n);
+        g = truncated(convolve(truncated(f, len), g.riffled()), len);
+    }
+    return truncated(g, n);
+}
+
+// Treats `n` as the binary digits of a big number (bit i is the 2^i digit) and divides it by `q` > 0.
+// The quotient goes in `quo` & we return the remainder. The long division runs a bit at a time so never overflows.
+template<Unsigned Word>
+u64
+divide(BitVector<Word> const& n, u64 q, BitVector<Word>& quo) {
+    quo.resize(n.size());
+    quo.set_all(false);
+    auto rem = u64{0};
+    for (auto i = n.size(); i-- > 0;) {
+        auto carry = (rem >> 63) != 0;
+        rem = (rem << 1) | static_cast<u64>(n.get(i));
+        if (carry || rem >= q) {
+            rem -= q;
+            quo.set(i);
+        }
+    }
+    return rem;
+}
+
+} // namespace details
+
 /// A `BitPolynomial` represents a polynomial over GF(2) where we store the polynomial coefficients in a bit-vector.
 /// <br> The template parameter `Word` sets the unsigned word type used by the `BitVector` that stores the coefficients.
 ///
@@ -483,8 +605,8 @@ public:
             return *this;
         }
 
-        // Generally we pass the work to the convolution method for bit-vectors.
-        *this = BitPolynomial{std::move(convolve(m_coeffs, rhs.m_coeffs))};
+        // Generally we pass the work to the convolution method for bit-vectors, which reuses our storage.
+        convolve(m_coeffs, rhs.m_coeffs, m_coeffs);
         return *this;
     }
 
@@ -497,7 +619,7 @@ public:
     /// auto r = p + q;
     /// assert_eq(r.to_string(), "x^2 + x^3");
     /// ```
-    constexpr auto operator+(BitPolynomial<Word> const& rhs) const {
+    constexpr auto operator+(BitPolynomial<Word> const& rhs) const& {
         // Avoid unnecessary resizing by adding the smaller degree BitPolynomial to the larger one ...
         if (degree() >= rhs.degree()) {
             BitPolynomial<Word> result{*this};
@@ -510,6 +632,25 @@ public:
         }
     }
 
+    /// Returns the sum of a temporary bit-polynomial and another, reusing the storage of the temporary.
+    ///
+    /// This is what lets a chain like `p * q + r + s` run without allocating a fresh result at each step.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<u8>::ones(100);
+    /// auto q = BitPolynomial<u8>::x_to_the(3);
+    /// auto expected = p + q;
+    /// auto coeffs = p.coefficients().store();
+    /// auto r = std::move(p) + q;
+    /// assert_eq(r, expected);
+    /// assert(r.coefficients().store() == coeffs);
+    /// ```
+    constexpr BitPolynomial operator+(BitPolynomial<Word> const& rhs) && {
+        *this += rhs;
+        return std::move(*this);
+    }
+
     /// Returns the difference of two bit-polynomials.
     ///
     /// **Note:** In GF(2) subtraction is the same as addition.
@@ -521,11 +662,22 @@ public:
     /// auto r = p - q;
     /// assert_eq(r.to_string(), "x^2 + x^3");
     /// ```
-    constexpr auto operator-(BitPolynomial<Word> const& rhs) const {
+    constexpr auto operator-(BitPolynomial<Word> const& rhs) const& {
         // Subtraction is identical to addition in GF(2).
         return operator+(rhs);
     }
 
+    /// Returns the difference of a temporary bit-polynomial and another, reusing the storage of the temporary.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::x_to_the(3);
+    /// auto q = BitPolynomial<>::x_to_the(2);
+    /// auto r = (p * q) - q;
+    /// assert_eq(r.to_string(), "x^2 + x^5");
+    /// ```
+    constexpr BitPolynomial operator-(BitPolynomial<Word> const& rhs) && { return std::move(*this) + rhs; }
+
     /// Returns the product of two bit-polynomials.
     ///
     /// # Example
@@ -535,12 +687,26 @@ public:
     /// auto r = p * q;
     /// assert_eq(r.to_string(), "x^5");
     /// ```
-    constexpr auto operator*(BitPolynomial<Word> const& rhs) const {
+    constexpr auto operator*(BitPolynomial<Word> const& rhs) const& {
         BitPolynomial<Word> result{*this};
         result *= rhs;
         return result;
     }
 
+    /// Returns the product of a temporary bit-polynomial and another, reusing the storage of the temporary.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::ones(1);
+    /// auto q = BitPolynomial<>::ones(2);
+    /// auto r = (p * p) * q;
+    /// assert_eq(r.to_string(), "1 + x + x^3 + x^4");
+    /// ```
+    constexpr BitPolynomial operator*(BitPolynomial<Word> const& rhs) && {
+        *this *= rhs;
+        return std::move(*this);
+    }
+
     /// @}
     /// @name Specialised Arithmetic Operations:
     /// @{
@@ -606,6 +772,185 @@ public:
         return *this;
     }
 
+    /// @}
+    /// @name Division:
+    /// @{
+
+    /// Divides this bit-polynomial by `d` filling `q` with the quotient and `r` with the remainder.
+    ///
+    /// On return `self(x) = q(x) d(x) + r(x)` where `r(x)` has degree less than `d(x)`.
+    ///
+    /// Most divisions are done by word-level long division where each step adds a pre-shifted copy of `d(x)` into the
+    /// remainder a word at a time. If both `d(x)` and the quotient have degree at least `gf2::FAST_DIVISION_THRESHOLD`
+    /// we instead get the quotient from the power series inverse of the reversal of `d(x)`. Newton iteration builds
+    /// that inverse using a handful of fast multiplications.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `d` is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::ones(5);
+    /// auto d = BitPolynomial<>::ones(2);
+    /// BitPolynomial<> q, r;
+    /// p.divmod(d, q, r);
+    /// assert_eq(q.to_string(), "1 + x^3");
+    /// assert_eq(r.to_string(), "0");
+    /// p.divmod(BitPolynomial<>::x_to_the(2), q, r);
+    /// assert_eq(q.to_string(), "1 + x + x^2 + x^3");
+    /// assert_eq(r.to_string(), "1 + x");
+    /// ```
+    ///
+    /// # Example (checks both division methods on some big random polynomials)
+    /// ```
+    /// auto p = BitPolynomial<u32>::random(20'000);
+    /// for (auto n : {10uz, 300uz, 5'000uz, 15'000uz}) {
+    ///     auto d = BitPolynomial<u32>::random(n);
+    ///     d[n] = true;
+    ///     BitPolynomial<u32> q, r;
+    ///     p.divmod(d, q, r);
+    ///     assert(r.is_zero() || r.degree() < d.degree());
+    ///     assert_eq(q * d + r, p);
+    /// }
+    /// ```
+    void divmod(BitPolynomial const& d, BitPolynomial& q, BitPolynomial& r) const {
+        // Error check: division by zero is not defined.
+        if (d.is_zero()) throw std::invalid_argument("Division by the zero polynomial is not defined.");
+
+        // Edge case: the divisor has a higher degree so the quotient is zero.
+        auto n = degree();
+        auto m = d.degree();
+        if (is_zero() || n < m) {
+            r = *this;
+            q.clear();
+            return;
+        }
+
+        // Edge case: dividing by 1.
+        if (m == 0) {
+            q = *this;
+            r.clear();
+            return;
+        }
+
+        // Work on the side in case either output aliases one of the inputs.
+        coeffs_type quo, rem;
+        if (m >= FAST_DIVISION_THRESHOLD && n - m >= FAST_DIVISION_THRESHOLD) {
+            newton_divmod(d, quo, rem);
+        } else {
+            long_divmod(d, quo, rem);
+        }
+        q.m_coeffs = std::move(quo);
+        r.m_coeffs = std::move(rem);
+    }
+
+    /// Returns the quotient and remainder from dividing this bit-polynomial by `d` as a pair.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `d` is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::x_to_the(5);
+    /// auto [q, r] = p.divmod(BitPolynomial<>::ones(2));
+    /// assert_eq(q.to_string(), "1 + x^2 + x^3");
+    /// assert_eq(r.to_string(), "1 + x");
+    /// ```
+    auto divmod(BitPolynomial const& d) const {
+        BitPolynomial q, r;
+        divmod(d, q, r);
+        return std::pair{std::move(q), std::move(r)};
+    }
+
+    /// In-place division by another bit-polynomial, keeping the quotient and returning a reference to it.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `d` is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::ones(5);
+    /// p /= BitPolynomial<>::ones(2);
+    /// assert_eq(p.to_string(), "1 + x^3");
+    /// ```
+    BitPolynomial& operator/=(BitPolynomial const& d) {
+        BitPolynomial r;
+        divmod(d, *this, r);
+        return *this;
+    }
+
+    /// In-place reduction modulo another bit-polynomial, keeping the remainder and returning a reference to it.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `d` is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::ones(5);
+    /// p %= BitPolynomial<>::x_to_the(2);
+    /// assert_eq(p.to_string(), "1 + x");
+    /// ```
+    BitPolynomial& operator%=(BitPolynomial const& d) {
+        BitPolynomial q;
+        divmod(d, q, *this);
+        return *this;
+    }
+
+    /// Returns the quotient from dividing this bit-polynomial by `d`.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `d` is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::x_to_the(4);
+    /// assert_eq((p / BitPolynomial<>::ones(1)).to_string(), "1 + x + x^2 + x^3");
+    /// ```
+    BitPolynomial operator/(BitPolynomial const& d) const {
+        BitPolynomial q, r;
+        divmod(d, q, r);
+        return q;
+    }
+
+    /// Returns the remainder from dividing this bit-polynomial by `d`.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `d` is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::x_to_the(4);
+    /// assert_eq((p % BitPolynomial<>::ones(1)).to_string(), "1");
+    /// ```
+    BitPolynomial operator%(BitPolynomial const& d) const {
+        BitPolynomial q, r;
+        divmod(d, q, r);
+        return r;
+    }
+
+    /// Returns the inverse of this bit-polynomial modulo `P(x)` or `std::nullopt` if there is no such inverse.
+    ///
+    /// The inverse is the polynomial `s(x)` of degree less than `P(x)` with `s(x) self(x) = 1 mod P(x)`. It exists if
+    /// and only if `gcd(self, P) = 1` and we get it from the extended Euclidean algorithm `gf2::xgcd`.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `P` is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(8) + BitPolynomial<>::x_to_the(4) + BitPolynomial<>::x_to_the(3) +
+    ///          BitPolynomial<>::ones(1);
+    /// auto p = BitPolynomial<>::x_to_the(6) + BitPolynomial<>::x_to_the(4) + BitPolynomial<>::ones(1);
+    /// auto s = p.inverse_mod(P).value();
+    /// assert_eq((s * p % P).to_string(), "1");
+    /// assert(!BitPolynomial<>::x_to_the(2).inverse_mod(BitPolynomial<>::x_to_the(5)).has_value());
+    /// ```
+    std::optional<BitPolynomial> inverse_mod(BitPolynomial const& P) const {
+        auto [g, s, t] = xgcd(*this % P, P);
+        if (!g.is_one()) return std::nullopt;
+        return s;
+    }
+
     /// @}
     /// @name Polynomial Pieces:
     /// @{
@@ -730,7 +1075,9 @@ public:
 
     /// Evaluates the bit-polynomial for a *square* `gf2::BitMatrix` argument `M`.
     ///
-    /// Uses Horner's method to evaluate `p(M)` where `M` is a square matrix and returns the result as a new bit-matrix.
+    /// Uses the Paterson-Stockmeyer method to evaluate `p(M)` where `M` is a square matrix and returns the result as a
+    /// new bit-matrix. A polynomial of degree `d` needs about `2 sqrt(d)` matrix products instead of the `d` products
+    /// of Horner's method. Use a `gf2::MatrixPowers` object to evaluate several polynomials at the same matrix.
     ///
     /// # Panics
     /// This method panics if the matrix is not square.
@@ -742,34 +1089,97 @@ public:
     /// assert_eq(p1(m), BitMatrix<>::zeros(6, 6));
     /// BitPolynomial p2{BitVector<>::alternating(6)};
     /// assert_eq(p2(m), BitMatrix<>::identity(6));
+    /// auto M = BitMatrix<>::random(20, 20);
+    /// assert(M.characteristic_polynomial()(M).is_zero());
     /// ```
     constexpr auto operator()(BitMatrix<Word> const& M) const {
         // The bit-matrix argument must be square.
         gf2_assert(M.is_square(), "Matrix must be square -- not {} x {}!", M.rows(), M.cols());
 
-        // The returned bit-matrix will be n x n.
-        auto n = M.rows();
-
         // Edge case: If the polynomial is zero then the return value is the n x n zero matrix.
+        auto n = M.rows();
         if (is_zero()) return BitMatrix<Word>{n, n};
 
-        // Otherwise we start with the polynomial sum being the n x n identity matrix.
-        auto result = BitMatrix<Word>::identity(n);
+        // Only compute the powers of M that are optimal for our degree.
+        return MatrixPowers<Word>{M, degree()}(*this);
+    }
 
-        // Work backwards a la Horner ...
-        auto d = degree();
-        while (d > 0) {
+    /// Evaluates the bit-polynomial at the bit-matrix whose powers are held in `powers`.
+    ///
+    /// # Example
+    /// ```
+    /// auto M = BitMatrix<>::random(10, 10);
+    /// MatrixPowers powers{M};
+    /// auto p = BitPolynomial<>::random(12);
+    /// assert_eq(p(powers), p(M));
+    /// ```
+    constexpr auto operator()(MatrixPowers<Word> const& powers) const { return powers(*this); }
 
-            // Always multiply ...
-            result = dot(M, result);
+    /// Returns the bit-vector `p(M) v` for a square bit-matrix `M` without forming the bit-matrix `p(M)`.
+    ///
+    /// Horner's method runs over the Krylov sequence `v, M v, M^2 v, ...` so a polynomial of degree `d` costs `d`
+    /// matrix-vector products, which is `O(n^2 d)` work for an `n x n` matrix instead of the `O(n^3)` of each product
+    /// needed to build `p(M)`.
+    ///
+    /// # Panics
+    /// This method panics if the matrix is not square or if its size does not match the size of `v`.
+    ///
+    /// # Example
+    /// ```
+    /// auto M = BitMatrix<>::random(40, 40);
+    /// auto v = BitVector<>::random(40);
+    /// auto p = BitPolynomial<>::random(25);
+    /// assert_eq(p.apply(M, v), p(M) * v);
+    /// assert_eq(BitPolynomial<>::zero().apply(M, v), BitVector<>::zeros(40));
+    /// assert_eq(M.characteristic_polynomial().apply(M, v), BitVector<>::zeros(40));
+    /// ```
+    template<BitStore Rhs>
+        requires std::same_as<typename Rhs::word_type, Word>
+    constexpr auto apply(BitMatrix<Word> const& M, Rhs const& v) const {
+        gf2_assert(M.is_square(), "Matrix must be square -- not {} x {}!", M.rows(), M.cols());
+        gf2_assert_eq(M.cols(), v.size(), "Incompatible dimensions: {} != {}", M.cols(), v.size());
 
-            // Add the identity to the sum if the corresponding polynomial coefficient is 1.
-            if (m_coeffs[d - 1]) result.add_identity();
+        // Edge case: If the polynomial is zero then the return value is the zero vector.
+        if (is_zero()) return coeffs_type::zeros(v.size());
 
-            // And count down ...
-            d--;
+        // Work backwards a la Horner starting from the leading coefficient which is 1.
+        auto result = coeffs_type::from(v);
+        for (auto d = degree(); d > 0; --d) {
+            result = dot(M, result);
+            if (m_coeffs[d - 1]) result ^= v;
         }
+        return result;
+    }
+
+    /// Returns the bit-matrix `p(M) V` for a square bit-matrix `M` without forming the bit-matrix `p(M)`.
+    ///
+    /// This is the batched form of the bit-vector version: each column of `V` is a vector to apply `p(M)` to. For a
+    /// polynomial of degree `d` it costs `d` products of `M` with an `n x k` matrix when `V` has `k` columns.
+    ///
+    /// # Panics
+    /// This method panics if the matrix is not square or if its size does not match the number of rows of `V`.
+    ///
+    /// # Example
+    /// ```
+    /// auto M = BitMatrix<>::random(40, 40);
+    /// auto V = BitMatrix<>::random(40, 7);
+    /// auto p = BitPolynomial<>::random(25);
+    /// assert_eq(p.apply(M, V), p(M) * V);
+    /// assert_eq(p.apply(M, V).col(3), p.apply(M, V.col(3)));
+    /// ```
+    constexpr auto apply(BitMatrix<Word> const& M, BitMatrix<Word> const& V) const {
+        gf2_assert(M.is_square(), "Matrix must be square -- not {} x {}!", M.rows(), M.cols());
+        gf2_assert_eq(M.cols(), V.rows(), "Incompatible dimensions: {} != {}", M.cols(), V.rows());
 
+        // Edge case: If the polynomial is zero then the return value is the zero matrix.
+        if (is_zero()) return BitMatrix<Word>{V.rows(), V.cols()};
+
+        // Work backwards a la Horner starting from the leading coefficient which is 1.
+        auto result = V;
+        for (auto d = degree(); d > 0; --d) {
+            result = dot(M, result);
+            if (m_coeffs[d - 1]) result += V;
+        }
         return result;
     }
 
@@ -796,104 +1206,314 @@ public:
     /// assert_eq(r.to_string(), "x^2");
     /// ```
     BitPolynomial reduce_x_to_the(usize n, bool n_is_log2 = false) const {
+        gf2_probe("BitPolynomial::reduce_x_to_the");
+
         // Error check: anything mod 0 is not defined.
         if (is_zero()) throw std::invalid_argument("... mod P(x) is not defined for P(x) := 0.");
 
-        // Edge case: anything mod 1 = 0.
-        if (is_one()) return BitPolynomial<Word>::zero();
+        // The work is done by a `ModContext` -- keep one around yourself if you need lots of reductions mod P(x).
+        return ModContext<Word>{*this}.reduce_x_to_the(n, n_is_log2);
+    }
 
-        // Edge case: x^0 = 1 and 1 mod P(x) = 1 for any P(x) != 1 (we already handled the case where P(x) := 1).
-        if (n == 0 && !n_is_log2) return BitPolynomial<Word>::one();
+    /// If this polynomial is P(x) we return a `ModContext` that does repeated reductions mod P(x).
+    ///
+    /// The context precomputes and keeps the table of `x^{d+i} mod P(x)` and the workspaces that `reduce_x_to_the`
+    /// would otherwise build on every call. Use it when you need lots of powers of `x` mod the same P(x).
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if the polynomial is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::x_to_the(3) + BitPolynomial<>::x_to_the(1) + BitPolynomial<>::one();
+    /// auto ctx = p.reducer();
+    /// for (auto n = 0uz; n < 20; ++n) assert_eq(ctx.x_to_the(n), p.reduce_x_to_the(n));
+    /// assert_eq(ctx.x_to_the_2_to_the(100), p.reduce_x_to_the(100, true));
+    /// ```
+    ModContext<Word> reducer() const { return ModContext<Word>{*this}; }
 
-        // The BitPolynomial P(x) is non-zero so can be written as P(x) = x^d + p(x) where degree(p) < d.
-        auto d = degree();
+    /// @}
+    /// @name Minimal Polynomials of Bit Sequences:
+    /// @{
 
-        // Edge case: P(x) = x + c where c is a constant so x = P(x) + c (subtraction in GF(2) is the same as addition).
-        // Then x^e = (P(x) + c)^e = terms in powers of P(x) + c^e. Hence, x^e mod P(x) = c^e = c.
-        if (d == 1) return BitPolynomial<Word>::constant(m_coeffs.get(0));
-
-        // This polynomial is P(x) where P(x) = x^d + p(x) where p(x) = p_0 + p_1 x + ... + p_{d-1} x^{d-1}.
-        // All that matters are the `d` coefficients of p(x).
-        auto p = m_coeffs.sub(0, d);
-
-        // A lambda to perform: q(x) <- x*q(x) mod P(x) where degree(q) < d.
-        // The lambda works in-place on the coefficients of q(x) passed as a bit-vector q of size d.
-        auto times_x_step = [&](auto& q) {
-            bool add_p = q[d - 1];
-            q >>= 1;
-            if (add_p) q ^= p;
-        };
+    /// Returns the minimal polynomial of the bit sequence `seq`.
+    ///
+    /// If `seq` holds the `N` bits `s_0, s_1, ..., s_{N-1}` then we return the monic polynomial
+    /// `m(x) = m_0 + m_1 x + ... + x^L` of least degree with `m_0 s_i + m_1 s_{i+1} + ... + s_{i+L} = 0` for all
+    /// `0 <= i < N - L`. `L` is the _linear complexity_ of the sequence --- the length of the shortest linear feedback
+    /// shift register that generates it --- and `m(x)` is the reciprocal `x^L C(1/x)` of the register's connection
+    /// polynomial `C(x)`. An all-zero (or empty) sequence has `m(x) = 1`.
+    ///
+    /// Sequences with fewer than `gf2::FAST_MINIMAL_POLYNOMIAL_THRESHOLD` bits are handled by a `gf2::BerlekampMassey`
+    /// engine which costs `O(N L)` bit operations done a word at a time. Longer ones use a half-GCD of `x^N` and the
+    /// reversed sequence built on the fast polynomial multiplication, which costs `O(M(N) log N)` where `M(N)` is the
+    /// cost of multiplying two polynomials of degree `N`.
+    ///
+    /// # Note
+    /// `m(x)` is unique if `N >= 2L`, which is always the case if `seq` comes from a register of length at most `N/2`.
+    /// For shorter sequences there can be several polynomials that fit and the two methods may pick different ones.
+    ///
+    /// # Example
+    /// ```
+    /// // The sequence s_{i+4} = s_{i+1} + s_i from the register with m(x) = 1 + x + x^4.
+    /// auto s = BitVector<>::zeros(30);
+    /// s.set(0);
+    /// for (auto i = 0uz; i + 4 < s.size(); ++i) s.set(i + 4, s[i + 1] ^ s[i]);
+    /// auto m = BitPolynomial<>::minimal_polynomial(s);
+    /// assert_eq(m.to_string(), "1 + x + x^4");
+    /// assert_eq(BitPolynomial<>::minimal_polynomial(BitVector<>::zeros(10)), BitPolynomial<>::one());
+    /// assert_eq(BitPolynomial<>::minimal_polynomial(BitVector<>::from_string("0001").value()).degree(), 4);
+    /// ```
+    ///
+    /// # Example (recovers a random register from a long output stream with both methods)
+    /// ```
+    /// auto p = BitPolynomial<u32>::random(9'000);
+    /// auto s = BitVector<u32>::random(30'000);
+    /// for (auto i = 0uz; i + 9'000 < s.size(); ++i) {
+    ///     auto sum = false;
+    ///     for (auto j = p.coefficients().first_set(); *j < 9'000; j = p.coefficients().next_set(*j)) sum ^= s[i + *j];
+    ///     s.set(i + 9'000, sum);
+    /// }
+    /// auto m = BitPolynomial<u32>::minimal_polynomial(s);
+    /// assert(m.degree() <= 9'000);
+    /// assert_eq(p % m, BitPolynomial<u32>::zero());
+    /// BerlekampMassey<u32> bm;
+    /// bm.push(s.span(0, 18'000));
+    /// assert_eq(bm.minimal_polynomial(), m);
+    /// ```
+    template<BitStore Src>
+    static BitPolynomial minimal_polynomial(Src const& sequence) {
+        if (sequence.size() >= FAST_MINIMAL_POLYNOMIAL_THRESHOLD)
+            return half_gcd_minimal_polynomial(coeffs_type::from(sequence));
+        BerlekampMassey<Word> engine;
+        engine.push(sequence);
+        return engine.minimal_polynomial();
+    }
 
-        // Iteratively precompute x^{d+i} mod P(x) for i = 0, 1, ..., d-1 starting with x^d mod P(x) ~ p.
-        // We store all those bit-vectors in a standard `std::vector` of length d.
-        std::vector<coeffs_type> power_mod(d, coeffs_type{d});
-        power_mod[0] = p;
-        for (auto i = 1uz; i < d; ++i) {
-            power_mod[i] = power_mod[i - 1];
-            times_x_step(power_mod[i]);
-        }
+    /// @}
+    /// @name Irreducibility & Factorization:
+    /// @{
 
-        // Some workspace we use/reuse below in order to minimize allocations/deallocations.
-        coeffs_type s{2 * d}, h{d};
-
-        // lambda to perform: q(x) <- q(x)^2 mod P(x) where degree(q) < d.
-        // The lambda works in-place on the coefficients of q(x) passed as a bit-vector q of size d.
-        auto square_step = [&](auto& q) {
-            // Square q(x) storing the result in workspace `s`.
-            q.riffled(s);
-
-            // Split s(x) = l(x) + x^d * h(x) where l(x) & h(x) are both of degree less than d.
-            // We reuse q(x) for l(x).
-            s.split_at(d, q, h);
-
-            // s(x) = q(x) + x^d h(x) so s(x) mod P(x) = q(x) + x^d h(x) mod P(x) which we handle term by term.
-            // If h(x) != 0 then at most every second term in h(x) is 1 (nature of bit-polynomial squares in GF(2)).
-            if (auto h_first = h.first_set()) {
-                auto h_last = h.last_set();
-                for (auto i = *h_first; i <= *h_last; i += 2)
-                    if (h[i]) q ^= power_mod[i];
+    /// Returns `true` if this bit-polynomial is irreducible, i.e. it has positive degree and no non-trivial factors.
+    ///
+    /// Most polynomials have a small factor, so we start with Ben-Or's test: for `i = 1, 2, ...` we check that
+    /// `gcd(x^(2^i) - x, P)` is one, which fails if `P(x)` has a factor whose degree divides `i`. After a few steps we
+    /// switch to Rabin's test: `P(x)` of degree `d` is irreducible if and only if `x^(2^d) = x mod P(x)` and
+    /// `gcd(x^(2^(d/q)) - x, P) = 1` for every prime `q` dividing `d`. All the powers `x^(2^i) mod P(x)` come from
+    /// a `gf2::ModContext`. The early ones come from repeated squaring & the Rabin ones from `ModContext::frobenius`,
+    /// whose modular compositions replace the `d` squarings by about `sqrt(d) log(d)` modular products.
+    ///
+    /// # Example
+    /// ```
+    /// auto p = BitPolynomial<>::x_to_the(8) + BitPolynomial<>::x_to_the(4) + BitPolynomial<>::x_to_the(3) +
+    ///          BitPolynomial<>::x_to_the(1) + BitPolynomial<>::one();
+    /// assert(p.is_irreducible());
+    /// assert(!(p * p).is_irreducible());
+    /// assert(!BitPolynomial<>::zero().is_irreducible());
+    /// assert(!BitPolynomial<>::one().is_irreducible());
+    /// assert(BitPolynomial<>::x_to_the(1).is_irreducible());
+    /// assert(BitPolynomial<>::ones(1).is_irreducible());
+    /// assert(BitPolynomial<>::ones(2).is_irreducible());
+    /// assert(!BitPolynomial<>::ones(3).is_irreducible());
+    /// ```
+    ///
+    /// # Example (compare with a count of the irreducible polynomials of degree 10)
+    /// ```
+    /// auto count = 0uz;
+    /// for (auto bits = 0uz; bits < 1024; ++bits) {
+    ///     auto p = BitPolynomial<u8>::from(10, [&](usize i) { return i == 10 || ((bits >> i) & 1) == 1; });
+    ///     if (p.is_irreducible()) ++count;
+    /// }
+    /// assert_eq(count, 99);
+    /// ```
+    bool is_irreducible() const {
+        // Constants are not irreducible & all linear polynomials are.
+        auto d = degree();
+        if (d == 0) return false;
+        if (d == 1) return true;
+
+        // Cheap checks for the factors x & 1 + x.
+        if (!m_coeffs.get(0) || m_coeffs.count_ones() % 2 == 0) return false;
+
+        // The last step i if we check all the Ben-Or gcds & the last Ben-Or step before we switch to Rabin otherwise.
+        auto half = d / 2;
+        auto sieve = std::min(half, static_cast<usize>(std::bit_width(d)));
+
+        // Rabin also needs the gcds at the steps d/q for the primes q that divide d.
+        std::vector<usize> checks;
+        for (auto q = 2uz, m = d; m > 1; ++q) {
+            if (q * q > m) q = m;
+            if (m % q == 0) {
+                checks.push_back(d / q);
+                while (m % q == 0) m /= q;
             }
-        };
-
-        // Our return value r(x) := x^e mod P(x) has degree < d: r(x) = r_0 + r_1 x + ... + r_{d-1} x^{d-1}.
-        coeffs_type r{d};
-
-        // If `n_is_log2` is `true`, we are reducing x^(2^n) mod P(x) which is done iteratively by squaring.
-        if (n_is_log2) {
-            // Note that we already handled edge case where P(x) = x + c above.
-            // Start with r(x) = x mod P(x) -> x^2 mod P(x) -> x^4 mod P(x) ...
-            r[1] = true;
-            for (auto i = 0uz; i < n; ++i) square_step(r);
-            return BitPolynomial{std::move(r)};
         }
 
-        // Small exponent case: n < d => x^n mod P(x) = x^n.
-        if (n < d) return BitPolynomial::x_to_the(n);
-
-        // Matching exponent case: n = d => x^n mod P(x) = x^d mod P(x) = p(x).
-        if (n == d) return BitPolynomial{std::move(p)};
+        // Run through the powers r(x) = x^(2^i) mod P(x) for i = 1, 2, ...
+        auto ctx = reducer();
+        auto r = x_to_the(1);
+        r.resize(d);
+        auto has_factor = [&] {
+            auto r_minus_x = r;
+            r_minus_x[1] ^= true;
+            return !gcd(r_minus_x, *this).is_one();
+        };
+        for (auto i = 1uz; i <= sieve; ++i) {
+            ctx.square_in_place(r);
+            if (has_factor()) return false;
+        }
 
-        // General case: n > d is handled by a square & multiply algorithm.
-        usize n_bit = std::bit_floor(n);
+        // If we ran Ben-Or all the way the answer is yes.
+        if (sieve == half) return true;
+
+        // Otherwise Rabin's steps are far apart & the Frobenius map jumps from one to the next in a few compositions.
+        std::ranges::sort(checks);
+        auto i = sieve;
+        for (auto c : checks) {
+            if (c <= sieve) continue;
+            r = ctx.frobenius(r, c - i);
+            i = c;
+            if (has_factor()) return false;
+        }
 
-        // Start with r(x) = x mod P(x) which takes care of the most significant binary digit in n.
-        // TODO: We could start a bit further along with a higher power r(x) := x^? mod P(x) where ? < n but > 1.
-        r[1] = 1;
-        n_bit >>= 1;
+        // Finally, Rabin needs x^(2^d) = x mod P(x).
+        r = ctx.frobenius(r, d - i);
+        return r == x_to_the(1);
+    }
 
-        // And off we go ...
-        while (n_bit) {
+    /// Returns `true` if this bit-polynomial is primitive given the distinct prime factors of `2^d - 1`.
+    ///
+    /// A polynomial `P(x)` of degree `d` is primitive if it is irreducible and `x` has order `2^d - 1` modulo `P(x)`,
+    /// which makes `P(x)` the characteristic polynomial of a maximal length LFSR. Given the primes `q` dividing
+    /// `2^d - 1` the test is `x^((2^d - 1)/q) != 1 mod P(x)` for each of them, with each power worked out by repeated
+    /// squaring over the bits of the exponent.
+    ///
+    /// Factoring `2^d - 1` is the hard part, so any factor that does not fit in a `u64` is left to us: whatever part
+    /// of `2^d - 1` is not accounted for by powers of the primes in `prime_factors` is taken to be one more (large)
+    /// prime factor. In particular, calling `is_primitive()` with no factors is the full test when `2^d - 1` is a
+    /// Mersenne prime.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if one of the passed numbers is not a
+    /// non-trivial factor of `2^d - 1`.
+    ///
+    /// # Example
+    /// ```
+    /// auto x = [](usize n) { return BitPolynomial<>::x_to_the(n); };
+    /// std::array<u64, 3> factors{3, 5, 17};
+    /// assert(( x(8) + x(4) + x(3) + x(2) + x(0)).is_primitive(factors));
+    /// assert((x(8) + x(4) + x(3) + x(1) + x(0)).is_irreducible());
+    /// assert(!(x(8) + x(4) + x(3) + x(1) + x(0)).is_primitive(factors));
+    /// assert((x(31) + x(3) + x(0)).is_primitive());
+    /// assert((x(1279) + x(216) + x(0)).is_primitive());
+    /// assert(!(x(1279) + x(217) + x(0)).is_primitive());
+    /// assert((x(1) + x(0)).is_primitive());
+    /// assert(!x(1).is_primitive());
+    /// ```
+    bool is_primitive(std::span<u64 const> prime_factors = {}) const {
+        if (!is_irreducible()) return false;
+
+        // In degree 1 the multiplicative group is trivial so 1 + x is primitive & x is not.
+        auto d = degree();
+        if (d == 1) return m_coeffs.get(0);
+
+        // We work with N = 2^d - 1 & the part of it that is left after dividing out the passed primes.
+        auto ctx = reducer();
+        auto n = coeffs_type::ones(d);
+        auto rest = n;
+        auto multiplicity = std::vector<usize>(prime_factors.size(), 0);
+        coeffs_type quotient;
+        for (auto k = 0uz; k < prime_factors.size(); ++k) {
+            auto q = prime_factors[k];
+            if (q < 2 || details::divide(n, q, quotient) != 0)
+                throw std::invalid_argument("The passed primes must all be factors of 2^d - 1.");
+            if (ctx.x_to_the(quotient).is_one()) return false;
+            while (rest.last_set() && details::divide(rest, q, quotient) == 0) {
+                rest = quotient;
+                ++multiplicity[k];
+            }
+        }
 
-            // Always do a square step and then a times_x step if necessary (i.e. if current bit in N is set).
-            square_step(r);
-            if (n & n_bit) times_x_step(r);
+        // Any leftover part of N is taken to be prime & x^(N/rest) is x raised to the product of the known powers.
+        if (rest.count_ones() == 1 && rest.get(0)) return true;
+        auto y = ctx.x_to_the(1);
+        for (auto k = 0uz; k < prime_factors.size(); ++k) {
+            for (auto i = 0uz; i < multiplicity[k]; ++i) {
+                auto q = prime_factors[k];
+                auto power = polynomial_one(d);
+                for (auto b = std::bit_width(q); b-- > 0;) {
+                    ctx.square_in_place(power);
+                    if ((q >> b) & 1) power = ctx.multiply(power, y);
+                }
+                y = std::move(power);
+            }
+        }
+        return !y.is_one();
+    }
 
-            // On to the next bit position in n.
-            n_bit >>= 1;
+    /// Returns the factorization of this bit-polynomial into irreducible factors as (factor, multiplicity) pairs.
+    ///
+    /// The factors are sorted by degree (ties broken by comparing coefficients from the top down) and the product of
+    /// `factor^multiplicity` over the pairs is the original polynomial. A constant polynomial has no factors.
+    ///
+    /// We use the usual three stages: a square-free factorization from gcds with the derivative, a distinct-degree
+    /// factorization that splits off the product of the factors of degree `i` with `gcd(x^(2^i) - x, f)`, and finally
+    /// Cantor-Zassenhaus equal-degree splitting with the trace map `a + a^2 + ... + a^(2^(i-1)) mod f` for (seeded)
+    /// random `a`. The powers & traces all come from repeated squaring in a `gf2::ModContext`.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if the polynomial is the zero polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto x = [](usize n) { return BitPolynomial<>::x_to_the(n); };
+    /// auto p = x(1) * x(1) * (x(1) + x(0)) * (x(2) + x(1) + x(0)) * (x(2) + x(1) + x(0)) * (x(3) + x(1) + x(0));
+    /// auto f = p.factorization();
+    /// assert_eq(f.size(), 4);
+    /// assert_eq(f[0].first.to_string(), "x");
+    /// assert_eq(f[0].second, 2);
+    /// assert_eq(f[1].first.to_string(), "1 + x");
+    /// assert_eq(f[1].second, 1);
+    /// assert_eq(f[2].first.to_string(), "1 + x + x^2");
+    /// assert_eq(f[2].second, 2);
+    /// assert_eq(f[3].first.to_string(), "1 + x + x^3");
+    /// assert_eq(f[3].second, 1);
+    /// assert(x(0).factorization().empty());
+    /// ```
+    ///
+    /// # Example (multiplies a big random polynomial back together from its factors)
+    /// ```
+    /// auto p = BitPolynomial<u32>::random(3000) * BitPolynomial<u32>::random(500).squared();
+    /// auto product = BitPolynomial<u32>::one();
+    /// for (auto const& [f, m] : p.factorization()) {
+    ///     assert(f.is_irreducible());
+    ///     for (auto i = 0uz; i < m; ++i) product *= f;
+    /// }
+    /// assert_eq(product, p);
+    /// ```
+    std::vector<std::pair<BitPolynomial, usize>> factorization() const {
+        if (is_zero()) throw std::invalid_argument("The zero polynomial has no factorization.");
+
+        std::vector<std::pair<BitPolynomial, usize>> result;
+        auto f = *this;
+        f.make_monic();
+        for (auto const& [g, m] : square_free_factors(f)) {
+            for (auto const& [h, k] : distinct_degree_factors(g)) {
+                std::vector<BitPolynomial> irreducibles;
+                equal_degree_factors(h, k, irreducibles);
+                for (auto& factor : irreducibles) result.emplace_back(std::move(factor), m);
+            }
         }
 
-        // Made it.
-        return BitPolynomial{std::move(r)};
+        // Sort by degree & then by the coefficients from the top down.
+        std::ranges::sort(result, [](auto const& a, auto const& b) {
+            auto da = a.first.degree(), db = b.first.degree();
+            if (da != db) return da < db;
+            for (auto i = da + 1; i-- > 0;)
+                if (a.first[i] != b.first[i]) return b.first[i];
+            return false;
+        });
+        return result;
     }
 
     /// @}
@@ -1010,6 +1630,63 @@ public:
     /// @}
 
 private:
+    // Long division by `d` with the quotient in `q` & the remainder in `r` where `d` is not constant.
+    void long_divmod(BitPolynomial const& d, coeffs_type& q, coeffs_type& r) const {
+        auto n = degree();
+        auto m = d.degree();
+
+        // The remainder starts out as a copy of the live words of this polynomial.
+        auto n_words = words_needed<Word>(n + 1);
+        auto rem = std::pmr::vector<Word>(n_words + 1, Word{0}, memory_resource());
+        for (auto i = 0uz; i < n_words; ++i) rem[i] = m_coeffs.word(i);
+
+        // Precompute d(x) x^s for s = 0, 1, ... as word arrays so each division step is a plain word-wise `XOR`.
+        auto d_words = words_needed<Word>(m + 1);
+        auto len = d_words + 1;
+        auto shifted = std::pmr::vector<Word>(BITS<Word> * len, Word{0}, memory_resource());
+        for (auto s = 0uz; s < BITS<Word>; ++s) {
+            auto dst = shifted.data() + s * len;
+            for (auto i = 0uz; i < d_words; ++i) {
+                auto w = d.m_coeffs.word(i);
+                dst[i] ^= static_cast<Word>(w << s);
+                if (s != 0) dst[i + 1] ^= static_cast<Word>(w >> (BITS<Word> - s));
+            }
+        }
+
+        // Clear the remainder terms from the top down -- any term x^i we clear adds x^{i-m} to the quotient.
+        q = coeffs_type::zeros(n - m + 1);
+        for (auto i = n + 1; i-- > m;) {
+            auto [wi, mi] = index_and_mask<Word>(i);
+            if (!(rem[wi] & mi)) continue;
+            auto k = i - m;
+            auto [wk, sk] = index_and_offset<Word>(k);
+            auto src = shifted.data() + sk * len;
+            for (auto j = 0uz; j < len && wk + j < rem.size(); ++j) rem[wk + j] ^= src[j];
+            q.set(k);
+        }
+
+        // What is left has degree less than m.
+        r = coeffs_type::zeros(m);
+        for (auto i = 0uz; i < r.words(); ++i) r.set_word(i, rem[i]);
+    }
+
+    // Division by `d` with the quotient in `q` & the remainder in `r` using Newton iteration.
+    //
+    // If self has degree n and d has degree m then reversing everything turns self = q d + r into
+    // rev(self) = rev(q) rev(d) mod x^{n-m+1} & rev(d) has a constant term of 1 so has a power series inverse.
+    void newton_divmod(BitPolynomial const& d, coeffs_type& q, coeffs_type& r) const {
+        auto n = degree();
+        auto m = d.degree();
+        auto k = n - m + 1;
+        auto inv = details::inverse_series(details::reversed(d.m_coeffs, m + 1), k);
+        auto rev_q = details::truncated(convolve(details::reversed(m_coeffs, n + 1).sub(0, k), inv), k);
+        q = details::reversed(rev_q, k);
+
+        // The remainder is then self - q d which only needs the low m coefficients.
+        r = details::truncated(m_coeffs, m);
+        r ^= details::truncated(convolve(details::truncated(q, m), details::truncated(d.m_coeffs, m)), m);
+    }
+
     // Returns the number of "active" words underlying the coefficient bit-vector.
     // There may be high order trailing zero coefficients that have no real impact on most bit-polynomial calculations.
     // This method returns the number of "words" that matter in the coefficient bit-vector store of words.
@@ -1017,6 +1694,1301 @@ private:
         if (auto deg = m_coeffs.last_set()) return word_index<Word>(*deg) + 1;
         return 0;
     }
+
+    // A 2 x 2 matrix of polynomials that takes a pair (a, b) to (m00 a + m01 b, m10 a + m11 b).
+    // The half-GCD accumulates the Euclidean steps (a, b) -> (b, a - q b) in one of these.
+    struct EuclidMatrix {
+        BitPolynomial m00 = one(), m01 = zero(), m10 = zero(), m11 = one();
+
+        // Returns the pair (m00 a + m01 b, m10 a + m11 b).
+        std::pair<BitPolynomial, BitPolynomial> operator()(BitPolynomial const& a, BitPolynomial const& b) const {
+            auto c = m00 * a + m01 * b;
+            auto d = m10 * a + m11 * b;
+            c.make_monic();
+            d.make_monic();
+            return std::pair{std::move(c), std::move(d)};
+        }
+
+        // Appends a Euclidean step with quotient q: *this <- [0 1; 1 q] * (*this).
+        void step(BitPolynomial const& q) {
+            auto n0 = m00 + q * m10;
+            auto n1 = m01 + q * m11;
+            m00 = std::exchange(m10, std::move(n0));
+            m01 = std::exchange(m11, std::move(n1));
+        }
+
+        // Returns the product (*this) * rhs.
+        EuclidMatrix operator*(EuclidMatrix const& rhs) const {
+            return EuclidMatrix{m00 * rhs.m00 + m01 * rhs.m10, m00 * rhs.m01 + m01 * rhs.m11,
+                                m10 * rhs.m00 + m11 * rhs.m10, m10 * rhs.m01 + m11 * rhs.m11};
+        }
+    };
+
+    // Returns true if p(x) is zero or has degree less than m.
+    static constexpr bool degree_below(BitPolynomial const& p, usize m) { return p.is_zero() || p.degree() < m; }
+
+    // Returns p(x) div x^m, i.e. p(x) with its m lowest coefficients dropped.
+    static BitPolynomial shifted_down(BitPolynomial const& p, usize m) {
+        auto n = p.size();
+        return BitPolynomial{p.m_coeffs.sub(std::min(m, n), n)};
+    }
+
+    // Returns the matrix M of Euclidean steps with M(a, b) = (c, d), consecutive remainders in the Euclidean algorithm
+    // for (a, b), where degree(c) >= ceil(n/2) > degree(d) and n = degree(a) > degree(b).
+    //
+    // This is the half-GCD of Thull & Yap: the quotients in the first half of Euclid only depend on the top halves of
+    // a & b. So we get the matrix for those from a recursive call on the top halves, apply it, take one more Euclidean
+    // step, and then recurse again on the top parts of that new pair.
+    static EuclidMatrix half_gcd(BitPolynomial const& a, BitPolynomial const& b) {
+        auto n = a.degree();
+        auto m = (n + 1) / 2;
+        if (degree_below(b, m)) return EuclidMatrix{};
+
+        // Small problems are faster with plain Euclidean steps.
+        if (n < HALF_GCD_THRESHOLD) {
+            EuclidMatrix result;
+            auto c = a, d = b;
+            while (!degree_below(d, m)) {
+                auto [q, r] = c.divmod(d);
+                result.step(q);
+                c = std::exchange(d, std::move(r));
+            }
+            return result;
+        }
+
+        // The first recursive call on the top halves gets us to a pair (c, d) with degree(c) >= m.
+        auto result = half_gcd(shifted_down(a, m), shifted_down(b, m));
+        auto [c, d] = result(a, b);
+        if (degree_below(d, m)) return result;
+
+        // One Euclidean step by hand.
+        auto [q, e] = c.divmod(d);
+        result.step(q);
+        if (degree_below(e, m)) return result;
+
+        // The second recursive call finishes the job working on the top 2(degree(d) - m) or so terms of (d, e).
+        auto k = 2 * m - d.degree();
+        return half_gcd(shifted_down(d, k), shifted_down(e, k)) * result;
+    }
+
+    // Returns the minimal polynomial of the bit sequence `sequence` from a half-GCD.
+    //
+    // If A(x) = s_0 x^{N-1} + s_1 x^{N-2} + ... + s_{N-1} is the reversed sequence then m(x) is the minimal polynomial
+    // exactly when m(x) A(x) = r(x) mod x^N with degree(r) < degree(m) = L as small as possible. The extended Euclidean
+    // algorithm on (x^N, A) produces the remainders r_k = s_k x^N + t_k A & m(x) is the first t_k with
+    // degree(r_k) < degree(t_k). The half-GCD jumps to the remainders straddling degree N/2 and at most one more
+    // Euclidean step is needed from there.
+    static BitPolynomial half_gcd_minimal_polynomial(coeffs_type const& sequence) {
+        auto n = sequence.size();
+        BitPolynomial a{details::reversed(sequence, n)};
+        if (a.is_zero()) return one();
+        auto x_to_n = x_to_the(n);
+
+        auto matrix = half_gcd(x_to_n, a);
+        auto [c, d] = matrix(x_to_n, a);
+        auto result = std::move(matrix.m11);
+        result.make_monic();
+        if (d.is_non_zero() && d.degree() >= result.degree()) {
+            result = matrix.m01 + (c / d) * result;
+            result.make_monic();
+        }
+        return result;
+    }
+
+    // Returns the polynomial 1 with room for `d` coefficients.
+    static BitPolynomial polynomial_one(usize d) {
+        auto result = one();
+        result.resize(d);
+        return result;
+    }
+
+    // Returns f'(x) -- in GF(2) only the odd powers survive & x^{2i+1} -> x^{2i}.
+    static BitPolynomial derivative(BitPolynomial const& f) {
+        auto n = f.size();
+        auto result = zeros(n > 0 ? n - 1 : 0);
+        for (auto i = f.m_coeffs.next_set(0); i; i = f.m_coeffs.next_set(*i))
+            if (*i % 2 == 1) result.m_coeffs.set(*i - 1);
+        return result;
+    }
+
+    // Returns g(x) where g(x)^2 = f(x) -- `f` should only have even powers of x.
+    static BitPolynomial square_root(BitPolynomial const& f) {
+        auto result = zeros(f.degree() / 2);
+        for (auto i = f.m_coeffs.first_set(); i; i = f.m_coeffs.next_set(*i)) result.m_coeffs.set(*i / 2);
+        return result;
+    }
+
+    // Returns the square-free parts g_i of the monic f = g_1 g_2^2 g_3^3 ... as (g_i, i) pairs (skipping g_i = 1).
+    //
+    // Over GF(2) the derivative of a square is zero, so gcd(f, f') picks out the repeated factors along with all of
+    // f's squares. We peel off the g_i one multiplicity at a time & what's left at the end is a perfect square.
+    static std::vector<std::pair<BitPolynomial, usize>> square_free_factors(BitPolynomial const& f) {
+        std::vector<std::pair<BitPolynomial, usize>> result;
+        auto c = gcd(f, derivative(f));
+        auto w = f / c;
+        for (auto i = 1uz; !w.is_one(); ++i) {
+            auto y = gcd(w, c);
+            if (auto g = w / y; !g.is_one()) result.emplace_back(std::move(g), i);
+            w = std::move(y);
+            c /= w;
+        }
+        if (!c.is_one()) {
+            for (auto& [g, m] : square_free_factors(square_root(c))) result.emplace_back(std::move(g), 2 * m);
+        }
+        return result;
+    }
+
+    // Returns the products h_k of all the degree k irreducible factors of the square-free f as (h_k, k) pairs.
+    static std::vector<std::pair<BitPolynomial, usize>> distinct_degree_factors(BitPolynomial const& f) {
+        std::vector<std::pair<BitPolynomial, usize>> result;
+        auto rest = f;
+        auto ctx = ModContext<Word>{rest};
+        auto h = ctx.x_to_the(1);
+        for (auto k = 1uz; 2 * k <= rest.degree(); ++k) {
+            // h = x^(2^k) mod rest & the factors of degree dividing k are those of gcd(h - x, rest).
+            ctx.square_in_place(h);
+            auto h_minus_x = h;
+            h_minus_x[1] ^= true;
+            auto g = gcd(h_minus_x, rest);
+            if (!g.is_one()) {
+                rest /= g;
+                rest.make_monic();
+                result.emplace_back(std::move(g), k);
+                ctx = ModContext<Word>{rest};
+                h = ctx.reduce(h);
+                h.resize(rest.degree());
+            }
+        }
+        if (!rest.is_one()) result.emplace_back(rest, rest.degree());
+        return result;
+    }
+
+    // Splits f, a product of distinct irreducible factors of degree k, into those factors (Cantor-Zassenhaus).
+    //
+    // For random a the trace a + a^2 + ... + a^(2^(k-1)) mod f is 0 or 1 modulo each factor with equal odds, so its gcd
+    // with f is a proper factor more than half the time. The random draws are seeded so the results are repeatable.
+    static void equal_degree_factors(BitPolynomial const& f, usize k, std::vector<BitPolynomial>& out) {
+        auto n = f.degree();
+        if (n == k) {
+            out.push_back(f);
+            return;
+        }
+        auto ctx = ModContext<Word>{f};
+        for (auto seed = std::uint64_t{n};; ++seed) {
+            auto a = seeded_random(n - 1, seed);
+            auto trace = a;
+            for (auto i = 1uz; i < k; ++i) {
+                ctx.square_in_place(a);
+                trace += a;
+            }
+            auto g = gcd(trace, f);
+            if (auto dg = g.degree(); dg > 0 && dg < n) {
+                auto other = f / g;
+                other.make_monic();
+                equal_degree_factors(g, k, out);
+                equal_degree_factors(other, k, out);
+                return;
+            }
+        }
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Greatest common divisors ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// Returns the greatest common divisor of two bit-polynomials.
+///
+/// We use the binary GCD algorithm which needs just word-level additions and shifts. Any common power of `x` is taken
+/// out first. After that both polynomials have a constant term of one so their sum is divisible by `x` and we can
+/// replace the one with the higher degree by that sum shifted down. By convention `gcd(0, 0) = 0`.
+///
+/// # Example
+/// ```
+/// auto p = BitPolynomial<>::ones(2) * BitPolynomial<>::ones(1) * BitPolynomial<>::x_to_the(3);
+/// auto q = BitPolynomial<>::ones(2) * BitPolynomial<>::x_to_the(1);
+/// assert_eq(gcd(p, q), BitPolynomial<>::ones(2) * BitPolynomial<>::x_to_the(1));
+/// assert_eq(gcd(p, BitPolynomial<>::zero()), p);
+/// assert_eq(gcd(BitPolynomial<>::ones(2), BitPolynomial<>::ones(1)).to_string(), "1");
+/// auto r = BitPolynomial<u8>::random(500);
+/// auto a = r * BitPolynomial<u8>::random(300);
+/// auto b = r * BitPolynomial<u8>::random(400);
+/// assert_eq(gcd(a, b) % r, BitPolynomial<u8>::zero());
+/// ```
+template<Unsigned Word>
+BitPolynomial<Word>
+gcd(BitPolynomial<Word> const& a, BitPolynomial<Word> const& b) {
+    // Edge cases: gcd(a, 0) = a and gcd(0, b) = b.
+    if (a.is_zero() || b.is_zero()) {
+        auto result = a.is_zero() ? b : a;
+        result.make_monic();
+        return result;
+    }
+
+    // Work on copies of the coefficients that are big enough to hold either polynomial.
+    auto n = std::max(a.degree(), b.degree()) + 1;
+    auto u = details::truncated(a.coefficients(), n);
+    auto v = details::truncated(b.coefficients(), n);
+
+    // Take out the common power of x & make sure both polynomials have a constant term of one.
+    auto ku = u.leading_zeros();
+    auto kv = v.leading_zeros();
+    u <<= ku;
+    v <<= kv;
+
+    // Replace the higher degree polynomial by the sum which has a zero constant term but the same gcd.
+    auto du = u.last_set().value();
+    auto dv = v.last_set().value();
+    while (true) {
+        if (du < dv) {
+            std::swap(u, v);
+            std::swap(du, dv);
+        }
+        u ^= v;
+        if (u.none()) break;
+        u <<= u.leading_zeros();
+        du = u.last_set().value();
+    }
+
+    // Put back the common power of x.
+    BitPolynomial<Word> result{std::move(v)};
+    result.times_x_to_the(std::min(ku, kv));
+    result.make_monic();
+    return result;
+}
+
+/// Returns the greatest common divisor `g` of two bit-polynomials along with the Bezout coefficients `s` and `t`.
+///
+/// On return `s(x) a(x) + t(x) b(x) = g(x)` where `g = gcd(a, b)`. We use the extended Euclidean algorithm.
+/// The results are returned as a tuple `[g, s, t]`.
+///
+/// # Example
+/// ```
+/// auto a = BitPolynomial<>::ones(4) * BitPolynomial<>::ones(1);
+/// auto b = BitPolynomial<>::ones(1) * BitPolynomial<>::x_to_the(2);
+/// auto [g, s, t] = xgcd(a, b);
+/// assert_eq(g.to_string(), "1 + x");
+/// assert_eq(s * a + t * b, g);
+/// auto p = BitPolynomial<u16>::random(700);
+/// auto q = BitPolynomial<u16>::random(500);
+/// auto [g2, s2, t2] = xgcd(p, q);
+/// assert_eq(g2, gcd(p, q));
+/// assert_eq(s2 * p + t2 * q, g2);
+/// ```
+template<Unsigned Word>
+std::tuple<BitPolynomial<Word>, BitPolynomial<Word>, BitPolynomial<Word>>
+xgcd(BitPolynomial<Word> const& a, BitPolynomial<Word> const& b) {
+    using poly = BitPolynomial<Word>;
+
+    // Keep r0 = s0 a + t0 b and r1 = s1 a + t1 b as we run Euclid on the remainders (subtraction is addition in GF(2)).
+    poly r0 = a, r1 = b;
+    poly s0 = poly::one(), s1 = poly::zero();
+    poly t0 = poly::zero(), t1 = poly::one();
+    while (r1.is_non_zero()) {
+        auto [q, r] = r0.divmod(r1);
+        auto s2 = s0 + q * s1;
+        auto t2 = t0 + q * t1;
+        r0 = std::exchange(r1, std::move(r));
+        s0 = std::exchange(s1, std::move(s2));
+        t0 = std::exchange(t1, std::move(t2));
+    }
+    r0.make_monic();
+    s0.make_monic();
+    t0.make_monic();
+    return std::tuple{std::move(r0), std::move(s0), std::move(t0)};
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Searching for irreducible polynomials ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// Returns the indices `i` in `[0, n)` for which the bit-polynomial `candidate(i)` is irreducible in increasing order.
+///
+/// The candidates are built & tested with `BitPolynomial::is_irreducible` in parallel on the threads of `exec` (pass
+/// `gf2::seq` to run everything on the calling thread). Most candidates fail fast on a small factor, so this is the
+/// way to hunt for irreducible (or, for Mersenne prime degrees, primitive) trinomials and pentanomials.
+///
+/// # Example
+/// ```
+/// auto x = [](usize n) { return BitPolynomial<>::x_to_the(n); };
+/// auto ks = find_irreducible(gf2::par, 127, [&](usize k) { return x(127) + x(k) + x(0); });
+/// assert_eq(ks.size(), 10);
+/// assert_eq(ks[0], 1);
+/// assert_eq(ks[1], 7);
+/// assert_eq(ks[2], 15);
+/// ThreadPool pool{2};
+/// assert(find_irreducible(pool, 127, [&](usize k) { return x(127) + x(k) + x(0); }) == ks);
+/// assert(find_irreducible(gf2::seq, 127, [&](usize k) { return x(127) + x(k) + x(0); }) == ks);
+/// ```
+template<Executor Exec, std::invocable<usize> Fn>
+std::vector<usize>
+find_irreducible(Exec&& exec, usize n, Fn&& candidate) {
+    // Every index gets its own flag so the threads never write to the same element.
+    std::vector<char> found(n, 0);
+    details::for_each_chunk(exec, n, 1, [&](usize begin, usize end) {
+        for (auto i = begin; i < end; ++i) found[i] = candidate(i).is_irreducible() ? 1 : 0;
+    });
+    std::vector<usize> result;
+    for (auto i = 0uz; i < n; ++i)
+        if (found[i]) result.push_back(i);
+    return result;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Arithmetic modulo a fixed bit-polynomial ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// A `ModContext` does arithmetic modulo a fixed bit-polynomial `P(x)`.
+///
+/// If `P(x)` has degree `d` then the context precomputes the table of `x^{d+i} mod P(x)` for `i = 0, ..., d-1` once.
+/// That is the table `BitPolynomial::reduce_x_to_the` builds internally. Any product of two polynomials of degree
+/// less than `d` has degree less than `2d` so can then be reduced by adding a few table entries.
+///
+/// A sparse `P(x)` needs no table as folding with its few terms is faster. Neither does a dense `P(x)` of degree at
+/// least `gf2::FAST_REDUCTION_THRESHOLD`, which is reduced by two fast multiplications with a precomputed power series
+/// inverse instead (Barrett reduction).
+///
+/// Use a context if you need many reductions modulo the same `P(x)` as the setup cost is then paid just once.
+/// `BitPolynomial::reducer` is a convenient way to get one.
+///
+/// # Note
+/// A context owns some workspace that its methods reuse to avoid allocations, so one context should not be shared by
+/// several threads at the same time. Give each thread its own copy instead.
+///
+/// # Example
+/// ```
+/// auto P = BitPolynomial<>::x_to_the(8) + BitPolynomial<>::x_to_the(4) + BitPolynomial<>::x_to_the(3) +
+///          BitPolynomial<>::ones(1);
+/// ModContext ctx{P};
+/// auto a = BitPolynomial<>::random(7);
+/// auto b = BitPolynomial<>::random(7);
+/// assert_eq(ctx.multiply(a, b), a * b % P);
+/// assert_eq(ctx.reduce_x_to_the(255), BitPolynomial<>::one());
+/// assert_eq(ctx.reduce_x_to_the(1000), P.reduce_x_to_the(1000));
+/// assert(ModContext{BitPolynomial<>::x_to_the(5)}.reduce_x_to_the(1000).is_zero());
+/// ```
+template<Unsigned Word = usize>
+class ModContext {
+public:
+    /// The type of the polynomials we work with.
+    using polynomial_type = BitPolynomial<Word>;
+
+    /// The type used to store the bit-polynomial coefficients.
+    using coeffs_type = BitVector<Word>;
+
+    /// Constructs a context for arithmetic modulo the bit-polynomial `P(x)`.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `P` is the zero polynomial.
+    explicit ModContext(polynomial_type const& P) : m_modulus{P}, m_degree{P.degree()} {
+        // Error check: anything mod 0 is not defined.
+        if (P.is_zero()) throw std::invalid_argument("... mod P(x) is not defined for P(x) := 0.");
+        m_modulus.make_monic();
+
+        // Edge case: everything is zero mod 1 so there is nothing to precompute.
+        auto d = m_degree;
+        if (d == 0) return;
+
+        // P(x) = x^d + p(x) where degree(p) < d so x^d mod P(x) = p(x).
+        m_p = m_modulus.coefficients().sub(0, d);
+
+        // A sparse P(x) like a trinomial is faster to reduce by folding with the few terms of p(x) than with a table.
+        // Each fold costs a shifted add per term & knocks at least d - e_max terms off the part still above x^d.
+        for (auto i = m_p.first_set(); i; i = m_p.next_set(*i)) m_terms.push_back(*i);
+        auto e_max = m_terms.empty() ? 0uz : m_terms.back();
+        auto folds = (d + (d - e_max) - 1) / (d - e_max);
+        m_sparse = 16 * m_terms.size() * folds <= d;
+
+        // A big dense P(x) is faster to reduce by two multiplications with the power series inverse of its reversal.
+        m_barrett = !m_sparse && d >= FAST_REDUCTION_THRESHOLD;
+        if (m_barrett) m_inverse = details::inverse_series(details::reversed(m_modulus.coefficients(), d + 1), d);
+
+        // Otherwise iteratively precompute x^{d+i} mod P(x) for i = 0, 1, ..., d-1 starting with x^d mod P(x) ~ p.
+        if (!m_sparse && !m_barrett) {
+            m_power_mod.assign(d, m_p);
+            for (auto i = 1uz; i < d; ++i) {
+                m_power_mod[i] = m_power_mod[i - 1];
+                times_x_step(m_power_mod[i]);
+            }
+        }
+
+        // Size the workspaces once & for all.
+        m_s.resize(2 * d);
+        m_h.resize(d);
+    }
+
+    /// Returns the modulus `P(x)`.
+    constexpr polynomial_type const& modulus() const { return m_modulus; }
+
+    /// Returns the degree of the modulus `P(x)`.
+    constexpr usize degree() const { return m_degree; }
+
+    /// Returns `h(x) mod P(x)`.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::ones(3);
+    /// ModContext ctx{P};
+    /// auto h = BitPolynomial<>::random(100);
+    /// assert_eq(ctx.reduce(h), h % P);
+    /// ```
+    polynomial_type reduce(polynomial_type const& h) const {
+        auto d = m_degree;
+        if (d == 0) return polynomial_type::zero();
+        if (h.degree() < d) return h;
+
+        // Anything with degree at least 2d is handled by long division.
+        if (h.degree() >= 2 * d) return h % m_modulus;
+
+        // Otherwise we add the table entries for the high order terms.
+        auto q = h.coefficients().sub(0, d);
+        reduce_high(h.coefficients(), q);
+        return polynomial_type{std::move(q)};
+    }
+
+    /// Returns `a(x) b(x) mod P(x)`.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(5) + BitPolynomial<>::x_to_the(2) + BitPolynomial<>::one();
+    /// ModContext ctx{P};
+    /// auto a = BitPolynomial<>::random(20);
+    /// auto b = BitPolynomial<>::random(30);
+    /// assert_eq(ctx.multiply(a, b), a * b % P);
+    /// ```
+    polynomial_type multiply(polynomial_type const& a, polynomial_type const& b) const {
+        return reduce(reduce(a) * reduce(b));
+    }
+
+    /// Returns `a(x)^2 mod P(x)`.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(5) + BitPolynomial<>::x_to_the(2) + BitPolynomial<>::one();
+    /// ModContext ctx{P};
+    /// auto a = BitPolynomial<>::random(20);
+    /// assert_eq(ctx.square(a), a * a % P);
+    /// ```
+    polynomial_type square(polynomial_type const& a) const { return reduce(reduce(a).squared()); }
+
+    /// Replaces `a(x)` by `a(x)^2 mod P(x)`.
+    ///
+    /// This reuses the context's workspaces so, once `a` has `degree()` coefficients, there are no allocations unless
+    /// the context uses Barrett reduction, whose products need their own space.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(8) + BitPolynomial<>::x_to_the(4) + BitPolynomial<>::x_to_the(3) +
+    ///          BitPolynomial<>::ones(1);
+    /// ModContext ctx{P};
+    /// auto a = BitPolynomial<>::x_to_the(7) + BitPolynomial<>::one();
+    /// auto b = a;
+    /// ctx.square_in_place(b);
+    /// assert_eq(b, a * a % P);
+    /// ```
+    void square_in_place(polynomial_type& a) const {
+        if (a.degree() >= m_degree) a = reduce(a);
+        auto& q = a.coefficients();
+        q.resize(m_degree);
+        if (m_degree > 0) square_step(q);
+    }
+
+    /// Returns the inverse of `a(x)` modulo `P(x)` or `std::nullopt` if there is no such inverse.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(5) + BitPolynomial<>::x_to_the(2) + BitPolynomial<>::one();
+    /// ModContext ctx{P};
+    /// auto a = BitPolynomial<>::x_to_the(3);
+    /// assert_eq(ctx.multiply(ctx.inverse(a).value(), a), BitPolynomial<>::one());
+    /// ```
+    std::optional<polynomial_type> inverse(polynomial_type const& a) const { return a.inverse_mod(m_modulus); }
+
+    /// Returns x^e mod P(x) for e = n or e = 2^n depending on the `n_is_log2` argument.
+    ///
+    /// This is the same as `BitPolynomial::reduce_x_to_the` but reuses the precomputed table.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(3) + BitPolynomial<>::x_to_the(1) + BitPolynomial<>::one();
+    /// ModContext ctx{P};
+    /// assert_eq(ctx.reduce_x_to_the(7).to_string(), "1");
+    /// assert_eq(ctx.reduce_x_to_the(3, true).to_string(), "x");
+    /// ```
+    polynomial_type reduce_x_to_the(usize n, bool n_is_log2 = false) const {
+        return n_is_log2 ? x_to_the_2_to_the(n) : x_to_the(n);
+    }
+
+    /// Returns x^n mod P(x).
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(3) + BitPolynomial<>::x_to_the(1) + BitPolynomial<>::one();
+    /// auto ctx = P.reducer();
+    /// assert_eq(ctx.x_to_the(7).to_string(), "1");
+    /// assert_eq(ctx.x_to_the(8).to_string(), "x");
+    /// ```
+    polynomial_type x_to_the(usize n) const {
+        polynomial_type result;
+        x_to_the(n, result);
+        return result;
+    }
+
+    /// Computes x^n mod P(x) into the passed polynomial `dst`.
+    ///
+    /// After the first call, `dst` and the context already have all the space they need, so later calls allocate
+    /// nothing (except for the products in Barrett reduction).
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(3) + BitPolynomial<>::x_to_the(1) + BitPolynomial<>::one();
+    /// auto ctx = P.reducer();
+    /// BitPolynomial dst;
+    /// for (auto n = 0uz; n < 100; ++n) {
+    ///     ctx.x_to_the(n, dst);
+    ///     assert_eq(dst, P.reduce_x_to_the(n));
+    /// }
+    /// ```
+    void x_to_the(usize n, polynomial_type& dst) const {
+        gf2_probe("ModContext::x_to_the");
+        auto  d = m_degree;
+        auto& r = dst.coefficients();
+
+        // Edge case: anything mod 1 = 0.
+        if (d == 0) {
+            r.resize(0);
+            return;
+        }
+
+        // Our return value r(x) := x^n mod P(x) has degree < d: r(x) = r_0 + r_1 x + ... + r_{d-1} x^{d-1}.
+        r.resize(d);
+        r.set_all(false);
+
+        // Edge case: P(x) = x + c where c is a constant so x = P(x) + c (subtraction in GF(2) is the same as addition).
+        // Then x^e = (P(x) + c)^e = terms in powers of P(x) + c^e. Hence, x^e mod P(x) = c^e = c for e > 0.
+        if (d == 1) {
+            r.set(0, n == 0 || m_p.get(0));
+            return;
+        }
+
+        // Small exponent case: n < d => x^n mod P(x) = x^n.
+        if (n < d) {
+            r.set(n);
+            return;
+        }
+
+        // Matching exponent case: n = d => x^n mod P(x) = x^d mod P(x) = p(x).
+        if (n == d) {
+            r.copy(m_p);
+            return;
+        }
+
+        // General case: n > d is handled by a windowed square & multiply algorithm.
+        // The leading bits of n give some e < d and x^e mod P(x) = x^e needs no work at all. So we start there.
+        auto s = std::bit_width(n / d);
+        r.set(n >> s);
+
+        // Then we handle the remaining s bits of n in windows of k bits where 2^k <= d.
+        // Each window of bits w costs k squarings and then a single multiply by x^w which is a shift and a reduction.
+        auto k = std::bit_width(d) - 1;
+        while (s > 0) {
+            auto c = std::min(k, s);
+            s -= c;
+            for (auto i = 0uz; i < c; ++i) square_step(r);
+            if (auto w = (n >> s) & ((1uz << c) - 1); w > 0) times_x_to_the_step(r, w);
+        }
+    }
+
+    /// Returns `x^e mod P(x)` where the exponent `e` is a big number given by the bits of a bit-store.
+    ///
+    /// Bit `i` of `e` is its `2^i` digit. We run the same windowed square & multiply as for `usize` exponents.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(8) + BitPolynomial<>::x_to_the(4) + BitPolynomial<>::x_to_the(3) +
+    ///          BitPolynomial<>::ones(1);
+    /// auto ctx = P.reducer();
+    /// assert_eq(ctx.x_to_the(BitVector<>::from(u64{1000})), ctx.x_to_the(1000));
+    /// auto e = BitVector<>::ones(200);
+    /// assert_eq(ctx.multiply(ctx.x_to_the(e), ctx.x_to_the(1)), ctx.x_to_the_2_to_the(200));
+    /// ```
+    template<BitStore Exponent>
+    polynomial_type x_to_the(Exponent const& e) const {
+        // Exponents that fit in a usize go the usual route & for degree(P) < 2 all that matters is whether e > 0.
+        auto top = e.last_set();
+        if (!top) return x_to_the(0);
+        if (*top < BITS<usize> || m_degree < 2) {
+            auto n = 0uz;
+            for (auto i = e.first_set(); i && *i < BITS<usize>; i = e.next_set(*i)) n |= 1uz << *i;
+            return x_to_the(m_degree < 2 ? 1 : n);
+        }
+
+        // Start from the top bit with x & then handle the remaining bits in windows of k bits where 2^k <= d.
+        polynomial_type result;
+        auto&           r = result.coefficients();
+        r.resize(m_degree);
+        r.set(1);
+        auto k = std::bit_width(m_degree) - 1;
+        auto s = *top;
+        while (s > 0) {
+            auto c = std::min(k, s);
+            s -= c;
+            for (auto i = 0uz; i < c; ++i) square_step(r);
+            auto w = 0uz;
+            for (auto j = 0uz; j < c; ++j)
+                if (e.get(s + j)) w |= 1uz << j;
+            if (w > 0) times_x_to_the_step(r, w);
+        }
+        return result;
+    }
+
+    /// Returns x^(2^n) mod P(x).
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(3) + BitPolynomial<>::x_to_the(1) + BitPolynomial<>::one();
+    /// auto ctx = P.reducer();
+    /// assert_eq(ctx.x_to_the_2_to_the(3).to_string(), "x");
+    /// assert_eq(ctx.x_to_the_2_to_the(10), ctx.x_to_the(1024));
+    /// ```
+    polynomial_type x_to_the_2_to_the(usize n) const {
+        polynomial_type result;
+        x_to_the_2_to_the(n, result);
+        return result;
+    }
+
+    /// Computes x^(2^n) mod P(x) into the passed polynomial `dst`.
+    ///
+    /// After the first call, `dst` and the context already have all the space they need, so later calls allocate
+    /// nothing (except for the products in Barrett reduction).
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(3) + BitPolynomial<>::x_to_the(1) + BitPolynomial<>::one();
+    /// auto ctx = P.reducer();
+    /// BitPolynomial dst;
+    /// ctx.x_to_the_2_to_the(3, dst);
+    /// assert_eq(dst.to_string(), "x");
+    /// ```
+    void x_to_the_2_to_the(usize n, polynomial_type& dst) const {
+        auto d = m_degree;
+
+        // If P(x) has degree 0 or 1 then x^(2^n) mod P(x) = x mod P(x) for all n.
+        if (d < 2) {
+            x_to_the(1, dst);
+            return;
+        }
+
+        // Start with r(x) = x mod P(x) -> x^2 mod P(x) -> x^4 mod P(x) ...
+        auto& r = dst.coefficients();
+        r.resize(d);
+        r.set_all(false);
+        r.set(1);
+        for (auto i = 0uz; i < n; ++i) square_step(r);
+    }
+
+    /// Returns the polynomials x^n mod P(x) for each exponent `n` in `ns` (in the same order as `ns`).
+    ///
+    /// The exponents are handled in increasing order so the work done for one is shared with the next.
+    /// If the gap `g` between consecutive exponents is at most the degree `d` of `P(x)`, then we get to the next
+    /// result by shifting the previous one up by `g` places and reducing the overflow with the precomputed table.
+    /// Bigger gaps cost one square & multiply run for `x^g` and one modular product.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(17) + BitPolynomial<>::x_to_the(3) + BitPolynomial<>::one();
+    /// auto ctx = P.reducer();
+    /// std::vector<usize> ns{1000, 3, 17, 1'000'000, 999, 1001, 3};
+    /// auto rs = ctx.x_to_the_each(ns);
+    /// assert_eq(rs.size(), ns.size());
+    /// for (auto i = 0uz; i < ns.size(); ++i) assert_eq(rs[i], P.reduce_x_to_the(ns[i]));
+    /// ```
+    std::vector<polynomial_type> x_to_the_each(std::span<usize const> ns) const {
+        std::vector<polynomial_type> result(ns.size());
+        if (ns.empty()) return result;
+
+        // Visit the exponents in increasing order.
+        std::vector<usize> order(ns.size());
+        for (auto i = 0uz; i < order.size(); ++i) order[i] = i;
+        std::ranges::sort(order, {}, [&](usize i) { return ns[i]; });
+
+        // The running power x^e mod P(x) & a workspace for x^g mod P(x) where g is the gap to the next exponent.
+        polynomial_type r, x_to_g;
+        auto            e = ns[order[0]];
+        x_to_the(e, r);
+        for (auto i : order) {
+            auto g = ns[i] - e;
+            if (g > 0 && g <= m_degree) {
+                times_x_to_the_step(r.coefficients(), g);
+            } else if (g > 0) {
+                x_to_the(g, x_to_g);
+                r = multiply(r, x_to_g);
+                r.resize(m_degree);
+            }
+            e = ns[i];
+            result[i] = r;
+        }
+        return result;
+    }
+
+    /// Returns the modular composition `f(g(x)) mod P(x)`.
+    ///
+    /// We use the baby-step giant-step method of Brent & Kung. With `k ~ sqrt(n)` for `n` the degree of `f(x)`, the
+    /// baby steps `g(x)^i mod P(x)` for `i < k` go in the rows of a bit-matrix `G`. Cutting `f(x)` into blocks of `k`
+    /// coefficients gives the rows of a bit-matrix `F` so all the block sums `f_j(g(x))` are the rows of one product
+    /// `F * G`. A Horner pass in the giant step `g(x)^k mod P(x)` then adds them up. That costs about `2 sqrt(n)`
+    /// modular products plus one bit-matrix product, where plain Horner needs `n` modular products.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(61) + BitPolynomial<>::x_to_the(5) + BitPolynomial<>::ones(1);
+    /// ModContext ctx{P};
+    /// auto f = BitPolynomial<>::random(100);
+    /// auto g = BitPolynomial<>::random(70);
+    /// auto expected = BitPolynomial<>::zero();
+    /// for (auto i = f.size(); i-- > 0;) {
+    ///     expected = ctx.multiply(expected, g);
+    ///     if (f[i]) expected += BitPolynomial<>::one();
+    /// }
+    /// assert_eq(ctx.compose(f, g), expected);
+    /// assert_eq(ctx.compose(f, BitPolynomial<>::x_to_the(1)), f % P);
+    /// assert_eq(ctx.compose(BitPolynomial<>::x_to_the(1), g), g % P);
+    /// assert(ctx.compose(BitPolynomial<>::zero(), g).is_zero());
+    /// ```
+    polynomial_type compose(polynomial_type const& f, polynomial_type const& g) const {
+        gf2_probe("ModContext::compose");
+
+        // Edge cases: everything is zero mod 1 & a constant f(x) does not depend on g(x).
+        auto d = m_degree;
+        if (d == 0 || f.is_zero()) return polynomial_type::zero();
+        auto n = f.degree();
+        if (n == 0) return polynomial_type::one();
+
+        // The block size k is the smallest with k^2 >= n + 1 & then there are m blocks of coefficients in f(x).
+        auto k = 1uz;
+        while (k * k < n + 1) ++k;
+        auto m = n / k + 1;
+
+        // The baby steps: row i of G holds g(x)^i mod P(x) & we finish on the giant step g(x)^k mod P(x).
+        BitMatrix<Word> G{k, d};
+        auto            h = reduce(g);
+        auto            giant = polynomial_type::one();
+        for (auto i = 0uz; i < k; ++i) {
+            giant.resize(d);
+            G.row(i).copy(giant.coefficients());
+            giant = multiply(giant, h);
+        }
+
+        // Row j of F holds the coefficients f_{jk}, ..., f_{jk+k-1} so row j of F * G is the block sum f_j(g(x)).
+        BitMatrix<Word> F{m, k};
+        for (auto j = 0uz; j < m; ++j) {
+            auto begin = j * k;
+            auto end = std::min(begin + k, n + 1);
+            F.row(j).span(0, end - begin).copy(f.coefficients().span(begin, end));
+        }
+        auto blocks = dot(F, G);
+
+        // Horner's method in the giant step over the block sums, starting from the top one.
+        polynomial_type result{blocks.row(m - 1)};
+        for (auto j = m - 1; j > 0; --j) {
+            result = multiply(result, giant);
+            result += polynomial_type{blocks.row(j - 1)};
+        }
+        return result;
+    }
+
+    /// Returns x^(2^k) mod P(x) using the cached Frobenius powers of the context.
+    ///
+    /// For big `k` this is much faster than `x_to_the_2_to_the(k)`, whose `k` squarings are replaced by a modular
+    /// composition for each set bit of `k`. See the two argument version for the details.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(521) + BitPolynomial<>::x_to_the(32) + BitPolynomial<>::ones(1);
+    /// auto ctx = P.reducer();
+    /// assert_eq(ctx.frobenius(5000), ctx.x_to_the_2_to_the(5000));
+    /// assert_eq(ctx.frobenius(521).to_string(), "x");
+    /// ```
+    polynomial_type frobenius(usize k) const { return frobenius(polynomial_type::x_to_the(1), k); }
+
+    /// Returns `a(x)^(2^k) mod P(x)`, the result of applying the Frobenius map `k` times to `a(x)`.
+    ///
+    /// Over GF(2) squaring is a ring homomorphism, so `a(x)^(2^k) = a(x^(2^k))`. If `k` is the sum of the powers of two
+    /// `2^j` for its set bits, then `a(x)^(2^k)` is `a(x)` composed in turn with each `x^(2^(2^j)) mod P(x)`. The
+    /// context caches those powers the first time it needs them, each one the composition of the previous one with
+    /// itself, so later calls pay only for the compositions. The low bits of `k` are cheaper to handle by squaring.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::random(600);
+    /// P.make_monic();
+    /// auto ctx = P.reducer();
+    /// auto a = BitPolynomial<>::random(599);
+    /// auto b = a;
+    /// for (auto i = 0uz; i < 3000; ++i) ctx.square_in_place(b);
+    /// assert_eq(ctx.frobenius(a, 3000), b);
+    /// assert_eq(ctx.frobenius(a, 0), a % P);
+    /// ```
+    polynomial_type frobenius(polynomial_type const& a, usize k) const {
+        // Edge case: everything is zero mod 1.
+        auto d = m_degree;
+        if (d == 0) return polynomial_type::zero();
+        auto result = reduce(a);
+        result.resize(d);
+
+        // The low bits of k up to the cross over point are cheaper to handle by squaring.
+        auto t = static_cast<usize>(std::bit_width(squarings_per_composition()));
+        auto low = t < BITS<usize> ? k & ((1uz << t) - 1) : k;
+        for (auto i = 0uz; i < low; ++i) square_step(result.coefficients());
+
+        // The high bits each cost one composition.
+        for (auto j = t; j < BITS<usize> && (k >> j) != 0; ++j) {
+            if ((k >> j) & 1) result = compose(result, frobenius_power(j));
+        }
+        result.resize(d);
+        return result;
+    }
+
+private:
+    polynomial_type               m_modulus; // The modulus P(x) = x^d + p(x).
+    usize                         m_degree;  // The degree d of the modulus.
+    coeffs_type                   m_p;       // The d coefficients of p(x).
+    std::pmr::vector<coeffs_type> m_power_mod{memory_resource()}; // The x^{d+i} mod P(x) for i = 0, 1, ..., d-1.
+    std::pmr::vector<usize>       m_terms{memory_resource()};     // The exponents of the terms in p(x).
+    bool                          m_sparse = false;  // Reduce by folding with the terms of p(x) instead of the table?
+    bool                          m_barrett = false; // Reduce with the power series inverse instead of the table?
+    coeffs_type                   m_inverse;         // The inverse of x^d P(1/x) mod x^d for Barrett reduction.
+    mutable coeffs_type           m_s;               // Workspace for products of degree < 2d.
+    mutable coeffs_type           m_h;               // Workspace for the high order half of those products.
+    mutable coeffs_type           m_fold;            // Workspaces for folds & for the Barrett products.
+    mutable coeffs_type           m_next_fold;
+
+    // The cache of x^(2^(2^j)) mod P(x) for j = 0, 1, ... behind the Frobenius map.
+    mutable std::vector<polynomial_type> m_frobenius;
+
+    // Returns a rough count of the modular squarings that cost as much as one modular composition.
+    // A composition costs about 2 sqrt(d) modular products & a product costs about one and a half squarings.
+    constexpr usize squarings_per_composition() const {
+        auto k = 1uz;
+        while (k * k < m_degree) ++k;
+        return 3 * k;
+    }
+
+    // Returns the cached x^(2^(2^j)) mod P(x), first filling in the cache up to index j if necessary.
+    // Each entry is the previous one squared 2^(j-1) times or, once that gets expensive, composed with itself.
+    polynomial_type const& frobenius_power(usize j) const {
+        while (m_frobenius.size() <= j) {
+            auto i = m_frobenius.size();
+            if (i == 0) {
+                m_frobenius.push_back(x_to_the_2_to_the(1));
+            } else if (auto n = 1uz << (i - 1); n <= squarings_per_composition()) {
+                auto r = m_frobenius.back();
+                for (auto s = 0uz; s < n; ++s) square_step(r.coefficients());
+                m_frobenius.push_back(std::move(r));
+            } else {
+                m_frobenius.push_back(compose(m_frobenius.back(), m_frobenius.back()));
+            }
+        }
+        return m_frobenius[j];
+    }
+
+    // Performs: q(x) <- x*q(x) mod P(x) where degree(q) < d.
+    // This works in-place on the coefficients of q(x) passed as a bit-vector q of size d.
+    constexpr void times_x_step(coeffs_type& q) const {
+        bool add_p = q[m_degree - 1];
+        q >>= 1;
+        if (add_p) q ^= m_p;
+    }
+
+    // Adds the reductions of terms x^i for i >= d in `s` to the size d bit-vector `q` where degree(s) < 2d.
+    constexpr void reduce_high(coeffs_type const& s, coeffs_type& q) const {
+        auto d = m_degree;
+        if (m_sparse || m_barrett) {
+            add_high(s.sub(d, s.size()), q);
+            return;
+        }
+        for (auto i = s.next_set(d - 1); i; i = s.next_set(*i)) q ^= m_power_mod[*i - d];
+    }
+
+    // Performs: q(x) <- q(x) + x^d h(x) mod P(x) where q is a bit-vector of size d and degree(h) < d.
+    constexpr void add_high(coeffs_type const& h, coeffs_type& q) const {
+        if (!m_sparse && !m_barrett) {
+            for (auto i = h.first_set(); i; i = h.next_set(*i)) q ^= m_power_mod[*i];
+            return;
+        }
+
+        // x^d h(x) = Q(x) P(x) + R(x) where reversing turns the quotient into rev(Q) = rev(h) rev(P)^{-1} mod x^d.
+        // The low d terms of x^d h(x) are zero so R(x) = Q(x) p(x) mod x^d.
+        auto d = m_degree;
+        // The fold workspaces are free on this path so the products go through them without allocating.
+        if (m_barrett) {
+            details::reversed(h, d, m_fold);
+            convolve(m_fold, m_inverse, m_fold);
+            m_fold.resize(d);
+            details::reversed(m_fold, d, m_next_fold);
+            convolve(m_next_fold, m_p, m_next_fold);
+            m_next_fold.resize(d);
+            q ^= m_next_fold;
+            return;
+        }
+
+        // Edge case: P(x) = x^d so x^d h(x) = 0 mod P(x).
+        if (m_terms.empty()) return;
+
+        // x^d = p(x) mod P(x) so x^d h(x) = x^{e_1} h(x) + x^{e_2} h(x) + ... for the exponents e_j of p(x).
+        // The low parts of those shifted copies land in q & the parts still at or above x^d get folded again.
+        auto e_max = m_terms.back();
+        m_fold.resize(h.size());
+        m_fold.copy(h);
+        while (auto top = m_fold.last_set()) {
+            auto n = *top + 1;
+            m_next_fold.resize(n + e_max > d ? n + e_max - d : 0);
+            m_next_fold.set_all(false);
+            for (auto e : m_terms) {
+                auto lo = std::min(n, d - e);
+                auto dst = q.span(e, e + lo);
+                dst ^= m_fold.span(0, lo);
+                if (n > lo) {
+                    auto over = m_next_fold.span(0, n - lo);
+                    over ^= m_fold.span(lo, n);
+                }
+            }
+            std::swap(m_fold, m_next_fold);
+        }
+    }
+
+    // Performs: q(x) <- x^g q(x) mod P(x) where degree(q) < d and 0 < g <= d.
+    // This works in-place on the coefficients of q(x) passed as a bit-vector q of size d.
+    constexpr void times_x_to_the_step(coeffs_type& q, usize g) const {
+        auto d = m_degree;
+
+        // Shift q(x) up by g places into the workspace `s` which has room for degree d + g - 1.
+        m_s.resize(d);
+        m_s.copy(q);
+        m_s.resize(d + g);
+        m_s >>= g;
+
+        // x^g q(x) = l(x) + x^d h(x) where degree(h) < g & we reduce x^d h(x) term by term.
+        m_s.split_at(d, q, m_h);
+        add_high(m_h, q);
+    }
+
+    // Performs: q(x) <- q(x)^2 mod P(x) where degree(q) < d using the workspace bit-vectors `m_s` and `m_h`.
+    // This works in-place on the coefficients of q(x) passed as a bit-vector q of size d.
+    constexpr void square_step(coeffs_type& q) const {
+        auto d = m_degree;
+
+        // Square q(x) storing the result in workspace `s`.
+        q.riffled(m_s);
+
+        // Split s(x) = l(x) + x^d * h(x) where l(x) & h(x) are both of degree less than d.
+        // We reuse q(x) for l(x).
+        m_s.split_at(d, q, m_h);
+
+        // s(x) = q(x) + x^d h(x) so s(x) mod P(x) = q(x) + x^d h(x) mod P(x) which we handle term by term.
+        // If h(x) != 0 then at most every second term in h(x) is 1 (nature of bit-polynomial squares in GF(2)).
+        if (m_sparse || m_barrett) {
+            add_high(m_h, q);
+        } else if (auto h_first = m_h.first_set()) {
+            auto h_last = m_h.last_set();
+            for (auto i = *h_first; i <= *h_last; i += 2)
+                if (m_h[i]) q ^= m_power_mod[i];
+        }
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Minimal polynomials of bit streams ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// A `BerlekampMassey` engine finds the shortest linear feedback shift register (LFSR) that generates a stream of bits.
+///
+/// Feed it bits as they arrive with `push`. After it has seen the `N` bits `s_0, s_1, ..., s_{N-1}`:
+/// - `linear_complexity()` is the length `L` of the shortest LFSR that generates them.
+/// - `connection_polynomial()` is that register's `C(x) = 1 + c_1 x + ... + c_L x^L` where
+///   `s_i = c_1 s_{i-1} + c_2 s_{i-2} + ... + c_L s_{i-L}` for `L <= i < N`.
+/// - `minimal_polynomial()` is the reciprocal `x^L C(1/x)`, which is what `BitPolynomial::minimal_polynomial` returns.
+///
+/// Each new bit costs `O(L)` bit operations which are done a word at a time: the engine keeps the stream back to front
+/// so the discrepancy between the next bit and the register's prediction is a dot product of two bit-stores.
+///
+/// # Example
+/// ```
+/// BerlekampMassey bm;
+/// for (auto bit : {1, 0, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 0, 0, 0}) bm.push(bit == 1);
+/// assert_eq(bm.size(), 15);
+/// assert_eq(bm.linear_complexity(), 4);
+/// assert_eq(bm.connection_polynomial().to_string(), "1 + x^3 + x^4");
+/// assert_eq(bm.minimal_polynomial().to_string(), "1 + x + x^4");
+/// assert_eq(bm.next(), true);
+/// ```
+template<Unsigned Word = usize>
+class BerlekampMassey {
+public:
+    /// The type of the polynomials we return.
+    using polynomial_type = BitPolynomial<Word>;
+
+    /// The type used to store the bits and the polynomial coefficients.
+    using coeffs_type = BitVector<Word>;
+
+    /// Constructs an engine that has not seen any bits yet.
+    ///
+    /// # Example
+    /// ```
+    /// BerlekampMassey<u8> bm;
+    /// assert_eq(bm.size(), 0);
+    /// assert_eq(bm.linear_complexity(), 0);
+    /// assert_eq(bm.minimal_polynomial(), BitPolynomial<u8>::one());
+    /// ```
+    BerlekampMassey() = default;
+
+    /// Returns the number of bits the engine has seen.
+    constexpr usize size() const { return m_size; }
+
+    /// Returns the linear complexity of the bits seen so far --- the length of the shortest LFSR that generates them.
+    constexpr usize linear_complexity() const { return m_length; }
+
+    /// Returns the connection polynomial `C(x) = 1 + c_1 x + ... + c_L x^L` of the shortest LFSR that generates the
+    /// bits seen so far, where `L` is the linear complexity. The returned polynomial has `L + 1` coefficients.
+    ///
+    /// # Example
+    /// ```
+    /// BerlekampMassey bm;
+    /// bm.push(BitVector<>::from_string("0010").value());
+    /// assert_eq(bm.linear_complexity(), 3);
+    /// assert_eq(bm.connection_polynomial().to_full_string(), "1 + 0x + 0x^2 + x^3");
+    /// ```
+    polynomial_type connection_polynomial() const { return polynomial_type{m_c.sub(0, m_length + 1)}; }
+
+    /// Returns the minimal polynomial `x^L C(1/x)` of the bits seen so far, where `C(x)` is the connection polynomial
+    /// and `L` is the linear complexity.
+    ///
+    /// # Example
+    /// ```
+    /// BerlekampMassey bm;
+    /// bm.push(BitVector<>::from_string("0010").value());
+    /// assert_eq(bm.minimal_polynomial().to_string(), "1 + x^3");
+    /// ```
+    polynomial_type minimal_polynomial() const { return polynomial_type{details::reversed(m_c, m_length + 1)}; }
+
+    /// Returns the next bit that the current shortest LFSR would output.
+    ///
+    /// # Example
+    /// ```
+    /// BerlekampMassey bm;
+    /// bm.push(BitVector<>::from_string("1101101101").value());
+    /// assert_eq(bm.linear_complexity(), 2);
+    /// assert_eq(bm.next(), true);
+    /// bm.push(true);
+    /// assert_eq(bm.next(), false);
+    /// ```
+    bool next() const {
+        if (m_length == 0) return false;
+        auto pos = m_seq.size() - m_size;
+        return dot(m_c.span(1, m_length + 1), m_seq.span(pos, pos + m_length));
+    }
+
+    /// Feeds the next bit of the stream to the engine.
+    ///
+    /// # Example
+    /// ```
+    /// BerlekampMassey<u8> bm;
+    /// for (auto i = 0uz; i < 100; ++i) bm.push(i % 3 == 0);
+    /// assert_eq(bm.linear_complexity(), 3);
+    /// assert_eq(bm.minimal_polynomial().to_string(), "1 + x^3");
+    /// ```
+    void push(bool bit) {
+        // The stream lives back to front in the top of `m_seq` so s_n, s_{n-1}, ... are stored in consecutive bits.
+        if (m_size == m_seq.size()) grow(m_size + 1);
+        auto n = m_size++;
+        auto pos = m_seq.size() - m_size;
+        m_seq.set(pos, bit);
+
+        // The discrepancy is s_n + c_1 s_{n-1} + ... + c_L s_{n-L} which is zero if the register predicts s_n.
+        if (!dot(m_c.span(0, m_length + 1), m_seq.span(pos, pos + m_length + 1))) {
+            ++m_shift;
+            return;
+        }
+
+        // Otherwise C(x) <- C(x) + x^shift B(x) where B(x) was the connection polynomial before the last length change.
+        if (m_c.size() < m_shift + m_b.size()) m_c.resize(m_shift + m_b.size());
+        if (2 * m_length <= n) {
+            // The register has to get longer & the current C(x) becomes the next B(x).
+            m_t = m_c;
+            add_shifted_b();
+            std::swap(m_b, m_t);
+            m_length = n + 1 - m_length;
+            m_shift = 1;
+        } else {
+            add_shifted_b();
+            ++m_shift;
+        }
+    }
+
+    /// Feeds all the bits in a bit-store to the engine in order.
+    ///
+    /// # Example
+    /// ```
+    /// BerlekampMassey bm;
+    /// bm.push(BitVector<u8>::from_string("100110101111000").value());
+    /// assert_eq(bm.minimal_polynomial().to_string(), "1 + x + x^4");
+    /// ```
+    template<BitStore Src>
+    void push(Src const& bits) {
+        if (m_size + bits.size() > m_seq.size()) grow(m_size + bits.size());
+        for (auto i = 0uz; i < bits.size(); ++i) push(bits.get(i));
+    }
+
+private:
+    coeffs_type m_seq;                      // The stream so far, stored back to front in the top bits.
+    coeffs_type m_c = coeffs_type::ones(1); // The current connection polynomial C(x).
+    coeffs_type m_b = coeffs_type::ones(1); // The connection polynomial before the last length change.
+    coeffs_type m_t;                        // Workspace for swapping C(x) and B(x).
+    usize       m_size = 0;                 // The number of bits seen.
+    usize       m_length = 0;               // The current linear complexity L.
+    usize       m_shift = 1;                // The number of bits seen since the last length change.
+
+    // Performs C(x) <- C(x) + x^shift B(x) a word at a time.
+    void add_shifted_b() {
+        auto dst = m_c.span(m_shift, m_shift + m_b.size());
+        dst ^= m_b;
+    }
+
+    // Makes room for at least `n` bits of the stream by doubling the buffer & moving the stream to its top.
+    void grow(usize n) {
+        auto buffer = coeffs_type::zeros(std::max<usize>({n, 2 * m_seq.size(), 8 * BITS<Word>}));
+        auto top = buffer.span(buffer.size() - m_size, buffer.size());
+        top.copy(m_seq.span(m_seq.size() - m_size, m_seq.size()));
+        m_seq = std::move(buffer);
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Evaluating bit-polynomials at a fixed bit-matrix ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// A `MatrixPowers` object holds the powers `I, M, M^2, ..., M^k` of a square bit-matrix `M` so that it can evaluate
+/// lots of bit-polynomials at `M` without recomputing them.
+///
+/// It uses the Paterson-Stockmeyer split of a polynomial of degree `d` into blocks of `k` coefficients:
+/// `p(M) = B_0 + B_1 M^k + B_2 M^{2k} + ...` where each `B_j` is a sum of the stored powers `M^i` for `i < k`.
+/// The blocks cost only additions and Horner's method in the "giant step" `M^k` combines them, so `p(M)` takes about
+/// `d / k` products on top of the `k - 1` that built the powers. Picking `k ~ sqrt(d)` gives about `2 sqrt(d)` products
+/// where plain Horner needs `d`.
+///
+/// The object keeps `k + 1` bit-matrices of the size of `M`, which is the price for the speed.
+///
+/// # Example
+/// ```
+/// auto M = BitMatrix<>::random(30, 30);
+/// MatrixPowers powers{M};
+/// assert_eq(powers.block_size(), 6);
+/// auto p = M.characteristic_polynomial();
+/// assert(powers(p).is_zero());
+/// auto q = BitPolynomial<>::random(50);
+/// assert_eq(powers(q), q(M));
+/// assert_eq(powers(p * q + q), q(M));
+/// ```
+template<Unsigned Word = usize>
+class MatrixPowers {
+public:
+    /// The type of the bit-matrices we work with.
+    using matrix_type = BitMatrix<Word>;
+
+    /// The type of the polynomials we evaluate.
+    using polynomial_type = BitPolynomial<Word>;
+
+    /// Precomputes the powers of a square bit-matrix `M` for evaluating polynomials of degree up to `degree`.
+    ///
+    /// The block size is `k = ceil(sqrt(degree + 1))`, which minimises the number of products for that degree.
+    /// Polynomials of higher degree can still be evaluated but they take more than the optimal number of products.
+    /// The default degree is the size of `M`, the degree of its characteristic polynomial.
+    ///
+    /// # Panics
+    /// This method panics if the matrix is not square.
+    ///
+    /// # Example
+    /// ```
+    /// auto M = BitMatrix<>::random(8, 8);
+    /// MatrixPowers powers{M, 99};
+    /// assert_eq(powers.block_size(), 10);
+    /// assert_eq(powers.power(0), BitMatrix<>::identity(8));
+    /// assert_eq(powers.power(1), M);
+    /// assert_eq(powers.power(10), M.to_the(10));
+    /// ```
+    explicit MatrixPowers(matrix_type const& M, std::optional<usize> degree = std::nullopt) {
+        gf2_assert(M.is_square(), "Matrix must be square -- not {} x {}!", M.rows(), M.cols());
+
+        // The smallest k with k^2 >= degree + 1.
+        auto d = degree.value_or(M.rows());
+        auto k = 1uz;
+        while (k * k < d + 1) ++k;
+
+        // The baby steps I, M, ..., M^k where the last one is also the giant step.
+        m_powers.reserve(k + 1);
+        m_powers.push_back(matrix_type::identity(M.rows()));
+        m_powers.push_back(M);
+        for (auto i = 2uz; i <= k; ++i) m_powers.push_back(dot(m_powers[i - 1], M));
+    }
+
+    /// Returns the size `n` of the `n x n` bit-matrix whose powers we hold.
+    constexpr usize size() const { return m_powers[0].rows(); }
+
+    /// Returns the block size `k`: we hold the powers `M^0` through `M^k`.
+    constexpr usize block_size() const { return m_powers.size() - 1; }
+
+    /// Returns a read-only reference to the stored power `M^i` for `i <= block_size()`.
+    ///
+    /// # Panics
+    /// In debug mode, this method panics if `i` is greater than the block size.
+    constexpr matrix_type const& power(usize i) const {
+        gf2_debug_assert(i < m_powers.size(), "Power {} is not stored -- the block size is {}", i, block_size());
+        return m_powers[i];
+    }
+
+    /// Returns the bit-matrix `p(M)` for the bit-polynomial `p`.
+    ///
+    /// # Example
+    /// ```
+    /// auto M = BitMatrix<>::random(12, 12);
+    /// MatrixPowers powers{M};
+    /// assert_eq(powers(BitPolynomial<>::zero()), BitMatrix<>::zeros(12, 12));
+    /// assert_eq(powers(BitPolynomial<>::one()), BitMatrix<>::identity(12));
+    /// assert_eq(powers(BitPolynomial<>::x_to_the(1)), M);
+    /// assert_eq(powers(BitPolynomial<>::x_to_the(40)), M.to_the(40));
+    /// ```
+    matrix_type operator()(polynomial_type const& p) const {
+        // Edge case: If the polynomial is zero then the return value is the n x n zero matrix.
+        auto n = size();
+        if (p.is_zero()) return matrix_type{n, n};
+
+        // Horner's method in the giant step M^k over the blocks B_j of k coefficients, starting from the top one.
+        auto k = block_size();
+        auto j = p.degree() / k;
+        auto result = block(p, j);
+        while (j > 0) {
+            result = dot(result, m_powers[k]);
+            result += block(p, --j);
+        }
+        return result;
+    }
+
+private:
+    std::vector<matrix_type> m_powers; // The powers I, M, ..., M^k of the bit-matrix.
+
+    // Returns the block B_j = sum of p_{jk+i} M^i for i < k, where any coefficients past the end of p are zero.
+    matrix_type block(polynomial_type const& p, usize j) const {
+        auto k = block_size();
+        auto n = size();
+        auto begin = j * k;
+        auto end = std::min(begin + k, p.size());
+
+        matrix_type result{n, n};
+        if (p[begin]) result.add_identity();
+        for (auto i = begin + 1; i < end; ++i)
+            if (p[i]) result += m_powers[i - begin];
+        return result;
+    }
 };
 
 } // namespace gf2
@@ -10,6 +10,18 @@
 
 namespace gf2 {
 
+// Forward declaration so we can recognise bit-spans, which `BitRef` holds by value (see below).
+template<Unsigned Word>
+class BitSpan;
+
+namespace details {
+// Trait that picks out the `BitSpan` types.
+template<typename T>
+inline constexpr bool is_bit_span = false;
+template<Unsigned Word>
+inline constexpr bool is_bit_span<BitSpan<Word>> = true;
+} // namespace details
+
 /// A `BitRef` is a *proxy* class to reference a single bit in a bit-store.
 ///
 /// If `v` is any non-const bit-store then `v[i]` is a `BitRef` that "references" the bit at index `i` in `v`.
@@ -19,6 +31,8 @@ namespace gf2 {
 /// expressions.
 ///
 ///  **Note:** The underlying bit-store must live as long as the `BitRef` that refers to it.
+///  Bit-spans are lightweight views that are often temporaries (e.g. the rows of a `BitMatrix`) so a `BitRef` into a
+///  bit-span holds a copy of that span -- it is the words the span views that must outlive the `BitRef`.
 ///
 /// # Example
 /// ```
@@ -32,15 +46,18 @@ namespace gf2 {
 template<BitStore Store>
 class BitRef {
 private:
-    // The bit-store we are referencing.
-    Store* m_store;
+    // Is the referenced bit-store a bit-span that we should hold by value?
+    static constexpr bool holds_span = details::is_bit_span<Store>;
+
+    // The bit-store we are referencing (or a copy of it if it is just a bit-span).
+    std::conditional_t<holds_span, Store, Store*> m_store;
 
     // The index of the bit of interest within that bit-store
     usize m_index;
 
 public:
     /// Constructs a reference to the bit at `index` in the given bit-store.
-    BitRef(Store* store, usize index) : m_store(store), m_index(index) {}
+    BitRef(Store* store, usize index) : m_store(init(store)), m_index(index) {}
 
     // The default compiler generator implementations for most "rule of 5" methods will be fine ...
     constexpr BitRef() = default;
@@ -56,7 +73,7 @@ public:
     /// auto bit = ref(v, 0);
     /// assert_eq(static_cast<bool>(bit), false);
     /// ```
-    constexpr operator bool() const { return gf2::get(*m_store, m_index); }
+    constexpr operator bool() const { return gf2::get(store(), m_index); }
 
     /// Sets the bit at `index` in the referenced bit-store to the given value.
     ///
@@ -67,7 +84,7 @@ public:
     /// assert_eq(to_string(v), "100");
     /// ```
     constexpr BitRef& operator=(bool rhs) {
-        gf2::set(*m_store, m_index, rhs);
+        gf2::set(store(), m_index, rhs);
         return *this;
     }
 
@@ -85,7 +102,7 @@ public:
     /// assert_eq(to_string(v), "111");
     /// ```
     constexpr BitRef& operator=(BitRef const& rhs) {
-        gf2::set(*m_store, m_index, static_cast<bool>(rhs));
+        gf2::set(store(), m_index, static_cast<bool>(rhs));
         return *this;
     }
 
@@ -98,7 +115,7 @@ public:
     /// assert_eq(to_string(v), "100");
     /// ```
     constexpr BitRef& flip() {
-        gf2::flip(*m_store, m_index);
+        gf2::flip(store(), m_index);
         return *this;
     }
 
@@ -111,7 +128,7 @@ public:
     /// assert_eq(to_string(v), "011");
     /// ```
     constexpr BitRef& operator&=(bool rhs) {
-        if (!rhs) gf2::set(*m_store, m_index, false);
+        if (!rhs) gf2::set(store(), m_index, false);
         return *this;
     }
 
@@ -125,7 +142,7 @@ public:
     /// assert_eq(to_string(v), "011");
     /// ```
     constexpr BitRef& operator&=(BitRef const& rhs) {
-        if (!static_cast<bool>(rhs)) gf2::set(*m_store, m_index, false);
+        if (!static_cast<bool>(rhs)) gf2::set(store(), m_index, false);
         return *this;
     }
 
@@ -138,7 +155,7 @@ public:
     /// assert_eq(to_string(v), "100");
     /// ```
     constexpr BitRef& operator|=(bool rhs) {
-        if (rhs) gf2::set(*m_store, m_index);
+        if (rhs) gf2::set(store(), m_index);
         return *this;
     }
 
@@ -152,7 +169,7 @@ public:
     /// assert_eq(to_string(v), "100");
     /// ```
     constexpr BitRef& operator|=(BitRef const& rhs) {
-        if (static_cast<bool>(rhs)) gf2::set(*m_store, m_index);
+        if (static_cast<bool>(rhs)) gf2::set(store(), m_index);
         return *this;
     }
 
@@ -165,7 +182,7 @@ public:
     /// assert_eq(to_string(v), "011");
     /// ```
     constexpr BitRef& operator^=(bool rhs) {
-        if (rhs) gf2::flip(*m_store, m_index);
+        if (rhs) gf2::flip(store(), m_index);
         return *this;
     }
 
@@ -179,9 +196,35 @@ public:
     /// assert_eq(to_string(v), "011");
     /// ```
     constexpr BitRef& operator^=(BitRef const& rhs) {
-        if (static_cast<bool>(rhs)) gf2::flip(*m_store, m_index);
+        if (static_cast<bool>(rhs)) gf2::flip(store(), m_index);
         return *this;
     }
+
+private:
+    // Helper that sets up the `m_store` member for the two types of referenced bit-store.
+    static constexpr auto init(Store* store) {
+        if constexpr (holds_span) {
+            return *store;
+        } else {
+            return store;
+        }
+    }
+
+    // Accessors for the referenced bit-store.
+    constexpr Store& store() {
+        if constexpr (holds_span) {
+            return m_store;
+        } else {
+            return *m_store;
+        }
+    }
+    constexpr Store const& store() const {
+        if constexpr (holds_span) {
+            return m_store;
+        } else {
+            return *m_store;
+        }
+    }
 };
 
 } // namespace gf2
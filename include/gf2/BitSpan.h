@@ -131,6 +131,13 @@ public:
     /// assert_eq(s.word(0), 0b1111'0000);
     /// ```
     constexpr word_type word(usize i) const {
+        // All but the last span word are whole words so we can just funnel-shift the pair of real words (or, for
+        // aligned spans, just return the real word).
+        if (i + 1 < m_words) {
+            if (m_offset == 0) return m_store[i];
+            return static_cast<word_type>((m_store[i] >> m_offset) | (m_store[i + 1] << (bits_per_word - m_offset)));
+        }
+
         // Get the recipe for the "word" at index `i` (we may need two real words to synthesise it).
         auto [w0_bits, w1_bits] = recipe_for_word(i);
 
@@ -172,6 +179,19 @@ public:
             // This should never get called for const bit-spans.
             throw std::logic_error("Cannot set a word in a const bit-span.");
         } else {
+            // All but the last span word are whole words so we just overwrite the matching bits in the real words.
+            if (i + 1 < m_words) {
+                if (m_offset == 0) {
+                    m_store[i] = value;
+                } else {
+                    auto lo_mask = static_cast<word_type>(MAX<word_type> << m_offset);
+                    m_store[i] = static_cast<word_type>((m_store[i] & ~lo_mask) | (value << m_offset));
+                    m_store[i + 1] = static_cast<word_type>((m_store[i + 1] & lo_mask) |
+                                                            (value >> (bits_per_word - m_offset)));
+                }
+                return;
+            }
+
             // Get the recipe for the "word" at index `i` (it may be a synthesis of two real words).
             auto [w0_bits, w1_bits] = recipe_for_word(i);
 
@@ -509,13 +529,40 @@ public:
     /// s.copy(BitVector<u8>::alternating(10));
     /// assert_eq(v.to_string(), "1010101010111111");
     /// ```
-    template<BitStore Src>
+    template<BitExpression Src>
     constexpr auto copy(Src const& src) {
         gf2::copy(src, *this);
         return *this;
         ;
     }
 
+    /// Copies the value of an equal-sized lazy bit-expression like `u ^ v` into the bits viewed by this bit-span.
+    ///
+    /// Operands that view bits overlapping this span at a different offset are handled (see `gf2::copy`). Assigning
+    /// another bit-span still just rebinds this one.
+    ///
+    /// # Panics
+    /// Panics if the size of the bit-span does not match the size of the expression.
+    ///
+    /// # Example
+    /// ```
+    /// auto v = BitVector<u8>::zeros(16);
+    /// auto u = BitVector<u8>::ones(10);
+    /// auto w = BitVector<u8>::alternating(10);
+    /// auto s = v.span(2, 12);
+    /// s = u ^ w;
+    /// assert_eq(v.to_string(), "0001010101010000");
+    /// s = v.span(3, 13) | v.span(1, 11);
+    /// assert_eq(v.to_string(), "0010101010100000");
+    /// ```
+    template<typename Expr>
+        requires(!std::is_const_v<Word>) && details::LazyBitExpression<Expr> &&
+                std::same_as<typename Expr::word_type, word_type>
+    constexpr BitSpan& operator=(Expr const& expr) {
+        gf2::copy(expr, *this);
+        return *this;
+    }
+
     /// Copies all the bits from an equal-sized `std::bitset` and returns a reference to this for chaining.
     ///
     /// # Note
@@ -828,6 +875,48 @@ public:
     /// ```
     constexpr auto unset_bits() const { return gf2::unset_bits(*this); }
 
+    /// Calls `f(i)` for the index `i` of each set bit in the bit-span in increasing order.
+    ///
+    /// This is faster than the `set_bits()` iterator as it reads each word once and peels off its set bits.
+    ///
+    /// # Example
+    /// ```
+    /// auto v = BitVector<u8>::alternating(12);
+    /// auto s = v.span(1, 11);
+    /// std::vector<usize> indices;
+    /// s.for_each_set_bit([&](usize i) { indices.push_back(i); });
+    /// assert_eq(indices, (std::vector<usize>{1, 3, 5, 7, 9}));
+    /// ```
+    template<typename F>
+        requires std::invocable<F&, usize>
+    constexpr void for_each_set_bit(F&& f) const {
+        gf2::for_each_set_bit(*this, std::forward<F>(f));
+    }
+
+    /// Writes the indices of the set bits in the bit-span to `out` in increasing order and returns how many it wrote.
+    ///
+    /// At most `out.size()` indices are written.
+    ///
+    /// # Example
+    /// ```
+    /// auto v = BitVector<u8>::alternating(12);
+    /// auto s = v.span(1, 11);
+    /// std::array<usize, 8> out{};
+    /// assert_eq(s.to_indices(out), 5);
+    /// assert_eq(out[4], 9);
+    /// ```
+    constexpr usize to_indices(std::span<usize> out) const { return gf2::to_indices(*this, out); }
+
+    /// Returns the indices of the set bits in the bit-span as a new `std::vector` in increasing order.
+    ///
+    /// # Example
+    /// ```
+    /// auto v = BitVector<u8>::alternating(12);
+    /// auto s = v.span(1, 11);
+    /// assert_eq(s.to_indices(), (std::vector<usize>{1, 3, 5, 7, 9}));
+    /// ```
+    constexpr std::vector<usize> to_indices() const { return gf2::to_indices(*this); }
+
     /// Returns a const iterator over all the *words* underlying the bit-span.
     ///
     /// You can use this iterator to iterate over the words in the bit-span and read the `Word` value of each word.
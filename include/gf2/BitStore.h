@@ -10,14 +10,20 @@
 #include <gf2/assert.h>
 #include <gf2/Unsigned.h>
 #include <gf2/RNG.h>
+#include <gf2/Simd.h>
+#include <gf2/instrument.h>
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <concepts>
+#include <cstdint>
 #include <format>
 #include <iterator>
+#include <limits>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -143,6 +149,495 @@ template<BitStore Store> class Words;
 
 } // namespace gf2
 
+namespace gf2::details {
+
+// The bulk bit-store functions hand whole runs of words to the vectorized kernels in `gf2/Simd.h` when they can.
+// That needs a store that starts on a word boundary so `store()[i]` is `word(i)` for all but the last word (which may
+// share a real word with bits outside the store).
+template<BitStore Store>
+constexpr bool
+has_direct_words(Store const& store) {
+    return store.offset() == 0 && store.words() > 1;
+}
+
+// Is the store able to hand out a mutable pointer to its words?
+template<typename Store>
+concept HasMutableWords = requires(Store& store) {
+    { store.store() } -> std::same_as<typename Store::word_type*>;
+};
+
+// Returns `true` if the first `n` words from `a` and `b` partially overlap (which rules out the vectorized kernels).
+template<Unsigned Word>
+inline bool
+overlaps(Word const* a, Word const* b, usize n) {
+    auto x = reinterpret_cast<std::uintptr_t>(a);
+    auto y = reinterpret_cast<std::uintptr_t>(b);
+    return x != y && x < y + n * sizeof(Word) && y < x + n * sizeof(Word);
+}
+
+// A store that begins `offset` bits into its first real word occupies `n` real words. We can work on those directly
+// as long as we mask off any bits outside the store in the first and last of them.
+template<Unsigned Word>
+struct RealWords {
+    usize n = 0;
+    Word  first = 0; // The store's bits in real word `0`.
+    Word  last = 0;  // The store's bits in real word `n - 1`.
+};
+
+// Returns the "real" word layout for a store (the bits in the store do not need to start on a word boundary).
+template<BitStore Store>
+constexpr auto
+real_words(Store const& store) {
+    using word_type = typename Store::word_type;
+    constexpr auto bits_per_word = BITS<word_type>;
+    auto           end = store.offset() + store.size();
+    auto           tail = static_cast<u8>(end % bits_per_word);
+
+    RealWords<word_type> result;
+    result.n = words_needed<word_type>(end);
+    result.first = static_cast<word_type>(MAX<word_type> << store.offset());
+    result.last = tail == 0 ? MAX<word_type> : static_cast<word_type>(MAX<word_type> >> (bits_per_word - tail));
+    if (result.n == 1) result.first = result.last = static_cast<word_type>(result.first & result.last);
+    return result;
+}
+
+// Returns a copy of `word` with the bits picked out by `mask` replaced by those bits from `value`.
+template<Unsigned Word>
+constexpr Word
+blend(Word word, Word value, Word mask) {
+    return static_cast<Word>((word & ~mask) | (value & mask));
+}
+
+// Streams the words of a store which starts at a non-zero `offset` inside its first real word. Each store word is a
+// funnel-shift of a pair of adjacent real words & the stream carries the high one over so every real word is loaded
+// once. This is only good for the first `words() - 1` store words as the last one may not need a second real word.
+template<Unsigned Word>
+class FunnelStream {
+public:
+    constexpr FunnelStream(Word const* src, u8 offset) : m_src{src}, m_offset{offset}, m_lo{src[0]} {}
+
+    constexpr Word next() {
+        Word hi = *++m_src;
+        auto result = static_cast<Word>((m_lo >> m_offset) | (hi << (BITS<Word> - m_offset)));
+        m_lo = hi;
+        return result;
+    }
+
+private:
+    Word const* m_src;
+    u8          m_offset;
+    Word        m_lo;
+};
+
+// Performs the in-place `lhs = op(lhs, rhs)` for the bit-wise operators using the vectorized `kernel` where we can.
+// Returns `false` if the operands don't allow that and the caller needs to fall back to the generic word loop.
+// Both stores have the same number of bits & there is nothing to do for an empty `lhs`.
+template<BitStore Lhs, BitStore Rhs, typename Op, typename Kernel>
+inline bool
+combine_into(Lhs& lhs, Rhs const& rhs, Op op, Kernel kernel) {
+    if constexpr (!HasMutableWords<Lhs>) {
+        return false;
+    } else {
+        if (lhs.size() == 0) return true;
+        auto d = lhs.store();
+        auto s = rhs.store();
+        if (lhs.offset() == rhs.offset()) {
+            // The bits line up in the real words so we can work on those directly.
+            auto [n, first, last] = real_words(lhs);
+            if (overlaps(d, s, n)) return false;
+            d[0] = blend(d[0], op(d[0], s[0]), first);
+            if (n > 1) {
+                kernel(d + 1, s + 1, n - 2);
+                d[n - 1] = blend(d[n - 1], op(d[n - 1], s[n - 1]), last);
+            }
+            return true;
+        }
+        if (lhs.offset() == 0) {
+            // Funnel-shift the words of `rhs` into place as we go.
+            auto n = lhs.words();
+            if (overlaps(d, s, n + 1)) return false;
+            FunnelStream stream{s, rhs.offset()};
+            for (auto i = 0uz; i + 1 < n; ++i) d[i] = op(d[i], stream.next());
+            lhs.set_word(n - 1, op(lhs.word(n - 1), rhs.word(n - 1)));
+            return true;
+        }
+        return false;
+    }
+}
+
+} // namespace gf2::details
+
+// --------------------------------------------------------------------------------------------------------------------
+// Lazy Bit-wise Expressions ...
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace gf2 {
+
+/// A concept that is satisfied by anything that can be read a word at a time like a bit-store.
+///
+/// That covers every `gf2::BitStore` along with the lazy expressions returned by the out-of-place bit-wise operators
+/// `lhs ^ rhs`, `lhs & rhs`, `lhs | rhs`, `~store`, `store << n`, and `store >> n`. Those expressions just hold on to
+/// their operands and compute a word of the result when it is asked for, so a chain like `a ^ (b & c) ^ ~d` does all
+/// its work in a single pass over the words once it is assigned to a bit-vector, copied into a bit-store, or handed to
+/// a reduction like `count_ones`, `any`, or `dot`.
+///
+/// # Required Methods
+/// | Method    | Description                                                                        |
+/// | --------- | ---------------------------------------------------------------------------------- |
+/// | `size()`  | Returns the number of bits in the expression.                                      |
+/// | `words()` | Returns `gf2::words_needed<word_type>(size())`.                                    |
+/// | `word(i)` | Returns "word" `i` of the expression with any unused bits in the final word unset. |
+template<typename Expr>
+concept BitExpression = requires(const Expr expr) {
+    typename Expr::word_type;
+    requires Unsigned<typename Expr::word_type>;
+    { expr.size() } -> std::same_as<usize>;
+    { expr.words() } -> std::same_as<usize>;
+    { expr.word(usize{}) } -> std::same_as<typename Expr::word_type>;
+};
+
+} // namespace gf2
+
+namespace gf2::details {
+
+// The lazy expressions are the bit-expressions that do not have any words of their own.
+template<typename Expr>
+concept LazyBitExpression = BitExpression<Expr> && !BitStore<Expr>;
+
+// The binary operators accept any pair of bit-expressions that use the same word type.
+template<typename Lhs, typename Rhs>
+concept BitExpressionPair =
+    BitExpression<std::remove_cvref_t<Lhs>> && BitExpression<std::remove_cvref_t<Rhs>> &&
+    std::same_as<typename std::remove_cvref_t<Lhs>::word_type, typename std::remove_cvref_t<Rhs>::word_type>;
+
+// Lazy expressions keep references to lvalue operands & take ownership of temporaries so `auto e = v ^ ~w;` is safe.
+template<typename T>
+using expr_operand =
+    std::conditional_t<std::is_lvalue_reference_v<T>, std::remove_cvref_t<T> const&, std::remove_cvref_t<T>>;
+
+// Shifts read words at other indices so can't be evaluated straight into a bit-store that they may also be reading.
+template<typename Expr>
+constexpr bool
+is_elementwise() {
+    using expr_type = std::remove_cvref_t<Expr>;
+    if constexpr (BitStore<expr_type>) {
+        return true;
+    } else {
+        return expr_type::elementwise;
+    }
+}
+
+// The word-wise operations used by `gf2::BitBinaryExpr`.
+struct XorWords {
+    template<Unsigned Word>
+    constexpr Word operator()(Word a, Word b) const {
+        return static_cast<Word>(a ^ b);
+    }
+};
+struct AndWords {
+    template<Unsigned Word>
+    constexpr Word operator()(Word a, Word b) const {
+        return static_cast<Word>(a & b);
+    }
+};
+struct OrWords {
+    template<Unsigned Word>
+    constexpr Word operator()(Word a, Word b) const {
+        return static_cast<Word>(a | b);
+    }
+};
+
+// Returns `true` if a bit-store in the element-wise expression `expr` sits on real words of `dst` at another position.
+// Writing the result a word at a time into `dst` would then overwrite words of that operand before they are read.
+// An operand that is `dst` itself or views exactly the same bits is fine as each word is read before it is written.
+template<BitStore Dst, typename Expr>
+inline bool
+reads_other_words(Dst const& dst, Expr const& expr) {
+    if constexpr (BitStore<Expr>) {
+        if (dst.size() == 0) return false;
+        auto x = reinterpret_cast<std::uintptr_t>(dst.store());
+        auto y = reinterpret_cast<std::uintptr_t>(expr.store());
+        if (x == y && dst.offset() == expr.offset()) return false;
+        auto nx = real_words(dst).n * sizeof(*dst.store());
+        auto ny = real_words(expr).n * sizeof(*expr.store());
+        return x < y + ny && y < x + nx;
+    } else if constexpr (requires { expr.lhs(); }) {
+        return reads_other_words(dst, expr.lhs()) || reads_other_words(dst, expr.rhs());
+    } else {
+        return reads_other_words(dst, expr.arg());
+    }
+}
+
+// Returns `true` if `expr` has to be evaluated into a temporary before its value is written into `dst`.
+// That is the case for shifts, which read words at other indices, and for operands that overlap `dst` at an offset.
+template<BitStore Dst, typename Expr>
+constexpr bool
+needs_temporary(Dst const& dst, Expr const& expr) {
+    if constexpr (!is_elementwise<Expr>()) {
+        return true;
+    } else {
+        if consteval {
+            return false;
+        } else {
+            return reads_other_words(dst, expr);
+        }
+    }
+}
+
+} // namespace gf2::details
+
+namespace gf2 {
+
+/// The bit-vector style query methods shared by the lazy bit-expressions so that `(u ^ v).count_ones()` works.
+///
+/// The reductions go straight to the free functions of the same name and so work a word at a time without making a
+/// temporary. The string conversions and `evaluate()` produce a bit-vector first.
+///
+/// # Note
+/// A lazy expression holds references to its lvalue operands, so `auto w = u ^ v;` does *not* make a bit-vector.
+/// Use `BitVector w = u ^ v;` or `auto w = (u ^ v).evaluate();` if `w` has to outlive `u` or `v`, or must not see later
+/// changes to them.
+///
+/// # Example
+/// ```
+/// auto u = BitVector<u8>::ones(10);
+/// auto v = BitVector<u8>::alternating(10);
+/// assert_eq((u ^ v).count_ones(), 5);
+/// assert_eq((u & v).count_zeros(), 5);
+/// assert_eq((u ^ u).none(), true);
+/// assert_eq((u | v).all(), true);
+/// assert_eq((~v).any(), true);
+/// assert_eq((v >> 1).to_string(), "0101010101");
+/// auto e = u ^ v;
+/// auto w = e.evaluate();
+/// u.set_all(false);
+/// assert_eq(e.to_string(), "1010101010");
+/// assert_eq(w.to_string(), "0101010101");
+/// ```
+template<typename Expr, Unsigned Word>
+class BitExpressionMethods {
+public:
+    /// Returns a new bit-vector holding the value of the expression.
+    constexpr BitVector<Word> evaluate() const;
+
+    /// Returns the number of set bits in the expression.
+    constexpr usize count_ones() const;
+
+    /// Returns the number of unset bits in the expression.
+    constexpr usize count_zeros() const;
+
+    /// Returns `true` if any bit in the expression is set.
+    constexpr bool any() const;
+
+    /// Returns `true` if every bit in the expression is set (`true` for an empty expression).
+    constexpr bool all() const;
+
+    /// Returns `true` if no bit in the expression is set.
+    constexpr bool none() const;
+
+    /// Returns a binary string for the expression, see `gf2::to_string`.
+    std::string to_string(std::string_view sep = "", std::string_view pre = "", std::string_view post = "") const;
+
+    /// Returns a binary string for the expression like `[1,0,1]`, see `gf2::to_pretty_string`.
+    std::string to_pretty_string() const;
+
+    /// Returns a hex string for the expression, see `gf2::to_hex_string`.
+    std::string to_hex_string() const;
+
+private:
+    constexpr Expr const& derived() const { return static_cast<Expr const&>(*this); }
+};
+
+/// A lazy bit-expression for the word-wise `XOR`, `AND`, or `OR` of two equal-sized bit-expressions.
+///
+/// This is the return type of `lhs ^ rhs`, `lhs & rhs`, and `lhs | rhs` (and of `lhs + rhs` and `lhs - rhs`).
+/// Nothing is computed until the expression is evaluated, and then each word of the result comes straight from the
+/// matching words of the operands.
+///
+/// Operands that are lvalues are held by reference so they must outlive the expression. Temporary operands are moved
+/// into the expression.
+///
+/// # Example
+/// ```
+/// auto u = BitVector<u8>::ones(10);
+/// auto v = BitVector<u8>::alternating(10);
+/// auto e = u ^ v;
+/// assert_eq(e.size(), 10);
+/// BitVector w = e;
+/// assert_eq(w.to_string(), "0101010101");
+/// ```
+template<typename Op, typename Lhs, typename Rhs>
+class BitBinaryExpr
+    : public BitExpressionMethods<BitBinaryExpr<Op, Lhs, Rhs>, typename std::remove_cvref_t<Lhs>::word_type> {
+public:
+    /// The expression produces words of this type.
+    using word_type = typename std::remove_cvref_t<Lhs>::word_type;
+
+    /// Can the expression be written straight into one of its own operands?
+    static constexpr bool elementwise = details::is_elementwise<Lhs>() && details::is_elementwise<Rhs>();
+
+    /// Constructs the expression from its two operands.
+    ///
+    /// # Panics
+    /// This method panics if the sizes of the operands do not match.
+    template<typename L, typename R>
+    constexpr BitBinaryExpr(L&& lhs, R&& rhs) : m_lhs(std::forward<L>(lhs)), m_rhs(std::forward<R>(rhs)) {
+        gf2_assert(m_lhs.size() == m_rhs.size(), "Lengths do not match: {} != {}.", m_lhs.size(), m_rhs.size());
+    }
+
+    /// Returns the number of bits in the expression.
+    constexpr usize size() const { return m_lhs.size(); }
+
+    /// Returns the number of words needed to hold the bits in the expression.
+    constexpr usize words() const { return m_lhs.words(); }
+
+    /// Returns word `i` of the expression.
+    constexpr word_type word(usize i) const { return Op{}(m_lhs.word(i), m_rhs.word(i)); }
+
+    /// Returns the left operand of the expression.
+    constexpr Lhs const& lhs() const { return m_lhs; }
+
+    /// Returns the right operand of the expression.
+    constexpr Rhs const& rhs() const { return m_rhs; }
+
+    /// Does the expression own a temporary bit-vector operand whose words can hold the result?
+    static constexpr bool owns_vector =
+        std::same_as<Lhs, BitVector<word_type>> || std::same_as<Rhs, BitVector<word_type>>;
+
+    /// Evaluates the expression into the words of the temporary bit-vector operand it owns and returns that operand.
+    ///
+    /// This is how a bit-vector constructed from an expression like `dot(M, v) ^ w` takes over the words of `dot(M, v)`
+    /// instead of allocating its own. The word-wise operations are all symmetric, so either operand will do.
+    constexpr BitVector<word_type> evaluate_in_place() &&
+        requires owns_vector
+    {
+        if constexpr (std::same_as<Lhs, BitVector<word_type>>) {
+            for (auto i = 0uz; i < m_lhs.words(); ++i) m_lhs.set_word(i, Op{}(m_lhs.word(i), m_rhs.word(i)));
+            return std::move(m_lhs);
+        } else {
+            for (auto i = 0uz; i < m_rhs.words(); ++i) m_rhs.set_word(i, Op{}(m_lhs.word(i), m_rhs.word(i)));
+            return std::move(m_rhs);
+        }
+    }
+
+private:
+    Lhs m_lhs;
+    Rhs m_rhs;
+};
+
+/// A lazy bit-expression for a bit-expression with all its bits flipped -- the return type of `~store`.
+///
+/// # Example
+/// ```
+/// auto v = BitVector<u8>::alternating(10);
+/// BitVector w = ~v;
+/// assert_eq(w.to_string(), "0101010101");
+/// ```
+template<typename Arg>
+class BitNotExpr : public BitExpressionMethods<BitNotExpr<Arg>, typename std::remove_cvref_t<Arg>::word_type> {
+public:
+    /// The expression produces words of this type.
+    using word_type = typename std::remove_cvref_t<Arg>::word_type;
+
+    /// Can the expression be written straight into its own operand?
+    static constexpr bool elementwise = details::is_elementwise<Arg>();
+
+    /// Constructs the expression from its operand.
+    template<typename A>
+    explicit constexpr BitNotExpr(A&& arg) : m_arg(std::forward<A>(arg)) {}
+
+    /// Returns the number of bits in the expression.
+    constexpr usize size() const { return m_arg.size(); }
+
+    /// Returns the number of words needed to hold the bits in the expression.
+    constexpr usize words() const { return m_arg.words(); }
+
+    /// Returns word `i` of the expression (the unused bits in the final word stay unset).
+    constexpr word_type word(usize i) const {
+        auto result = static_cast<word_type>(~m_arg.word(i));
+        auto tail = size() % BITS<word_type>;
+        if (i + 1 == words() && tail != 0) result &= static_cast<word_type>(MAX<word_type> >> (BITS<word_type> - tail));
+        return result;
+    }
+
+    /// Returns the operand of the expression.
+    constexpr Arg const& arg() const { return m_arg; }
+
+private:
+    Arg m_arg;
+};
+
+/// A lazy bit-expression for a bit-expression shifted by a number of bits -- the return type of `store << n` and
+/// `store >> n`.
+///
+/// Shifting is in *vector-order* so a left shift moves the bits towards index `0` and a right shift moves them towards
+/// the end, with zeros filling the vacated slots in either case.
+///
+/// # Example
+/// ```
+/// auto v = BitVector<u8>::ones(20);
+/// BitVector w = v << 8;
+/// assert_eq(w.to_string(), "11111111111100000000");
+/// BitVector x = v >> 8;
+/// assert_eq(x.to_string(), "00000000111111111111");
+/// ```
+template<typename Arg, bool Left>
+class BitShiftExpr
+    : public BitExpressionMethods<BitShiftExpr<Arg, Left>, typename std::remove_cvref_t<Arg>::word_type> {
+public:
+    /// The expression produces words of this type.
+    using word_type = typename std::remove_cvref_t<Arg>::word_type;
+
+    /// Each word of a shift comes from other words of the operand so it can't be written into that operand directly.
+    static constexpr bool elementwise = false;
+
+    /// Constructs the expression from its operand and the number of bits to shift by.
+    template<typename A>
+    constexpr BitShiftExpr(A&& arg, usize shift) :
+        m_arg(std::forward<A>(arg)), m_word_shift(shift / BITS<word_type>),
+        m_bit_shift(static_cast<u8>(shift % BITS<word_type>)) {}
+
+    /// Returns the number of bits in the expression.
+    constexpr usize size() const { return m_arg.size(); }
+
+    /// Returns the number of words needed to hold the bits in the expression.
+    constexpr usize words() const { return m_arg.words(); }
+
+    /// Returns word `i` of the expression.
+    constexpr word_type word(usize i) const {
+        constexpr auto bits_per_word = BITS<word_type>;
+        word_type      result = 0;
+        if constexpr (Left) {
+            // Bit `j` of the result is bit `j + shift` of the operand (whose own unused bits are already unset).
+            if (m_word_shift >= words() - i) return 0;
+            auto j = i + m_word_shift;
+            result = static_cast<word_type>(arg_word(j) >> m_bit_shift);
+            if (m_bit_shift != 0) result |= static_cast<word_type>(arg_word(j + 1) << (bits_per_word - m_bit_shift));
+        } else {
+            // Bit `j` of the result is bit `j - shift` of the operand & we need to unset any bits pushed off the end.
+            if (i < m_word_shift) return 0;
+            auto j = i - m_word_shift;
+            result = static_cast<word_type>(arg_word(j) << m_bit_shift);
+            if (m_bit_shift != 0 && j > 0)
+                result |= static_cast<word_type>(arg_word(j - 1) >> (bits_per_word - m_bit_shift));
+            auto tail = size() % bits_per_word;
+            if (i + 1 == words() && tail != 0)
+                result &= static_cast<word_type>(MAX<word_type> >> (bits_per_word - tail));
+        }
+        return result;
+    }
+
+private:
+    Arg   m_arg;
+    usize m_word_shift;
+    u8    m_bit_shift;
+
+    // Returns word `j` of the operand or zero if `j` is past its end.
+    constexpr word_type arg_word(usize j) const { return j < m_arg.words() ? m_arg.word(j) : word_type{0}; }
+};
+
+} // namespace gf2
+
 // --------------------------------------------------------------------------------------------------------------------
 // Free Functions for BitStore Types.
 // --------------------------------------------------------------------------------------------------------------------
@@ -358,7 +853,7 @@ is_empty(Store const& store) {
 /// set(v, 0);
 /// assert_eq(any(v), true);
 /// ```
-template<BitStore Store>
+template<BitExpression Store>
 constexpr bool
 any(Store const& store) {
     for (auto i = 0uz; i < store.words(); ++i)
@@ -380,7 +875,7 @@ any(Store const& store) {
 /// set(v, 2);
 /// assert_eq(all(v), true);
 /// ```
-template<BitStore Store>
+template<BitExpression Store>
 constexpr bool
 all(Store const& store) {
     auto num_words = store.words();
@@ -414,7 +909,7 @@ all(Store const& store) {
 /// set(v,0);
 /// assert_eq(none(v), false);
 /// ```
-template<BitStore Store>
+template<BitExpression Store>
 constexpr bool
 none(Store const& store) {
     return !any(store);
@@ -439,6 +934,17 @@ constexpr void
 set_all(Store& store, bool value = true) {
     using word_type = typename Store::word_type;
     auto word_value = value ? MAX<word_type> : word_type{0};
+    if !consteval {
+        if constexpr (details::HasMutableWords<Store>) {
+            if (auto [n, first, last] = details::real_words(store); n > 1) {
+                auto p = store.store();
+                p[0] = details::blend(p[0], word_value, first);
+                details::simd::set_all(p + 1, n - 2, value);
+                p[n - 1] = details::blend(p[n - 1], word_value, last);
+                return;
+            }
+        }
+    }
     for (auto i = 0uz; i < store.words(); ++i) store.set_word(i, word_value);
 }
 
@@ -454,6 +960,17 @@ template<BitStore Store>
 constexpr void
 flip_all(Store& store) {
     using word_type = typename Store::word_type;
+    if !consteval {
+        if constexpr (details::HasMutableWords<Store>) {
+            if (auto [n, first, last] = details::real_words(store); n > 1) {
+                auto p = store.store();
+                p[0] ^= first;
+                details::simd::flip_all(p + 1, n - 2);
+                p[n - 1] ^= last;
+                return;
+            }
+        }
+    }
     for (auto i = 0uz; i < store.words(); ++i) store.set_word(i, static_cast<word_type>(~store.word(i)));
 }
 
@@ -560,7 +1077,7 @@ copy(Iter src_begin, Iter src_end, Store& store) {
     }
 }
 
-/// Copies all the bits from _any_ `src` bit-store to another _equal-sized_ `dst` bit-store.
+/// Copies all the bits from _any_ `src` bit-store (or lazy bit-expression) to another _equal-sized_ `dst` bit-store.
 ///
 /// # Note:
 /// This is one of the few methods in the library that *doesn't* require the two stores to have the same `word_type`.
@@ -576,8 +1093,19 @@ copy(Iter src_begin, Iter src_end, Store& store) {
 /// assert_eq(to_string(v), "1111111111");
 /// copy(BitVector<u8>::alternating(10), v);
 /// assert_eq(to_string(v), "1010101010");
+/// copy(~v, v);
+/// assert_eq(to_string(v), "0101010101");
+/// ```
+///
+/// # Example
+/// ```
+/// auto b = BitVector<u8>::random(100);
+/// auto expected = BitVector<u8>::from(b.span(0, 80));
+/// expected.flip_all();
+/// b.span(4, 84).copy(~b.span(0, 80));
+/// assert_eq(BitVector<u8>::from(b.span(4, 84)), expected);
 /// ```
-template<BitStore Src, BitStore Dst>
+template<BitExpression Src, BitStore Dst>
 constexpr void
 copy(Src const& src, Dst& dst) {
     // The sizes must match ...
@@ -587,6 +1115,16 @@ copy(Src const& src, Dst& dst) {
     using dst_type = std::remove_const_t<typename Dst::word_type>;
     using src_type = std::remove_const_t<typename Src::word_type>;
 
+    // An expression or store that may read words of `dst` we have already overwritten is evaluated first.
+    if (details::needs_temporary(dst, src)) {
+        if constexpr (details::LazyBitExpression<Src>) {
+            copy(BitVector<src_type>(src), dst);
+        } else {
+            copy(BitVector<src_type>::from(src), dst);
+        }
+        return;
+    }
+
     // Numbers of bits per respective words
     constexpr auto dst_bpw = BITS<dst_type>;
     constexpr auto src_bpw = BITS<src_type>;
@@ -675,6 +1213,103 @@ copy(Store& store, std::invocable<usize> auto f) {
         if (f(i) == true) set(store, i);
 }
 
+namespace details {
+
+// Returns the probability `p` scaled by 2^64 & rounded (or `std::nullopt` if `p` rounds to 1 so every bit is set).
+// A negative `p` is treated as 0.
+constexpr std::optional<u64>
+scaled_probability(double p) {
+    if (p < 0) return 0;
+    p = p * 0x1p64 + 0.5;
+    if (p >= 0x1p64) return std::nullopt;
+    return static_cast<u64>(p);
+}
+
+// Returns a 64-bit word where each bit is 1 with probability `scaled_p / 2^64`.
+//
+// If `p = 0.b_1 b_2 ... b_k` in binary then we start with a fair coin word for `b_k = 1` & work back up to `b_1`.
+// An `OR` with a fresh fair word takes a bit probability `q` to `(1 + q)/2` and an `AND` takes it to `q/2`. So after
+// the `k` steps each bit is 1 with probability exactly `p`. A fair coin needs one draw & in general we need `k`.
+template<RandomEngine Engine>
+constexpr u64
+random_bits(Engine& rng, u64 scaled_p) {
+    if (scaled_p == 0) return 0;
+
+    // We need one fair word for each bit of the expansion so we draw them all in one go.
+    auto                t = static_cast<usize>(std::countr_zero(scaled_p));
+    std::array<u64, 64> fair;
+    fill_words(rng, fair.data(), 64 - t);
+
+    u64 result = fair[0];
+    for (auto j = t + 1; j < 64; ++j) result = (scaled_p >> j) & 1 ? result | fair[j - t] : result & fair[j - t];
+    return result;
+}
+
+// Fills the store a word at a time where each bit is 1 with probability `scaled_p / 2^64`.
+// Each 64-bit draw is split over as many store words as it covers. Fair coins are drawn in bulk.
+template<BitStore Store, RandomEngine Engine>
+constexpr void
+fill_random_words(Store& store, Engine& rng, u64 scaled_p) {
+    using word_type = typename Store::word_type;
+    constexpr auto per_draw = 64 / BITS<word_type>;
+    constexpr auto batch = 64uz;
+    std::array<u64, batch> draws;
+
+    auto n_words = store.words();
+    auto n_draws = (n_words + per_draw - 1) / per_draw;
+    for (auto d0 = 0uz; d0 < n_draws; d0 += batch) {
+        auto n = std::min(batch, n_draws - d0);
+        if (scaled_p == u64{1} << 63) {
+            fill_words(rng, draws.data(), n);
+        } else {
+            for (auto d = 0uz; d < n; ++d) draws[d] = random_bits(rng, scaled_p);
+        }
+        for (auto d = 0uz; d < n; ++d) {
+            auto bits = draws[d];
+            auto i = (d0 + d) * per_draw;
+            for (auto k = 0uz; k < per_draw && i + k < n_words; ++k) {
+                store.set_word(i + k, static_cast<word_type>(bits));
+                if constexpr (per_draw > 1) bits >>= BITS<word_type>;
+            }
+        }
+    }
+}
+
+} // namespace details
+
+/// Fill the store with random bits from the passed random number engine where each bit is 1 with probability `p`.
+///
+/// The engine can be any type that satisfies the `gf2::RandomEngine` concept, e.g. `gf2::Xoshiro256pp`,
+/// `gf2::Philox4x32` or `std::mt19937_64`. If `p < 0` then the fill is all zeros, if `p > 1` then the fill is all ones.
+///
+/// The store is filled a word at a time. For a fair coin each word is just one draw from the engine (and those are
+/// drawn in bulk if the engine has a `fill` method). Otherwise `p` is rounded to a multiple of `2^-64` and we combine
+/// fair words with `AND`/`OR` to match its binary expansion, so a dyadic probability like `p = 0.25` or `p = 0.375`
+/// needs only a few draws per word.
+///
+/// # Example
+/// ```
+/// BitVector u{100}, v{100};
+/// Philox4x32 a{42, 7}, b{42, 7};
+/// fill_random(u, a);
+/// fill_random(v, b);
+/// assert(u == v);
+/// BitVector<u8> w{100'000};
+/// Xoshiro256pp rng{42};
+/// fill_random(w, rng, 0.25);
+/// auto ones = w.count_ones();
+/// assert(ones > 24'000 && ones < 26'000);
+/// ```
+template<BitStore Store, RandomEngine Engine>
+constexpr void
+fill_random(Store& store, Engine& rng, double p = 0.5) {
+    if (auto scaled_p = details::scaled_probability(p)) {
+        details::fill_random_words(store, rng, *scaled_p);
+    } else {
+        set_all(store);
+    }
+}
+
 /// Fill the store with random bits based on an optional probability `p` and an optional `seed` for the RNG.
 ///
 /// The default call `fill_random()` sets each bit to 1 with probability 0.5 (fair coin).
@@ -684,6 +1319,9 @@ copy(Store& store, std::invocable<usize> auto f) {
 ///
 /// If `p < 0` then the fill is all zeros, if `p > 1` then the fill is all ones.
 ///
+/// A non-zero seed fills from a fresh `gf2::RNG` with that seed. Otherwise we use a `gf2::RNG` that is kept per
+/// thread and seeded from entropy on its first use, so unseeded calls on different threads never share any state.
+///
 /// # Example
 /// ```
 /// BitVector u{10}, v{10};
@@ -695,36 +1333,15 @@ copy(Store& store, std::invocable<usize> auto f) {
 template<BitStore Store>
 constexpr void
 fill_random(Store& store, double p = 0.5, u64 seed = 0) {
-    // Keep a single static RNG per thread for all calls to this method, seeded with entropy on the first call.
-    thread_local RNG rng;
-
-    // Edge case handling ...
-    if (p < 0) {
-        set_all(store, false);
+    if (seed != 0) {
+        RNG rng{seed};
+        fill_random(store, rng, p);
         return;
     }
 
-    // Scale p by 2^64 to remove floating point arithmetic from the main loop below.
-    // If we determine p rounds to 1 then we can just set all elements to 1 and return early.
-    p = p * 0x1p64 + 0.5;
-    if (p >= 0x1p64) {
-        set_all(store);
-        return;
-    }
-
-    // p does not round to 1 so we use a 64-bit URNG and check each draw against the 64-bit scaled p.
-    auto scaled_p = static_cast<u64>(p);
-
-    // If a seed was provided, set the RNG's seed to it. Otherwise, we carry on from where we left off.
-    u64 old_seed = rng.seed();
-    if (seed != 0) rng.set_seed(seed);
-
-    set_all(store, false);
-    for (auto i = 0uz; i < store.size(); ++i)
-        if (rng.u64() < scaled_p) set(store, i);
-
-    // Restore the old seed if necessary.
-    if (seed != 0) rng.set_seed(old_seed);
+    // Keep a single static RNG per thread for all unseeded calls to this method, seeded with entropy on first use.
+    thread_local RNG rng;
+    fill_random(store, rng, p);
 }
 
 /// @}
@@ -740,9 +1357,21 @@ fill_random(Store& store, double p = 0.5, u64 seed = 0) {
 /// set(v, 0);
 /// assert_eq(count_ones(v), 1);
 /// ```
-template<BitStore Store>
+template<BitExpression Store>
 constexpr usize
 count_ones(Store const& store) {
+    if constexpr (BitStore<Store>) {
+        if !consteval {
+            // Counts don't care where the bits sit in the real words so we can always count those directly.
+            if (auto [n, first, last] = details::real_words(store); n > 1) {
+                using word_type = typename Store::word_type;
+                auto p = store.store();
+                auto count = details::simd::count_ones(p + 1, n - 2);
+                return count + static_cast<usize>(gf2::count_ones(static_cast<word_type>(p[0] & first)) +
+                                                  gf2::count_ones(static_cast<word_type>(p[n - 1] & last)));
+            }
+        }
+    }
     usize count = 0;
     for (auto i = 0uz; i < store.words(); ++i) count += static_cast<usize>(gf2::count_ones(store.word(i)));
     return count;
@@ -757,12 +1386,99 @@ count_ones(Store const& store) {
 /// set(v, 0);
 /// assert_eq(count_zeros(v), 9);
 /// ```
-template<BitStore Store>
+template<BitExpression Store>
 constexpr usize
 count_zeros(Store const& store) {
     return store.size() - count_ones(store);
 }
 
+namespace details {
+
+// Returns the number of places where `lhs` and `rhs` differ, stopping early with some count above `limit` once the
+// count passes `limit`. Stores that start at the same bit-offset go through the fused XOR-popcount kernel.
+template<BitExpression Lhs, BitExpression Rhs>
+constexpr usize
+hamming_distance(Lhs const& lhs, Rhs const& rhs, usize limit) {
+    using word_type = typename Lhs::word_type;
+    if constexpr (BitStore<Lhs> && BitStore<Rhs>) {
+        if !consteval {
+            auto [n, first, last] = real_words(lhs);
+            if (n > 1 && lhs.offset() == rhs.offset()) {
+                auto a = lhs.store();
+                auto b = rhs.store();
+                auto edges = static_cast<usize>(gf2::count_ones(static_cast<word_type>((a[0] ^ b[0]) & first)) +
+                                                gf2::count_ones(static_cast<word_type>((a[n - 1] ^ b[n - 1]) & last)));
+                if (edges > limit) return edges;
+                return edges + simd::xor_count_ones(a + 1, b + 1, n - 2, limit - edges);
+            }
+        }
+    }
+    usize count = 0;
+    for (auto i = 0uz; i < lhs.words() && count <= limit; ++i)
+        count += static_cast<usize>(gf2::count_ones(static_cast<word_type>(lhs.word(i) ^ rhs.word(i))));
+    return count;
+}
+
+} // namespace details
+
+/// Returns the Hamming distance between `lhs` and `rhs`, the number of places where they differ.
+///
+/// This is `count_ones(lhs ^ rhs)` fused into a single pass: when both operands start at the same bit-offset in their
+/// first words, as every pair of bit-vectors and bit-matrix rows does, the words go straight through a vectorized
+/// XOR-popcount kernel.
+///
+/// # Panics
+/// In debug mode, this method panics if the lengths of the two bit-stores do not match.
+///
+/// # Example
+/// ```
+/// auto u = BitVector<>::from_string("1100110011").value();
+/// auto v = BitVector<>::from_string("1010101010").value();
+/// assert_eq(hamming_distance(u, v), 5);
+/// assert_eq(hamming_distance(u, u), 0);
+/// auto a = BitVector<u8>::random(1000);
+/// auto b = BitVector<u8>::random(1000);
+/// assert_eq(hamming_distance(a, b), count_ones(a ^ b));
+/// assert_eq(hamming_distance(a.span(3, 900), b.span(3, 900)), count_ones(a.span(3, 900) ^ b.span(3, 900)));
+/// assert_eq(hamming_distance(a.span(3, 900), b.span(5, 902)), count_ones(a.span(3, 900) ^ b.span(5, 902)));
+/// ```
+template<BitExpression Lhs, BitExpression Rhs>
+    requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
+constexpr usize
+hamming_distance(Lhs const& lhs, Rhs const& rhs) {
+    gf2_debug_assert_eq(lhs.size(), rhs.size(), "Length mismatch {} != {}", lhs.size(), rhs.size());
+    return details::hamming_distance(lhs, rhs, std::numeric_limits<usize>::max());
+}
+
+/// Returns the Hamming distance between `lhs` and `rhs` if it is at most `max_distance`, or `std::nullopt` if not.
+///
+/// The scan gives up as soon as the count passes `max_distance`, which is what a nearest-neighbour search wants once
+/// it has a candidate to beat.
+///
+/// # Panics
+/// In debug mode, this method panics if the lengths of the two bit-stores do not match.
+///
+/// # Example
+/// ```
+/// auto u = BitVector<>::zeros(5000);
+/// auto v = BitVector<>::zeros(5000);
+/// v.set(10);
+/// v.set(4000);
+/// assert_eq(hamming_distance(u, v, 2).value(), 2);
+/// assert_eq(hamming_distance(u, v, 1).has_value(), false);
+/// assert_eq(hamming_distance(u, v, 0).has_value(), false);
+/// assert_eq(hamming_distance(u, u, 0).value(), 0);
+/// ```
+template<BitExpression Lhs, BitExpression Rhs>
+    requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
+constexpr std::optional<usize>
+hamming_distance(Lhs const& lhs, Rhs const& rhs, usize max_distance) {
+    gf2_debug_assert_eq(lhs.size(), rhs.size(), "Length mismatch {} != {}", lhs.size(), rhs.size());
+    auto d = details::hamming_distance(lhs, rhs, max_distance);
+    if (d > max_distance) return std::nullopt;
+    return d;
+}
+
 /// Returns the number of leading zeros in the store.
 ///
 /// # Example
@@ -779,6 +1495,15 @@ constexpr usize
 leading_zeros(Store const& store) {
     // Note: Even if the last word is not fully occupied, we know unused bits are set to 0.
     auto bits_per_word = BITS<typename Store::word_type>;
+    if !consteval {
+        if (details::has_direct_words(store)) {
+            auto n = store.words();
+            auto i = details::simd::first_non_zero(store.store(), n - 1);
+            if (i < n - 1) return i * bits_per_word + static_cast<usize>(gf2::trailing_zeros(store.store()[i]));
+            auto w = store.word(n - 1);
+            return w != 0 ? (n - 1) * bits_per_word + static_cast<usize>(gf2::trailing_zeros(w)) : store.size();
+        }
+    }
     for (auto i = 0uz; i < store.words(); ++i) {
         auto w = store.word(i);
         if (w != 0) return i * bits_per_word + static_cast<usize>(gf2::trailing_zeros(w));
@@ -806,6 +1531,14 @@ trailing_zeros(Store const& store) {
     auto unused_bits = tail_bits == 0 ? 0 : bits_per_word - tail_bits;
     auto num_words = store.words();
     auto i = num_words;
+    if !consteval {
+        if (details::has_direct_words(store) && store.word(num_words - 1) == 0) {
+            // The last word is empty so look for the last non-zero word among the others.
+            i = details::simd::last_non_zero(store.store(), num_words - 1);
+            if (i == num_words - 1) return store.size();
+            i += 1;
+        }
+    }
     while (i--) {
         auto w = store.word(i);
         if (w != 0) {
@@ -842,7 +1575,11 @@ first_set(Store const& store) {
     // Iterate forward looking for a word with a set bit and use the lowest of those ...
     // Remember that any unused bits in the final word are guaranteed to be unset.
     auto bits_per_word = BITS<typename Store::word_type>;
-    for (auto i = 0uz; i < store.words(); ++i) {
+    auto start = 0uz;
+    if !consteval {
+        if (details::has_direct_words(store)) start = details::simd::first_non_zero(store.store(), store.words() - 1);
+    }
+    for (auto i = start; i < store.words(); ++i) {
         if (auto loc = lowest_set_bit(store.word(i))) return i * bits_per_word + loc.value();
     }
     return {};
@@ -867,7 +1604,15 @@ last_set(Store const& store) {
     // Iterate backward looking for a word with a set bit and use the highest of those ...
     // Remember that any unused bits in the final word are guaranteed to be unset.
     auto bits_per_word = BITS<typename Store::word_type>;
-    for (auto i = store.words(); i--;) {
+    auto end = store.words();
+    if !consteval {
+        if (details::has_direct_words(store) && store.word(end - 1) == 0) {
+            // The last word is empty so look for the last non-zero word among the others.
+            auto i = details::simd::last_non_zero(store.store(), end - 1);
+            end = i == end - 1 ? 0 : i + 1;
+        }
+    }
+    for (auto i = end; i--;) {
         if (auto loc = highest_set_bit(store.word(i))) return i * bits_per_word + loc.value();
     }
     return {};
@@ -1188,6 +1933,76 @@ unset_bits(Store const& store) {
     return UnsetBits<Store>(&store);
 }
 
+/// Calls `f(i)` for the index `i` of each set bit in the bit-store in increasing order.
+///
+/// This is the fastest way to visit the set bits. We read each store word once and then repeatedly peel off its lowest
+/// set bit, so sparse stores cost little more than a scan of their words.
+///
+/// # Example
+/// ```
+/// auto v = BitVector<u8>::alternating(10);
+/// std::vector<usize> indices;
+/// for_each_set_bit(v, [&](usize i) { indices.push_back(i); });
+/// assert_eq(indices, (std::vector<usize>{0, 2, 4, 6, 8}));
+/// ```
+template<BitStore Store, typename F>
+    requires std::invocable<F&, usize>
+constexpr void
+for_each_set_bit(Store const& store, F&& f) {
+    using word_type = typename Store::word_type;
+    auto n_words = store.words();
+    for (auto i = 0uz; i < n_words; ++i) {
+        auto base = i * BITS<word_type>;
+        for (auto w = store.word(i); w != 0; w &= static_cast<word_type>(w - 1))
+            f(base + static_cast<usize>(std::countr_zero(w)));
+    }
+}
+
+/// Writes the indices of the set bits in the bit-store to `out` in increasing order and returns how many it wrote.
+///
+/// # Note
+/// - At most `out.size()` indices are written. Use `count_ones(store)` to size `out` for all of them.
+/// - If there is extra space in `out`, those extra slots are left unchanged.
+///
+/// # Example
+/// ```
+/// auto v = BitVector<u8>::alternating(10);
+/// std::array<usize, 8> out{};
+/// assert_eq(to_indices(v, out), 5);
+/// assert_eq(out[4], 8);
+/// std::array<usize, 2> small{};
+/// assert_eq(to_indices(v, small), 2);
+/// assert_eq(small[1], 2);
+/// ```
+template<BitStore Store>
+constexpr usize
+to_indices(Store const& store, std::span<usize> out) {
+    using word_type = typename Store::word_type;
+    auto n_words = store.words();
+    auto k = 0uz;
+    for (auto i = 0uz; i < n_words && k < out.size(); ++i) {
+        auto base = i * BITS<word_type>;
+        for (auto w = store.word(i); w != 0 && k < out.size(); w &= static_cast<word_type>(w - 1))
+            out[k++] = base + static_cast<usize>(std::countr_zero(w));
+    }
+    return k;
+}
+
+/// Returns the indices of the set bits in the bit-store as a new `std::vector` in increasing order.
+///
+/// # Example
+/// ```
+/// auto v = BitVector<u8>::alternating(10);
+/// assert_eq(to_indices(v), (std::vector<usize>{0, 2, 4, 6, 8}));
+/// ```
+template<BitStore Store>
+constexpr std::vector<usize>
+to_indices(Store const& store) {
+    std::vector<usize> result(count_ones(store));
+    to_indices(store, result);
+    return result;
+}
+
 /// Returns a const iterator over all the *words* underlying the bit-store.
 ///
 /// You can use this iterator to iterate over the words in the store and read the `Word` value of each word.
@@ -1329,8 +2144,9 @@ span(Store& store, usize begin, usize end) {
         bit_offset %= bits_per_word;
     }
 
-    // Return the read-only bit-span over the underlying word data.
-    return BitSpan<word_type>(store.store() + data_index, bit_offset, end - begin);
+    // Return the bit-span over the underlying word data (read-only if `store` is itself a span of const words).
+    using span_word_type = std::remove_pointer_t<decltype(store.store())>;
+    return BitSpan<span_word_type>(store.store() + data_index, bit_offset, end - begin);
 }
 
 /// @}
@@ -1512,9 +2328,126 @@ riffle(Store const& store) {
 }
 
 /// @}
+
+namespace details {
+
+// The eight characters for the elements in each possible byte of a bit-store, element 0 (bit 0) first.
+inline constexpr auto binary_chars_for_byte = [] {
+    std::array<std::array<char, 8>, 256> table{};
+    for (auto b = 0uz; b < 256; ++b)
+        for (auto i = 0uz; i < 8; ++i) table[b][i] = ((b >> i) & 1) != 0 ? '1' : '0';
+    return table;
+}();
+
+// The two hex digits for the elements in each possible byte of a bit-store, the low nibble first.
+// Elements are read in vector-order so the first element of a nibble is the *most* significant bit of its digit.
+inline constexpr auto hex_chars_for_byte = [] {
+    constexpr char                       digits[] = "0123456789ABCDEF";
+    std::array<std::array<char, 2>, 256> table{};
+    for (auto b = 0uz; b < 256; ++b) {
+        auto rev = reverse_bits(static_cast<u8>(b));
+        table[b] = {digits[(rev >> 4) & 0xF], digits[rev & 0xF]};
+    }
+    return table;
+}();
+
+// Writes the characters for the first `n` elements held in the bytes of `store` to `out` via the table `chars` which
+// has `k` characters per byte. Returns the iterator past the last character written.
+template<BitStore Store, typename Out, usize k>
+constexpr Out
+write_byte_chars(Out out, Store const& store, usize n, std::array<std::array<char, k>, 256> const& chars) {
+    using word_type = typename Store::word_type;
+    auto n_words = store.words();
+    for (auto i = 0uz; i < n_words && n > 0; ++i) {
+        auto word = store.word(i);
+        for (auto j = 0uz; j < sizeof(word_type) && n > 0; ++j) {
+            auto const& c = chars[static_cast<u8>(word >> (8 * j))];
+            auto        len = std::min(n, k);
+            out = std::copy_n(c.data(), len, out);
+            n -= len;
+        }
+    }
+    return out;
+}
+
+} // namespace details
+
 /// @name String Representations:
 /// @{
 
+/// Writes the binary string representation of a store to an output iterator and returns the iterator past the end.
+///
+/// This is what `to_binary_string` and the `std::formatter` for bit-stores use. It writes the characters straight to
+/// `out`, which can be a `char*` into a buffer of your own, a `std::back_inserter`, or the output of a format context,
+/// without building any intermediate strings. We look up the eight characters for each byte of the store in a table.
+///
+/// @param out Where to write the characters.
+/// @param store The bit-store to write.
+/// @param sep The separator between bit elements which defaults to no separator.
+/// @param pre The prefix to add to the string which defaults to no prefix.
+/// @param post The postfix to add to the string which defaults to no postfix.
+///
+/// # Example
+/// ```
+/// auto v = BitVector<>::alternating(10);
+/// std::array<char, 16> buffer{};
+/// auto end = format_binary_to(buffer.data(), v);
+/// assert_eq(std::string_view(buffer.data(), end), "1010101010");
+/// std::string s;
+/// format_binary_to(std::back_inserter(s), v.span(0, 3), ",", "[", "]");
+/// assert_eq(s, "[1,0,1]");
+/// ```
+template<BitStore Store, std::output_iterator<char> Out>
+constexpr Out
+format_binary_to(Out out, Store const& store, std::string_view sep = "", std::string_view pre = "",
+                 std::string_view post = "") {
+    out = std::ranges::copy(pre, out).out;
+    if (sep.empty()) {
+        out = details::write_byte_chars(out, store, store.size(), details::binary_chars_for_byte);
+    } else {
+        for (auto i = 0uz; i < store.size(); ++i) {
+            if (i != 0) out = std::ranges::copy(sep, out).out;
+            *out++ = get(store, i) ? '1' : '0';
+        }
+    }
+    return std::ranges::copy(post, out).out;
+}
+
+/// Writes the hex string representation of a store to an output iterator and returns the iterator past the end.
+///
+/// The format is the same as `to_hex_string` which is built on this function. We look up the two hex digits for each
+/// byte of the store in a table so no bit reversal is needed.
+///
+/// # Example
+/// ```
+/// auto v = BitVector<>::ones(5);
+/// std::array<char, 16> buffer{};
+/// auto end = format_hex_to(buffer.data(), v);
+/// assert_eq(std::string_view(buffer.data(), end), "F1.2");
+/// ```
+template<BitStore Store, std::output_iterator<char> Out>
+constexpr Out
+format_hex_to(Out out, Store const& store) {
+    // Every four elements are encoded by a single hex digit.
+    auto n = store.size();
+    out = details::write_byte_chars(out, store, n / 4, details::hex_chars_for_byte);
+
+    // But `size()` may not be a multiple of 4 in which case the last digit is written in base 2, 4 or 8.
+    auto k = n % 4;
+    if (k != 0) {
+        // We compute the number represented by the trailing `k` elements in the bit-vector.
+        int num = 0;
+        for (auto i = 0uz; i < k; ++i)
+            if (get(store, n - 1 - i)) num |= 1 << i;
+
+        // Write that digit with the appropriate base so that it can be interpreted properly.
+        *out++ = "01234567"[num];
+        *out++ = '.';
+        *out++ = "248"[k - 1];
+    }
+    return out;
+}
+
 /// Returns a binary string representation of a store.
 ///
 /// The string is formatted as a sequence of `0`s and `1`s with the least significant bit on the right.
@@ -1535,34 +2468,11 @@ riffle(Store const& store) {
 template<BitStore Store>
 static std::string
 to_binary_string(Store const& store, std::string_view sep = "", std::string_view pre = "", std::string_view post = "") {
-    // Edge case ...
-    if (is_empty(store)) { return std::format("{}{}", pre, post); }
-
-    // Start with the raw binary string by iterating over the words ...
-    // We preallocate enough space to hold the entire string (actually this is usually a bit bigger than we need).
-    auto        num_words = store.words();
-    std::string binary_string;
-    binary_string.reserve(num_words * BITS<typename Store::word_type>);
-    for (auto i = 0uz; i < num_words; ++i) {
-        auto w = reverse_bits(store.word(i));
-        binary_string.append(gf2::to_binary_string(w));
-    }
-
-    // The last word may not be fully occupied and we need to remove the spurious zeros
-    binary_string.resize(store.size());
-
-    // If there is no separator, return early ...
-    if (sep.empty()) { return std::format("{}{}{}", pre, binary_string, post); }
-
-    // Build `result` with separators between each character ...
-    std::string result;
-    result.reserve(pre.size() + store.size() * (sep.size() + 1) + post.size());
-    result.append(pre);
-    for (auto i = 0uz; i < store.size(); ++i) {
-        result.push_back(binary_string[i]);
-        if (i != store.size() - 1) { result.append(sep); }
-    }
-    result.append(post);
+    // We size the string exactly and then write the characters straight into it.
+    auto        n = store.size();
+    auto        n_seps = n > 0 ? n - 1 : 0;
+    std::string result(pre.size() + n + n_seps * sep.size() + post.size(), '\0');
+    format_binary_to(result.data(), store, sep, pre, post);
     return result;
 }
 
@@ -1640,40 +2550,10 @@ to_pretty_string(Store const& store) {
 template<BitStore Store>
 static std::string
 to_hex_string(Store const& store) {
-    // Edge case: No bits in the store, return the empty string.
-    if (is_empty(store)) return "";
-
-    // The number of digits in the output string. Generally hexadecimal but the last may be to a lower base.
-    auto digits = (store.size() + 3) / 4;
-
-    // Preallocate space allowing for a possible lower base on the last digit such as "_2".
-    std::string result;
-    result.reserve(digits + 2);
-
-    //  Reverse the bits in each word to vector-order and get the fully padded hex string representation.
-    using word_type = typename Store::word_type;
-    for (auto i = 0uz; i < store.words(); ++i) {
-        auto w = reverse_bits(store.word(i));
-        result.append(gf2::to_hex_string<word_type>(w));
-    }
-
-    // Last word may not be fully occupied and padded with spurious zeros so we truncate the output string.
-    result.resize(digits);
-
-    // Every four elements is encoded by a single hex digit but `size()` may not be a multiple of 4.
-    auto k = store.size() % 4;
-    if (k != 0) {
-        // That last hex digit should really be encoded to a lower base -- 2, 4 or 8.
-        // We compute the number represented by the trailing `k` elements in the bit-vector.
-        int num = 0;
-        for (auto i = 0uz; i < k; ++i)
-            if (get(store, store.size() - 1 - i)) num |= 1 << i;
-
-        // Convert that number to hex & use it to *replace* the last hex digit in our `result` string.
-        // Also append the appropriate base to the output string so that the last digit can be interpreted properly.
-        result.resize(result.size() - 1);
-        result.append(std::format("{:X}.{}", num, 1 << k));
-    }
+    // One digit per four elements plus a possible ".base" suffix on the last one -- we size the string exactly.
+    auto        n = store.size();
+    std::string result(n / 4 + (n % 4 != 0 ? 3 : 0), '\0');
+    format_hex_to(result.data(), store);
     return result;
 }
 
@@ -1728,12 +2608,25 @@ operator<<(Store const& store, std::ostream& s) {
 /// v.set(23, false);
 /// assert(u != v);
 /// ```
-template<BitStore Lhs, BitStore Rhs>
+template<BitExpression Lhs, BitExpression Rhs>
 constexpr bool
 operator==(Lhs const& lhs, Rhs const& rhs) {
     if constexpr (!std::same_as<typename Lhs::word_type, typename Rhs::word_type>) return false;
-    if (&lhs != &rhs) {
+    if (static_cast<void const*>(&lhs) != static_cast<void const*>(&rhs)) {
         if (lhs.size() != rhs.size()) return false;
+        if !consteval {
+            if constexpr (BitStore<Lhs> && BitStore<Rhs> &&
+                          std::same_as<typename Lhs::word_type, typename Rhs::word_type>) {
+                auto [n, first, last] = details::real_words(lhs);
+                if (n > 1 && lhs.offset() == rhs.offset()) {
+                    // The bits line up in the real words so we can compare those directly.
+                    auto a = lhs.store();
+                    auto b = rhs.store();
+                    return ((a[0] ^ b[0]) & first) == 0 && details::simd::equal(a + 1, b + 1, n - 2) &&
+                           ((a[n - 1] ^ b[n - 1]) & last) == 0;
+                }
+            }
+        }
         for (auto i = 0uz; i < lhs.words(); ++i)
             if (lhs.word(i) != rhs.word(i)) return false;
     }
@@ -1867,71 +2760,103 @@ operator>>=(Store& store, usize shift) {
 /// @name Out-of-place Bit Shifts:
 /// @{
 
-/// Returns a new bit-vector that is the store shifted left by `shift` bits.
+/// Returns a lazy bit-expression for a bit-expression shifted left by `shift` bits.
 ///
 /// Shifting is in *vector-order* so if `v = [v0,v1,v2,v3]` then `v << 1` is `[v1,v2,v3,0]` with zeros added to
 /// the right. Left shifting in vector-order is the same as right shifting in bit-order.
 ///
-/// **Note:** Only accessible bits are affected by the shift.
+/// The result is a `gf2::BitShiftExpr` that is evaluated a word at a time when it is assigned to a bit-vector, copied
+/// into a bit-store, or reduced.
 ///
 /// # Example
 /// ```
 /// auto v = BitVector<u8>::ones(20);
-/// auto w = v << 8;
+/// BitVector w = v << 8;
 /// assert_eq(to_string(w), "11111111111100000000");
+/// assert_eq(count_ones(v << 12), 8);
 /// ```
-template<BitStore Store>
+template<typename Expr>
+    requires BitExpression<std::remove_cvref_t<Expr>>
 constexpr auto
-operator<<(Store const& store, usize shift) {
-    auto result = BitVector<typename Store::word_type>::from(store);
-    result <<= shift;
-    return result;
+operator<<(Expr&& expr, usize shift) {
+    return BitShiftExpr<details::expr_operand<Expr>, true>{std::forward<Expr>(expr), shift};
 }
 
-/// Returns a new bit-vector that is `lhs` shifted right by `shift` bits.
+/// Returns a lazy bit-expression for a bit-expression shifted right by `shift` bits.
 ///
-/// Shifting is in *vector-order* so if `v = [v0,v1,v2,v3]` then `v >>= 1` is `[0,v0,v1,v2]` with zeros added to
+/// Shifting is in *vector-order* so if `v = [v0,v1,v2,v3]` then `v >> 1` is `[0,v0,v1,v2]` with zeros added to
 /// the left. Right shifting in vector-order is the same as left shifting in bit-order.
 ///
-/// **Note:** Only accessible bits are affected by the shift.
+/// The result is a `gf2::BitShiftExpr` that is evaluated a word at a time when it is assigned to a bit-vector, copied
+/// into a bit-store, or reduced.
 ///
 /// # Example
 /// ```
 /// auto v = BitVector<u8>::ones(20);
-/// auto w = v >> 8;
+/// BitVector w = v >> 8;
 /// assert_eq(to_string(w), "00000000111111111111");
+/// assert_eq(count_ones(v >> 12), 8);
 /// ```
-template<BitStore Store>
+template<typename Expr>
+    requires BitExpression<std::remove_cvref_t<Expr>>
 constexpr auto
-operator>>(Store const& store, usize shift) {
-    auto result = BitVector<typename Store::word_type>::from(store);
-    result >>= shift;
-    return result;
+operator>>(Expr&& expr, usize shift) {
+    return BitShiftExpr<details::expr_operand<Expr>, false>{std::forward<Expr>(expr), shift};
 }
 
 /// @}
 /// @name In-place Bitwise Operations:
 /// @{
 
-/// In-place `XOR` of one bit-store with an equal-sized bit-store.
+/// In-place `XOR` of one bit-store with an equal-sized bit-store or lazy bit-expression.
 ///
-/// **Note:** Only accessible bits are affected by the shift.
+/// A lazy right-hand side like `a & b` is evaluated a word at a time straight into `lhs`.
+///
+/// # Panics
+/// This method panics if the lengths of the two bit-stores do not match.
 ///
 /// # Example
 /// ```
 /// auto v1 = BitVector<u8>::alternating(10);
 /// v1 ^= ~v1;
 /// assert_eq(to_string(v1), "1111111111");
+/// v1 ^= v1 >> 2;
+/// assert_eq(to_string(v1), "1100000000");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
+///
+/// # Example
+/// ```
+/// auto v = BitVector<u8>::random(100);
+/// auto w = BitVector<u8>::random(80);
+/// auto expected = BitVector<u8>::from(v.span(3, 83));
+/// expected ^= BitVector<u8>::from(v.span(0, 80)) & w;
+/// auto s = v.span(3, 83);
+/// s ^= (v.span(0, 80) & w);
+/// assert_eq(BitVector<u8>::from(v.span(3, 83)), expected);
+/// ```
+template<BitStore Lhs, BitExpression Rhs>
     requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
 constexpr void
 operator^=(Lhs& lhs, Rhs const& rhs) {
     gf2_assert(lhs.size() == rhs.size(), "Lengths do not match: {} != {}.", lhs.size(), rhs.size());
-    for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) ^ rhs.word(i));
+    if constexpr (details::LazyBitExpression<Rhs>) {
+        // Expressions that may read words of `lhs` we have already overwritten are evaluated first.
+        if (details::needs_temporary(lhs, rhs)) {
+            lhs ^= BitVector<typename Lhs::word_type>(rhs);
+            return;
+        }
+        for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) ^ rhs.word(i));
+    } else {
+        if !consteval {
+            using word_type = typename Lhs::word_type;
+            auto op = [](word_type a, word_type b) { return static_cast<word_type>(a ^ b); };
+            if (details::combine_into(lhs, rhs, op, details::simd::xor_into<word_type>)) return;
+        }
+        for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) ^ rhs.word(i));
+    }
 }
 
-/// In-place `AND` of one bit-store with an equal-sized bit-store.
+/// In-place `AND` of one bit-store with an equal-sized bit-store or lazy bit-expression.
 ///
 /// # Panics
 /// In debug mode, this method panics if the lengths of the two bit-stores do not match.
@@ -1942,15 +2867,29 @@ operator^=(Lhs& lhs, Rhs const& rhs) {
 /// v1 &= ~v1;
 /// assert_eq(to_string(v1), "0000000000");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
+template<BitStore Lhs, BitExpression Rhs>
     requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
 constexpr void
 operator&=(Lhs& lhs, Rhs const& rhs) {
     gf2_assert(lhs.size() == rhs.size(), "Lengths do not match: {} != {}.", lhs.size(), rhs.size());
-    for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) & rhs.word(i));
+    if constexpr (details::LazyBitExpression<Rhs>) {
+        // Expressions that may read words of `lhs` we have already overwritten are evaluated first.
+        if (details::needs_temporary(lhs, rhs)) {
+            lhs &= BitVector<typename Lhs::word_type>(rhs);
+            return;
+        }
+        for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) & rhs.word(i));
+    } else {
+        if !consteval {
+            using word_type = typename Lhs::word_type;
+            auto op = [](word_type a, word_type b) { return static_cast<word_type>(a & b); };
+            if (details::combine_into(lhs, rhs, op, details::simd::and_into<word_type>)) return;
+        }
+        for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) & rhs.word(i));
+    }
 }
 
-/// In-place `OR` of one bit-store with an equal-sized bit-store.
+/// In-place `OR` of one bit-store with an equal-sized bit-store or lazy bit-expression.
 ///
 /// # Panics
 /// In debug mode, this method panics if the lengths of the two bit-stores do not match.
@@ -1961,96 +2900,122 @@ operator&=(Lhs& lhs, Rhs const& rhs) {
 /// v1 |= ~v1;
 /// assert_eq(to_string(v1), "1111111111");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
+template<BitStore Lhs, BitExpression Rhs>
     requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
 constexpr void
 operator|=(Lhs& lhs, Rhs const& rhs) {
     gf2_assert(lhs.size() == rhs.size(), "Lengths do not match: {} != {}.", lhs.size(), rhs.size());
-    for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) | rhs.word(i));
+    if constexpr (details::LazyBitExpression<Rhs>) {
+        // Expressions that may read words of `lhs` we have already overwritten are evaluated first.
+        if (details::needs_temporary(lhs, rhs)) {
+            lhs |= BitVector<typename Lhs::word_type>(rhs);
+            return;
+        }
+        for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) | rhs.word(i));
+    } else {
+        if !consteval {
+            using word_type = typename Lhs::word_type;
+            auto op = [](word_type a, word_type b) { return static_cast<word_type>(a | b); };
+            if (details::combine_into(lhs, rhs, op, details::simd::or_into<word_type>)) return;
+        }
+        for (auto i = 0uz; i < lhs.words(); ++i) lhs.set_word(i, lhs.word(i) | rhs.word(i));
+    }
 }
 
 /// @}
 /// @name Out-of-place Bitwise Operations:
 /// @{
 
-/// Returns a new bit-vector that has the same bits as a bit-store but with all the bits flipped.
+/// Returns a lazy bit-expression that has the bits of a bit-expression all flipped.
+///
+/// The result is a `gf2::BitNotExpr` that is evaluated a word at a time when it is assigned to a bit-vector, copied
+/// into a bit-store, or reduced.
 ///
 /// # Example
 /// ```
 /// auto v = BitVector<u8>::alternating(10);
 /// assert_eq(to_string(v), "1010101010");
-/// auto w = ~v;
+/// BitVector w = ~v;
 /// assert_eq(to_string(w), "0101010101");
+/// assert_eq(count_ones(~v), 5);
 /// ```
-template<BitStore Store>
+template<typename Expr>
+    requires BitExpression<std::remove_cvref_t<Expr>>
 constexpr auto
-operator~(Store const& store) {
-    auto result = BitVector<typename Store::word_type>::from(store);
-    result.flip_all();
-    return result;
+operator~(Expr&& expr) {
+    return BitNotExpr<details::expr_operand<Expr>>{std::forward<Expr>(expr)};
 }
 
-/// Returns the `XOR` of two equal-sized bit-stores as a new bit-vector.
+/// Returns a lazy bit-expression for the `XOR` of two equal-sized bit-expressions.
+///
+/// The result is a `gf2::BitBinaryExpr` that is evaluated a word at a time when it is assigned to a bit-vector, copied
+/// into a bit-store, or reduced. So an expression like `a ^ (b & c) ^ ~d` is computed in a single pass over the words
+/// without any temporary bit-vectors.
 ///
 /// # Panics
-/// In debug mode, this method panics if the lengths of the two bit-stores do not match.
+/// This method panics if the lengths of the two bit-expressions do not match.
 ///
 /// # Example
 /// ```
 /// auto v1 = BitVector<u8>::alternating(10);
-/// auto v2 = ~v1;
-/// auto v3 = v1 ^ v2;
+/// BitVector v2 = ~v1;
+/// BitVector v3 = v1 ^ v2;
 /// assert_eq(to_string(v3), "1111111111");
+/// BitVector v4 = v1 ^ (v2 & v3) ^ ~v3;
+/// assert_eq(to_string(v4), "1111111111");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
-    requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
+template<typename Lhs, typename Rhs>
+    requires details::BitExpressionPair<Lhs, Rhs>
 constexpr auto
-operator^(Lhs const& lhs, Rhs const& rhs) {
-    auto result = BitVector<typename Lhs::word_type>::from(lhs);
-    result ^= rhs;
-    return result;
+operator^(Lhs&& lhs, Rhs&& rhs) {
+    using expr_type = BitBinaryExpr<details::XorWords, details::expr_operand<Lhs>, details::expr_operand<Rhs>>;
+    return expr_type{std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
 }
 
-/// Returns the `AND` of two equal-sized bit-stores as a new bit-vector.
+/// Returns a lazy bit-expression for the `AND` of two equal-sized bit-expressions.
+///
+/// The result is a `gf2::BitBinaryExpr` that is evaluated a word at a time when it is assigned to a bit-vector, copied
+/// into a bit-store, or reduced.
 ///
 /// # Panics
-/// In debug mode, this method panics if the lengths of the two bit-stores do not match.
+/// This method panics if the lengths of the two bit-expressions do not match.
 ///
 /// # Example
 /// ```
 /// auto v1 = BitVector<u8>::alternating(10);
-/// auto v2 = ~v1;
-/// auto v3 = v1 & v2;
+/// BitVector v2 = ~v1;
+/// BitVector v3 = v1 & v2;
 /// assert_eq(to_string(v3), "0000000000");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
-    requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
+template<typename Lhs, typename Rhs>
+    requires details::BitExpressionPair<Lhs, Rhs>
 constexpr auto
-operator&(Lhs const& lhs, Rhs const& rhs) {
-    auto result = BitVector<typename Lhs::word_type>::from(lhs);
-    result &= rhs;
-    return result;
+operator&(Lhs&& lhs, Rhs&& rhs) {
+    using expr_type = BitBinaryExpr<details::AndWords, details::expr_operand<Lhs>, details::expr_operand<Rhs>>;
+    return expr_type{std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
 }
 
-/// Returns the `OR` of two equal-sized bit-stores as a new bit-vector.
+/// Returns a lazy bit-expression for the `OR` of two equal-sized bit-expressions.
+///
+/// The result is a `gf2::BitBinaryExpr` that is evaluated a word at a time when it is assigned to a bit-vector, copied
+/// into a bit-store, or reduced.
 ///
 /// # Panics
-/// In debug mode, this method panics if the lengths of the two bit-stores do not match.
+/// This method panics if the lengths of the two bit-expressions do not match.
 ///
 /// # Example
 /// ```
 /// auto v1 = BitVector<u8>::alternating(10);
-/// auto v2 = ~v1;
-/// auto v3 = v1 | v2;
+/// BitVector v2 = ~v1;
+/// BitVector v3 = v1 | v2;
 /// assert_eq(to_string(v3), "1111111111");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
-    requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
+template<typename Lhs, typename Rhs>
+    requires details::BitExpressionPair<Lhs, Rhs>
 constexpr auto
-operator|(Lhs const& lhs, Rhs const& rhs) {
-    auto result = BitVector<typename Lhs::word_type>::from(lhs);
-    result |= rhs;
-    return result;
+operator|(Lhs&& lhs, Rhs&& rhs) {
+    using expr_type = BitBinaryExpr<details::OrWords, details::expr_operand<Lhs>, details::expr_operand<Rhs>>;
+    return expr_type{std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
 }
 
 /// @}
@@ -2070,7 +3035,7 @@ operator|(Lhs const& lhs, Rhs const& rhs) {
 /// v1 += ~v1;
 /// assert_eq(to_string(v1), "1111111111");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
+template<BitStore Lhs, BitExpression Rhs>
     requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
 constexpr void
 operator+=(Lhs& lhs, Rhs const& rhs) {
@@ -2090,7 +3055,7 @@ operator+=(Lhs& lhs, Rhs const& rhs) {
 /// v1 -= ~v1;
 /// assert_eq(to_string(v1), "1111111111");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
+template<BitStore Lhs, BitExpression Rhs>
     requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
 constexpr void
 operator-=(Lhs& lhs, Rhs const& rhs) {
@@ -2101,50 +3066,46 @@ operator-=(Lhs& lhs, Rhs const& rhs) {
 /// @name Out-of-place Arithmetic Operations:
 /// @{
 
-/// Adds two equal-sized bit-stores and returns the result as a new bit-vector.
+/// Returns a lazy bit-expression for the sum of two equal-sized bit-expressions.
 ///
-/// In GF(2) addition is the same as `XOR`.
+/// In GF(2) addition is the same as `XOR` so this is the same as `lhs ^ rhs`.
 ///
 /// # Panics
-/// In debug mode, this method panics if the lengths of the two bit-stores do not match.
+/// This method panics if the lengths of the two bit-expressions do not match.
 ///
 /// # Example
 /// ```
 /// auto v1 = BitVector<u8>::alternating(10);
-/// auto v2 = ~v1;
-/// auto v3 = v1 + v2;
+/// BitVector v2 = ~v1;
+/// BitVector v3 = v1 + v2;
 /// assert_eq(to_string(v3), "1111111111");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
-    requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
+template<typename Lhs, typename Rhs>
+    requires details::BitExpressionPair<Lhs, Rhs>
 constexpr auto
-operator+(Lhs const& lhs, Rhs const& rhs) {
-    auto result = BitVector<typename Lhs::word_type>::from(lhs);
-    result += rhs;
-    return result;
+operator+(Lhs&& lhs, Rhs&& rhs) {
+    return std::forward<Lhs>(lhs) ^ std::forward<Rhs>(rhs);
 }
 
-/// Subtracts two equal-sized bit-stores and returns the result as a new bit-vector.
+/// Returns a lazy bit-expression for the difference of two equal-sized bit-expressions.
 ///
-/// In GF(2) addition is the same as `XOR`.
+/// In GF(2) subtraction is the same as `XOR` so this is the same as `lhs ^ rhs`.
 ///
 /// # Panics
-/// In debug mode, this method panics if the lengths of the two bit-stores do not match.
+/// This method panics if the lengths of the two bit-expressions do not match.
 ///
 /// # Example
 /// ```
 /// auto v1 = BitVector<u8>::alternating(10);
-/// auto v2 = ~v1;
-/// auto v3 = v1 - v2;
+/// BitVector v2 = ~v1;
+/// BitVector v3 = v1 - v2;
 /// assert_eq(to_string(v3), "1111111111");
 /// ```
-template<BitStore Lhs, BitStore Rhs>
-    requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
+template<typename Lhs, typename Rhs>
+    requires details::BitExpressionPair<Lhs, Rhs>
 constexpr auto
-operator-(Lhs const& lhs, Rhs const& rhs) {
-    auto result = BitVector<typename Lhs::word_type>::from(lhs);
-    result -= rhs;
-    return result;
+operator-(Lhs&& lhs, Rhs&& rhs) {
+    return std::forward<Lhs>(lhs) ^ std::forward<Rhs>(rhs);
 }
 
 /// @}
@@ -2167,12 +3128,24 @@ operator-(Lhs const& lhs, Rhs const& rhs) {
 /// assert_eq(dot(v1, v1), true);
 /// assert_eq(dot(v1, v2), false);
 /// ```
-template<BitStore Lhs, BitStore Rhs>
+template<BitExpression Lhs, BitExpression Rhs>
     requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
 constexpr bool
 dot(Lhs const& lhs, Rhs const& rhs) {
     gf2_debug_assert_eq(lhs.size(), rhs.size(), "Length mismatch {} != {}", lhs.size(), rhs.size());
     using word_type = typename Lhs::word_type;
+    if constexpr (BitStore<Lhs> && BitStore<Rhs>) {
+        if !consteval {
+            auto [n, first, last] = details::real_words(lhs);
+            if (n > 1 && lhs.offset() == rhs.offset()) {
+                // The bits line up in the real words so we can work on those directly.
+                auto a = lhs.store();
+                auto b = rhs.store();
+                auto edges = static_cast<word_type>((a[0] & b[0] & first) ^ (a[n - 1] & b[n - 1] & last));
+                return details::simd::and_parity(a + 1, b + 1, n - 2) != (count_ones(edges) % 2 == 1);
+            }
+        }
+    }
     auto sum = word_type{0};
     for (auto i = 0uz; i < lhs.words(); ++i) { sum ^= static_cast<word_type>(lhs.word(i) & rhs.word(i)); }
     return count_ones(sum) % 2 == 1;
@@ -2194,7 +3167,7 @@ dot(Lhs const& lhs, Rhs const& rhs) {
 /// assert_eq(v1*v1, true);
 /// assert_eq(v1*v2, false);
 /// ```
-template<BitStore Lhs, BitStore Rhs>
+template<BitExpression Lhs, BitExpression Rhs>
     requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
 constexpr bool
 operator*(Lhs const& lhs, Rhs const& rhs) {
@@ -2205,11 +3178,196 @@ operator*(Lhs const& lhs, Rhs const& rhs) {
 /// Convolutions:
 /// @{
 
+/// Word counts at or above this size are multiplied using Karatsuba's method in `gf2::convolve`.
+///
+/// Below this size the schoolbook method of multiplying every pair of words with `gf2::clmul` is faster.
+inline constexpr usize KARATSUBA_THRESHOLD = 16;
+
+namespace details {
+
+// Adds (XOR's) the carry-less product of the words `a[0, na)` and `b[0, nb)` into `r[0, na + nb)` -- schoolbook style.
+template<Unsigned Word>
+constexpr void
+clmul_schoolbook(Word const* a, usize na, Word const* b, usize nb, Word* r) {
+    for (auto i = 0uz; i < na; ++i) {
+        if (a[i] == 0) continue;
+        gf2_count_words(nb, 4 * nb * sizeof(Word));
+        for (auto j = 0uz; j < nb; ++j) {
+            auto [lo, hi] = clmul(a[i], b[j]);
+            r[i + j] ^= lo;
+            r[i + j + 1] ^= hi;
+        }
+    }
+}
+
+// Returns the number of workspace words that `clmul_karatsuba` needs for a product of two `n` word operands.
+// Each level needs room for two sums & three products of its halves, and the recursive calls run one after another
+// so they can all share the space beyond that.
+constexpr usize
+karatsuba_workspace(usize n) {
+    usize result = 0;
+    for (; n >= KARATSUBA_THRESHOLD; n -= n / 2) result += 2 * n + 4 * (n - n / 2);
+    return result;
+}
+
+// Adds (XOR's) the carry-less product of the words `a[0, n)` and `b[0, n)` into `r[0, 2n)` using Karatsuba.
+// The `work` array must have room for `karatsuba_workspace(n)` words.
+//
+// With `a = a0 + x^h a1` and `b = b0 + x^h b1` we have `a * b = P0 + x^h (P0 + P1 + P2) + x^{2h} P2` where
+// `P0 = a0 * b0`, `P2 = a1 * b1`, and `P1 = (a0 + a1) * (b0 + b1)`, so three half size products instead of four.
+template<Unsigned Word>
+constexpr void
+clmul_karatsuba(Word const* a, Word const* b, usize n, Word* r, Word* work) {
+    if (n < KARATSUBA_THRESHOLD) {
+        clmul_schoolbook(a, n, b, n, r);
+        return;
+    }
+
+    // The low halves have `h` words, the high halves have `m >= h` words.
+    auto h = n / 2;
+    auto m = n - h;
+
+    // Our part of the workspace holds the two sums and the three products & the rest is for the recursive calls.
+    auto sa = work;
+    auto sb = sa + m;
+    auto p0 = sb + m;
+    auto p1 = p0 + 2 * h;
+    auto p2 = p1 + 2 * m;
+    auto rest = p2 + 2 * m;
+    std::fill(p0, rest, Word{0});
+    for (auto i = 0uz; i < m; ++i) {
+        sa[i] = a[h + i] ^ (i < h ? a[i] : Word{0});
+        sb[i] = b[h + i] ^ (i < h ? b[i] : Word{0});
+    }
+    clmul_karatsuba(a, b, h, p0, rest);
+    clmul_karatsuba(sa, sb, m, p1, rest);
+    clmul_karatsuba(a + h, b + h, m, p2, rest);
+
+    // Reassemble the pieces.
+    for (auto i = 0uz; i < 2 * h; ++i) {
+        r[i] ^= p0[i];
+        r[h + i] ^= p0[i];
+    }
+    for (auto i = 0uz; i < 2 * m; ++i) {
+        r[h + i] ^= p1[i] ^ p2[i];
+        r[2 * h + i] ^= p2[i];
+    }
+}
+
+// Adds (XOR's) the carry-less product of the words `a[0, na)` and `b[0, nb)` into `r[0, na + nb)`.
+// Unbalanced products are split into a sequence of balanced ones. The `work` array must have room for
+// `karatsuba_workspace(min(na, nb))` words.
+template<Unsigned Word>
+constexpr void
+clmul_words(Word const* a, usize na, Word const* b, usize nb, Word* r, Word* work) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < KARATSUBA_THRESHOLD) {
+        clmul_schoolbook(a, na, b, nb, r);
+        return;
+    }
+    for (auto off = 0uz; off < na; off += nb) {
+        auto len = std::min(nb, na - off);
+        if (len == nb) {
+            clmul_karatsuba(a + off, b, nb, r + off, work);
+        } else {
+            clmul_words(b, nb, a + off, len, r + off, work);
+        }
+    }
+}
+
+// Returns this thread's scratch buffer for the words of `gf2::convolve`, grown to at least `n` words.
+//
+// The buffer only ever grows, so convolutions in a loop stop allocating once they have seen their biggest size. It
+// comes from the global heap rather than the current `gf2::memory_resource()` as it outlives any `MemoryScope`.
+template<Unsigned Word>
+inline std::vector<Word>&
+convolve_scratch(usize n) {
+    static thread_local std::vector<Word> scratch;
+    if (scratch.size() < n) scratch.resize(n);
+    return scratch;
+}
+
+} // namespace details
+
+/// Computes the convolution of two bit-stores into the bit-vector `dst`, resizing it as needed.
+///
+/// This is the allocation-free form of `convolve(lhs, rhs)`: the result goes into the words `dst` already has, and
+/// the workspace comes from a per-thread buffer that is kept between calls. A loop that convolves into the same
+/// destination stops allocating once the buffers have grown to the biggest size needed.
+///
+/// The destination may be one of the inputs, so `convolve(p, q, p)` works in-place.
+///
+/// # Example
+/// ```
+/// auto lhs = BitVector<u8>::random(1000);
+/// auto rhs = BitVector<u8>::random(700);
+/// BitVector<u8> dst;
+/// convolve(lhs, rhs, dst);
+/// assert_eq(dst, convolve(lhs, rhs));
+/// auto words = dst.store();
+/// convolve(rhs, lhs, dst);
+/// assert(dst.store() == words);
+/// convolve(lhs, rhs, lhs);
+/// assert_eq(lhs, dst);
+/// convolve(BitVector<u8>{}, rhs, dst);
+/// assert(dst.is_empty());
+/// ```
+template<BitStore Lhs, BitStore Rhs>
+    requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
+void
+convolve(Lhs const& lhs, Rhs const& rhs, BitVector<typename Lhs::word_type>& dst) {
+    using word_type = typename Lhs::word_type;
+    gf2_probe("gf2::convolve");
+
+    // Edge case: if either store is empty then the convolution is empty.
+    if (lhs.is_empty() || rhs.is_empty()) {
+        dst.resize(0);
+        return;
+    }
+    auto n = lhs.size() + rhs.size() - 1;
+
+    // If either vector is all zeros then the convolution is all zeros.
+    auto lhs_last = lhs.last_set();
+    auto rhs_last = rhs.last_set();
+    if (!lhs_last || !rhs_last) {
+        dst.resize(n);
+        dst.set_all(false);
+        return;
+    }
+
+    // Only need to consider words up to and including the ones holding the final set bits. They are copied to the
+    // scratch buffer first, which lines up their bits and lets `dst` be one of the inputs.
+    auto  na = word_index<word_type>(*lhs_last) + 1;
+    auto  nb = word_index<word_type>(*rhs_last) + 1;
+    auto  n_work = details::karatsuba_workspace(std::min(na, nb));
+    auto& scratch = details::convolve_scratch<word_type>(2 * (na + nb) + n_work);
+    auto  a = scratch.data();
+    auto  b = a + na;
+    auto  r = b + nb;
+    for (auto i = 0uz; i < na; ++i) a[i] = lhs.word(i);
+    for (auto i = 0uz; i < nb; ++i) b[i] = rhs.word(i);
+
+    // Multiply the words & copy the live ones into the result.
+    std::fill(r, r + na + nb, word_type{0});
+    details::clmul_words(a, na, b, nb, r, r + na + nb);
+    dst.resize(n);
+    auto n_live = std::min(na + nb, dst.words());
+    for (auto i = 0uz; i < n_live; ++i) dst.set_word(i, r[i]);
+    for (auto i = n_live; i < dst.words(); ++i) dst.set_word(i, word_type{0});
+}
+
 /// Returns the convolution of two bit-stores as a new bit-vector.
 ///
 /// The *convolution* of $u$ and $v$ is a vector with the elements $ (u * v)_k = \sum_j u_j v_{k-j+1} $
 /// where the sum is taken over all $j$ such that the indices in the formula are valid.
 ///
+/// Seen as polynomials over GF(2), the convolution is the product of $u$ and $v$. We compute it a word at a time
+/// using `gf2::clmul` and, once both stores are at least `gf2::KARATSUBA_THRESHOLD` words long, with Karatsuba's
+/// recursive method which needs three half size products instead of four.
+///
 /// # Example
 /// ```
 /// auto lhs = BitVector<>::ones(3);
@@ -2217,46 +3375,85 @@ operator*(Lhs const& lhs, Rhs const& rhs) {
 /// auto result = convolve(lhs, rhs);
 /// assert_eq(to_string(result), "1001");
 /// ```
+///
+/// # Example (checks the Karatsuba path against a bit-by-bit convolution)
+/// ```
+/// auto lhs = BitVector<u8>::random(1000);
+/// auto rhs = BitVector<u8>::random(700);
+/// auto result = convolve(lhs, rhs);
+/// auto expected = BitVector<u8>::zeros(lhs.size() + rhs.size() - 1);
+/// for (auto i : lhs.set_bits())
+///     for (auto j : rhs.set_bits()) expected.flip(i + j);
+/// assert_eq(result, expected);
+/// ```
 template<BitStore Lhs, BitStore Rhs>
     requires std::same_as<typename Lhs::word_type, typename Rhs::word_type>
 auto
 convolve(Lhs const& lhs, Rhs const& rhs) {
-    using word_type = typename Lhs::word_type;
-    auto bits_per_word = BITS<word_type>;
+    BitVector<typename Lhs::word_type> result;
+    convolve(lhs, rhs, result);
+    return result;
+}
 
-    // Edge case: if either store is empty then the convolution is empty.
-    if (lhs.is_empty() || rhs.is_empty()) return BitVector<word_type>{};
+/// @}
 
-    // Set up the result bit-vector.
-    auto result = BitVector<word_type>::zeros(lhs.size() + rhs.size() - 1);
+// --------------------------------------------------------------------------------------------------------------------
+// The methods of the lazy bit-expressions are defined here after the free functions they forward to.
+// --------------------------------------------------------------------------------------------------------------------
 
-    // If either vector is all zeros then the convolution is all zeros.
-    if (lhs.none() || rhs.none()) return result;
-
-    // Only need to consider words in `rhs` up to and including the one holding its final set bit.
-    // We have already checked that `rhs` is not all zeros so we know there is a last set bit!
-    auto rhs_words_end = word_index<word_type>(rhs.last_set().value()) + 1;
-
-    // Initialize `result` by copying the live words from `rhs`
-    for (auto i = 0uz; i < rhs_words_end; ++i) result.set_word(i, rhs.word(i));
-
-    // Work backwards from the last set bit in `lhs` (which we know exists as we checked `lhs` is not all zeros).
-    for (auto i = lhs.last_set().value(); i-- > 0;) {
-        word_type prev = 0;
-        for (auto j = 0uz; j < result.words(); ++j) {
-            auto left = static_cast<word_type>(prev >> (bits_per_word - 1));
-            prev = result.word(j);
-            result.set_word(j, static_cast<word_type>(prev << 1) | left);
-        }
+template<typename Expr, Unsigned Word>
+constexpr BitVector<Word>
+BitExpressionMethods<Expr, Word>::evaluate() const {
+    return BitVector<Word>{derived()};
+}
 
-        if (lhs.get(i)) {
-            for (auto j = 0uz; j < rhs_words_end; ++j) result.set_word(j, result.word(j) ^ rhs.word(j));
-        }
-    }
-    return result;
+template<typename Expr, Unsigned Word>
+constexpr usize
+BitExpressionMethods<Expr, Word>::count_ones() const {
+    return gf2::count_ones(derived());
 }
 
-/// @}
+template<typename Expr, Unsigned Word>
+constexpr usize
+BitExpressionMethods<Expr, Word>::count_zeros() const {
+    return gf2::count_zeros(derived());
+}
+
+template<typename Expr, Unsigned Word>
+constexpr bool
+BitExpressionMethods<Expr, Word>::any() const {
+    return gf2::any(derived());
+}
+
+template<typename Expr, Unsigned Word>
+constexpr bool
+BitExpressionMethods<Expr, Word>::all() const {
+    return gf2::all(derived());
+}
+
+template<typename Expr, Unsigned Word>
+constexpr bool
+BitExpressionMethods<Expr, Word>::none() const {
+    return gf2::none(derived());
+}
+
+template<typename Expr, Unsigned Word>
+std::string
+BitExpressionMethods<Expr, Word>::to_string(std::string_view sep, std::string_view pre, std::string_view post) const {
+    return gf2::to_string(evaluate(), sep, pre, post);
+}
+
+template<typename Expr, Unsigned Word>
+std::string
+BitExpressionMethods<Expr, Word>::to_pretty_string() const {
+    return gf2::to_pretty_string(evaluate());
+}
+
+template<typename Expr, Unsigned Word>
+std::string
+BitExpressionMethods<Expr, Word>::to_hex_string() const {
+    return gf2::to_hex_string(evaluate());
+}
 
 } // namespace gf2
 
@@ -2284,11 +3481,11 @@ struct std::formatter<Store> {
         if (m_error) return std::format_to(ctx.out(), "'UNRECOGNIZED FORMAT SPECIFIER FOR BIT-STORE'");
 
         // Special handling requested?
-        if (m_hex) return std::format_to(ctx.out(), "{}", to_hex_string(rhs));
-        if (m_pretty) return std::format_to(ctx.out(), "{}", to_pretty_string(rhs));
+        if (m_hex) return gf2::format_hex_to(ctx.out(), rhs);
+        if (m_pretty) return gf2::format_binary_to(ctx.out(), rhs, ",", "[", "]");
 
         // Default
-        return std::format_to(ctx.out(), "{}", to_string(rhs));
+        return gf2::format_binary_to(ctx.out(), rhs);
     }
 
     bool m_hex = false;
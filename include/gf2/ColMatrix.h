@@ -0,0 +1,399 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Bit-matrices stored column by column for algorithms that mostly work on columns. <br>
+/// See the [ColMatrix](docs/pages/ColMatrix.md) page for more details.
+
+#include <gf2/BitMatrix.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace gf2 {
+
+/// A bit-matrix over GF(2) that stores its elements column by column.
+///
+/// A `gf2::BitMatrix` is row-major so its rows are word-level `gf2::BitSpan` views but anything that works on a column
+/// like `col`, `swap_cols`, `append_col` or `remove_col` has to visit one bit in every row. A `gf2::ColMatrix` is the
+/// same matrix laid out the other way round: it holds the transpose as a `gf2::BitMatrix`, so column `j` of the matrix
+/// is row `j` of that store. Now the column operations are the cheap ones and it is the row operations that work a bit
+/// at a time.
+///
+/// Converting between the two layouts uses the tiled `BitMatrix::transposed` in both directions, so an algorithm with a
+/// column-heavy pass can convert once, do the pass a word at a time, and convert back.
+///
+/// The class owns its data so there is no separate row-major copy to keep in sync when it changes.
+///
+/// # Example
+/// ```
+/// auto m = BitMatrix<>::random(20, 30);
+/// ColMatrix<> c{m};
+/// assert_eq(c.rows(), 20);
+/// assert_eq(c.cols(), 30);
+/// assert_eq(c.col(7), m.col(7));
+/// assert_eq(c.row(3), m.row(3));
+/// c.swap_cols(0, 29);
+/// m.swap_cols(0, 29);
+/// assert_eq(c.to_matrix(), m);
+/// ```
+template<Unsigned Word = usize>
+class ColMatrix {
+private:
+    // Row `j` of this bit-matrix is column `j` of the matrix we represent.
+    BitMatrix<Word> m_cols;
+
+public:
+    /// The underlying unsigned word type used to store the bits.
+    using word_type = Word;
+
+    /// The type of a mutable view of a column.
+    using col_type = typename BitMatrix<Word>::row_type;
+
+    /// The type of a read-only view of a column.
+    using const_col_type = typename BitMatrix<Word>::const_row_type;
+
+    /// @name Constructors
+    /// @{
+
+    /// The default constructor creates an empty column-major bit-matrix with no rows or columns.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c;
+    /// assert_eq(c.is_empty(), true);
+    /// ```
+    constexpr ColMatrix() = default;
+
+    /// Constructs the `m x n` zero bit-matrix.
+    ///
+    /// As with `gf2::BitMatrix`, a zero in either dimension gives the empty bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<u8> c{3, 5};
+    /// assert_eq(c.rows(), 3);
+    /// assert_eq(c.cols(), 5);
+    /// assert_eq(c.to_matrix(), BitMatrix<u8>::zeros(3, 5));
+    /// ```
+    constexpr ColMatrix(usize m, usize n) : m_cols{n, m} {}
+
+    /// Constructs a column-major copy of a row-major bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u8>::random(19, 45);
+    /// ColMatrix<u8> c{m};
+    /// assert_eq(c.to_matrix(), m);
+    /// ```
+    explicit constexpr ColMatrix(BitMatrix<Word> const& m) : m_cols{m.transposed()} {}
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the number of rows in the bit-matrix.
+    constexpr usize rows() const { return m_cols.cols(); }
+
+    /// Returns the number of columns in the bit-matrix.
+    constexpr usize cols() const { return m_cols.rows(); }
+
+    /// Returns `true` if the bit-matrix has no elements.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{0, 3};
+    /// assert(c.is_empty());
+    /// ```
+    constexpr bool is_empty() const { return m_cols.is_empty(); }
+
+    /// Returns the number of set elements in the bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{BitMatrix<>::identity(5)};
+    /// assert_eq(c.count_ones(), 5);
+    /// ```
+    constexpr usize count_ones() const { return m_cols.count_ones(); }
+
+    /// Returns the row-major bit-matrix whose rows are the columns of this one, i.e., the transpose.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(6, 9);
+    /// ColMatrix<> c{m};
+    /// assert_eq(c.cols_as_rows(), m.transposed());
+    /// ```
+    constexpr BitMatrix<Word> const& cols_as_rows() const { return m_cols; }
+
+    /// @}
+    /// @name Element Access
+    /// @{
+
+    /// Returns `true` if the element at row `r` and column `c` is set.
+    ///
+    /// # Panics
+    /// In debug mode, panics if either index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{BitMatrix<>::identity(3)};
+    /// assert(c.get(1, 1));
+    /// assert(!c.get(0, 1));
+    /// ```
+    constexpr bool get(usize r, usize c) const { return m_cols.get(c, r); }
+
+    /// Sets the element at row `r` and column `c` to `val`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if either index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{2, 3};
+    /// c.set(1, 2);
+    /// assert_eq(c.to_matrix().to_compact_binary_string(), "000 001");
+    /// ```
+    constexpr void set(usize r, usize c, bool val = true) { m_cols.set(c, r, val); }
+
+    /// Flips the element at row `r` and column `c`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if either index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{2, 3};
+    /// c.flip(0, 1);
+    /// assert_eq(c.to_matrix().to_compact_binary_string(), "010 000");
+    /// ```
+    constexpr void flip(usize r, usize c) { m_cols.flip(c, r); }
+
+    /// Returns a read-only word-level view of column `c`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if the index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(70, 10);
+    /// ColMatrix<> const c{m};
+    /// assert_eq(c.col(4), m.col(4));
+    /// ```
+    constexpr const_col_type col(usize c) const { return m_cols.row(c); }
+
+    /// Returns a mutable word-level view of column `c`.
+    ///
+    /// # Panics
+    /// In debug mode, panics if the index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{3, 3};
+    /// c.col(1).set_all();
+    /// auto dst = c.col(2);
+    /// dst ^= c.col(1);
+    /// assert_eq(c.to_matrix().to_compact_binary_string(), "011 011 011");
+    /// ```
+    constexpr col_type col(usize c) { return m_cols.row(c); }
+
+    /// Returns a copy of row `r` as a new bit-vector.
+    ///
+    /// This gathers one bit from every column so it is the slow direction for this layout.
+    ///
+    /// # Panics
+    /// In debug mode, panics if the index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(10, 70);
+    /// ColMatrix<> c{m};
+    /// assert_eq(c.row(9), m.row(9));
+    /// ```
+    constexpr BitVector<Word> row(usize r) const { return m_cols.col(r); }
+
+    /// @}
+    /// @name Mutators
+    /// @{
+
+    /// Swaps columns `i` and `j` a word at a time.
+    ///
+    /// # Panics
+    /// In debug mode, panics if either index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{BitMatrix<>::identity(3)};
+    /// c.swap_cols(0, 1);
+    /// assert_eq(c.to_matrix().to_compact_binary_string(), "010 100 001");
+    /// ```
+    constexpr void swap_cols(usize i, usize j) { m_cols.swap_rows(i, j); }
+
+    /// Swaps rows `i` and `j`, one bit in each column.
+    ///
+    /// # Panics
+    /// In debug mode, panics if either index is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{BitMatrix<>::identity(3)};
+    /// c.swap_rows(1, 2);
+    /// assert_eq(c.to_matrix().to_compact_binary_string(), "100 001 010");
+    /// ```
+    constexpr void swap_rows(usize i, usize j) { m_cols.swap_cols(i, j); }
+
+    /// Appends a column onto the right of the bit-matrix and returns a reference to this for chaining.
+    ///
+    /// Appending to an empty bit-matrix is allowed and fixes its number of rows.
+    ///
+    /// # Panics
+    /// Unless the bit-matrix is empty, the column must have the same number of elements as the bit-matrix has rows.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c;
+    /// c.append_col(BitVector<>::ones(3));
+    /// c.append_col(BitVector<>::zeros(3));
+    /// assert_eq(c.to_matrix().to_compact_binary_string(), "10 10 10");
+    /// ```
+    template<BitStore Store>
+        requires std::same_as<typename Store::word_type, Word>
+    constexpr ColMatrix& append_col(Store const& col) {
+        if (is_empty() && col.size() > 0) {
+            m_cols.resize(1, col.size());
+            m_cols.row(0).copy(col);
+        } else {
+            m_cols.append_row(col);
+        }
+        return *this;
+    }
+
+    /// Removes the last column and returns it or `std::nullopt` if the bit-matrix is empty.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{BitMatrix<>::identity(3)};
+    /// auto col = c.remove_col();
+    /// assert_eq(col->to_string(), "001");
+    /// assert_eq(c.to_matrix().to_compact_binary_string(), "10 01 00");
+    /// ```
+    constexpr std::optional<BitVector<Word>> remove_col() { return m_cols.remove_row(); }
+
+    /// @}
+    /// @name Conversions
+    /// @{
+
+    /// Returns the same bit-matrix in the row-major `gf2::BitMatrix` layout.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u16>::random(33, 17);
+    /// assert_eq(ColMatrix<u16>{m}.to_matrix(), m);
+    /// ```
+    constexpr BitMatrix<Word> to_matrix() const { return m_cols.transposed(); }
+
+    /// Returns the transpose of this bit-matrix in the row-major layout, which involves no bit shuffling at all.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(8, 12);
+    /// assert_eq(ColMatrix<>{m}.transposed(), m.transposed());
+    /// ```
+    constexpr BitMatrix<Word> transposed() const { return m_cols; }
+
+    /// Returns a string with the rows of the bit-matrix in binary separated by spaces.
+    ///
+    /// # Example
+    /// ```
+    /// ColMatrix<> c{BitMatrix<>::identity(3)};
+    /// assert_eq(c.to_compact_binary_string(), "100 010 001");
+    /// ```
+    std::string to_compact_binary_string() const { return to_matrix().to_compact_binary_string(); }
+
+    /// @}
+
+    /// Equality operator which checks the dimensions and all the elements.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(5, 6);
+    /// assert(ColMatrix<>{m} == ColMatrix<>{m});
+    /// assert(ColMatrix<>{m} != ColMatrix<>{m.transposed()});
+    /// ```
+    friend constexpr bool operator==(ColMatrix const& lhs, ColMatrix const& rhs) = default;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Column-major matrix products ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// Column-major bit-matrix, bit-store multiplication, `C * v`, returning a new bit-vector.
+///
+/// The product is the sum of the columns of `C` picked out by the set bits of `v`, so it works a word at a time.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible.
+///
+/// # Example
+/// ```
+/// auto m = BitMatrix<u8>::random(50, 40);
+/// auto v = BitVector<u8>::random(40);
+/// ColMatrix<u8> c{m};
+/// assert_eq(dot(c, v), dot(m, v));
+/// assert_eq(c * v, dot(m, v));
+/// ```
+template<Unsigned Word, BitStore Rhs>
+    requires std::same_as<typename Rhs::word_type, Word>
+constexpr auto
+dot(ColMatrix<Word> const& lhs, Rhs const& rhs) {
+    gf2_assert_eq(lhs.cols(), rhs.size(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.size());
+    auto result = BitVector<Word>::zeros(lhs.rows());
+    for_each_set_bit(rhs, [&](usize j) { result ^= lhs.col(j); });
+    return result;
+}
+
+/// Operator form for column-major bit-matrix, bit-store multiplication, `C * v`, returning a new bit-vector.
+template<Unsigned Word, BitStore Rhs>
+    requires std::same_as<typename Rhs::word_type, Word>
+constexpr auto
+operator*(ColMatrix<Word> const& lhs, Rhs const& rhs) {
+    return dot(lhs, rhs);
+}
+
+/// Bit-store, column-major bit-matrix multiplication, `v * C`, returning a new bit-vector.
+///
+/// Element `j` of the product is the dot product of `v` with column `j` of `C`.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible.
+///
+/// # Example
+/// ```
+/// auto m = BitMatrix<>::random(50, 40);
+/// auto v = BitVector<>::random(50);
+/// ColMatrix<> c{m};
+/// assert_eq(dot(v, c), dot(v, m));
+/// assert_eq(v * c, dot(v, m));
+/// ```
+template<Unsigned Word, BitStore Lhs>
+    requires std::same_as<typename Lhs::word_type, Word>
+constexpr auto
+dot(Lhs const& lhs, ColMatrix<Word> const& rhs) {
+    gf2_assert_eq(lhs.size(), rhs.rows(), "Incompatible dimensions: {} != {}", lhs.size(), rhs.rows());
+    auto result = BitVector<Word>::zeros(rhs.cols());
+    for (auto j = 0uz; j < rhs.cols(); ++j)
+        if (dot(lhs, rhs.col(j))) result.set(j);
+    return result;
+}
+
+/// Operator form for bit-store, column-major bit-matrix multiplication, `v * C`, returning a new bit-vector.
+template<Unsigned Word, BitStore Lhs>
+    requires std::same_as<typename Lhs::word_type, Word>
+constexpr auto
+operator*(Lhs const& lhs, ColMatrix<Word> const& rhs) {
+    return dot(lhs, rhs);
+}
+
+} // namespace gf2
@@ -0,0 +1,512 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Table driven & carry-less folding cyclic redundancy checks for any generator polynomial of degree up to 64. <br>
+/// See the [CrcEngine](docs/pages/CrcEngine.md) page for more details.
+
+#include <gf2/BitPolynomial.h>
+#include <gf2/ThreadPool.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace gf2 {
+
+/// The parameters of a CRC beyond its generator polynomial, as in the usual catalogues of CRCs.
+///
+/// Only the low `w` bits of `init` and `xor_out` are used for a CRC of width `w`.
+struct CrcOptions {
+    /// The starting value of the register.
+    u64 init = 0;
+
+    /// The value that is added to the register to give the checksum.
+    u64 xor_out = 0;
+
+    /// Whether the bits of the input bytes are taken lowest first (the "reflected" CRCs).
+    bool reflect_in = false;
+
+    /// Whether the register is bit-reversed before `xor_out` is added.
+    bool reflect_out = false;
+};
+
+namespace details {
+
+// The 16 slicing tables of a CRC with generator x^w + p(x): table k holds the register left by each byte value
+// followed by k zero bytes, starting from a zero register.
+//
+// The register is kept in a full 64-bit word so that widths that are not a multiple of 8 need no special cases.
+// Normal CRCs keep it in the top w bits & it is then the register of the width 64 CRC with generator x^{64-w} P(x).
+// Reflected CRCs keep the bit-reversed register in the bottom w bits & reverse everything else to match.
+using crc_tables = std::array<std::array<u64, 256>, 16>;
+
+constexpr crc_tables
+make_crc_tables(u64 low, usize width, bool reflected) {
+    crc_tables result{};
+    auto       poly = low << (64 - width);
+    if (reflected) poly = reverse_bits(poly);
+    auto& t0 = result[0];
+    for (auto b = 0uz; b < 256; ++b) {
+        u64 r = reflected ? b : u64{b} << 56;
+        for (auto i = 0; i < 8; ++i) {
+            if (reflected) {
+                r = (r >> 1) ^ (poly & (0 - (r & 1)));
+            } else {
+                r = (r << 1) ^ (poly & (0 - (r >> 63)));
+            }
+        }
+        t0[b] = r;
+    }
+    for (auto k = 1uz; k < 16; ++k) {
+        for (auto b = 0uz; b < 256; ++b) {
+            auto r = result[k - 1][b];
+            result[k][b] = reflected ? (r >> 8) ^ t0[r & 255] : (r << 8) ^ t0[r >> 56];
+        }
+    }
+    return result;
+}
+
+} // namespace details
+
+/// A `CrcEngine` computes the cyclic redundancy check of byte buffers for a generator polynomial `P(x)` of any degree
+/// `w` from 1 to 64, with the `init`, `xor_out` & reflection parameters of the usual catalogues of CRCs.
+///
+/// Mathematically, the unreflected CRC of a message `M(x)` is `M(x) x^w mod P(x)` (adjusted by `init` & `xor_out`).
+/// General purpose reduction by a `BitPolynomial` would allocate, so the engine instead precomputes from `P(x)`:
+///
+/// - Sixteen 256-entry tables that take the register past 16 bytes of input at a time ("slicing-by-16"). The tables
+///   are built by a `constexpr` function.
+/// - On targets with a carry-less multiply instruction, the constants `x^k mod P(x)` that fold four independent
+///   128-bit lanes of the input forward by 64 bytes with two carry-less products each. Only the last 16 bytes of
+///   the folded lanes go through the tables, so big buffers run at close to memory speed.
+///
+/// The tables are shared by copies of an engine. Feeding bytes with `update` changes just the running register of the
+/// one engine, so copies of an engine are cheap & independent checksums in progress.
+///
+/// The CRC of a concatenation follows from the CRCs of its parts: appending `n` bytes multiplies the register by
+/// `x^{8n} mod P(x)`, which `BitPolynomial::reduce_x_to_the` finds in `O(w^2 log n)` time. `combine` uses that to join
+/// checksums computed separately & the executor version of `checksum` splits a buffer over threads.
+///
+/// # Example
+/// ```
+/// auto crc = CrcEngine<>::crc32();
+/// assert_eq(crc.width(), 32);
+/// assert_eq(crc.checksum("123456789"), 0xCBF4'3926);
+/// crc.update("12345").update("6789");
+/// assert_eq(crc.value(), 0xCBF4'3926);
+/// ```
+template<Unsigned Word = usize>
+class CrcEngine {
+public:
+    /// The underlying unsigned word type of the generator polynomial.
+    using word_type = Word;
+
+    /// The type of the generator polynomial.
+    using polynomial_type = BitPolynomial<Word>;
+
+    /// @name Constructors
+    /// @{
+
+    /// Constructs the CRC with generator polynomial `P(x)` of degree `w` & the given parameters.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if the degree of `P(x)` is 0 or more than 64.
+    ///
+    /// # Example
+    /// ```
+    /// // CRC-16/XMODEM: x^16 + x^12 + x^5 + 1.
+    /// auto x = [](usize n) { return BitPolynomial<>::x_to_the(n); };
+    /// CrcEngine crc{x(16) + x(12) + x(5) + x(0)};
+    /// assert_eq(crc.checksum("123456789"), 0x31C3);
+    /// // CRC-16/IBM-3740 has the same generator with a different starting register.
+    /// CrcEngine ccitt{x(16) + x(12) + x(5) + x(0), {.init = 0xFFFF}};
+    /// assert_eq(ccitt.checksum("123456789"), 0x29B1);
+    /// bool threw = false;
+    /// try { CrcEngine<>{x(0)}; } catch (std::invalid_argument const&) { threw = true; }
+    /// assert(threw);
+    /// ```
+    explicit CrcEngine(polynomial_type const& P, CrcOptions const& options = {}) : m_generator{P} {
+        m_width = m_generator.degree();
+        if (m_generator.is_zero() || m_width == 0 || m_width > 64)
+            throw std::invalid_argument("A CRC needs a generator polynomial of degree 1 to 64.");
+        m_generator.coefficients().resize(m_width + 1);
+        auto mask = m_width == 64 ? MAX<u64> : (u64{1} << m_width) - 1;
+        m_init = options.init & mask;
+        m_xor_out = options.xor_out & mask;
+        m_reflect_in = options.reflect_in;
+        m_reflect_out = options.reflect_out;
+
+        auto shared = std::make_shared<Shared>();
+        shared->slice = details::make_crc_tables(to_word(m_generator), m_width, m_reflect_in);
+
+        // The folding constants for x^{64j} with j = 2, ..., 9.
+        for (auto j = 0uz; j < shared->fold.size(); ++j) shared->fold[j] = x_to_the(64 * (j + 2), m_reflect_in);
+
+        m_shared = std::move(shared);
+        reset();
+    }
+
+    /// Returns the CRC of degree `width` whose generator polynomial has the low coefficients `poly`, the "normal"
+    /// hex form of the generator in the catalogues of CRCs, which leave out its leading `x^w` term.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `width` is 0 or more than 64.
+    ///
+    /// # Example
+    /// ```
+    /// auto crc8 = CrcEngine<>::from_normal(8, 0x07);
+    /// assert_eq(crc8.checksum("123456789"), 0xF4);
+    /// CrcOptions reflected{.init = 0x1F, .xor_out = 0x1F, .reflect_in = true, .reflect_out = true};
+    /// auto usb = CrcEngine<>::from_normal(5, 0x05, reflected);
+    /// assert_eq(usb.checksum("123456789"), 0x19);
+    /// auto umts = CrcEngine<>::from_normal(12, 0x80F, {.reflect_out = true});
+    /// assert_eq(umts.checksum("123456789"), 0xDAF);
+    /// auto ecma = CrcEngine<>::from_normal(64, 0x42F0'E1EB'A9EA'3693);
+    /// assert_eq(ecma.checksum("123456789"), 0x6C40'DF5F'0B49'7347);
+    /// assert_eq(ecma.generator().degree(), 64);
+    /// ```
+    static CrcEngine from_normal(usize width, u64 poly, CrcOptions const& options = {}) {
+        if (width == 0 || width > 64) throw std::invalid_argument("A CRC needs a width of 1 to 64 bits.");
+        auto P = polynomial_type::from(width, [&](usize i) { return i == width || (i < 64 && ((poly >> i) & 1)); });
+        return CrcEngine{P, options};
+    }
+
+    /// Returns the engine for CRC-32 (ISO-HDLC), the checksum of Ethernet, zip, gzip & PNG.
+    static CrcEngine crc32() {
+        return from_normal(32, 0x04C1'1DB7, {.init = 0xFFFF'FFFF, .xor_out = 0xFFFF'FFFF, .reflect_in = true,
+                                             .reflect_out = true});
+    }
+
+    /// Returns the engine for CRC-32C (Castagnoli), the checksum of iSCSI, SCTP, ext4 & many storage formats.
+    ///
+    /// # Example
+    /// ```
+    /// assert_eq(CrcEngine<>::crc32c().checksum("123456789"), 0xE306'9283);
+    /// ```
+    static CrcEngine crc32c() {
+        return from_normal(32, 0x1EDC'6F41, {.init = 0xFFFF'FFFF, .xor_out = 0xFFFF'FFFF, .reflect_in = true,
+                                             .reflect_out = true});
+    }
+
+    /// Returns the engine for CRC-64/XZ, the checksum of the xz format.
+    ///
+    /// # Example
+    /// ```
+    /// assert_eq(CrcEngine<>::crc64().checksum("123456789"), 0x995D'C9BB'DF19'39FA);
+    /// ```
+    static CrcEngine crc64() {
+        return from_normal(64, 0x42F0'E1EB'A9EA'3693, {.init = MAX<u64>, .xor_out = MAX<u64>, .reflect_in = true,
+                                                       .reflect_out = true});
+    }
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the width `w` of the CRC, the degree of its generator polynomial.
+    constexpr usize width() const { return m_width; }
+
+    /// Returns a read-only reference to the generator polynomial `P(x)`.
+    constexpr polynomial_type const& generator() const { return m_generator; }
+
+    /// Returns the parameters of the CRC other than its generator polynomial.
+    constexpr CrcOptions options() const { return {m_init, m_xor_out, m_reflect_in, m_reflect_out}; }
+
+    /// @}
+    /// @name Streaming
+    /// @{
+
+    /// Feeds a span of bytes to the running checksum & returns a reference to the engine so calls can be chained.
+    ///
+    /// # Example
+    /// ```
+    /// auto crc = CrcEngine<>::crc32c();
+    /// std::vector<std::byte> data(1000);
+    /// for (auto i = 0uz; i < data.size(); ++i) data[i] = std::byte(i * i + 7);
+    /// auto whole = crc.checksum(data);
+    /// for (auto cut : {0uz, 1uz, 15uz, 64uz, 333uz, 1000uz}) {
+    ///     crc.reset();
+    ///     crc.update(std::span{data}.first(cut)).update(std::span{data}.subspan(cut));
+    ///     assert_eq(crc.value(), whole);
+    /// }
+    /// ```
+    CrcEngine& update(std::span<std::byte const> bytes) {
+        m_state = process(m_state, bytes);
+        return *this;
+    }
+
+    /// Feeds the characters of a string to the running checksum & returns a reference to the engine.
+    CrcEngine& update(std::string_view chars) { return update(std::as_bytes(std::span{chars})); }
+
+    /// Returns the checksum of all the bytes fed to the engine since it was constructed or last reset.
+    constexpr u64 value() const { return finish(m_state); }
+
+    /// Restarts the running checksum, so that `value()` is then the checksum of the empty message.
+    constexpr void reset() { m_state = start(); }
+
+    /// @}
+    /// @name One-shot Checksums
+    /// @{
+
+    /// Returns the checksum of a span of bytes. This leaves the running checksum of `update` alone.
+    ///
+    /// # Example
+    /// ```
+    /// auto crc = CrcEngine<>::crc64();
+    /// assert_eq(crc.checksum(""), 0);
+    /// std::vector<std::byte> data(5000);
+    /// for (auto i = 0uz; i < data.size(); ++i) data[i] = std::byte(i * 31 + (i >> 5));
+    /// // Check the folding & the tables against bit-at-a-time polynomial arithmetic for all the kinds of CRC.
+    /// auto x = [](usize n) { return BitPolynomial<>::x_to_the(n); };
+    /// for (auto w : {3uz, 8uz, 13uz, 32uz, 57uz, 64uz}) {
+    ///     auto P = x(w) + x(w / 2) + x(1) + x(0);
+    ///     for (auto reflect : {false, true}) {
+    ///         CrcEngine engine{P, {.reflect_in = reflect, .reflect_out = reflect}};
+    ///         for (auto n : {1uz, 9uz, 100uz, 300uz, 5000uz}) {
+    ///             // Bit k of byte i is the coefficient of x^{8(n-i)-1-k} in M(x) (k counts from the top byte bit).
+    ///             auto M = BitPolynomial<>::from(8 * n - 1, [&](usize j) {
+    ///                 auto i = n - 1 - j / 8, k = 7 - j % 8;
+    ///                 return ((static_cast<unsigned>(data[i]) >> (reflect ? k : 7 - k)) & 1) != 0;
+    ///             });
+    ///             auto r = (M * x(w)) % P;
+    ///             u64 expected = 0;
+    ///             for (auto k = 0uz; k < r.size(); ++k)
+    ///                 if (r[k]) expected |= u64{1} << (reflect ? w - 1 - k : k);
+    ///             assert_eq(engine.checksum(std::span{data}.first(n)), expected);
+    ///         }
+    ///     }
+    /// }
+    /// ```
+    u64 checksum(std::span<std::byte const> bytes) const { return finish(process(start(), bytes)); }
+
+    /// Returns the checksum of the characters in a string.
+    u64 checksum(std::string_view chars) const { return checksum(std::as_bytes(std::span{chars})); }
+
+    /// Returns the checksum of a span of bytes, computing the checksums of blocks of it in parallel with an executor
+    /// and joining them as in `combine`.
+    ///
+    /// # Example
+    /// ```
+    /// auto crc = CrcEngine<>::crc32();
+    /// std::vector<std::byte> data(3'000'017);
+    /// for (auto i = 0uz; i < data.size(); ++i) data[i] = std::byte((i * 2654435761u) >> 13);
+    /// ThreadPool pool{4};
+    /// assert_eq(crc.checksum(pool, data), crc.checksum(data));
+    /// assert_eq(crc.checksum(par, std::span{data}.first(1000)), crc.checksum(std::span{data}.first(1000)));
+    /// ```
+    template<Executor Exec>
+    u64 checksum(Exec&& exec, std::span<std::byte const> bytes) const {
+        auto n = bytes.size();
+        auto n_threads = details::concurrency(exec);
+        if (n_threads <= 1 || n < 2 * PARALLEL_BLOCK) return checksum(bytes);
+
+        // Blocks of a fixed size are cheap to join: one carry-less product & a table pass each.
+        auto block = std::max(PARALLEL_BLOCK, (n / (4 * n_threads) + 63) / 64 * 64);
+        auto n_blocks = (n + block - 1) / block;
+        std::vector<u64> partial(n_blocks);
+        details::for_each_chunk(exec, n_blocks, 1, [&](usize begin, usize end) {
+            for (auto b = begin; b < end; ++b) {
+                auto part = bytes.subspan(b * block, std::min(block, n - b * block));
+                partial[b] = process(b == 0 ? start() : 0, part);
+            }
+        });
+
+        auto last = n - (n_blocks - 1) * block;
+        auto k_block = x_to_the(8 * block - 64, m_reflect_in);
+        auto k_last = last >= 16 ? x_to_the(8 * last - 64, m_reflect_in) : 0;
+        auto r = partial[0];
+        for (auto b = 1uz; b < n_blocks; ++b) {
+            auto len = b + 1 < n_blocks ? block : last;
+            r = (len >= 16 ? times_x_to_the(r, len == block ? k_block : k_last) : zeros(r, len)) ^ partial[b];
+        }
+        return finish(r);
+    }
+
+    /// Returns the checksum of the concatenation `A B` of two messages from the checksums of `A` & `B` and the number
+    /// of bytes in `B`.
+    ///
+    /// # Example
+    /// ```
+    /// auto crc = CrcEngine<>::crc32();
+    /// std::string_view a = "The quick brown fox ", b = "jumps over the lazy dog";
+    /// auto ab = std::string{a} + std::string{b};
+    /// assert_eq(crc.combine(crc.checksum(a), crc.checksum(b), b.size()), crc.checksum(ab));
+    /// assert_eq(crc.combine(crc.checksum(a), crc.checksum(""), 0), crc.checksum(a));
+    /// assert_eq(crc.combine(crc.checksum(a), crc.checksum("xyz"), 3), crc.checksum(std::string{a} + "xyz"));
+    /// auto odd = CrcEngine<>::from_normal(12, 0x80F, {.init = 0x123, .reflect_out = true});
+    /// assert_eq(odd.combine(odd.checksum(a), odd.checksum(b), b.size()), odd.checksum(ab));
+    /// ```
+    u64 combine(u64 crc_a, u64 crc_b, usize len_b) const {
+        // Going on from A's register r_A through B gives r_A x^{8n} + f(B), while B's register is init x^{8n} + f(B).
+        auto r = unfinish(crc_a) ^ start();
+        r = len_b >= 16 ? times_x_to_the(r, x_to_the(8 * len_b - 64, m_reflect_in)) : zeros(r, len_b);
+        return finish(r ^ unfinish(crc_b));
+    }
+
+    /// @}
+
+private:
+    // The tables & folding constants that copies of an engine share.
+    struct Shared {
+        details::crc_tables slice;
+        std::array<u64, 8>  fold;
+    };
+
+    // Buffers at least twice this size are split into blocks for the executor version of `checksum`.
+    static constexpr usize PARALLEL_BLOCK = 64 * 1024;
+
+    polynomial_type               m_generator;          // The generator P(x) = x^w + p(x).
+    usize                         m_width;              // The width w, which is the degree of P(x).
+    u64                           m_init = 0;           // The starting value of the register.
+    u64                           m_xor_out = 0;        // The value added to the register to give the checksum.
+    bool                          m_reflect_in = false; // Whether the input bits are taken lowest first.
+    bool                          m_reflect_out = false; // Whether the register is reversed to give the checksum.
+    std::shared_ptr<Shared const> m_shared;              // The tables & folding constants.
+    u64                           m_state = 0;           // The running register of `update`.
+
+    // Returns the low 64 coefficients of a polynomial packed into a word.
+    static u64 to_word(polynomial_type const& p) {
+        u64  result = 0;
+        auto n = std::min(p.coefficients().size(), 64uz);
+        for (auto i = 0uz; i < n; ++i)
+            if (p.coefficients().get(i)) result |= u64{1} << i;
+        return result;
+    }
+
+    // Returns the folding constant for x^k: x^k mod P(x) as a word, or for the reflected CRCs x^{k-1} mod P(x)
+    // bit-reversed. Carry-less products of bit-reversed words come out reversed in 127 bits, a bit short of the 128
+    // bits of a lane, and the missing factor of x makes up for that.
+    u64 x_to_the(usize k, bool reflected) const {
+        if (!reflected) return to_word(m_generator.reduce_x_to_the(k));
+        return reverse_bits(to_word(m_generator.reduce_x_to_the(k - 1)));
+    }
+
+    // Returns the bit-reverse of the low w bits of a word.
+    constexpr u64 reverse_width(u64 v) const { return reverse_bits(v) >> (64 - m_width); }
+
+    // Converts between a w-bit unreflected register value & our internal form of the register.
+    constexpr u64 to_register(u64 v) const { return m_reflect_in ? reverse_width(v) : v << (64 - m_width); }
+    constexpr u64 from_register(u64 r) const { return m_reflect_in ? reverse_width(r) : r >> (64 - m_width); }
+
+    // The register for the empty message, & the conversions between registers & checksums.
+    constexpr u64 start() const { return to_register(m_init); }
+    constexpr u64 finish(u64 r) const {
+        auto v = from_register(r);
+        return (m_reflect_out ? reverse_width(v) : v) ^ m_xor_out;
+    }
+    constexpr u64 unfinish(u64 crc) const {
+        auto v = crc ^ m_xor_out;
+        return to_register(m_reflect_out ? reverse_width(v) : v);
+    }
+
+    // Returns the register after feeding the bytes to the register r.
+    u64 process(u64 r, std::span<std::byte const> bytes) const {
+        return m_reflect_in ? process<true>(r, bytes.data(), bytes.size())
+                            : process<false>(r, bytes.data(), bytes.size());
+    }
+
+    // Returns the register after n zero bytes for the short runs where folding does not pay.
+    constexpr u64 zeros(u64 r, usize n) const {
+        auto const& t0 = m_shared->slice[0];
+        for (; n > 0; --n) r = m_reflect_in ? (r >> 8) ^ t0[r & 255] : (r << 8) ^ t0[r >> 56];
+        return r;
+    }
+
+    // Returns the register after 16 + (k - 64) / 8 zero bytes given the folding constant x^k mod P(x) for k >= 64.
+    // The register first moves into a lane of its own, the lane is folded forward & then run through the tables.
+    u64 times_x_to_the(u64 r, u64 k) const {
+        auto lane = m_reflect_in ? fold<true>({r, 0}, k, 0) : fold<false>({r, 0}, k, 0);
+        return m_reflect_in ? slice<true>(lane.first, lane.second) : slice<false>(lane.first, lane.second);
+    }
+
+    // 16 bytes of input as two words, `first` from the earlier bytes. Normal CRCs load the words big-endian so the
+    // earliest bit is the top one, reflected CRCs load them little-endian so it is the bottom one.
+    struct Lane {
+        u64 first;
+        u64 second;
+        constexpr Lane& operator^=(Lane const& rhs) {
+            first ^= rhs.first;
+            second ^= rhs.second;
+            return *this;
+        }
+    };
+
+    template<bool Reflected>
+    static u64 load(std::byte const* p) {
+        u64 v;
+        std::memcpy(&v, p, sizeof(v));
+        constexpr bool swap = (std::endian::native == std::endian::little) != Reflected;
+        if constexpr (swap) v = std::byteswap(v);
+        return v;
+    }
+
+    template<bool Reflected>
+    static Lane load_lane(std::byte const* p) {
+        return {load<Reflected>(p), load<Reflected>(p + 8)};
+    }
+
+    // Returns the register after the 16 bytes of a lane, where the (old) register is already added into `first`.
+    template<bool Reflected>
+    u64 slice(u64 a, u64 b) const {
+        auto const& t = m_shared->slice;
+        u64         r = 0;
+        for (auto i = 0uz; i < 8; ++i) {
+            auto s = Reflected ? 8 * i : 56 - 8 * i;
+            r ^= t[15 - i][(a >> s) & 255] ^ t[7 - i][(b >> s) & 255];
+        }
+        return r;
+    }
+
+    // Returns a lane that stands for the same remainder as the lane times x^k, given the folding constants k_hi for
+    // x^{k+64} & k_lo for x^k.
+    template<bool Reflected>
+    static Lane fold(Lane lane, u64 k_hi, u64 k_lo) {
+        auto [a_lo, a_hi] = clmul(lane.first, k_hi);
+        auto [b_lo, b_hi] = clmul(lane.second, k_lo);
+        if constexpr (Reflected) return {a_lo ^ b_lo, a_hi ^ b_hi};
+        return {a_hi ^ b_hi, a_lo ^ b_lo};
+    }
+
+    // The work horse: 64 bytes at a time in four folded lanes if the target has a carry-less multiply instruction,
+    // then 16 bytes at a time through the slicing tables & last a byte at a time.
+    template<bool Reflected>
+    u64 process(u64 r, std::byte const* p, usize n) const {
+        auto const& t0 = m_shared->slice[0];
+#if defined(__PCLMUL__) || defined(__ARM_FEATURE_AES)
+        if (n >= 256) {
+            auto const& k = m_shared->fold;
+            Lane        lanes[4];
+            for (auto j = 0; j < 4; ++j) lanes[j] = load_lane<Reflected>(p + 16 * j);
+            lanes[0].first ^= r;
+            for (p += 64, n -= 64; n >= 64; p += 64, n -= 64) {
+                for (auto j = 0; j < 4; ++j) {
+                    lanes[j] = fold<Reflected>(lanes[j], k[7], k[6]);
+                    lanes[j] ^= load_lane<Reflected>(p + 16 * j);
+                }
+            }
+            // The lanes stand for L_0 x^384 + L_1 x^256 + L_2 x^128 + L_3.
+            auto acc = lanes[3];
+            acc ^= fold<Reflected>(lanes[0], k[5], k[4]);
+            acc ^= fold<Reflected>(lanes[1], k[3], k[2]);
+            acc ^= fold<Reflected>(lanes[2], k[1], k[0]);
+            r = slice<Reflected>(acc.first, acc.second);
+        }
+#endif
+        for (; n >= 16; p += 16, n -= 16) r = slice<Reflected>(load<Reflected>(p) ^ r, load<Reflected>(p + 8));
+        for (; n > 0; ++p, --n) {
+            auto b = static_cast<u64>(*p);
+            r = Reflected ? (r >> 8) ^ t0[(r ^ b) & 255] : (r << 8) ^ t0[(r >> 56) ^ b];
+        }
+        return r;
+    }
+};
+
+} // namespace gf2
@@ -0,0 +1,652 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Bit-matrices whose words live in the memory of an offload device such as a GPU. <br>
+/// See the [DeviceMatrix](docs/pages/DeviceMatrix.md) page for more details.
+
+#include <gf2/BitLU.h>
+#include <gf2/BitMatrix.h>
+#include <gf2/BitVector.h>
+
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+
+// The device kernels are OpenMP target regions. Configure with `-DGF2_GPU=ON` (or compile with `-fopenmp` and the
+// offload flags for your device) to run them on a GPU. Without OpenMP they are plain loops that run on the host.
+#ifdef _OPENMP
+    #include <omp.h>
+    #define GF2_OMP_STRING(...) #__VA_ARGS__
+    #define GF2_OMP(...) _Pragma(GF2_OMP_STRING(omp __VA_ARGS__))
+#else
+    #define GF2_OMP(...)
+#endif
+
+namespace gf2 {
+
+namespace details {
+
+// Returns the device that a `DeviceMatrix` uses unless it is told otherwise.
+inline int
+default_device() {
+#ifdef _OPENMP
+    return omp_get_default_device();
+#else
+    return 0;
+#endif
+}
+
+// Allocates room for `n` words on a device.
+template<Unsigned Word>
+Word*
+device_alloc(usize n, int device) {
+    if (n == 0) return nullptr;
+#ifdef _OPENMP
+    auto result = static_cast<Word*>(omp_target_alloc(n * sizeof(Word), device));
+    gf2_assert(result != nullptr, "Failed to allocate {} words on device {}", n, device);
+    return result;
+#else
+    (void)device;
+    return new Word[n];
+#endif
+}
+
+// Frees the words allocated by `device_alloc`.
+template<Unsigned Word>
+void
+device_free(Word* ptr, int device) {
+    if (ptr == nullptr) return;
+#ifdef _OPENMP
+    omp_target_free(ptr, device);
+#else
+    (void)device;
+    delete[] ptr;
+#endif
+}
+
+} // namespace details
+
+/// A dense bit-matrix whose words are resident in the memory of an offload device such as a GPU.
+///
+/// The words are laid out exactly as in a `gf2::BitMatrix` with the same dimensions --- row `i` starts at word
+/// `i * stride()` and the padding bits are zero --- so an upload or download is a single copy of the whole buffer.
+///
+/// The kernels for products, powers, echelon forms and LU decompositions are OpenMP target regions, so one code path
+/// runs on NVIDIA, AMD or Intel GPUs with the matching compiler offload plugin. Without a device, or if the library
+/// is compiled without OpenMP, they run on the host.
+///
+/// Work on a device matrix is ordered: each transfer and kernel starts once everything queued on its buffers before it
+/// has finished. The `_async` transfers return without waiting and `sync()` waits for everything queued on the matrix.
+///
+/// # Note
+/// Device matrices pay for themselves once a matrix is large enough that the memory bandwidth of the host limits the
+/// work --- for products and eliminations of matrices with tens of thousands of rows. Keep the hot data on the device
+/// and transfer it as rarely as possible.
+template<Unsigned Word = usize>
+class DeviceMatrix {
+private:
+    // The words of the bit-matrix in device memory -- row `i` starts at word `i * m_stride`.
+    Word* m_data = nullptr;
+
+    // The dimensions of the bit-matrix & the number of words used to store each row (the same as for a `BitMatrix`).
+    usize m_rows = 0;
+    usize m_cols = 0;
+    usize m_stride = 0;
+
+    // The device that holds the words.
+    int m_device = details::default_device();
+
+public:
+    /// @name Constructors
+    /// @{
+
+    /// Constructs an empty device matrix on the default device.
+    DeviceMatrix() = default;
+
+    /// Constructs the `m x n` zero matrix on the given device (which defaults to the OpenMP default device).
+    ///
+    /// As with a `gf2::BitMatrix`, a zero in either dimension gives the empty matrix.
+    ///
+    /// # Example
+    /// ```
+    /// DeviceMatrix<u32> d{3, 70};
+    /// assert_eq(d.rows(), 3);
+    /// assert_eq(d.cols(), 70);
+    /// assert_eq(d.to_matrix(), BitMatrix<u32>::zeros(3, 70));
+    /// ```
+    DeviceMatrix(usize m, usize n, int device = details::default_device()) : m_device{device} {
+        allocate(m, n);
+        zero();
+    }
+
+    /// Constructs a device matrix on the default device and uploads a copy of the bit-matrix `src` to it.
+    ///
+    /// To put the copy on another device, construct a matrix there with the constructor above and then `upload`.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u8>::random(20, 30);
+    /// DeviceMatrix d{m};
+    /// assert_eq(d.to_matrix(), m);
+    /// ```
+    explicit DeviceMatrix(BitMatrix<Word> const& src) { upload(src); }
+
+    /// Copy constructor makes a device-to-device copy on the same device.
+    DeviceMatrix(DeviceMatrix const& other) : m_device{other.m_device} {
+        allocate(other.m_rows, other.m_cols);
+        copy_from(other);
+    }
+
+    /// Move constructor takes over the device buffer of `other` which is left empty.
+    DeviceMatrix(DeviceMatrix&& other) noexcept :
+        m_data{std::exchange(other.m_data, nullptr)},
+        m_rows{std::exchange(other.m_rows, 0)},
+        m_cols{std::exchange(other.m_cols, 0)},
+        m_stride{std::exchange(other.m_stride, 0)},
+        m_device{other.m_device} {}
+
+    /// Copy assignment makes a device-to-device copy.
+    DeviceMatrix& operator=(DeviceMatrix const& other) {
+        if (this != &other) {
+            if (m_device != other.m_device) {
+                release();
+                m_device = other.m_device;
+            }
+            allocate(other.m_rows, other.m_cols);
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    /// Move assignment takes over the device buffer of `other` which is left empty.
+    DeviceMatrix& operator=(DeviceMatrix&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_rows = std::exchange(other.m_rows, 0);
+            m_cols = std::exchange(other.m_cols, 0);
+            m_stride = std::exchange(other.m_stride, 0);
+            m_device = other.m_device;
+        }
+        return *this;
+    }
+
+    /// The destructor waits for any work queued on the matrix before freeing its device memory.
+    ~DeviceMatrix() { release(); }
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the number of rows in the device matrix.
+    usize rows() const { return m_rows; }
+
+    /// Returns the number of columns in the device matrix.
+    usize cols() const { return m_cols; }
+
+    /// Returns the number of words used to store each row (the same as the `stride()` of a matching `BitMatrix`).
+    usize stride() const { return m_stride; }
+
+    /// Is this an empty device matrix?
+    bool is_empty() const { return m_rows == 0; }
+
+    /// Returns the device that holds the matrix.
+    int device() const { return m_device; }
+
+    /// Returns the device pointer to the words of the matrix for use in your own OpenMP target regions.
+    ///
+    /// The pointer is only valid on `device()` and should be passed to a target region with `is_device_ptr`.
+    Word* data() { return m_data; }
+
+    /// Returns the device pointer to the words of the matrix for use in your own OpenMP target regions.
+    const Word* data() const { return m_data; }
+
+    /// @}
+    /// @name Transfers
+    /// @{
+
+    /// Copies the bit-matrix `src` to the device, resizing this matrix to match, and waits for the copy to finish.
+    ///
+    /// # Example
+    /// ```
+    /// DeviceMatrix<u16> d;
+    /// auto m = BitMatrix<u16>::random(40, 50);
+    /// d.upload(m);
+    /// assert_eq(d.rows(), 40);
+    /// assert_eq(d.to_matrix(), m);
+    /// ```
+    void upload(BitMatrix<Word> const& src) {
+        upload_async(src);
+        sync();
+    }
+
+    /// Queues a copy of the bit-matrix `src` to the device, resizing this matrix to match, and returns at once.
+    ///
+    /// Any later work on this matrix waits for the copy. `src` must not change or go away until after a `sync()`.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(100, 100);
+    /// DeviceMatrix d{100, 100};
+    /// d.upload_async(m);
+    /// auto p = d * d;
+    /// assert_eq(p.to_matrix(), m * m);
+    /// ```
+    void upload_async(BitMatrix<Word> const& src) {
+        allocate(src.rows(), src.cols());
+        auto n = m_rows * m_stride;
+        if (n == 0) return;
+        auto dst = m_data;
+        auto host = src.data();
+        GF2_OMP(target teams distribute parallel for nowait device(m_device) is_device_ptr(dst) map(to: host[0:n])
+                depend(inout: dst[0]))
+        for (usize k = 0; k < n; ++k) dst[k] = host[k];
+    }
+
+    /// Copies the device matrix into the bit-matrix `dst`, resizing `dst` to match, once all queued work is done.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u64>::random(10, 200);
+    /// DeviceMatrix d{m};
+    /// BitMatrix<u64> back;
+    /// d.download(back);
+    /// assert_eq(back, m);
+    /// ```
+    void download(BitMatrix<Word>& dst) const {
+        download_async(dst);
+        sync();
+    }
+
+    /// Queues a copy of the device matrix into the bit-matrix `dst`, resizing `dst` to match, and returns at once.
+    ///
+    /// The words of `dst` are only valid after a `sync()`. `dst` must not be touched or go away until then.
+    ///
+    /// # Example
+    /// ```
+    /// auto a = BitMatrix<u8>::random(30, 30);
+    /// auto b = BitMatrix<u8>::random(30, 30);
+    /// DeviceMatrix da{a}, db{b};
+    /// BitMatrix<u8> ra, rb;
+    /// da.download_async(ra);
+    /// db.download_async(rb);
+    /// da.sync();
+    /// db.sync();
+    /// assert_eq(ra, a);
+    /// assert_eq(rb, b);
+    /// ```
+    void download_async(BitMatrix<Word>& dst) const {
+        dst.resize(m_rows, m_cols);
+        auto n = m_rows * m_stride;
+        if (n == 0) return;
+        auto src = m_data;
+        auto host = dst.m_data.data();
+        GF2_OMP(target teams distribute parallel for nowait device(m_device) is_device_ptr(src) map(from: host[0:n])
+                depend(inout: src[0]))
+        for (usize k = 0; k < n; ++k) host[k] = src[k];
+    }
+
+    /// Returns a copy of the device matrix as a `gf2::BitMatrix` once all queued work is done.
+    BitMatrix<Word> to_matrix() const {
+        BitMatrix<Word> result;
+        download(result);
+        return result;
+    }
+
+    /// Waits for all the transfers and kernels queued on this device matrix to finish.
+    void sync() const {
+        if (m_data == nullptr) return;
+        [[maybe_unused]] auto ptr = m_data;
+        GF2_OMP(taskwait depend(inout: ptr[0]))
+    }
+
+    /// @}
+    /// @name Algebra
+    /// @{
+
+    /// Returns this square device matrix raised to the power `n` (or `2^n` if `n_is_log2` is set).
+    ///
+    /// The power is worked out on the device by repeated squaring, so it needs `O(log n)` device products.
+    ///
+    /// # Panics
+    /// Panics if the matrix is not square.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u32>::random(70, 70);
+    /// DeviceMatrix d{m};
+    /// assert_eq(d.to_the(0).to_matrix(), BitMatrix<u32>::identity(70));
+    /// assert_eq(d.to_the(5).to_matrix(), m.to_the(5));
+    /// assert_eq(d.to_the(3, true).to_matrix(), m.to_the(8));
+    /// ```
+    DeviceMatrix to_the(usize n, bool n_is_log2 = false) const {
+        gf2_assert(!is_empty() && m_rows == m_cols, "Matrix is {} x {} but it should be square!", m_rows, m_cols);
+        DeviceMatrix scratch{m_rows, m_cols, m_device};
+        if (n_is_log2) {
+            auto result = *this;
+            for (auto k = 0uz; k < n; ++k) {
+                multiply(result, result, scratch);
+                std::swap(result, scratch);
+            }
+            return result;
+        }
+
+        auto result = identity(m_rows, m_device);
+        auto square = *this;
+        while (n > 0) {
+            if (n & 1) {
+                multiply(result, square, scratch);
+                std::swap(result, scratch);
+            }
+            n >>= 1;
+            if (n > 0) {
+                multiply(square, square, scratch);
+                std::swap(square, scratch);
+            }
+        }
+        return result;
+    }
+
+    /// Transforms the device matrix to row-echelon form (in-place) and returns a bit-vector showing the pivot columns.
+    ///
+    /// The elimination stays on the device. For each column, one kernel finds the pivot row and one more clears the
+    /// column below the pivot with each row of the matrix handled by its own team of threads. Any all zero rows end up
+    /// at the bottom of the matrix. The echelon form is not unique so it need not match `BitMatrix::to_echelon_form`.
+    ///
+    /// # Panics
+    /// Panics if the matrix is empty.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u16>::random(60, 90);
+    /// DeviceMatrix d{m};
+    /// auto pivots = d.to_echelon_form();
+    /// auto e = d.to_matrix();
+    /// assert_eq(pivots, m.to_echelon_form());
+    /// assert_eq(e.to_reduced_echelon_form(), m.to_reduced_echelon_form());
+    /// assert_eq(e, m);
+    /// ```
+    BitVector<Word> to_echelon_form() {
+        gf2_assert(!is_empty(), "Bit-matrix must not be empty");
+        return eliminate(false);
+    }
+
+    /// Transforms the device matrix to reduced row-echelon form (in-place) and returns a bit-vector showing the pivot
+    /// columns.
+    ///
+    /// The reduced echelon form is unique so it matches the one from `BitMatrix::to_reduced_echelon_form`.
+    ///
+    /// # Panics
+    /// Panics if the matrix is empty.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(80, 50);
+    /// DeviceMatrix d{m};
+    /// auto pivots = d.to_reduced_echelon_form();
+    /// assert_eq(pivots, m.to_reduced_echelon_form());
+    /// assert_eq(d.to_matrix(), m);
+    /// ```
+    BitVector<Word> to_reduced_echelon_form() {
+        gf2_assert(!is_empty(), "Bit-matrix must not be empty");
+        return eliminate(true);
+    }
+
+    /// Returns the LU decomposition of this square device matrix as a `gf2::BitLU` on the host.
+    ///
+    /// The factoring is done on the device using the same pivoting as the `gf2::BitLU` constructor, so the results
+    /// match. Only the packed LU matrix is downloaded at the end and the device matrix itself is left unchanged.
+    ///
+    /// # Panics
+    /// Panics if the matrix is not square.
+    ///
+    /// # Example
+    /// ```
+    /// for (auto n : {1uz, 9uz, 65uz, 150uz}) {
+    ///     auto A = BitMatrix<u8>::random(n, n);
+    ///     A.row(n / 2).set_all(false);
+    ///     auto lu = DeviceMatrix{A}.LU();
+    ///     assert_eq(lu.LU(), A.LU().LU());
+    ///     assert_eq(lu.swaps(), A.LU().swaps());
+    ///     assert_eq(lu.rank(), A.LU().rank());
+    /// }
+    /// ```
+    BitLU<Word> LU() const {
+        gf2_assert(!is_empty() && m_rows == m_cols, "Matrix is {} x {} but it should be square!", m_rows, m_cols);
+        auto work = *this;
+        auto n = m_rows;
+        auto swaps = std::vector<usize>(n);
+        auto rank = n;
+        for (auto j = 0uz; j < n; ++j) {
+            swaps[j] = j;
+            auto p = work.find_pivot(j, j);
+            if (p == n) {
+                rank--;
+                continue;
+            }
+            work.swap_rows(j, p);
+            swaps[j] = p;
+            work.clear_column(j, j, j + 1, true);
+        }
+        return BitLU<Word>{work.to_matrix(), std::move(swaps), rank};
+    }
+
+    /// @}
+
+    // The products need to get at the buffers of their arguments.
+    friend DeviceMatrix dot(DeviceMatrix const& lhs, DeviceMatrix const& rhs) {
+        DeviceMatrix result{lhs.m_rows, rhs.m_cols, lhs.m_device};
+        multiply(lhs, rhs, result);
+        result.sync();
+        return result;
+    }
+
+    template<Unsigned W>
+    friend void dot(std::span<DeviceMatrix<W> const> lhs, std::span<DeviceMatrix<W> const> rhs,
+                    std::span<DeviceMatrix<W>> out);
+
+private:
+    // Returns the `n x n` identity matrix on a device.
+    static DeviceMatrix identity(usize n, int device) {
+        DeviceMatrix result{n, n, device};
+        auto         d = result.m_data;
+        auto         s = result.m_stride;
+        GF2_OMP(target teams distribute parallel for device(device) is_device_ptr(d) depend(inout: d[0]))
+        for (usize i = 0; i < n; ++i) d[i * s + i / BITS<Word>] = static_cast<Word>(Word{1} << (i % BITS<Word>));
+        return result;
+    }
+
+    // (Re)allocates the buffer for an `r x c` matrix if that changes its size (the words are left uninitialized).
+    void allocate(usize r, usize c) {
+        if (r == 0 || c == 0) r = c = 0;
+        auto stride = BitMatrix<Word>::stride_for(c);
+        if (r * stride != m_rows * m_stride) {
+            release();
+            m_data = details::device_alloc<Word>(r * stride, m_device);
+        }
+        m_rows = r;
+        m_cols = c;
+        m_stride = stride;
+    }
+
+    // Waits for any queued work and then frees the buffer.
+    void release() {
+        sync();
+        details::device_free(m_data, m_device);
+        m_data = nullptr;
+        m_rows = m_cols = m_stride = 0;
+    }
+
+    // Sets all the words to zero.
+    void zero() {
+        auto n = m_rows * m_stride;
+        if (n == 0) return;
+        auto d = m_data;
+        GF2_OMP(target teams distribute parallel for nowait device(m_device) is_device_ptr(d) depend(inout: d[0]))
+        for (usize k = 0; k < n; ++k) d[k] = Word{0};
+    }
+
+    // Queues a copy of the words of a device matrix with the same dimensions on the same device.
+    void copy_from(DeviceMatrix const& other) {
+        auto n = m_rows * m_stride;
+        if (n == 0) return;
+        auto d = m_data;
+        auto s = other.m_data;
+        GF2_OMP(target teams distribute parallel for nowait device(m_device) is_device_ptr(d, s) depend(inout: d[0])
+                depend(in: s[0]))
+        for (usize k = 0; k < n; ++k) d[k] = s[k];
+    }
+
+    // Queues the product `lhs * rhs` into `out`, which must already be allocated with the right dimensions.
+    //
+    // Each thread produces one word of the product by adding the rows of `rhs` picked out by a row of `lhs`. The
+    // threads for neighbouring words of an output row read neighbouring words of `rhs` & branch the same way.
+    static void multiply(DeviceMatrix const& lhs, DeviceMatrix const& rhs, DeviceMatrix& out) {
+        gf2_assert_eq(lhs.m_cols, rhs.m_rows, "Incompatible dimensions: {} != {}", lhs.m_cols, rhs.m_rows);
+        gf2_assert(out.m_rows == lhs.m_rows && out.m_cols == rhs.m_cols, "Output has the wrong dimensions");
+        if (out.is_empty()) return;
+        auto a = lhs.m_data;
+        auto b = rhs.m_data;
+        auto c = out.m_data;
+        auto sa = lhs.m_stride;
+        auto sb = rhs.m_stride;
+        auto sc = out.m_stride;
+        auto nr = out.m_rows;
+        auto nk = lhs.m_cols;
+        GF2_OMP(target teams distribute parallel for collapse(2) nowait device(out.m_device) is_device_ptr(a, b, c)
+                depend(in: a[0]) depend(in: b[0]) depend(inout: c[0]))
+        for (usize i = 0; i < nr; ++i) {
+            for (usize w = 0; w < sc; ++w) {
+                Word sum = 0;
+                for (usize kw = 0; kw * BITS<Word> < nk; ++kw) {
+                    auto bits = a[i * sa + kw];
+                    for (usize k = kw * BITS<Word>; bits != 0; ++k, bits >>= 1)
+                        if (bits & 1) sum ^= b[k * sb + w];
+                }
+                c[i * sc + w] = sum;
+            }
+        }
+    }
+
+    // Returns the first row from `r` onwards with a set bit in column `j` (or `rows()` if there isn't one).
+    usize find_pivot(usize r, usize j) const {
+        auto d = m_data;
+        auto s = m_stride;
+        auto nr = m_rows;
+        auto [jw, jm] = index_and_mask<Word>(j);
+        auto p = nr;
+        GF2_OMP(target teams distribute parallel for reduction(min: p) map(tofrom: p) device(m_device) is_device_ptr(d)
+                depend(inout: d[0]))
+        for (usize i = r; i < nr; ++i)
+            if ((d[i * s + jw] & jm) && i < p) p = i;
+        return p;
+    }
+
+    // Swaps rows `i` and `j`.
+    void swap_rows(usize i, usize j) {
+        if (i == j) return;
+        auto d = m_data;
+        auto s = m_stride;
+        GF2_OMP(target teams distribute parallel for device(m_device) is_device_ptr(d) depend(inout: d[0]))
+        for (usize w = 0; w < s; ++w) {
+            auto tmp = d[i * s + w];
+            d[i * s + w] = d[j * s + w];
+            d[j * s + w] = tmp;
+        }
+    }
+
+    // Adds the pivot row `r` to each row from `begin` onwards (other than `r`) with a set bit in column `j`.
+    //
+    // If `keep` is set the bits in columns up to & including `j` are left alone, which leaves the multipliers of an LU
+    // decomposition in place. Each row is handled by one team which reads the bit in column `j` before its threads
+    // split up the words.
+    void clear_column(usize r, usize j, usize begin, bool keep) {
+        auto d = m_data;
+        auto s = m_stride;
+        auto nr = m_rows;
+        auto [jw, jm] = index_and_mask<Word>(j);
+        auto first = keep ? static_cast<Word>(~(jm | (jm - 1))) : static_cast<Word>(~(jm - 1));
+        auto all = static_cast<Word>(~Word{0});
+        GF2_OMP(target teams distribute device(m_device) is_device_ptr(d) depend(inout: d[0]))
+        for (usize i = begin; i < nr; ++i) {
+            if (i == r || !(d[i * s + jw] & jm)) continue;
+            GF2_OMP(parallel for)
+            for (usize w = jw; w < s; ++w) d[i * s + w] ^= d[r * s + w] & (w == jw ? first : all);
+        }
+    }
+
+    // The forward elimination for the (reduced) echelon forms.
+    BitVector<Word> eliminate(bool reduced) {
+        auto pivots = BitVector<Word>::zeros(m_cols);
+        auto r = 0uz;
+        for (auto j = 0uz; j < m_cols && r < m_rows; ++j) {
+            auto p = find_pivot(r, j);
+            if (p == m_rows) continue;
+            pivots.set(j);
+            swap_rows(r, p);
+            clear_column(r, j, reduced ? 0 : r + 1, false);
+            ++r;
+        }
+        return pivots;
+    }
+};
+
+/// Returns the product of two device matrices, computed on the device of `lhs`.
+///
+/// Each thread works out one word of the product. The matrices must be on the same device.
+///
+/// # Panics
+/// Panics if the dimensions are incompatible.
+///
+/// # Example
+/// ```
+/// auto a = BitMatrix<u8>::random(50, 70);
+/// auto b = BitMatrix<u8>::random(70, 30);
+/// DeviceMatrix da{a}, db{b};
+/// assert_eq(dot(da, db).to_matrix(), a * b);
+/// assert_eq((da * db).to_matrix(), a * b);
+/// ```
+template<Unsigned Word>
+DeviceMatrix<Word>
+operator*(DeviceMatrix<Word> const& lhs, DeviceMatrix<Word> const& rhs) {
+    return dot(lhs, rhs);
+}
+
+/// Works out the products `lhs[i] * rhs[i]` for a batch of pairs of device matrices.
+///
+/// Each output is resized if need be, then all the product kernels are queued before waiting for any of them, so the
+/// device can overlap them. Each output ends up on the device of its left-hand factor.
+///
+/// # Panics
+/// Panics if the spans have different lengths or any pair has incompatible dimensions.
+///
+/// # Example
+/// ```
+/// std::vector<DeviceMatrix<>> a, b, p(5);
+/// std::vector<BitMatrix<>> ha, hb;
+/// for (auto i = 0uz; i < 5; ++i) {
+///     ha.push_back(BitMatrix<>::random(40 + i, 60));
+///     hb.push_back(BitMatrix<>::random(60, 20 + i));
+///     a.emplace_back(ha.back());
+///     b.emplace_back(hb.back());
+/// }
+/// dot(std::span<DeviceMatrix<> const>{a}, std::span<DeviceMatrix<> const>{b}, std::span{p});
+/// for (auto i = 0uz; i < 5; ++i) assert_eq(p[i].to_matrix(), ha[i] * hb[i]);
+/// ```
+template<Unsigned Word>
+void
+dot(std::span<DeviceMatrix<Word> const> lhs, std::span<DeviceMatrix<Word> const> rhs,
+    std::span<DeviceMatrix<Word>> out) {
+    gf2_assert(lhs.size() == rhs.size() && lhs.size() == out.size(), "Batch sizes do not match");
+    for (auto i = 0uz; i < lhs.size(); ++i) {
+        if (out[i].m_device != lhs[i].m_device) out[i] = DeviceMatrix<Word>{0, 0, lhs[i].m_device};
+        out[i].allocate(lhs[i].m_rows, rhs[i].m_cols);
+        DeviceMatrix<Word>::multiply(lhs[i], rhs[i], out[i]);
+    }
+    for (auto& p : out) p.sync();
+}
+
+} // namespace gf2
@@ -0,0 +1,458 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Arithmetic in the extension fields GF(2^m) for `m` up to 64 with each element held in a single word. <br>
+/// See the [GF2m](docs/pages/GF2m.md) page for more details.
+
+#include <gf2/BitPolynomial.h>
+
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace gf2 {
+
+/// Fields GF(2^m) with degree `m` up to this multiply by looking up log & antilog tables, larger ones by carry-less
+/// multiplication & Barrett reduction.
+///
+/// A product from the tables is a couple of dependent loads. Even with the `PCLMULQDQ` or `PMULL` instructions, the
+/// three carry-less products of a Barrett multiply cost more than that as long as the tables fit in the L2 cache.
+inline constexpr usize GF2M_TABLE_THRESHOLD = 16;
+
+/// A `GF2m` does arithmetic in the finite field GF(2^m), the polynomials over GF(2) modulo an irreducible polynomial
+/// `P(x)` of degree `m`, for `1 <= m <= BITS<Word>`.
+///
+/// An element of the field is a polynomial of degree less than `m` & it is held in a single `Word` with coefficient
+/// `i` in bit `i`. The field object holds the modulus & whatever it precomputed for it, and its methods take & return
+/// elements as plain words, so none of the arithmetic allocates & spans of elements are just spans of words. For
+/// example, GF(2^8) with `Word = u8` is the field of the usual Reed-Solomon codes.
+///
+/// Fields with `m <= GF2M_TABLE_THRESHOLD` multiply by adding discrete logarithms from a table built on construction.
+/// Bigger fields multiply with `gf2::clmul` & reduce the double-width product by Barrett's method:
+/// `q = ((p >> m) * mu) >> m` with `mu = x^{2m} / P(x)` is the exact quotient of the product `p` by `P(x)`, so the
+/// remainder is `p + q * P(x)` which takes two more carry-less products and no loops.
+/// On targets without a carry-less multiply instruction those products would go through the portable `gf2::clmul`,
+/// so bigger fields work through the multiplier four bits at a time instead, reducing as they go.
+///
+/// The elements passed to the methods must be reduced, i.e. less than `2^m`. Addition is `XOR` whatever the field.
+///
+/// For fields of higher degree, whose elements no longer fit in a word, use a `ModContext` with an irreducible modulus.
+///
+/// # Example
+/// ```
+/// // The field of the AES cipher: x^8 + x^4 + x^3 + x + 1.
+/// GF2m<u8> F{BitPolynomial<u8>::from(8, [](usize i) { return i == 8 || i == 4 || i == 3 || i == 1 || i == 0; })};
+/// assert_eq(F.degree(), 8);
+/// assert_eq(F.mul(0x57, 0x83), 0xc1);
+/// assert_eq(F.mul(0x53, F.inv(0x53)), 1);
+/// assert_eq(F.inv(0x53), 0xca);
+/// ```
+template<Unsigned Word = usize>
+class GF2m {
+public:
+    /// The underlying unsigned word type, which is also the type of the field elements.
+    using word_type = Word;
+
+    /// The type of the modulus & of the polynomials that the elements stand for.
+    using polynomial_type = BitPolynomial<Word>;
+
+    /// @name Constructors
+    /// @{
+
+    /// Constructs the field GF(2^m) of the polynomials modulo `P(x)`, which must be irreducible of degree `m`.
+    ///
+    /// Fields with `m <= GF2M_TABLE_THRESHOLD` build their log & antilog tables here, which is `O(2^m)` work and
+    /// `3 * 2^m` words of memory. Nothing else the field does allocates.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `P(x)` is not irreducible or if its degree
+    /// is 0 or larger than the number of bits in a `Word`.
+    ///
+    /// # Example
+    /// ```
+    /// auto x = [](usize n) { return BitPolynomial<u16>::x_to_the(n); };
+    /// GF2m<u16> F{x(16) + x(5) + x(3) + x(1) + x(0)};
+    /// assert_eq(F.degree(), 16);
+    /// assert_eq(F.has_tables(), 16 <= GF2M_TABLE_THRESHOLD);
+    /// assert_eq(F.mul(F.inv(12345), 12345), 1);
+    /// bool threw = false;
+    /// try { GF2m<u16>{x(4) + x(2) + x(0)}; } catch (std::invalid_argument const&) { threw = true; }
+    /// assert(threw);
+    /// ```
+    explicit GF2m(polynomial_type const& P) : m_modulus{P} {
+        m_degree = m_modulus.degree();
+        if (m_modulus.is_zero() || m_degree == 0 || m_degree > BITS<Word>)
+            throw std::invalid_argument("GF(2^m) needs a modulus of degree 1 to the number of bits in a word.");
+        if (!m_modulus.is_irreducible()) throw std::invalid_argument("GF(2^m) needs an irreducible modulus.");
+        m_modulus.coefficients().resize(m_degree + 1);
+
+        // P(x) = x^m + p(x) & mu(x) = x^{2m} / P(x) = x^m + mu'(x), where only the low parts p & mu' are kept.
+        m_mask = m_degree == 64 ? MAX<u64> : (u64{1} << m_degree) - 1;
+        auto const& coeffs = m_modulus.coefficients();
+        for (auto i = 0uz; i < m_degree; ++i)
+            if (coeffs.get(i)) m_low |= u64{1} << i;
+        auto mu = polynomial_type::x_to_the(2 * m_degree) / m_modulus;
+        for (auto i = 0uz; i < m_degree; ++i)
+            if (mu.coefficients().get(i)) m_mu |= u64{1} << i;
+
+        // For m >= 4, t x^m mod P(x) = (t x^4) x^{m-4} mod P(x) for the four-bit overflows t of r x^4 in a product.
+        if (m_degree >= 4) {
+            for (auto t = 1uz; t < 16; ++t) {
+                u64 v = 0;
+                for (auto i = 4uz; i-- > 0;) v = times_x(v) ^ (m_low & (0 - ((t >> i) & 1)));
+                m_fold[t] = v;
+            }
+        }
+
+        if (m_degree <= GF2M_TABLE_THRESHOLD) build_tables();
+    }
+
+    /// Returns the field GF(2^m) for the smallest irreducible modulus of degree `m`, the one whose coefficients read
+    /// as the smallest binary number.
+    ///
+    /// # Panics
+    /// This method panics (throws a `std::invalid_argument` exception) if `m` is 0 or larger than the number of bits
+    /// in a `Word`.
+    ///
+    /// # Example
+    /// ```
+    /// auto F = GF2m<u8>::of_degree(8);
+    /// assert_eq(F.modulus().to_string(), "1 + x + x^3 + x^4 + x^8");
+    /// auto G = GF2m<u64>::of_degree(64);
+    /// assert_eq(G.modulus().to_string(), "1 + x + x^3 + x^4 + x^64");
+    /// assert_eq(G.mul(G.inv(0xdead'beef'cafe'f00d), 0xdead'beef'cafe'f00d), 1);
+    /// ```
+    static GF2m of_degree(usize m) {
+        if (m == 0 || m > BITS<Word>)
+            throw std::invalid_argument("GF(2^m) needs a degree from 1 to the number of bits in a word.");
+
+        // Irreducible polynomials have a constant term (apart from x itself) so we only try the odd ones.
+        for (u64 low = 1;; low += 2) {
+            auto P = polynomial_type::from(m, [&](usize i) { return i == m || (i < 64 && ((low >> i) & 1)); });
+            if (P.is_irreducible()) return GF2m{P};
+        }
+    }
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the degree `m` of the field GF(2^m) over GF(2).
+    constexpr usize degree() const { return m_degree; }
+
+    /// Returns `2^m - 1`, the number of non-zero elements & the order of the multiplicative group of the field.
+    constexpr u64 group_order() const { return m_mask; }
+
+    /// Returns a read-only reference to the irreducible modulus `P(x)`.
+    constexpr polynomial_type const& modulus() const { return m_modulus; }
+
+    /// Returns `true` if the field multiplies by looking up log & antilog tables.
+    constexpr bool has_tables() const { return !m_exp.empty(); }
+
+    /// @}
+    /// @name Conversions
+    /// @{
+
+    /// Returns the element for the polynomial `p(x) mod P(x)`.
+    ///
+    /// # Example
+    /// ```
+    /// auto F = GF2m<u8>::of_degree(8);
+    /// assert_eq(F.from_polynomial(BitPolynomial<u8>::x_to_the(8)), 0b0001'1011);
+    /// assert_eq(F.to_polynomial(0b0001'1011).to_string(), "1 + x + x^3 + x^4");
+    /// assert_eq(F.from_polynomial(F.to_polynomial(200)), 200);
+    /// ```
+    Word from_polynomial(polynomial_type const& p) const {
+        auto r = p % m_modulus;
+        auto n = std::min(r.coefficients().size(), m_degree);
+        u64  result = 0;
+        for (auto i = 0uz; i < n; ++i)
+            if (r.coefficients().get(i)) result |= u64{1} << i;
+        return static_cast<Word>(result);
+    }
+
+    /// Returns the polynomial of degree less than `m` that the element `a` stands for.
+    polynomial_type to_polynomial(Word a) const {
+        return polynomial_type::from(m_degree - 1, [&](usize i) { return ((a >> i) & 1) != 0; });
+    }
+
+    /// @}
+    /// @name Arithmetic
+    /// @{
+
+    /// Returns the sum `a + b`, which is also the difference `a - b`, of two elements.
+    static constexpr Word add(Word a, Word b) { return static_cast<Word>(a ^ b); }
+
+    /// Returns the product `a * b` of two elements.
+    ///
+    /// # Example
+    /// ```
+    /// auto F = GF2m<u32>::of_degree(20);
+    /// auto G = GF2m<u32>::of_degree(30);
+    /// for (u32 a = 1; a < 5000; a += 37) {
+    ///     auto p = F.to_polynomial(a) * F.to_polynomial(a + 1);
+    ///     assert_eq(F.mul(a, a + 1), F.from_polynomial(p));
+    ///     assert_eq(G.mul(a << 10, a), G.from_polynomial(G.to_polynomial(a << 10) * G.to_polynomial(a)));
+    /// }
+    /// for (auto m = 1uz; m <= 5; ++m) {
+    ///     auto K = GF2m<u8>::of_degree(m);
+    ///     for (u32 a = 0; a < (1u << m); ++a)
+    ///         for (u32 b = 0; b < (1u << m); ++b)
+    ///             assert_eq(K.mul(u8(a), u8(b)), K.from_polynomial(K.to_polynomial(u8(a)) * K.to_polynomial(u8(b))));
+    /// }
+    /// auto H = GF2m<u8>::of_degree(8);
+    /// for (u32 a = 0; a < 256; ++a)
+    ///     for (u32 b = 0; b < 256; b += 7)
+    ///         assert_eq(H.mul(u8(a), u8(b)), H.from_polynomial(H.to_polynomial(u8(a)) * H.to_polynomial(u8(b))));
+    /// ```
+    Word mul(Word a, Word b) const {
+        if (has_tables()) return table_mul(a, b);
+        return clmul_mul(a, b);
+    }
+
+    /// Returns the square `a * a` of an element.
+    Word square(Word a) const { return mul(a, a); }
+
+    /// Returns the multiplicative inverse of a non-zero element.
+    ///
+    /// The table fields look it up. The others raise `a` to the power `2^m - 2` with `2m - 2` products.
+    ///
+    /// # Panics
+    /// This method panics if `a` is zero.
+    ///
+    /// # Example
+    /// ```
+    /// auto F = GF2m<u16>::of_degree(11);
+    /// for (u16 a = 1; a < 2048; ++a) assert_eq(F.mul(a, F.inv(a)), 1);
+    /// auto G = GF2m<u64>::of_degree(41);
+    /// for (u64 a = 1; a < 100; ++a) assert_eq(G.mul(a, G.inv(a)), 1);
+    /// ```
+    Word inv(Word a) const {
+        gf2_assert(a != 0, "Zero has no multiplicative inverse!");
+        if (has_tables()) return m_exp[static_cast<usize>(m_mask - m_log[a])];
+
+        // a^{2^m - 2} = a^2 * a^4 * ... * a^{2^{m-1}}.
+        Word result = 1;
+        for (auto i = 1uz; i < m_degree; ++i) {
+            a = clmul_mul(a, a);
+            result = clmul_mul(result, a);
+        }
+        return result;
+    }
+
+    /// Returns the quotient `a / b` of an element by a non-zero element.
+    ///
+    /// # Panics
+    /// This method panics if `b` is zero.
+    Word div(Word a, Word b) const { return mul(a, inv(b)); }
+
+    /// Returns the element `a` raised to the power `e`, where `a^0 = 1` for every `a`.
+    ///
+    /// # Example
+    /// ```
+    /// auto F = GF2m<u8>::of_degree(8);
+    /// assert_eq(F.pow(3, 0), 1);
+    /// assert_eq(F.pow(0, 5), 0);
+    /// assert_eq(F.pow(3, 255), 1);
+    /// assert_eq(F.pow(3, 254), F.inv(3));
+    /// auto G = GF2m<u64>::of_degree(64);
+    /// assert_eq(G.pow(2, 64), G.from_polynomial(BitPolynomial<u64>::x_to_the(64)));
+    /// assert_eq(G.pow(12345, G.group_order()), 1);
+    /// ```
+    Word pow(Word a, u64 e) const {
+        if (e == 0) return 1;
+        if (a == 0) return 0;
+        if (has_tables()) {
+            auto k = (static_cast<u64>(m_log[a]) * (e % m_mask)) % m_mask;
+            return m_exp[k];
+        }
+        Word result = 1;
+        for (; e != 0; e >>= 1) {
+            if (e & 1) result = clmul_mul(result, a);
+            a = clmul_mul(a, a);
+        }
+        return result;
+    }
+
+    /// @}
+    /// @name Batched Arithmetic
+    /// @{
+
+    /// Sets `out[i] = a[i] * b[i]` for each index.
+    ///
+    /// # Panics
+    /// This method panics if the three spans do not have the same size.
+    ///
+    /// # Example
+    /// ```
+    /// auto F = GF2m<u8>::of_degree(8);
+    /// std::vector<u8> a{1, 2, 3, 0, 255}, b{7, 7, 7, 7, 7}, out(5);
+    /// F.mul(a, b, out);
+    /// for (auto i = 0uz; i < a.size(); ++i) assert_eq(out[i], F.mul(a[i], b[i]));
+    /// ```
+    void mul(std::span<Word const> a, std::span<Word const> b, std::span<Word> out) const {
+        gf2_assert(a.size() == b.size() && a.size() == out.size(), "Span sizes {}, {} & {} should all match!", a.size(),
+                   b.size(), out.size());
+        if (has_tables()) {
+            for (auto i = 0uz; i < a.size(); ++i) out[i] = table_mul(a[i], b[i]);
+        } else {
+            for (auto i = 0uz; i < a.size(); ++i) out[i] = clmul_mul(a[i], b[i]);
+        }
+    }
+
+    /// Multiplies each element of `x` by the scalar `c` in place.
+    ///
+    /// The table fields look up the logarithm of `c` just once.
+    void scale(Word c, std::span<Word> x) const {
+        if (has_tables()) {
+            if (c == 0) {
+                std::ranges::fill(x, Word{0});
+                return;
+            }
+            auto lc = static_cast<usize>(m_log[c]);
+            for (auto& xi : x) xi = xi == 0 ? Word{0} : m_exp[lc + m_log[xi]];
+        } else {
+            for (auto& xi : x) xi = clmul_mul(c, xi);
+        }
+    }
+
+    /// Adds `c * x[i]` to `y[i]` for each index, the basic step of Reed-Solomon encoding & syndrome updates.
+    ///
+    /// # Panics
+    /// This method panics if the two spans do not have the same size.
+    ///
+    /// # Example
+    /// ```
+    /// for (auto m : {8uz, 32uz}) {
+    ///     auto F = GF2m<u32>::of_degree(m);
+    ///     std::vector<u32> x{1, 2, 3, 4, 0}, y{9, 8, 7, 6, 5}, z = y;
+    ///     F.axpy(77, x, y);
+    ///     for (auto i = 0uz; i < x.size(); ++i) assert_eq(y[i], F.add(z[i], F.mul(77, x[i])));
+    ///     F.scale(77, x);
+    ///     assert_eq(x[3], F.mul(77, 4));
+    /// }
+    /// ```
+    void axpy(Word c, std::span<Word const> x, std::span<Word> y) const {
+        gf2_assert_eq(x.size(), y.size(), "Span sizes {} & {} should match!", x.size(), y.size());
+        if (c == 0) return;
+        if (has_tables()) {
+            auto lc = static_cast<usize>(m_log[c]);
+            for (auto i = 0uz; i < x.size(); ++i)
+                if (x[i] != 0) y[i] ^= m_exp[lc + m_log[x[i]]];
+        } else {
+            for (auto i = 0uz; i < x.size(); ++i) y[i] ^= clmul_mul(c, x[i]);
+        }
+    }
+
+    /// Returns the value at `x` of the polynomial with coefficients `coeffs[0] + coeffs[1] y + coeffs[2] y^2 + ...`
+    /// over the field, by Horner's method.
+    ///
+    /// # Example
+    /// ```
+    /// auto F = GF2m<u16>::of_degree(13);
+    /// std::vector<u16> c{5, 0, 1};
+    /// assert_eq(F.evaluate(c, 0), 5);
+    /// assert_eq(F.evaluate(c, 3), F.add(5, F.mul(3, 3)));
+    /// assert_eq(F.evaluate(std::vector<u16>{}, 3), 0);
+    /// ```
+    Word evaluate(std::span<Word const> coeffs, Word x) const {
+        Word result = 0;
+        if (has_tables() && x != 0) {
+            auto lx = static_cast<usize>(m_log[x]);
+            for (auto i = coeffs.size(); i-- > 0;)
+                result = static_cast<Word>((result == 0 ? Word{0} : m_exp[lx + m_log[result]]) ^ coeffs[i]);
+        } else {
+            for (auto i = coeffs.size(); i-- > 0;) result = static_cast<Word>(mul(result, x) ^ coeffs[i]);
+        }
+        return result;
+    }
+
+    /// @}
+
+private:
+    polynomial_type     m_modulus;   // The irreducible modulus P(x) = x^m + p(x).
+    usize               m_degree;    // The degree m of P(x).
+    u64                 m_mask = 0;  // The low m bits set, which is also 2^m - 1.
+    u64                 m_low = 0;   // The coefficients of p(x).
+    u64                 m_mu = 0;    // The low m coefficients of mu = x^{2m} / P(x) (whose top one is x^m).
+    std::array<u64, 16> m_fold{};    // The reductions t x^m mod P(x) of the four-bit overflows t (for m >= 4).
+    std::vector<Word>   m_exp;       // Powers g^k of a primitive element for k < 2(2^m - 1) (empty for big fields).
+    std::vector<Word>   m_log;       // The logarithm k with g^k = a for each non-zero element a.
+
+    // Returns the high half `p >> m` of the 128-bit value `hi:lo` for 1 <= m <= 64.
+    constexpr u64 shift_down(u64 lo, u64 hi) const {
+        return m_degree == 64 ? hi : (lo >> m_degree) | (hi << (64 - m_degree));
+    }
+
+    // Returns a * b by carry-less multiplication & Barrett reduction. With the product p = H x^m + L we have the
+    // quotient q = (H * mu) >> m = H + (H * mu') >> m & the remainder is the low m bits of L + q * p(x).
+    //
+    // Without a carry-less multiply instruction we go by Horner's rule through b four bits at a time from the top
+    // instead: r <- r x^4 mod P(x) + a * (next four bits of b), where the multiples of a are formed as we go and the
+    // reduction looks up what the four bits shifted past x^m fold back to.
+    constexpr Word clmul_mul(Word a, Word b) const {
+#if defined(__PCLMUL__) || defined(__ARM_FEATURE_AES)
+        auto [lo, hi] = clmul(static_cast<u64>(a), static_cast<u64>(b));
+        auto H = shift_down(lo, hi);
+        auto [tlo, thi] = clmul(H, m_mu);
+        auto q = H ^ shift_down(tlo, thi);
+        auto r = (lo ^ clmul(q, m_low).first) & m_mask;
+        return static_cast<Word>(r);
+#else
+        if (m_degree < 4) return static_cast<Word>(bitwise_mul(a, b));
+        std::array<u64, 16> multiple{0, static_cast<u64>(a)};
+        for (auto k = 2uz; k < 16; ++k)
+            multiple[k] = (k & 1) ? multiple[k - 1] ^ multiple[1] : times_x(multiple[k / 2]);
+        u64 r = 0;
+        for (auto j = (m_degree + 3) / 4; j-- > 0;) {
+            r = (((r << 4) & m_mask) ^ m_fold[r >> (m_degree - 4)]) ^ multiple[(static_cast<u64>(b) >> (4 * j)) & 15];
+        }
+        return static_cast<Word>(r);
+#endif
+    }
+
+    // Returns v * x mod P(x) for a reduced v.
+    constexpr u64 times_x(u64 v) const {
+        auto top = (v >> (m_degree - 1)) & 1;
+        return ((v << 1) & m_mask) ^ (m_low & (0 - top));
+    }
+
+    // Returns a * b for a reduced a by Horner's rule going through b one bit at a time from the top.
+    constexpr u64 bitwise_mul(Word a, Word b) const {
+        u64 r = 0;
+        for (auto j = m_degree; j-- > 0;)
+            r = times_x(r) ^ (static_cast<u64>(a) & (0 - ((static_cast<u64>(b) >> j) & 1)));
+        return r;
+    }
+
+    // Returns a * b by adding the discrete logarithms (the antilog table is doubled so the sum needs no reduction).
+    constexpr Word table_mul(Word a, Word b) const {
+        if (a == 0 || b == 0) return 0;
+        return m_exp[static_cast<usize>(m_log[a]) + m_log[b]];
+    }
+
+    // Finds a primitive element g, the smallest whose powers run through every non-zero element, & tabulates them.
+    void build_tables() {
+        usize order = m_mask;
+        m_exp.resize(2 * order);
+        m_log.resize(order + 1);
+        for (u64 g = m_degree == 1 ? 1 : 2;; ++g) {
+            auto  x = Word{1};
+            usize k = 0;
+            do {
+                m_exp[k++] = x;
+                x = clmul_mul(x, static_cast<Word>(g));
+            } while (x != 1 && k < order);
+            if (x == 1 && k == order) break;
+        }
+        for (auto k = 0uz; k < order; ++k) {
+            m_exp[k + order] = m_exp[k];
+            m_log[m_exp[k]] = static_cast<Word>(k);
+        }
+    }
+};
+
+} // namespace gf2
@@ -110,18 +110,33 @@ public:
 ///
 /// This is a constant iterator that returns the indices of the set bits in the store as successive `usize`s.
 ///
+/// The iterator caches the store word it is scanning. Each step clears the lowest set bit of that word and only moves
+/// on to the next word once it runs out. So a step usually costs just a couple of instructions. If you don't need an
+/// iterator, `gf2::for_each_set_bit` and `gf2::to_indices` are a little faster still.
+///
 /// # Example
 /// ```
 /// auto v = BitVector<u8>::alternating(10);
 /// assert_eq(v.to_string(), "1010101010");
 /// auto indices = std::ranges::to<std::vector>(v.set_bits());
 /// assert_eq(indices, (std::vector<usize>{0, 2, 4, 6, 8}));
+/// auto it = v.set_bits().begin();
+/// ++it;
+/// ++it;
+/// assert_eq(*it, 4);
+/// --it;
+/// assert_eq(*it, 2);
 /// ```
 template<BitStore Store>
 class SetBits {
 private:
-    const Store*         m_store = nullptr;      // The store we're iterating over
-    std::optional<usize> m_index = std::nullopt; // Search after this index.
+    using word_type = typename Store::word_type;
+    static constexpr usize bits_per_word = BITS<word_type>;
+
+    const Store* m_store = nullptr; // The store we're iterating over
+    usize        m_words = 0;       // The number of words in the store.
+    usize        m_word_index = 0;  // The word we're scanning (`m_words` once we're past the end).
+    word_type    m_word = 0;        // The set bits in that word we haven't visited yet.
 
 public:
     // The value type is a `usize` (the index of the set bit).
@@ -130,9 +145,10 @@ public:
     // The difference type is always a `std::ptrdiff_t` (required by the iterator concept).
     using difference_type = std::ptrdiff_t;
 
-    // Our constructor captures a pointer to the store and sets the index to uninitialized.
-    SetBits(Store const* store, std::optional<usize> idx = std::nullopt) : m_store(store), m_index{idx} {
-        // Empty body ...
+    // Our constructor captures a pointer to the store and positions us at the first set bit at or after `idx`.
+    // With no index, we are at the end.
+    SetBits(Store const* store, std::optional<usize> idx = std::nullopt) : m_store(store), m_words{store->words()} {
+        seek(idx.value_or(store->size()));
     }
 
     // Iterator are required to act like value types so must be default constructible, moveable, and copyable.
@@ -144,21 +160,26 @@ public:
 
     // Iterators must be comparable (this is how the range-for loops work).
     constexpr bool operator==(SetBits const& other) const {
-        return m_store == other.m_store && m_index == other.m_index;
+        return m_store == other.m_store && m_word_index == other.m_word_index && m_word == other.m_word;
     }
 
     // What is the iterator currently pointing to? (this is what the range-for loop will use).
-    constexpr value_type operator*() const { return *m_index; }
+    constexpr value_type operator*() const {
+        return m_word_index * bits_per_word + static_cast<usize>(std::countr_zero(m_word));
+    }
 
     // Any call to `begin` returns a new iterator pointing to the first set bit in the store.
-    constexpr auto begin() const { return SetBits(m_store, m_store->first_set()); }
+    constexpr auto begin() const { return SetBits(m_store, 0); }
 
-    // Any call to `end` returns a new iterator that is not initialized.
+    // Any call to `end` returns a new iterator that is past the last set bit.
     constexpr auto end() const { return SetBits(m_store, std::nullopt); }
 
     // Increment the iterator, returning the new value (the `i++` operator).
     constexpr SetBits& operator++() {
-        if (m_index.has_value()) m_index = m_store->next_set(*m_index);
+        if (m_word != 0) {
+            m_word &= static_cast<word_type>(m_word - 1);
+            skip_empty_words();
+        }
         return *this;
     }
 
@@ -171,7 +192,10 @@ public:
 
     // Decrement the iterator, returning the new value (the `--i` operator).
     constexpr SetBits& operator--() {
-        if (m_index.has_value()) m_index = previous_set(*m_store, *m_index);
+        if (m_word != 0) {
+            auto prev = previous_set(*m_store, **this);
+            seek(prev.value_or(m_store->size()));
+        }
         return *this;
     }
 
@@ -181,6 +205,26 @@ public:
         --*this;
         return prev;
     }
+
+private:
+    // Positions us at the first set bit at or after index `i`.
+    constexpr void seek(usize i) {
+        if (i >= m_store->size()) {
+            m_word_index = m_words;
+            m_word = 0;
+            return;
+        }
+        auto [index, offset] = index_and_offset<word_type>(i);
+        m_word_index = index;
+        m_word = static_cast<word_type>(m_store->word(index) & (MAX<word_type> << offset));
+        skip_empty_words();
+    }
+
+    // Moves on through the words of the store until we find one with a bit we haven't visited yet.
+    constexpr void skip_empty_words() {
+        while (m_word == 0 && m_word_index < m_words)
+            if (++m_word_index < m_words) m_word = m_store->word(m_word_index);
+    }
 };
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -192,18 +236,27 @@ public:
 ///
 /// This is a constant iterator that returns the indices of the unset bits in the store as successive `usize`s.
 ///
+/// It works just like `gf2::SetBits` but scans the complement of each store word.
+///
 /// # Example
 /// ```
 /// auto v = BitVector<u8>::alternating(10);
 /// assert_eq(v.to_string(), "1010101010");
 /// auto indices = std::ranges::to<std::vector>(v.unset_bits());
 /// assert_eq(indices, (std::vector<usize>{1, 3, 5, 7, 9}));
+/// auto u = BitVector<u8>::ones(10);
+/// assert_eq(std::ranges::distance(u.unset_bits()), 0);
 /// ```
 template<BitStore Store>
 class UnsetBits {
 private:
-    const Store*         m_store = nullptr;      // The store we're iterating over
-    std::optional<usize> m_index = std::nullopt; // Search after this index.
+    using word_type = typename Store::word_type;
+    static constexpr usize bits_per_word = BITS<word_type>;
+
+    const Store* m_store = nullptr; // The store we're iterating over
+    usize        m_words = 0;       // The number of words in the store.
+    usize        m_word_index = 0;  // The word we're scanning (`m_words` once we're past the end).
+    word_type    m_word = 0;        // The unset bits in that word we haven't visited yet (as ones).
 
 public:
     // The value type is a `usize` (the index of the unset bit).
@@ -212,9 +265,10 @@ public:
     // The difference type is always a `std::ptrdiff_t` (required by the iterator concept).
     using difference_type = std::ptrdiff_t;
 
-    // Our constructor captures a pointer to the store and sets the index to uninitialized.
-    UnsetBits(Store const* store, std::optional<usize> idx = std::nullopt) : m_store(store), m_index{idx} {
-        // Empty body ...
+    // Our constructor captures a pointer to the store and positions us at the first unset bit at or after `idx`.
+    // With no index, we are at the end.
+    UnsetBits(Store const* store, std::optional<usize> idx = std::nullopt) : m_store(store), m_words{store->words()} {
+        seek(idx.value_or(store->size()));
     }
 
     // Iterator are required to act like value types so must be default constructible, moveable, and copyable.
@@ -226,21 +280,26 @@ public:
 
     // Iterators must be comparable (this is how the range-for loops work).
     constexpr bool operator==(UnsetBits const& other) const {
-        return m_store == other.m_store && m_index == other.m_index;
+        return m_store == other.m_store && m_word_index == other.m_word_index && m_word == other.m_word;
     }
 
     // What is the iterator currently pointing to? (this is what the range-for loop will use).
-    constexpr value_type operator*() const { return *m_index; }
+    constexpr value_type operator*() const {
+        return m_word_index * bits_per_word + static_cast<usize>(std::countr_zero(m_word));
+    }
 
     // Any call to `begin` returns a new iterator pointing to the first unset bit in the store.
-    constexpr auto begin() const { return UnsetBits(m_store, m_store->first_unset()); }
+    constexpr auto begin() const { return UnsetBits(m_store, 0); }
 
-    // Any call to `end` returns a new iterator that is not initialized.
+    // Any call to `end` returns a new iterator that is past the last unset bit.
     constexpr auto end() const { return UnsetBits(m_store, std::nullopt); }
 
     // Increment the iterator, returning the new value (the `i++` operator).
     constexpr UnsetBits& operator++() {
-        if (m_index.has_value()) m_index = m_store->next_unset(*m_index);
+        if (m_word != 0) {
+            m_word &= static_cast<word_type>(m_word - 1);
+            skip_empty_words();
+        }
         return *this;
     }
 
@@ -253,7 +312,10 @@ public:
 
     // Decrement the iterator, returning the new value (the `--i` operator).
     constexpr UnsetBits& operator--() {
-        if (m_index.has_value()) m_index = previous_unset(*m_store, *m_index);
+        if (m_word != 0) {
+            auto prev = previous_unset(*m_store, **this);
+            seek(prev.value_or(m_store->size()));
+        }
         return *this;
     }
 
@@ -263,6 +325,36 @@ public:
         --*this;
         return prev;
     }
+
+private:
+    // Returns the complement of store word `i` with any bits past the end of the store cleared.
+    constexpr word_type flipped_word(usize i) const {
+        auto w = static_cast<word_type>(~m_store->word(i));
+        if (i + 1 == m_words) {
+            auto tail = m_store->size() % bits_per_word;
+            if (tail != 0) w &= static_cast<word_type>(MAX<word_type> >> (bits_per_word - tail));
+        }
+        return w;
+    }
+
+    // Positions us at the first unset bit at or after index `i`.
+    constexpr void seek(usize i) {
+        if (i >= m_store->size()) {
+            m_word_index = m_words;
+            m_word = 0;
+            return;
+        }
+        auto [index, offset] = index_and_offset<word_type>(i);
+        m_word_index = index;
+        m_word = static_cast<word_type>(flipped_word(index) & (MAX<word_type> << offset));
+        skip_empty_words();
+    }
+
+    // Moves on through the words of the store until we find one with a bit we haven't visited yet.
+    constexpr void skip_empty_words() {
+        while (m_word == 0 && m_word_index < m_words)
+            if (++m_word_index < m_words) m_word = flipped_word(m_word_index);
+    }
 };
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,301 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// A word-parallel linear feedback shift register with jump-ahead. <br>
+/// See the [Lfsr](docs/pages/Lfsr.md) page for more details.
+
+#include <gf2/BitPolynomial.h>
+#include <gf2/MemoryScope.h>
+
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace gf2 {
+
+/// An `Lfsr` generates the bit stream `s_0, s_1, s_2, ...` of the linear recurrence whose characteristic polynomial is
+/// `P(x) = x^L + p_{L-1} x^{L-1} + ... + p_1 x + p_0`.
+/// That is, `s_{i+L} = p_0 s_i + p_1 s_{i+1} + ... + p_{L-1} s_{i+L-1}` for all `i`.
+/// The state is the window of the next `L` bits `s_i, ..., s_{i+L-1}` and the first state is the seed.
+///
+/// Stepping one bit at a time costs an `L` bit dot product per output bit. Instead, `next_word` emits a whole word of
+/// the stream at once. The `W` bits that follow the window are linear in the window since `s_{i+n}` is the dot product
+/// of the window with the coefficients of `x^n mod P(x)`. The constructor builds a table of those `W`-bit words for
+/// each of the 256 values of each byte of the window, so a step costs one lookup per byte of the window and a shift.
+///
+/// Jumps ahead use the same fact: `jump(n)` reduces `x^n` modulo `P(x)` and costs `O(L^2)` however large `n` is.
+///
+/// The `minimal_polynomial` of a bit sequence (see `BerlekampMassey`) has exactly this form, so an `Lfsr` built from it
+/// and the first `L` bits of the sequence regenerates the whole sequence.
+///
+/// # Example
+/// ```
+/// // s_{i+4} = s_i + s_{i+1}
+/// auto P = BitPolynomial<>::x_to_the(4) + BitPolynomial<>::ones(1);
+/// Lfsr lfsr{P, BitVector<>::from_string("1001").value()};
+/// assert_eq(lfsr.next_bits(15).to_string(), "100110101111000");
+/// assert_eq(lfsr.next_bits(15).to_string(), "100110101111000");
+/// ```
+template<Unsigned Word = usize>
+class Lfsr {
+public:
+    /// The underlying unsigned word type used to store the bits.
+    using word_type = Word;
+
+    /// The type of the characteristic polynomial.
+    using polynomial_type = BitPolynomial<Word>;
+
+    /// The type of the state & of the bit-vectors we return.
+    using vector_type = BitVector<Word>;
+
+    /// @name Constructors
+    /// @{
+
+    /// Constructs the generator for the characteristic polynomial `P(x)` seeded with `s_0 = 1` and the other state bits
+    /// zero. If `P(x)` is primitive then this seed gives the maximal length sequence with period `2^L - 1`.
+    ///
+    /// # Panics
+    /// This method panics if `P(x)` is a constant polynomial.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(3) + BitPolynomial<>::ones(1);
+    /// Lfsr lfsr{P};
+    /// assert_eq(lfsr.degree(), 3);
+    /// assert_eq(lfsr.state().to_string(), "100");
+    /// assert_eq(lfsr.next_bits(14).to_string(), "10010111001011");
+    /// ```
+    explicit Lfsr(polynomial_type const& P) : Lfsr{P, vector_type::unit(P.degree(), 0)} {}
+
+    /// Constructs the generator for the characteristic polynomial `P(x)` with the first `L` bits of the stream, the
+    /// seed `s_0, ..., s_{L-1}`, copied from any bit-store.
+    ///
+    /// # Panics
+    /// This method panics if `P(x)` is a constant polynomial or if the seed does not have `L = degree(P)` bits.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(3) + BitPolynomial<>::ones(1);
+    /// Lfsr lfsr{P, BitVector<>::from_string("011").value()};
+    /// assert_eq(lfsr.next_bits(7).to_string(), "0111001");
+    /// auto s = BitVector<>::random(200);
+    /// auto m = BitPolynomial<>::minimal_polynomial(s);
+    /// Lfsr regenerate{m, s.sub(0, m.degree())};
+    /// assert_eq(regenerate.next_bits(200), s);
+    /// ```
+    template<BitStore Store>
+        requires std::same_as<typename Store::word_type, Word>
+    Lfsr(polynomial_type const& P, Store const& seed) : m_poly{P} {
+        m_poly.make_monic();
+        auto L = m_poly.degree();
+        gf2_assert(L > 0, "The characteristic polynomial must have degree at least 1 -- not {}!", m_poly.to_string());
+        m_p = m_poly.coefficients().sub(0, L);
+        m_state.resize(L);
+        set_state(seed);
+
+        // Column j of the look-ahead: bit k of `cols[j]` is coefficient j of x^{L+k} mod P(x), starting at x^L = p(x).
+        std::pmr::vector<Word> cols(L, Word{0}, memory_resource());
+        auto                   r = m_p;
+        for (auto k = 0uz; k < BITS<Word>; ++k) {
+            for (auto j = r.first_set(); j; j = r.next_set(*j)) cols[*j] |= Word{1} << k;
+            times_x(r);
+        }
+
+        // The window is looked up a byte at a time & each table entry is the sum of the columns picked out by a byte.
+        auto n_bytes = (L + 7) / 8;
+        m_table.assign(n_bytes * 256, Word{0});
+        for (auto c = 0uz; c < n_bytes; ++c) {
+            auto table = m_table.data() + c * 256;
+            for (auto v = 1uz; v < 256; ++v) {
+                auto j = 8 * c + static_cast<usize>(std::countr_zero(v));
+                table[v] = table[v & (v - 1)] ^ (j < L ? cols[j] : Word{0});
+            }
+        }
+    }
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the degree `L` of the characteristic polynomial, which is the number of bits in the state.
+    constexpr usize degree() const { return m_state.size(); }
+
+    /// Returns a read-only reference to the (monic) characteristic polynomial `P(x)`.
+    constexpr polynomial_type const& characteristic_polynomial() const { return m_poly; }
+
+    /// Returns a read-only reference to the state: the next `L` bits of the stream.
+    constexpr vector_type const& state() const { return m_state; }
+
+    /// Sets the state, the next `L` bits of the stream, by copying them from any bit-store.
+    ///
+    /// # Panics
+    /// This method panics if the bit-store does not have `L` bits.
+    template<BitStore Store>
+        requires std::same_as<typename Store::word_type, Word>
+    constexpr void set_state(Store const& state) {
+        gf2_assert_eq(state.size(), degree(), "The state must have {} bits not {}!", degree(), state.size());
+        m_state.copy(state);
+    }
+
+    /// @}
+    /// @name Generating the Stream
+    /// @{
+
+    /// Returns the next bit of the stream.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(2) + BitPolynomial<>::ones(1);
+    /// Lfsr lfsr{P, BitVector<>::from_string("01").value()};
+    /// assert_eq(lfsr.next(), false);
+    /// assert_eq(lfsr.next(), true);
+    /// assert_eq(lfsr.next(), true);
+    /// assert_eq(lfsr.next(), false);
+    /// ```
+    constexpr bool next() {
+        auto L = degree();
+        bool result = m_state[0];
+        bool feedback = dot(m_p, m_state);
+        m_state <<= 1;
+        m_state.set(L - 1, feedback);
+        return result;
+    }
+
+    /// Returns the next `BITS<Word>` bits of the stream packed into a word where the earliest bit is the lowest one.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<u8>::x_to_the(4) + BitPolynomial<u8>::ones(1);
+    /// Lfsr lfsr{P, BitVector<u8>::from_string("1001").value()};
+    /// assert_eq(lfsr.next_word(), 0b0101'1001);
+    /// assert_eq(lfsr.next_word(), 0b1000'1111);
+    /// ```
+    constexpr Word next_word() {
+        constexpr auto W = BITS<Word>;
+        auto           L = degree();
+        auto           ahead = look_ahead();
+
+        // Short registers: the whole new state lies in the look-ahead.
+        if (L < W) {
+            auto result = static_cast<Word>(m_state.word(0) | (ahead << L));
+            m_state.set_word(0, static_cast<Word>(ahead >> (W - L)));
+            return result;
+        }
+
+        // Otherwise the state shifts down a word & the look-ahead fills in its last W bits.
+        auto result = m_state.word(0);
+        auto n_words = m_state.words();
+        for (auto i = 0uz; i + 1 < n_words; ++i) m_state.set_word(i, m_state.word(i + 1));
+        m_state.span(L - W, L).set_word(0, ahead);
+        return result;
+    }
+
+    /// Overwrites all the bits of a bit-store with the next bits of the stream.
+    ///
+    /// All but the last partial word of the store are written a word at a time using `next_word`.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<u8>::x_to_the(4) + BitPolynomial<u8>::ones(1);
+    /// Lfsr lfsr{P, BitVector<u8>::from_string("1001").value()};
+    /// auto v = BitVector<u8>::zeros(40);
+    /// auto s = v.span(3, 33);
+    /// lfsr.fill(s);
+    /// assert_eq(v.to_string(), "0001001101011110001001101011110000000000");
+    /// ```
+    template<BitStore Store>
+        requires std::same_as<typename Store::word_type, Word>
+    constexpr void fill(Store& dst) {
+        auto n = dst.size();
+        auto n_full = n / BITS<Word>;
+        for (auto i = 0uz; i < n_full; ++i) dst.set_word(i, next_word());
+        for (auto i = n_full * BITS<Word>; i < n; ++i) dst.set(i, next());
+    }
+
+    /// Returns a bit-vector holding the next `n` bits of the stream.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::ones(1);
+    /// Lfsr lfsr{P};
+    /// assert_eq(lfsr.next_bits(100), BitVector<>::ones(100));
+    /// ```
+    vector_type next_bits(usize n) {
+        auto result = vector_type::zeros(n);
+        fill(result);
+        return result;
+    }
+
+    /// @}
+    /// @name Jumping Ahead
+    /// @{
+
+    /// Skips over the next `e` bits of the stream where `e = n` or `e = 2^n` depending on the `n_is_log2` argument.
+    ///
+    /// The new state is `s_{i+e}, ..., s_{i+e+L-1}` where `s_{i+e+j}` is the dot product of the old state with the
+    /// coefficients of `x^{e+j} mod P(x)`. Each jump reduces `x^e` modulo `P(x)` with a `ModContext` that is built on
+    /// the first jump & reused after that, so even astronomically large jumps cost `O(L^2)` bit operations.
+    ///
+    /// # Example
+    /// ```
+    /// auto P = BitPolynomial<>::x_to_the(31) + BitPolynomial<>::x_to_the(3) + BitPolynomial<>::one();
+    /// Lfsr a{P};
+    /// Lfsr b{P};
+    /// a.next_bits(12'345);
+    /// b.jump(12'345);
+    /// assert_eq(a.state(), b.state());
+    /// assert_eq(a.next_bits(100), b.next_bits(100));
+    /// Lfsr c{P};
+    /// Lfsr d{P};
+    /// c.jump(20, true);
+    /// d.jump(1'048'576);
+    /// assert_eq(c.state(), d.state());
+    /// ```
+    void jump(usize n, bool n_is_log2 = false) {
+        if (!m_ctx) m_ctx.emplace(m_poly);
+        auto r = m_ctx->reduce_x_to_the(n, n_is_log2).coefficients();
+        auto L = degree();
+        r.resize(L);
+
+        auto state = vector_type::zeros(L);
+        for (auto j = 0uz; j < L; ++j) {
+            if (dot(r, m_state)) state.set(j);
+            times_x(r);
+        }
+        m_state = std::move(state);
+    }
+
+    /// @}
+
+private:
+    polynomial_type                 m_poly;                          // The monic characteristic polynomial P(x).
+    vector_type                     m_p;                             // The low coefficients: P(x) = x^L + p(x).
+    vector_type                     m_state;                         // The next L bits of the stream.
+    std::pmr::vector<Word>          m_table{memory_resource()};      // The look-ahead words for each byte value.
+    std::optional<ModContext<Word>> m_ctx;                           // Reduces x^e mod P(x) for jumps.
+
+    // Performs: r(x) <- x r(x) mod P(x) where r(x) has degree less than L & is stored in L bits.
+    constexpr void times_x(vector_type& r) const {
+        bool carry = r[degree() - 1];
+        r >>= 1;
+        if (carry) r ^= m_p;
+    }
+
+    // Returns the W bits of the stream that follow the state, one table lookup per byte of the state.
+    constexpr Word look_ahead() const {
+        Word result = 0;
+        auto table = m_table.data();
+        auto n_bytes = m_table.size() / 256;
+        auto c = 0uz;
+        for (auto i = 0uz; i < m_state.words(); ++i) {
+            auto word = m_state.word(i);
+            for (auto b = 0uz; b < sizeof(Word) && c < n_bytes; ++b, ++c, table += 256)
+                result ^= table[static_cast<usize>((word >> (8 * b)) & 0xFF)];
+        }
+        return result;
+    }
+};
+
+} // namespace gf2
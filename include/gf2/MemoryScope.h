@@ -0,0 +1,90 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Per-thread `std::pmr::memory_resource` selection for the heap allocations made by the library. <br>
+/// See the [MemoryScope](docs/pages/MemoryScope.md) page for more details.
+
+#include <memory_resource>
+
+namespace gf2 {
+
+namespace details {
+
+// The resource installed by the innermost live `gf2::MemoryScope` on this thread (null if there isn't one).
+inline std::pmr::memory_resource*&
+scoped_memory_resource() noexcept {
+    static thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+} // namespace details
+
+/// Returns the memory resource that new bit-vectors, bit-matrices and bit-polynomials on this thread allocate from.
+///
+/// That is the resource of the innermost live `gf2::MemoryScope` on the calling thread if there is one, and otherwise
+/// whatever `std::pmr::get_default_resource()` returns (normally the global heap).
+///
+/// # Example
+/// ```
+/// assert(memory_resource() == std::pmr::get_default_resource());
+/// ```
+inline std::pmr::memory_resource*
+memory_resource() noexcept {
+    auto resource = details::scoped_memory_resource();
+    return resource != nullptr ? resource : std::pmr::get_default_resource();
+}
+
+/// An RAII guard that routes the allocations made by the library on the current thread to a given memory resource.
+///
+/// While a scope is alive, every `gf2::BitVector`, `gf2::BitMatrix`, and `gf2::BitPolynomial` created on this thread
+/// (including all the temporaries inside methods like `BitMatrix::to_the`, `BitPolynomial::reduce_x_to_the`, or the
+/// linear solvers) gets its words from `resource` instead of the global heap. The scope restores the previous resource
+/// when it is destroyed, so scopes nest.
+///
+/// Objects keep the resource they were created with for their whole life. Copying an object allocates from whatever
+/// resource is current where the copy is made, while assigning to an object keeps the resource of that object. So to
+/// keep a result that was computed inside a scope after its resource has gone, assign it to an object created outside
+/// the scope or copy it once the scope has ended.
+///
+/// # Note
+/// The setting is per thread. Work handed to a `gf2::ThreadPool` runs on the pool threads, which allocate from their
+/// own current resource, so a resource that is not thread-safe (like `std::pmr::monotonic_buffer_resource`) is never
+/// shared between threads by accident.
+///
+/// # Example
+/// ```
+/// std::pmr::monotonic_buffer_resource arena;
+/// BitVector<> kept;
+/// {
+///     MemoryScope scope{&arena};
+///     assert(memory_resource() == &arena);
+///     auto v = BitVector<>::ones(1000);
+///     assert(v.get_allocator().resource() == &arena);
+///     kept = v;
+/// }
+/// assert(memory_resource() == std::pmr::get_default_resource());
+/// assert(kept.get_allocator().resource() == std::pmr::get_default_resource());
+/// assert_eq(kept.count_ones(), 1000);
+/// ```
+class MemoryScope {
+public:
+    /// Makes `resource` the current resource of the calling thread until this scope is destroyed.
+    explicit MemoryScope(std::pmr::memory_resource* resource) noexcept :
+        m_previous(details::scoped_memory_resource()) {
+        details::scoped_memory_resource() = resource;
+    }
+
+    /// Restores the resource that was current when this scope was created.
+    ~MemoryScope() { details::scoped_memory_resource() = m_previous; }
+
+    // A scope is tied to the stack frame that created it.
+    MemoryScope(MemoryScope const&) = delete;
+    MemoryScope& operator=(MemoryScope const&) = delete;
+
+private:
+    std::pmr::memory_resource* m_previous;
+};
+
+} // namespace gf2
@@ -1,22 +1,71 @@
 #pragma once
-// Internal file for the gf2 library.
-//
 // SPDX-FileCopyrightText: 2025 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
 // SPDX-License-Identifier: MIT
 
+/// @file
+/// The random number engines used to fill bit-vectors & bit-matrices and the `RandomEngine` concept they satisfy. <br>
+/// See the [RNG](docs/pages/RNG.md) page for more details.
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <random>
 
+namespace gf2 {
+
+/// The `RandomEngine` concept is satisfied by any uniform random bit generator that returns full 64-bit words.
+///
+/// That includes the engines in this file and standard ones like `std::mt19937_64`. An engine can also have a bulk
+/// `fill(std::uint64_t* dst, std::size_t n)` method which the library then uses to draw lots of words in one go.
+///
+/// # Example
+/// ```
+/// static_assert(RandomEngine<Xoshiro256pp>);
+/// static_assert(RandomEngine<Philox4x32>);
+/// static_assert(RandomEngine<std::mt19937_64>);
+/// static_assert(!RandomEngine<std::mt19937>);
+/// ```
+template<typename Engine>
+concept RandomEngine =
+    std::uniform_random_bit_generator<Engine> && std::same_as<typename Engine::result_type, std::uint64_t> &&
+    Engine::min() == 0 && Engine::max() == std::numeric_limits<std::uint64_t>::max();
+
+} // namespace gf2
+
 namespace gf2::details {
 
+// Returns a seed drawn from the computer's entropy (some std::random_device implementations return 32-bit values).
+inline std::uint64_t
+entropy_seed() {
+    std::random_device rd;
+    if constexpr (sizeof(std::uint64_t) <= sizeof(std::random_device::result_type)) {
+        return static_cast<std::uint64_t>(rd());
+    } else {
+        return static_cast<std::uint64_t>(rd()) << 32 | rd();
+    }
+}
+
 // A trivial `SplitMix64` random number generator for internal use in the `gf2` library.
+// It is also used to expand a single 64-bit seed into the bigger states of the other engines.
 class SplitMix64 {
 public:
+    using result_type = std::uint64_t;
+
     // Constructs a new `SplitMix64` random number generator seeded from a random device.
     SplitMix64() { seed_from_entropy(); }
 
     // Constructs a new `SplitMix64` random number generator with the given seed.
-    SplitMix64(std::uint64_t seed) : m_state(seed) {}
+    constexpr SplitMix64(std::uint64_t seed) : m_state(seed) {}
+
+    // The range of the outputs.
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    // Returns the next random 64-bit unsigned integer.
+    constexpr std::uint64_t operator()() { return next(); }
 
     // Returns the next random 64-bit unsigned integer.
     constexpr std::uint64_t u64() { return next(); }
@@ -30,6 +79,9 @@ public:
         return z;
     }
 
+    // Skips over the next `n` outputs (the state is just a counter).
+    constexpr void discard(std::uint64_t n) { m_state += n * 0x9e3779b97f4a7c15; }
+
     // Sets the seed to the given value.
     constexpr void set_seed(std::uint64_t new_seed) { m_state = new_seed; }
 
@@ -37,15 +89,7 @@ public:
     constexpr std::uint64_t seed() const { return m_state; }
 
     // Sets the state from a random device.
-    void seed_from_entropy() {
-        // Some std::random_device implementations will return a 32-bit unsigned integer.
-        std::random_device rd;
-        if constexpr (sizeof(std::uint64_t) <= sizeof(std::random_device::result_type)) {
-            m_state = static_cast<std::uint64_t>(rd());
-        } else {
-            m_state = static_cast<std::uint64_t>(rd()) << 32 | rd();
-        }
-    }
+    void seed_from_entropy() { m_state = entropy_seed(); }
 
 private:
     std::uint64_t m_state;
@@ -55,8 +99,225 @@ private:
 
 namespace gf2 {
 
-// The default random number generator type used in the `gf2` library for generating random bit-vectors & matrices.
-// We generally just use `RNG` in code as a type alias for whichever RNG we are actually using.
-using RNG = gf2::details::SplitMix64;
+/// The `xoshiro256++` engine of Blackman & Vigna: fast, small, and good enough for any simulation work.
+///
+/// The 256-bit state is expanded from a 64-bit seed with `SplitMix64`. The `jump()` method advances the engine by
+/// `2^128` steps, so calling it `k` times on copies of one engine gives `k` streams that never overlap in practice.
+/// The `stream(seed, k)` factory does just that.
+///
+/// # Example
+/// ```
+/// Xoshiro256pp a{42}, b{42};
+/// assert_eq(a(), b());
+/// auto s0 = Xoshiro256pp::stream(42, 0);
+/// auto s1 = Xoshiro256pp::stream(42, 1);
+/// assert(s0() != s1());
+/// std::array<u64, 4> words;
+/// Xoshiro256pp c{7}, d{7};
+/// c.fill(words.data(), words.size());
+/// for (auto w : words) assert_eq(w, d());
+/// ```
+class Xoshiro256pp {
+public:
+    /// The type of the outputs.
+    using result_type = std::uint64_t;
+
+    /// Constructs an engine seeded from the computer's entropy.
+    Xoshiro256pp() : Xoshiro256pp(details::entropy_seed()) {}
+
+    /// Constructs an engine with a state that is expanded from the given seed.
+    explicit constexpr Xoshiro256pp(std::uint64_t seed) {
+        details::SplitMix64 sm{seed};
+        for (auto& s : m_state) s = sm();
+    }
+
+    /// Returns an engine for the `k`'th independent stream from a seed, i.e. the seeded engine jumped `k` times.
+    static constexpr Xoshiro256pp stream(std::uint64_t seed, std::uint64_t k) {
+        Xoshiro256pp result{seed};
+        for (auto i = 0uz; i < k; ++i) result.jump();
+        return result;
+    }
+
+    /// The smallest possible output.
+    static constexpr result_type min() { return 0; }
+
+    /// The largest possible output.
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
 
-} // namespace gf2
\ No newline at end of file
+    /// Returns the next random 64-bit word.
+    constexpr result_type operator()() {
+        auto result = std::rotl(m_state[0] + m_state[3], 23) + m_state[0];
+        auto t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = std::rotl(m_state[3], 45);
+        return result;
+    }
+
+    /// Fills `dst[0], ..., dst[n-1]` with the next `n` random words.
+    constexpr void fill(std::uint64_t* dst, std::size_t n) {
+        // Work on local copies of the state so the compiler can keep it all in registers.
+        auto [s0, s1, s2, s3] = m_state;
+        for (auto i = 0uz; i < n; ++i) {
+            dst[i] = std::rotl(s0 + s3, 23) + s0;
+            auto t = s1 << 17;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = std::rotl(s3, 45);
+        }
+        m_state = {s0, s1, s2, s3};
+    }
+
+    /// Skips over the next `n` outputs.
+    constexpr void discard(std::uint64_t n) {
+        for (auto i = 0uz; i < n; ++i) (*this)();
+    }
+
+    /// Advances the engine by `2^128` steps.
+    constexpr void jump() { jump_by({0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c}); }
+
+    /// Advances the engine by `2^192` steps.
+    constexpr void long_jump() {
+        jump_by({0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635});
+    }
+
+    /// Equality means the two engines will produce the same outputs from here on.
+    constexpr bool operator==(Xoshiro256pp const&) const = default;
+
+private:
+    std::array<std::uint64_t, 4> m_state;
+
+    // The state update is linear over GF(2), so a jump applies the polynomial x^N mod c(x) (c is the characteristic
+    // polynomial of the update) to the state. The coefficients of that polynomial are the bits of `poly`.
+    constexpr void jump_by(std::array<std::uint64_t, 4> const& poly) {
+        std::array<std::uint64_t, 4> acc{};
+        for (auto word : poly) {
+            for (auto b = 0; b < 64; ++b) {
+                if ((word >> b) & 1)
+                    for (auto i = 0uz; i < 4; ++i) acc[i] ^= m_state[i];
+                (*this)();
+            }
+        }
+        m_state = acc;
+    }
+};
+
+/// The counter-based `Philox4x32-10` engine of Salmon et al.
+///
+/// Output `i` of the stream is a fixed function of the counter `i` and a key, so the engine can jump to any position
+/// in its stream in constant time with `discard`, and engines with different `stream` ids never share outputs.
+/// That is what you want for parallel work: give chunk `k` of a job the engine `Philox4x32{seed, k}` and the result
+/// does not depend on how many threads ran the chunks.
+///
+/// # Example
+/// ```
+/// Philox4x32 a{42}, b{42};
+/// assert_eq(a(), b());
+/// b.discard(1000);
+/// for (auto i = 0; i < 1000; ++i) a();
+/// assert_eq(a(), b());
+/// Philox4x32 s0{42, 0}, s1{42, 1};
+/// assert(s0() != s1());
+/// ```
+class Philox4x32 {
+public:
+    /// The type of the outputs.
+    using result_type = std::uint64_t;
+
+    /// Constructs an engine seeded from the computer's entropy.
+    Philox4x32() : Philox4x32(details::entropy_seed()) {}
+
+    /// Constructs an engine for the given seed (the key) and stream id.
+    explicit constexpr Philox4x32(std::uint64_t seed, std::uint64_t stream = 0) : m_key{seed}, m_stream{stream} {}
+
+    /// The smallest possible output.
+    static constexpr result_type min() { return 0; }
+
+    /// The largest possible output.
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /// Returns the next random 64-bit word.
+    constexpr result_type operator()() {
+        auto block = m_position >> 1;
+        if (!m_cached || block != m_cached_block) {
+            m_cache = generate(block);
+            m_cached_block = block;
+            m_cached = true;
+        }
+        return m_cache[m_position++ & 1];
+    }
+
+    /// Fills `dst[0], ..., dst[n-1]` with the next `n` random words.
+    ///
+    /// The counter blocks are independent of each other so this loop is easy for the compiler to vectorize.
+    constexpr void fill(std::uint64_t* dst, std::size_t n) {
+        auto i = 0uz;
+        while (i < n && (m_position & 1)) dst[i++] = (*this)();
+        for (; i + 1 < n; i += 2, m_position += 2) {
+            auto words = generate(m_position >> 1);
+            dst[i] = words[0];
+            dst[i + 1] = words[1];
+        }
+        if (i < n) dst[i] = (*this)();
+    }
+
+    /// Skips over the next `n` outputs in constant time.
+    constexpr void discard(std::uint64_t n) { m_position += n; }
+
+    /// Equality means the two engines will produce the same outputs from here on.
+    constexpr bool operator==(Philox4x32 const& rhs) const {
+        return m_key == rhs.m_key && m_stream == rhs.m_stream && m_position == rhs.m_position;
+    }
+
+private:
+    std::uint64_t                m_key;
+    std::uint64_t                m_stream;
+    std::uint64_t                m_position = 0;
+    std::uint64_t                m_cached_block = 0;
+    bool                         m_cached = false;
+    std::array<std::uint64_t, 2> m_cache{};
+
+    // Returns the two 64-bit output words for the 128-bit counter (block, stream).
+    constexpr std::array<std::uint64_t, 2> generate(std::uint64_t block) const {
+        auto c0 = static_cast<std::uint32_t>(block), c1 = static_cast<std::uint32_t>(block >> 32);
+        auto c2 = static_cast<std::uint32_t>(m_stream), c3 = static_cast<std::uint32_t>(m_stream >> 32);
+        auto k0 = static_cast<std::uint32_t>(m_key), k1 = static_cast<std::uint32_t>(m_key >> 32);
+        for (auto round = 0; round < 10; ++round) {
+            auto p0 = std::uint64_t{0xD2511F53} * c0;
+            auto p1 = std::uint64_t{0xCD9E8D57} * c2;
+            c0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            c1 = static_cast<std::uint32_t>(p1);
+            c2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c3 = static_cast<std::uint32_t>(p0);
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        return {std::uint64_t{c1} << 32 | c0, std::uint64_t{c3} << 32 | c2};
+    }
+};
+
+/// The default random number engine type used in the `gf2` library for generating random bit-vectors & matrices.
+using RNG = Xoshiro256pp;
+
+} // namespace gf2
+
+namespace gf2::details {
+
+// Fills `dst[0], ..., dst[n-1]` with random words using the engine's bulk `fill` method if it has one.
+template<RandomEngine Engine>
+constexpr void
+fill_words(Engine& rng, std::uint64_t* dst, std::size_t n) {
+    if constexpr (requires { rng.fill(dst, n); }) {
+        rng.fill(dst, n);
+    } else {
+        for (auto i = 0uz; i < n; ++i) dst[i] = rng();
+    }
+}
+
+} // namespace gf2::details
@@ -0,0 +1,465 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Vectorized kernels for the bulk operations on contiguous runs of words behind the bit-store functions. <br>
+/// See the [BitStore](docs/pages/BitStore.md) page for more details.
+///
+/// The kernel set is picked at compile time from the instruction sets the compiler targets (AVX-512, AVX2 or NEON)
+/// with a portable word-at-a-time fallback. Define `GF2_NO_SIMD` to always use that fallback.
+///
+/// # Example
+/// Each kernel must agree with the obvious word-at-a-time loop whatever the word type and however the words split into
+/// whole vector lanes and leftovers.
+/// ```
+/// using namespace gf2::details;
+/// auto check = [&](auto zero) {
+///     using Word = decltype(zero);
+///     SplitMix64 rng{42};
+///     for (auto n = 0uz; n < 200; n += 7) {
+///         std::vector<Word> a(n), b(n), c;
+///         for (auto& w : a) w = static_cast<Word>(rng());
+///         for (auto& w : b) w = static_cast<Word>(rng());
+///
+///         auto ones = 0uz, diff = 0uz;
+///         auto parity = false;
+///         for (auto i = 0uz; i < n; ++i) {
+///             ones += static_cast<usize>(std::popcount(a[i]));
+///             diff += static_cast<usize>(std::popcount(static_cast<Word>(a[i] ^ b[i])));
+///             parity ^= std::popcount(static_cast<Word>(a[i] & b[i])) % 2 == 1;
+///         }
+///         assert_eq(simd::count_ones(a.data(), n), ones);
+///         assert_eq(simd::xor_count_ones(a.data(), b.data(), n), diff);
+///         assert(simd::xor_count_ones(a.data(), b.data(), n, diff / 2) > diff / 2 || diff == 0);
+///         assert_eq(simd::and_parity(a.data(), b.data(), n), parity);
+///         assert(simd::equal(a.data(), a.data(), n));
+///         if (n > 0) assert(!simd::equal(a.data(), b.data(), n) || a == b);
+///
+///         c = a;
+///         simd::xor_into(c.data(), b.data(), n);
+///         for (auto i = 0uz; i < n; ++i) assert_eq(c[i], static_cast<Word>(a[i] ^ b[i]));
+///         c = a;
+///         simd::and_into(c.data(), b.data(), n);
+///         for (auto i = 0uz; i < n; ++i) assert_eq(c[i], static_cast<Word>(a[i] & b[i]));
+///         c = a;
+///         simd::or_into(c.data(), b.data(), n);
+///         for (auto i = 0uz; i < n; ++i) assert_eq(c[i], static_cast<Word>(a[i] | b[i]));
+///         c = a;
+///         simd::flip_all(c.data(), n);
+///         for (auto i = 0uz; i < n; ++i) assert_eq(c[i], static_cast<Word>(~a[i]));
+///         simd::set_all(c.data(), n, true);
+///         for (auto i = 0uz; i < n; ++i) assert_eq(c[i], MAX<Word>);
+///
+///         // A single set word anywhere in a run of zeros.
+///         simd::set_all(c.data(), n, false);
+///         assert_eq(simd::first_non_zero(c.data(), n), n);
+///         assert_eq(simd::last_non_zero(c.data(), n), n);
+///         for (auto i = 0uz; i < n; ++i) {
+///             c[i] = 1;
+///             assert_eq(simd::first_non_zero(c.data(), n), i);
+///             assert_eq(simd::last_non_zero(c.data(), n), i);
+///             c[i] = 0;
+///         }
+///     }
+/// };
+/// check(u8{0});
+/// check(u16{0});
+/// check(u32{0});
+/// check(u64{0});
+/// ```
+///
+/// # Example
+/// ```
+/// using namespace gf2::details;
+/// SplitMix64 rng{7};
+/// for (auto n = 0uz; n <= 64; ++n) {
+///     std::string s(n, '0');
+///     u64 expected = 0;
+///     for (auto i = 0uz; i < n; ++i)
+///         if (rng() % 2 == 1) {
+///             s[i] = '1';
+///             expected |= u64{1} << i;
+///         }
+///     u64 bits;
+///     assert(simd::pack_binary_chars(s.data(), n, bits));
+///     assert_eq(bits, expected);
+///     if (n > 0) {
+///         s[rng() % n] = '2';
+///         assert(!simd::pack_binary_chars(s.data(), n, bits));
+///     }
+/// }
+/// ```
+
+#include <gf2/Unsigned.h>
+#include <gf2/instrument.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#if !defined(GF2_NO_SIMD)
+    #if defined(__AVX512F__) || defined(__AVX2__)
+        #include <immintrin.h>
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #include <arm_neon.h>
+    #elif defined(__SSE2__)
+        #include <emmintrin.h>
+    #endif
+#endif
+
+namespace gf2::details::simd {
+
+// The name of the kernel set that this translation unit was compiled with.
+#if defined(GF2_NO_SIMD)
+inline constexpr char const* name = "portable";
+#elif defined(__AVX512F__)
+inline constexpr char const* name = "avx512";
+#elif defined(__AVX2__)
+inline constexpr char const* name = "avx2";
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+inline constexpr char const* name = "neon";
+#else
+inline constexpr char const* name = "portable";
+#endif
+
+// The number of bytes the kernels handle per step (the portable versions just do one word at a time).
+#if defined(GF2_NO_SIMD)
+inline constexpr usize lane_bytes = 0;
+#elif defined(__AVX512F__)
+inline constexpr usize lane_bytes = 64;
+#elif defined(__AVX2__)
+inline constexpr usize lane_bytes = 32;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+inline constexpr usize lane_bytes = 16;
+#else
+inline constexpr usize lane_bytes = 0;
+#endif
+
+// Returns the number of whole vector lanes in `n` words & the number of words those lanes cover.
+template<Unsigned Word>
+constexpr std::pair<usize, usize>
+lanes(usize n) {
+    if constexpr (lane_bytes == 0) {
+        return {0, 0};
+    } else {
+        constexpr auto per_lane = lane_bytes / sizeof(Word);
+        auto           n_lanes = n / per_lane;
+        return {n_lanes, n_lanes * per_lane};
+    }
+}
+
+// The vector type, loads/stores and the bitwise operations used below.
+#if !defined(GF2_NO_SIMD) && defined(__AVX512F__)
+using vec = __m512i;
+inline vec   load(void const* p) { return _mm512_loadu_si512(p); }
+inline void  store(void* p, vec v) { _mm512_storeu_si512(p, v); }
+inline vec   vxor(vec a, vec b) { return _mm512_xor_si512(a, b); }
+inline vec   vand(vec a, vec b) { return _mm512_and_si512(a, b); }
+inline vec   vor(vec a, vec b) { return _mm512_or_si512(a, b); }
+inline vec   vones() { return _mm512_set1_epi64(-1); }
+inline bool  is_zero(vec v) { return _mm512_test_epi64_mask(v, v) == 0; }
+inline usize popcount(vec v) {
+    alignas(64) u64 w[8];
+    usize count = 0;
+    #if defined(__AVX512VPOPCNTDQ__)
+    _mm512_store_si512(w, _mm512_popcnt_epi64(v));
+    for (auto x : w) count += x;
+    #else
+    _mm512_store_si512(w, v);
+    for (auto x : w) count += static_cast<usize>(std::popcount(x));
+    #endif
+    return count;
+}
+#elif !defined(GF2_NO_SIMD) && defined(__AVX2__)
+using vec = __m256i;
+inline vec  load(void const* p) { return _mm256_loadu_si256(static_cast<__m256i const*>(p)); }
+inline void store(void* p, vec v) { _mm256_storeu_si256(static_cast<__m256i*>(p), v); }
+inline vec  vxor(vec a, vec b) { return _mm256_xor_si256(a, b); }
+inline vec  vand(vec a, vec b) { return _mm256_and_si256(a, b); }
+inline vec  vor(vec a, vec b) { return _mm256_or_si256(a, b); }
+inline vec  vones() { return _mm256_set1_epi64x(-1); }
+inline bool is_zero(vec v) { return _mm256_testz_si256(v, v) != 0; }
+
+// Counts the set bits with the nibble lookup table method of Muła, Kurz & Lemire.
+inline vec popcount_bytes(vec v) {
+    auto const table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2,
+                                        2, 3, 2, 3, 3, 4);
+    auto const low = _mm256_set1_epi8(0x0f);
+    auto       lo = _mm256_and_si256(v, low);
+    auto       hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(table, lo), _mm256_shuffle_epi8(table, hi));
+}
+inline usize popcount(vec v) {
+    auto sums = _mm256_sad_epu8(popcount_bytes(v), _mm256_setzero_si256());
+    return static_cast<usize>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+                              _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+}
+#elif !defined(GF2_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+using vec = uint8x16_t;
+inline vec   load(void const* p) { return vld1q_u8(static_cast<u8 const*>(p)); }
+inline void  store(void* p, vec v) { vst1q_u8(static_cast<u8*>(p), v); }
+inline vec   vxor(vec a, vec b) { return veorq_u8(a, b); }
+inline vec   vand(vec a, vec b) { return vandq_u8(a, b); }
+inline vec   vor(vec a, vec b) { return vorrq_u8(a, b); }
+inline vec   vones() { return vdupq_n_u8(0xff); }
+inline bool  is_zero(vec v) { return vmaxvq_u8(v) == 0; }
+inline usize popcount(vec v) { return static_cast<usize>(vaddvq_u8(vcntq_u8(v))); }
+#else
+// The portable build never uses these (its `lane_bytes` is zero) but the kernels below still need them to compile.
+using vec = u64;
+inline vec   load(void const* p) {
+    vec v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+inline void  store(void* p, vec v) { std::memcpy(p, &v, sizeof(v)); }
+inline vec   vxor(vec a, vec b) { return a ^ b; }
+inline vec   vand(vec a, vec b) { return a & b; }
+inline vec   vor(vec a, vec b) { return a | b; }
+inline vec   vones() { return ~vec{0}; }
+inline bool  is_zero(vec v) { return v == 0; }
+inline usize popcount(vec v) { return static_cast<usize>(std::popcount(v)); }
+#endif
+
+// Returns the number of set bits in the `n` words starting at `p`.
+template<Unsigned Word>
+inline usize
+count_ones(Word const* p, usize n) {
+    gf2_count_words(n, n * sizeof(Word));
+    usize count = 0;
+    auto [n_lanes, done] = lanes<Word>(n);
+    if constexpr (lane_bytes > 0) {
+        auto bytes = reinterpret_cast<u8 const*>(p);
+#if !defined(GF2_NO_SIMD) && !defined(__AVX512VPOPCNTDQ__) && !defined(__AVX512F__) && defined(__AVX2__)
+        // With AVX2 we sum the byte counts of up to 31 lanes before doing the horizontal sum (31 * 8 < 256).
+        for (auto l = 0uz; l < n_lanes;) {
+            auto acc = _mm256_setzero_si256();
+            for (auto end = std::min(n_lanes, l + 31); l < end; ++l)
+                acc = _mm256_add_epi8(acc, popcount_bytes(load(bytes + l * lane_bytes)));
+            auto sums = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+            count += static_cast<usize>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+                                        _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+        }
+#else
+        for (auto l = 0uz; l < n_lanes; ++l) count += popcount(load(bytes + l * lane_bytes));
+#endif
+    }
+    for (auto i = done; i < n; ++i) count += static_cast<usize>(std::popcount(p[i]));
+    return count;
+}
+
+// Returns the number of set bits in `a[i] ^ b[i]` over the `n` words starting at `a` & `b`.
+// The count is checked against `limit` after each block of lanes & we stop early with some count above `limit` once it
+// is passed, so the result is exact if and only if it is at most `limit`.
+template<Unsigned Word>
+inline usize
+xor_count_ones(Word const* a, Word const* b, usize n, usize limit = std::numeric_limits<usize>::max()) {
+    gf2_count_words(n, 2 * n * sizeof(Word));
+    usize count = 0;
+    auto [n_lanes, done] = lanes<Word>(n);
+    if constexpr (lane_bytes > 0) {
+        auto x = reinterpret_cast<u8 const*>(a);
+        auto y = reinterpret_cast<u8 const*>(b);
+        for (auto l = 0uz; l < n_lanes && count <= limit;) {
+#if !defined(GF2_NO_SIMD) && !defined(__AVX512VPOPCNTDQ__) && !defined(__AVX512F__) && defined(__AVX2__)
+            // As in `count_ones` we sum the byte counts of up to 31 lanes before doing the horizontal sum.
+            auto acc = _mm256_setzero_si256();
+            for (auto end = std::min(n_lanes, l + 31); l < end; ++l)
+                acc = _mm256_add_epi8(acc, popcount_bytes(vxor(load(x + l * lane_bytes), load(y + l * lane_bytes))));
+            auto sums = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+            count += static_cast<usize>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+                                        _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+#else
+            for (auto end = std::min(n_lanes, l + 8); l < end; ++l)
+                count += popcount(vxor(load(x + l * lane_bytes), load(y + l * lane_bytes)));
+#endif
+        }
+    }
+    for (auto i = done; i < n && count <= limit; ++i)
+        count += static_cast<usize>(std::popcount(static_cast<Word>(a[i] ^ b[i])));
+    return count;
+}
+
+// Performs `dst[i] ^= src[i]` for the `n` words starting at `dst` & `src`.
+template<Unsigned Word>
+inline void
+xor_into(Word* dst, Word const* src, usize n) {
+    gf2_count_words(n, 3 * n * sizeof(Word));
+    auto [n_lanes, done] = lanes<Word>(n);
+    if constexpr (lane_bytes > 0) {
+        auto d = reinterpret_cast<u8*>(dst);
+        auto s = reinterpret_cast<u8 const*>(src);
+        for (auto l = 0uz; l < n_lanes; ++l)
+            store(d + l * lane_bytes, vxor(load(d + l * lane_bytes), load(s + l * lane_bytes)));
+    }
+    for (auto i = done; i < n; ++i) dst[i] ^= src[i];
+}
+
+// Performs `dst[i] &= src[i]` for the `n` words starting at `dst` & `src`.
+template<Unsigned Word>
+inline void
+and_into(Word* dst, Word const* src, usize n) {
+    gf2_count_words(n, 3 * n * sizeof(Word));
+    auto [n_lanes, done] = lanes<Word>(n);
+    if constexpr (lane_bytes > 0) {
+        auto d = reinterpret_cast<u8*>(dst);
+        auto s = reinterpret_cast<u8 const*>(src);
+        for (auto l = 0uz; l < n_lanes; ++l)
+            store(d + l * lane_bytes, vand(load(d + l * lane_bytes), load(s + l * lane_bytes)));
+    }
+    for (auto i = done; i < n; ++i) dst[i] &= src[i];
+}
+
+// Performs `dst[i] |= src[i]` for the `n` words starting at `dst` & `src`.
+template<Unsigned Word>
+inline void
+or_into(Word* dst, Word const* src, usize n) {
+    gf2_count_words(n, 3 * n * sizeof(Word));
+    auto [n_lanes, done] = lanes<Word>(n);
+    if constexpr (lane_bytes > 0) {
+        auto d = reinterpret_cast<u8*>(dst);
+        auto s = reinterpret_cast<u8 const*>(src);
+        for (auto l = 0uz; l < n_lanes; ++l)
+            store(d + l * lane_bytes, vor(load(d + l * lane_bytes), load(s + l * lane_bytes)));
+    }
+    for (auto i = done; i < n; ++i) dst[i] |= src[i];
+}
+
+// Sets the `n` words starting at `dst` to all zeros or all ones.
+template<Unsigned Word>
+inline void
+set_all(Word* dst, usize n, bool value) {
+    gf2_count_words(n, n * sizeof(Word));
+    std::memset(dst, value ? 0xff : 0x00, n * sizeof(Word));
+}
+
+// Flips all the bits in the `n` words starting at `dst`.
+template<Unsigned Word>
+inline void
+flip_all(Word* dst, usize n) {
+    gf2_count_words(n, 2 * n * sizeof(Word));
+    auto [n_lanes, done] = lanes<Word>(n);
+    if constexpr (lane_bytes > 0) {
+        auto d = reinterpret_cast<u8*>(dst);
+        for (auto l = 0uz; l < n_lanes; ++l) store(d + l * lane_bytes, vxor(load(d + l * lane_bytes), vones()));
+    }
+    for (auto i = done; i < n; ++i) dst[i] = static_cast<Word>(~dst[i]);
+}
+
+// Returns the parity of the number of set bits in `a[i] & b[i]` over the `n` words starting at `a` & `b`.
+template<Unsigned Word>
+inline bool
+and_parity(Word const* a, Word const* b, usize n) {
+    gf2_count_words(n, 2 * n * sizeof(Word));
+    auto sum = Word{0};
+    auto [n_lanes, done] = lanes<Word>(n);
+    if constexpr (lane_bytes > 0) {
+        // XOR all the lanes together and fold the result down to a single word at the end.
+        auto x = reinterpret_cast<u8 const*>(a);
+        auto y = reinterpret_cast<u8 const*>(b);
+        auto acc = vxor(vones(), vones());
+        for (auto l = 0uz; l < n_lanes; ++l)
+            acc = vxor(acc, vand(load(x + l * lane_bytes), load(y + l * lane_bytes)));
+        alignas(64) Word folded[lane_bytes / sizeof(Word)];
+        store(folded, acc);
+        for (auto w : folded) sum ^= w;
+    }
+    for (auto i = done; i < n; ++i) sum ^= static_cast<Word>(a[i] & b[i]);
+    return std::popcount(sum) % 2 == 1;
+}
+
+// Returns `true` if the `n` words starting at `a` & `b` are all equal.
+template<Unsigned Word>
+inline bool
+equal(Word const* a, Word const* b, usize n) {
+    return std::memcmp(a, b, n * sizeof(Word)) == 0;
+}
+
+// Returns the index of the first non-zero word among the `n` words starting at `p` (or `n` if they are all zero).
+template<Unsigned Word>
+inline usize
+first_non_zero(Word const* p, usize n) {
+    // Skip over the whole lanes that are all zero and then finish off one word at a time.
+    auto start = 0uz;
+    if constexpr (lane_bytes > 0) {
+        constexpr auto per_lane = lane_bytes / sizeof(Word);
+        auto           n_lanes = lanes<Word>(n).first;
+        auto           bytes = reinterpret_cast<u8 const*>(p);
+        auto           l = 0uz;
+        while (l < n_lanes && is_zero(load(bytes + l * lane_bytes))) ++l;
+        start = l * per_lane;
+    }
+    for (auto i = start; i < n; ++i)
+        if (p[i] != 0) return i;
+    return n;
+}
+
+// Returns the index of the last non-zero word among the `n` words starting at `p` (or `n` if they are all zero).
+template<Unsigned Word>
+inline usize
+last_non_zero(Word const* p, usize n) {
+    auto [n_lanes, done] = lanes<Word>(n);
+
+    // The words after the last whole lane are checked one at a time.
+    for (auto i = n; i-- > done;)
+        if (p[i] != 0) return i;
+
+    if constexpr (lane_bytes > 0) {
+        constexpr auto per_lane = lane_bytes / sizeof(Word);
+        auto           bytes = reinterpret_cast<u8 const*>(p);
+        for (auto l = n_lanes; l-- > 0;) {
+            if (!is_zero(load(bytes + l * lane_bytes))) {
+                for (auto i = (l + 1) * per_lane; i-- > l * per_lane;)
+                    if (p[i] != 0) return i;
+            }
+        }
+    }
+    return n;
+}
+
+// Packs the `n <= 64` characters starting at `s` into `bits` where character `i` gives bit `i`.
+// Returns `false` if any of the characters is not a '0' or a '1' (in which case `bits` is unspecified).
+inline bool
+pack_binary_chars(char const* s, usize n, u64& bits) {
+    bits = 0;
+    auto i = 0uz;
+
+#if !defined(GF2_NO_SIMD) && defined(__SSE2__)
+    // Classify sixteen characters at a time & the byte masks of the '1's are the bits we want.
+    auto const zero = _mm_set1_epi8('0');
+    auto const one = _mm_set1_epi8('1');
+    for (; i + 16 <= n; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + i));
+        auto is_one = _mm_cmpeq_epi8(v, one);
+        auto is_zero = _mm_cmpeq_epi8(v, zero);
+        if (_mm_movemask_epi8(_mm_or_si128(is_one, is_zero)) != 0xFFFF) return false;
+        bits |= static_cast<u64>(static_cast<u16>(_mm_movemask_epi8(is_one))) << i;
+    }
+#endif
+
+    // Eight characters at a time in a 64-bit word: after the XOR every byte should be 0 or 1, and the multiply gathers
+    // the low bits of those bytes into the top byte of the product (byte `j` lands on bit `56 + j` with no carries).
+    constexpr u64 chars_0 = 0x3030'3030'3030'3030ull;
+    constexpr u64 not_bit = 0xFEFE'FEFE'FEFE'FEFEull;
+    constexpr u64 gather = 0x0102'0408'1020'4080ull;
+    for (; i + 8 <= n; i += 8) {
+        u64 x;
+        std::memcpy(&x, s + i, 8);
+        if constexpr (std::endian::native == std::endian::big) x = std::byteswap(x);
+        x ^= chars_0;
+        if ((x & not_bit) != 0) return false;
+        bits |= ((x * gather) >> 56) << i;
+    }
+
+    // Finish off one character at a time.
+    for (; i < n; ++i) {
+        if (s[i] != '0' && s[i] != '1') return false;
+        if (s[i] == '1') bits |= u64{1} << i;
+    }
+    return true;
+}
+
+} // namespace gf2::details::simd
@@ -0,0 +1,961 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Sparse bit-matrices in compressed sparse row form with a Block Lanczos solver. <br>
+/// See the [SparseBitMatrix](docs/pages/SparseBitMatrix.md) page for more details.
+
+#include <gf2/BitMatrix.h>
+#include <gf2/RNG.h>
+#include <gf2/ThreadPool.h>
+
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gf2 {
+
+/// Sparse bit-matrices with fewer than this many columns are solved by converting them to a dense `gf2::BitMatrix`.
+///
+/// Block Lanczos only pays off once the matrix is a good deal wider than the block of 64 vectors it moves through the
+/// iteration. Below this size Gaussian elimination on the dense form is both faster and exact.
+inline constexpr usize BLOCK_LANCZOS_THRESHOLD = 256;
+
+/// A bit-matrix over GF(2) that only stores the positions of its ones in _compressed sparse row_ (CSR) form.
+///
+/// Row `i` is the sorted list of the column indices of its ones. The lists for all the rows are concatenated into one
+/// buffer with a second buffer of offsets saying where each row starts. So a $10^6 \times 10^6$ bit-matrix with twenty
+/// ones per row needs a few hundred megabytes instead of the 125 gigabytes of a dense `gf2::BitMatrix`.
+///
+/// The matrix interoperates with bit-vectors through the usual `gf2::dot` overloads and the kernel and linear solvers
+/// use Block Lanczos which only ever needs products of the matrix and its transpose with dense blocks of vectors.
+///
+/// # Note
+/// The `Word` parameter is the word type of the bit-vectors and bit-matrices that the sparse matrix works with. The
+/// Block Lanczos iteration always works on blocks of 64 vectors held in 64-bit words whatever `Word` is.
+///
+/// # Example
+/// ```
+/// std::vector<std::pair<usize, usize>> ones{{0, 1}, {1, 2}, {2, 0}, {2, 1}};
+/// SparseBitMatrix<> A{3, 3, ones};
+/// assert_eq(A.count_ones(), 4);
+/// assert_eq(A.to_dense().to_compact_binary_string(), "010 001 110");
+/// auto v = BitVector<>::from_string("101").value();
+/// assert_eq(dot(A, v).to_string(), "011");
+/// assert_eq(dot(A, v), dot(A.to_dense(), v));
+/// ```
+template<Unsigned Word = usize>
+class SparseBitMatrix {
+private:
+    // The dimensions of the bit-matrix.
+    usize m_rows = 0;
+    usize m_cols = 0;
+
+    // Row `i` has its ones in the columns `m_indices[m_offsets[i]]` up to (not including) `m_indices[m_offsets[i+1]]`.
+    std::pmr::vector<usize> m_offsets{1, 0uz, memory_resource()};
+    std::pmr::vector<usize> m_indices{memory_resource()};
+
+public:
+    /// The word type of the bit-vectors and bit-matrices that this sparse matrix works with.
+    using word_type = Word;
+
+    /// The dense bit-matrix type with the same word type.
+    using dense_type = BitMatrix<Word>;
+
+    /// @name Constructors
+    /// @{
+
+    /// The default constructor creates an empty sparse bit-matrix with no rows or columns.
+    ///
+    /// # Example
+    /// ```
+    /// SparseBitMatrix A;
+    /// assert_eq(A.is_empty(), true);
+    /// ```
+    SparseBitMatrix() = default;
+
+    /// Constructs the `m x n` sparse bit-matrix with all the elements set to 0.
+    ///
+    /// # Example
+    /// ```
+    /// SparseBitMatrix A{3, 4};
+    /// assert_eq(A.rows(), 3);
+    /// assert_eq(A.cols(), 4);
+    /// assert_eq(A.count_ones(), 0);
+    /// ```
+    SparseBitMatrix(usize m, usize n) : m_rows{m}, m_cols{n} { m_offsets.assign(m + 1, 0); }
+
+    /// Constructs the `m x n` sparse bit-matrix with ones at the `(i, j)` positions in the passed list.
+    ///
+    /// The entries can come in any order. Entries are _added_ over GF(2), so a position that is listed twice is zero.
+    ///
+    /// # Panics
+    /// We check that every position is inside the matrix unless `NDEBUG` is defined.
+    ///
+    /// # Example
+    /// ```
+    /// std::vector<std::pair<usize, usize>> ones{{2, 2}, {0, 0}, {1, 1}, {0, 2}, {0, 2}};
+    /// SparseBitMatrix<u8> A{3, 3, ones};
+    /// assert_eq(A.count_ones(), 3);
+    /// assert_eq(A.to_dense(), BitMatrix<u8>::identity(3));
+    /// ```
+    SparseBitMatrix(usize m, usize n, std::span<std::pair<usize, usize> const> entries) : m_rows{m}, m_cols{n} {
+        auto sorted = std::pmr::vector<std::pair<usize, usize>>(entries.begin(), entries.end(), memory_resource());
+        std::ranges::sort(sorted);
+
+        m_offsets.assign(m + 1, 0);
+        m_indices.reserve(sorted.size());
+        for (auto k = 0uz; k < sorted.size();) {
+            auto [i, j] = sorted[k];
+            gf2_assert(i < m && j < n, "Position ({}, {}) is outside a {} x {} matrix.", i, j, m, n);
+
+            // Pairs of equal entries cancel.
+            auto count = 1uz;
+            while (k + count < sorted.size() && sorted[k + count] == sorted[k]) ++count;
+            if (count % 2 == 1) {
+                m_indices.push_back(j);
+                ++m_offsets[i + 1];
+            }
+            k += count;
+        }
+        for (auto i = 0uz; i < m; ++i) m_offsets[i + 1] += m_offsets[i];
+    }
+
+    /// Constructs a sparse bit-matrix with the same elements as a dense one.
+    ///
+    /// # Example
+    /// ```
+    /// auto M = BitMatrix<>::random(30, 40, 0.1, 42);
+    /// SparseBitMatrix<> A{M};
+    /// assert_eq(A.count_ones(), M.count_ones());
+    /// assert_eq(A.to_dense(), M);
+    /// ```
+    explicit SparseBitMatrix(dense_type const& dense) : SparseBitMatrix(dense.rows(), dense.cols()) {
+        m_indices.reserve(dense.count_ones());
+        for (auto i = 0uz; i < m_rows; ++i) {
+            dense.row(i).for_each_set_bit([&](usize j) { m_indices.push_back(j); });
+            m_offsets[i + 1] = m_indices.size();
+        }
+    }
+
+    /// @}
+    /// @name Factory Constructors
+    /// @{
+
+    /// Factory method to generate the `m x n` sparse bit-matrix with all the elements set to 0.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::zeros(3, 4);
+    /// assert_eq(A.to_dense().to_compact_binary_string(), "0000 0000 0000");
+    /// ```
+    static SparseBitMatrix zeros(usize m, usize n) { return SparseBitMatrix{m, n}; }
+
+    /// Factory method to generate the `n x n` identity matrix.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::identity(3);
+    /// assert_eq(A.to_dense().to_compact_binary_string(), "100 010 001");
+    /// ```
+    static SparseBitMatrix identity(usize n) {
+        SparseBitMatrix result{n, n};
+        result.m_indices.resize(n);
+        for (auto i = 0uz; i < n; ++i) {
+            result.m_indices[i] = i;
+            result.m_offsets[i + 1] = i + 1;
+        }
+        return result;
+    }
+
+    /// Factory method to generate an `m x n` sparse bit-matrix with `k` ones at random positions in each row.
+    ///
+    /// Row `i` is drawn from a `gf2::Xoshiro256pp` engine seeded from the counter-based `gf2::Philox4x32{seed, i}`
+    /// stream, which is the same scheme that `gf2::BitMatrix::random` uses. If you set the seed to 0 then a seed is
+    /// drawn from a per-thread RNG seeded with entropy.
+    ///
+    /// # Panics
+    /// We check that `k` is at most `n` unless `NDEBUG` is defined.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::random(1000, 500, 7, 42);
+    /// assert_eq(A.count_ones(), 7000);
+    /// assert_eq(A.row(17).size(), 7);
+    /// assert(A == SparseBitMatrix<>::random(1000, 500, 7, 42));
+    /// ```
+    static SparseBitMatrix random(usize m, usize n, usize k, std::uint64_t seed = 0) {
+        gf2_assert(k <= n, "Cannot put {} ones in a row with just {} columns.", k, n);
+
+        // No seed? Draw one from a per-thread RNG that is seeded with entropy on first use.
+        thread_local RNG rng;
+        if (seed == 0) seed = rng();
+
+        SparseBitMatrix result{m, n};
+        result.m_indices.resize(m * k);
+        for (auto i = 0uz; i < m; ++i) {
+            Xoshiro256pp stream{Philox4x32{seed, i}()};
+            auto         row = std::span{result.m_indices}.subspan(i * k, k);
+
+            // Draw distinct columns -- for the sparse rows we care about the redraws are rare.
+            for (auto t = 0uz; t < k; ++t) {
+                do {
+                    row[t] = stream() % n;
+                } while (std::ranges::find(row.first(t), row[t]) != row.begin() + static_cast<std::ptrdiff_t>(t));
+            }
+            std::ranges::sort(row);
+            result.m_offsets[i + 1] = (i + 1) * k;
+        }
+        return result;
+    }
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the number of rows in the sparse bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// SparseBitMatrix A{3, 4};
+    /// assert_eq(A.rows(), 3);
+    /// ```
+    constexpr usize rows() const { return m_rows; }
+
+    /// Returns the number of columns in the sparse bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// SparseBitMatrix A{3, 4};
+    /// assert_eq(A.cols(), 4);
+    /// ```
+    constexpr usize cols() const { return m_cols; }
+
+    /// Returns `true` if the sparse bit-matrix has no rows or no columns.
+    ///
+    /// # Example
+    /// ```
+    /// SparseBitMatrix A{3, 0};
+    /// assert_eq(A.is_empty(), true);
+    /// ```
+    constexpr bool is_empty() const { return m_rows == 0 || m_cols == 0; }
+
+    /// Returns the number of ones in the sparse bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::identity(5);
+    /// assert_eq(A.count_ones(), 5);
+    /// ```
+    constexpr usize count_ones() const { return m_indices.size(); }
+
+    /// Returns the sorted column indices of the ones in row `i` as a read-only span.
+    ///
+    /// # Panics
+    /// In debug mode the index `i` is bounds-checked.
+    ///
+    /// # Example
+    /// ```
+    /// std::vector<std::pair<usize, usize>> ones{{1, 3}, {1, 0}};
+    /// SparseBitMatrix A{2, 4, ones};
+    /// assert_eq(A.row(0).size(), 0);
+    /// assert_eq(A.row(1)[0], 0);
+    /// assert_eq(A.row(1)[1], 3);
+    /// ```
+    constexpr std::span<usize const> row(usize i) const {
+        gf2_debug_assert(i < m_rows, "Row index {} is out of bounds for a matrix with {} rows.", i, m_rows);
+        return std::span{m_indices}.subspan(m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+    }
+
+    /// Returns the element at row `i` and column `j`.
+    ///
+    /// This is a binary search in the row so it costs $\mathcal{O}(\log k)$ for a row with $k$ ones.
+    ///
+    /// # Panics
+    /// In debug mode the indices are bounds-checked.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::identity(3);
+    /// assert_eq(A.get(1, 1), true);
+    /// assert_eq(A.get(1, 2), false);
+    /// ```
+    constexpr bool get(usize i, usize j) const {
+        gf2_debug_assert(j < m_cols, "Column index {} is out of bounds for a matrix with {} columns.", j, m_cols);
+        return std::ranges::binary_search(row(i), j);
+    }
+
+    /// Returns the element at row `i` and column `j`.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::identity(3);
+    /// assert_eq(A(2, 2), true);
+    /// assert_eq(A(2, 0), false);
+    /// ```
+    constexpr bool operator()(usize i, usize j) const { return get(i, j); }
+
+    /// Equality operator checks that two sparse bit-matrices have the same dimensions and the same ones.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::identity(3);
+    /// auto B = SparseBitMatrix<>{BitMatrix<>::identity(3)};
+    /// assert(A == B);
+    /// ```
+    bool operator==(SparseBitMatrix const& other) const {
+        return m_rows == other.m_rows && m_cols == other.m_cols && m_offsets == other.m_offsets &&
+               m_indices == other.m_indices;
+    }
+
+    /// @}
+    /// @name Conversions & Builders
+    /// @{
+
+    /// Returns a dense `gf2::BitMatrix` copy of this sparse bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<u8>::identity(4);
+    /// assert_eq(A.to_dense(), BitMatrix<u8>::identity(4));
+    /// ```
+    dense_type to_dense() const {
+        auto result = dense_type::zeros(m_rows, m_cols);
+        for (auto i = 0uz; i < m_rows; ++i)
+            for (auto j : row(i)) result.set(i, j);
+        return result;
+    }
+
+    /// Returns the transpose of this sparse bit-matrix.
+    ///
+    /// This is a counting sort of the column indices so it costs $\mathcal{O}(m + n + k)$ for $k$ ones.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::random(40, 70, 5, 42);
+    /// assert_eq(A.transposed().to_dense(), A.to_dense().transposed());
+    /// ```
+    SparseBitMatrix transposed() const {
+        SparseBitMatrix result{m_cols, m_rows};
+        for (auto j : m_indices) ++result.m_offsets[j + 1];
+        for (auto j = 0uz; j < m_cols; ++j) result.m_offsets[j + 1] += result.m_offsets[j];
+
+        // Walking the rows in order leaves every row of the transpose sorted.
+        result.m_indices.resize(m_indices.size());
+        auto next = std::pmr::vector<usize>(result.m_offsets.begin(), result.m_offsets.end() - 1, memory_resource());
+        for (auto i = 0uz; i < m_rows; ++i)
+            for (auto j : row(i)) result.m_indices[next[j]++] = i;
+        return result;
+    }
+
+    /// Appends a row with ones in the listed columns and returns a reference to this matrix for chaining.
+    ///
+    /// The columns can come in any order, and as for the constructor a column that is listed twice cancels out.
+    ///
+    /// # Panics
+    /// We check that the column indices are in bounds unless `NDEBUG` is defined.
+    ///
+    /// # Example
+    /// ```
+    /// SparseBitMatrix A{0, 5};
+    /// std::vector<usize> r0{4, 0}, r1{2, 2, 3};
+    /// A.push_row(r0).push_row(r1);
+    /// assert_eq(A.to_dense().to_compact_binary_string(), "10001 00010");
+    /// ```
+    SparseBitMatrix& push_row(std::span<usize const> cols) {
+        auto start = m_indices.size();
+        m_indices.insert(m_indices.end(), cols.begin(), cols.end());
+        auto added = std::span{m_indices}.subspan(start);
+        std::ranges::sort(added);
+
+        // Drop pairs of equal columns.
+        auto kept = start;
+        for (auto k = start; k < m_indices.size();) {
+            gf2_assert(m_indices[k] < m_cols, "Column {} is out of bounds for a matrix with {} columns.", m_indices[k],
+                       m_cols);
+            auto count = 1uz;
+            while (k + count < m_indices.size() && m_indices[k + count] == m_indices[k]) ++count;
+            if (count % 2 == 1) m_indices[kept++] = m_indices[k];
+            k += count;
+        }
+        m_indices.resize(kept);
+        m_offsets.push_back(kept);
+        ++m_rows;
+        return *this;
+    }
+
+    /// @}
+    /// @name Kernels & Linear Systems
+    /// @{
+
+    /// Returns a bit-matrix whose rows are linearly independent vectors $x$ with $A \cdot x = 0$.
+    ///
+    /// Matrices with fewer than `gf2::BLOCK_LANCZOS_THRESHOLD` columns are converted to dense form and the rows are a
+    /// basis for the whole kernel. Larger matrices go through Montgomery's Block Lanczos iteration on the symmetric
+    /// matrix $A^T A$, which finds up to about 64 independent kernel vectors (or all of them if the kernel is smaller
+    /// than that). An empty result means the kernel is trivial.
+    ///
+    /// Block Lanczos only touches `A` through products with blocks of 64 vectors so for a matrix with $k$ ones and $n$
+    /// columns the cost is about $\mathcal{O}(k n / 64)$ word operations. The random start block comes from `seed` (0
+    /// means use entropy).
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::random(900, 1000, 10, 42);
+    /// auto K = A.kernel(7);
+    /// assert(K.rows() > 0);
+    /// for (auto i = 0uz; i < K.rows(); ++i) assert(dot(A, K.row(i)).none());
+    /// auto E = K;
+    /// assert_eq(E.to_echelon_form().count_ones(), K.rows());
+    /// ```
+    BitMatrix<Word> kernel(std::uint64_t seed = 0) const { return kernel(seq, seed); }
+
+    /// Returns a bit-matrix whose rows are linearly independent vectors $x$ with $A \cdot x = 0$ using an executor.
+    ///
+    /// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The sparse-times-block products and the inner
+    /// products of blocks are spread over its threads. Otherwise this is the same as `kernel(seed)` and, for a given
+    /// non-zero seed, the result does not depend on the number of threads.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<u32>::random(2000, 2100, 12, 42);
+    /// ThreadPool pool{3};
+    /// auto K = A.kernel(pool, 5);
+    /// assert_eq(K, A.kernel(par, 5));
+    /// assert(K.rows() >= 32);
+    /// for (auto i = 0uz; i < K.rows(); ++i) assert(dot(A, K.row(i)).none());
+    /// ```
+    template<Executor Exec>
+    BitMatrix<Word> kernel(Exec&& exec, std::uint64_t seed = 0) const {
+        if (m_cols == 0) return BitMatrix<Word>{};
+        if (m_rows == 0) return BitMatrix<Word>::identity(m_cols);
+        if (m_cols < BLOCK_LANCZOS_THRESHOLD) return to_dense().kernel();
+
+        // No seed? Draw one from a per-thread RNG that is seeded with entropy on first use.
+        thread_local RNG rng;
+        if (seed == 0) seed = rng();
+
+        // Block Lanczos works with both A and its transpose so make the transpose once.
+        auto At = transposed();
+        for (auto attempt = 0uz; attempt < 8; ++attempt) {
+            auto result = block_lanczos(exec, *this, At, Philox4x32{seed, attempt}());
+            if (result) return std::move(*result);
+        }
+        throw std::runtime_error("Block Lanczos failed to converge -- try a different seed.");
+    }
+
+    /// Returns a solution $x$ to the system $A \cdot x = b$ or `std::nullopt` if there isn't one.
+    ///
+    /// We look for a kernel vector of the augmented matrix $[A | b]$ whose last element is one. For matrices going
+    /// through Block Lanczos a missing solution is then a probabilistic answer --- a consistent system is missed with
+    /// probability of about $2^{-64}$.
+    ///
+    /// # Panics
+    /// We check that `b` has one element per row of the matrix unless `NDEBUG` is defined.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::random(1000, 1000, 10, 42);
+    /// auto x0 = BitVector<>::random(1000, 0.5, 3);
+    /// auto b = dot(A, x0);
+    /// auto x = A.x_for(b, 11).value();
+    /// assert_eq(dot(A, x), b);
+    /// auto I = SparseBitMatrix<>::identity(10);
+    /// auto c = BitVector<>::ones(10);
+    /// assert_eq(I.x_for(c).value(), c);
+    /// ```
+    template<BitStore Rhs>
+        requires std::same_as<typename Rhs::word_type, Word>
+    std::optional<BitVector<Word>> x_for(Rhs const& b, std::uint64_t seed = 0) const {
+        return x_for(seq, b, seed);
+    }
+
+    /// Returns a solution $x$ to the system $A \cdot x = b$ or `std::nullopt` if there isn't one using an executor.
+    ///
+    /// # Example
+    /// ```
+    /// auto A = SparseBitMatrix<>::random(600, 500, 8, 42);
+    /// auto b = dot(A, BitVector<>::random(500, 0.5, 3));
+    /// auto x = A.x_for(par, b, 11).value();
+    /// assert_eq(dot(A, x), b);
+    /// auto c = BitVector<>::ones(600);
+    /// assert(!A.x_for(par, c, 11).has_value());
+    /// ```
+    template<Executor Exec, BitStore Rhs>
+        requires std::same_as<typename Rhs::word_type, Word>
+    std::optional<BitVector<Word>> x_for(Exec&& exec, Rhs const& b, std::uint64_t seed = 0) const {
+        gf2_assert_eq(m_rows, b.size(), "Matrix has {} rows but the RHS vector has {} elements.", m_rows, b.size());
+        if (b.none()) return BitVector<Word>::zeros(m_cols);
+
+        // The augmented matrix [A | b] has an extra column with ones where b does.
+        SparseBitMatrix augmented{m_rows, m_cols + 1};
+        augmented.m_indices.reserve(m_indices.size() + b.count_ones());
+        for (auto i = 0uz; i < m_rows; ++i) {
+            auto r = row(i);
+            augmented.m_indices.insert(augmented.m_indices.end(), r.begin(), r.end());
+            if (b.get(i)) augmented.m_indices.push_back(m_cols);
+            augmented.m_offsets[i + 1] = augmented.m_indices.size();
+        }
+
+        auto K = augmented.kernel(exec, seed);
+        for (auto i = 0uz; i < K.rows(); ++i)
+            if (K.get(i, m_cols)) return BitVector<Word>::from(K.row(i).span(0, m_cols));
+        return std::nullopt;
+    }
+
+    /// @}
+
+private:
+    // Block Lanczos always works with blocks of N = 64 vectors whatever the word type of the matrix.
+    static constexpr usize N = 64;
+
+    // An N x N bit-matrix stored as N words (row i is word i).
+    using square_type = std::array<u64, N>;
+
+    // A dense block of N vectors stored one word per row.
+    using block_type = std::pmr::vector<u64>;
+
+    static constexpr u64 all_ones = ~u64{0};
+
+    // Sets `y = A x` where `x` is a block with a word per column of `A` and `y` gets a word per row.
+    template<Executor Exec>
+    static void apply(Exec&& exec, SparseBitMatrix const& A, block_type const& x, block_type& y) {
+        details::for_each_chunk(exec, A.m_rows, 1024, [&](usize begin, usize end) {
+            for (auto i = begin; i < end; ++i) {
+                u64 sum = 0;
+                for (auto k = A.m_offsets[i]; k < A.m_offsets[i + 1]; ++k) sum ^= x[A.m_indices[k]];
+                y[i] = sum;
+            }
+        });
+    }
+
+    // Returns x^T y for two blocks with the same number of rows.
+    //
+    // Each row of `x` is split into bytes and row k of `y` is added to one of 256 slots for every byte of `x[k]`.
+    // The slots are then folded into the N rows of the product, so each row costs sizeof(u64) additions.
+    template<Executor Exec>
+    static square_type inner(Exec&& exec, block_type const& x, block_type const& y) {
+        constexpr usize n_bytes = sizeof(u64);
+        auto            n = x.size();
+        auto            n_parts = std::clamp(n / 4096, 1uz, details::concurrency(exec));
+        auto            part_rows = (n + n_parts - 1) / n_parts;
+
+        auto tables = std::pmr::vector<u64>(n_parts * n_bytes * 256, u64{0}, memory_resource());
+        details::for_each_chunk(exec, n_parts, 1, [&](usize begin, usize end) {
+            for (auto p = begin; p < end; ++p) {
+                auto table = tables.data() + p * n_bytes * 256;
+                for (auto k = p * part_rows; k < std::min(n, (p + 1) * part_rows); ++k) {
+                    for (auto b = 0uz; b < n_bytes; ++b) table[b * 256 + ((x[k] >> (8 * b)) & 0xFF)] ^= y[k];
+                }
+            }
+        });
+
+        square_type result{};
+        for (auto p = 0uz; p < n_parts; ++p) {
+            auto table = tables.data() + p * n_bytes * 256;
+            for (auto b = 0uz; b < n_bytes; ++b) {
+                for (auto v = 1uz; v < 256; ++v) {
+                    auto w = table[b * 256 + v];
+                    if (w == 0) continue;
+                    for (auto t = 0uz; t < 8; ++t)
+                        if ((v >> t) & 1) result[8 * b + t] ^= w;
+                }
+            }
+        }
+        return result;
+    }
+
+    // Returns the N x N product a * b.
+    static square_type mul(square_type const& a, square_type const& b) {
+        square_type result{};
+        for (auto i = 0uz; i < N; ++i) {
+            u64 sum = 0;
+            for (auto j = 0uz; j < N; ++j)
+                if ((a[i] >> j) & 1) sum ^= b[j];
+            result[i] = sum;
+        }
+        return result;
+    }
+
+    // Sets `y ^= x_0 * M_0 + x_1 * M_1 + ...` for blocks `x_t` and N x N matrices `M_t`.
+    //
+    // Each matrix is expanded into byte tables so a row of a product costs sizeof(u64) lookups.
+    template<Executor Exec, typename Block, typename Square, usize Count>
+    static void mul_add(Exec&& exec, std::array<Block*, Count> const& x, std::array<Square*, Count> const& M,
+                        block_type& y) {
+        constexpr usize n_bytes = sizeof(u64);
+        auto            tables = std::pmr::vector<u64>(Count * n_bytes * 256, u64{0}, memory_resource());
+        for (auto c = 0uz; c < Count; ++c) {
+            for (auto b = 0uz; b < n_bytes; ++b) {
+                auto table = tables.data() + (c * n_bytes + b) * 256;
+                for (auto v = 1uz; v < 256; ++v) {
+                    auto low = v & (v - 1);
+                    table[v] = table[low] ^ (*M[c])[8 * b + static_cast<usize>(std::countr_zero(v))];
+                }
+            }
+        }
+        details::for_each_chunk(exec, y.size(), 4096, [&](usize begin, usize end) {
+            for (auto k = begin; k < end; ++k) {
+                u64 sum = y[k];
+                for (auto c = 0uz; c < Count; ++c) {
+                    auto table = tables.data() + c * n_bytes * 256;
+                    auto w = (*x[c])[k];
+                    for (auto b = 0uz; b < n_bytes; ++b) sum ^= table[b * 256 + ((w >> (8 * b)) & 0xFF)];
+                }
+                y[k] = sum;
+            }
+        });
+    }
+
+    // Montgomery's choice of the columns S of V that are used in the next step of the iteration.
+    //
+    // Returns the mask of the chosen columns and sets `winv` to the inverse of the chosen sub-matrix of `T = V^T A V`
+    // padded with zeros. The columns missed by the previous step pass must be chosen now for the recurrence to hold, so
+    // we try those first and fail if that doesn't happen.
+    static std::optional<u64> select(square_type const& T, u64 previous, square_type& winv) {
+
+        // Gauss-Jordan on [T | I] with the columns missed by the last pass first.
+        square_type lo = T, hi{};
+        for (auto i = 0uz; i < N; ++i) hi[i] = u64{1} << i;
+        std::array<usize, N> order;
+        auto                 k = 0uz;
+        for (auto i = 0uz; i < N; ++i)
+            if (!((previous >> i) & 1)) order[k++] = i;
+        for (auto i = 0uz; i < N; ++i)
+            if ((previous >> i) & 1) order[k++] = i;
+
+        u64 chosen = 0;
+        for (auto i = 0uz; i < N; ++i) {
+            auto c = order[i];
+            auto bit = u64{1} << c;
+
+            // Look for a pivot in T -- if there is one column c joins the chosen set.
+            auto j = i;
+            while (j < N && !(lo[order[j]] & bit)) ++j;
+            if (j < N) {
+                std::swap(lo[c], lo[order[j]]);
+                std::swap(hi[c], hi[order[j]]);
+                for (auto r = 0uz; r < N; ++r) {
+                    if (r != c && (lo[r] & bit)) {
+                        lo[r] ^= lo[c];
+                        hi[r] ^= hi[c];
+                    }
+                }
+                chosen |= bit;
+                continue;
+            }
+
+            // Otherwise we eliminate with the right half and zap the row so column c is left out.
+            j = i;
+            while (j < N && !(hi[order[j]] & bit)) ++j;
+            if (j == N) return std::nullopt;
+            std::swap(lo[c], lo[order[j]]);
+            std::swap(hi[c], hi[order[j]]);
+            for (auto r = 0uz; r < N; ++r) {
+                if (r != c && (hi[r] & bit)) {
+                    lo[r] ^= lo[c];
+                    hi[r] ^= hi[c];
+                }
+            }
+            lo[c] = hi[c] = 0;
+        }
+
+        if ((chosen | previous) != all_ones) return std::nullopt;
+        winv = hi;
+        return chosen;
+    }
+
+    // One run of Block Lanczos on A^T A from a random start that returns the kernel vectors of A it finds.
+    //
+    // Returns `std::nullopt` if the iteration ran far past the expected number of steps, in which case the caller tries
+    // again from another start.
+    template<Executor Exec>
+    static std::optional<BitMatrix<Word>> block_lanczos(Exec&& exec, SparseBitMatrix const& A,
+                                                        SparseBitMatrix const& At, std::uint64_t seed) {
+        auto n = A.m_cols;
+        auto make_block = [&](usize size) { return block_type(size, u64{0}, memory_resource()); };
+
+        // B v = A^T (A v) is symmetric and has the kernel of A inside its kernel.
+        auto scratch = make_block(A.m_rows);
+        auto apply_B = [&](block_type const& v, block_type& out) {
+            apply(exec, A, v, scratch);
+            apply(exec, At, scratch, out);
+        };
+
+        // The random start Y and V_0 = B Y.
+        auto y = make_block(n);
+        details::for_each_chunk(exec, n, 4096, [&](usize begin, usize end) {
+            for (auto k = begin; k < end; ++k) y[k] = Philox4x32{seed, k}();
+        });
+        auto v_start = make_block(n);
+        apply_B(y, v_start);
+
+        // The last three blocks V_i, V_{i-1}, V_{i-2} and the matching small matrices.
+        auto        v0 = v_start, v1 = make_block(n), v2 = make_block(n);
+        auto        bv = make_block(n);
+        auto        x = make_block(n);
+        square_type winv0{}, winv1{}, winv2{}, vtbv1{}, vtb2v1{};
+        u64         mask1 = all_ones;
+
+        // Each step normally adds about N - 0.76 dimensions to the Krylov space.
+        auto max_steps = n / (N - 4) + 20;
+        auto steps = 0uz;
+        for (;; ++steps) {
+            if (steps > max_steps) return std::nullopt;
+
+            apply_B(v0, bv);
+            auto vtbv0 = inner(exec, v0, bv);
+            if (std::ranges::all_of(vtbv0, [](u64 w) { return w == 0; })) break;
+            auto vtb2v0 = inner(exec, bv, bv);
+
+            // If no usable columns are left we are at the end of the Krylov space (or, very rarely, there was a breakdown
+            // which just means fewer kernel vectors come out of the post-processing below).
+            auto chosen = select(vtbv0, mask1, winv0);
+            if (!chosen) break;
+            auto mask0 = *chosen;
+
+            // X += V_i W_i^{-1} V_i^T V_0.
+            auto proj = mul(winv0, inner(exec, v0, v_start));
+            mul_add(exec, std::array{&v0}, std::array{&proj}, x);
+
+            // D = I - W_i^{-1} (V_i^T B^2 V_i S_i S_i^T + V_i^T B V_i).
+            square_type d;
+            for (auto i = 0uz; i < N; ++i) d[i] = (vtb2v0[i] & mask0) ^ vtbv0[i];
+            d = mul(winv0, d);
+            for (auto i = 0uz; i < N; ++i) d[i] ^= u64{1} << i;
+
+            // E = - W_{i-1}^{-1} V_i^T B V_i S_i S_i^T.
+            auto e = mul(winv1, vtbv0);
+            for (auto& w : e) w &= mask0;
+
+            // F = - W_{i-2}^{-1} (I - V_{i-1}^T B V_{i-1} W_{i-1}^{-1})
+            //       (V_{i-1}^T B^2 V_{i-1} S_{i-1} S_{i-1}^T + V_{i-1}^T B V_{i-1}) S_i S_i^T.
+            auto f = mul(vtbv1, winv1);
+            for (auto i = 0uz; i < N; ++i) f[i] ^= u64{1} << i;
+            f = mul(winv2, f);
+            square_type f2;
+            for (auto i = 0uz; i < N; ++i) f2[i] = ((vtb2v1[i] & mask1) ^ vtbv1[i]) & mask0;
+            f = mul(f, f2);
+
+            // V_{i+1} = B V_i S_i S_i^T + V_i D + V_{i-1} E + V_{i-2} F.
+            for (auto& w : bv) w &= mask0;
+            mul_add(exec, std::array{&v0, &v1, &v2}, std::array{&d, &e, &f}, bv);
+
+            std::swap(v2, v1);
+            std::swap(v1, v0);
+            std::swap(v0, bv);
+            winv2 = winv1;
+            winv1 = winv0;
+            vtbv1 = vtbv0;
+            vtb2v1 = vtb2v0;
+            mask1 = mask0;
+        }
+
+        // B (X - Y) and B V_m are (nearly) zero, so combinations of the 2N columns of Z = [X - Y | V_m] that A sends
+        // to zero are in its kernel. Here X - Y is the block `x` and V_m is the block `v0`.
+        for (auto k = 0uz; k < n; ++k) x[k] ^= y[k];
+        auto ax = make_block(A.m_rows), av = make_block(A.m_rows);
+        apply(exec, A, x, ax);
+        apply(exec, A, v0, av);
+
+        // We track a basis for the combinations as 2N columns each split into an `x` half and a `v` half. Each row of
+        // A Z that is hit by a surviving combination uses up one of them.
+        std::array<u64, 2 * N> cx{}, cv{};
+        for (auto i = 0uz; i < N; ++i) {
+            cx[i] = u64{1} << i;
+            cv[N + i] = u64{1} << i;
+        }
+        auto alive = 2 * N;
+        auto hits = [&](usize r, usize j) {
+            return (std::popcount((ax[r] & cx[j]) ^ (av[r] & cv[j])) & 1) != 0;
+        };
+        for (auto r = 0uz; r < A.m_rows && alive > 0; ++r) {
+            auto pivot = alive;
+            for (auto j = 0uz; j < alive; ++j) {
+                if (!hits(r, j)) continue;
+                if (pivot == alive) {
+                    pivot = j;
+                } else {
+                    cx[j] ^= cx[pivot];
+                    cv[j] ^= cv[pivot];
+                }
+            }
+            if (pivot == alive) continue;
+            --alive;
+            std::swap(cx[pivot], cx[alive]);
+            std::swap(cv[pivot], cv[alive]);
+        }
+
+        // The surviving combinations of Z are kernel vectors of A -- put them in the rows of a bit-matrix and reduce
+        // that to echelon form to drop any zero or dependent ones.
+        if (alive == 0) return BitMatrix<Word>{};
+        auto result = BitMatrix<Word>::zeros(alive, n);
+        for (auto k = 0uz; k < n; ++k) {
+            for (auto j = 0uz; j < alive; ++j)
+                if (std::popcount((x[k] & cx[j]) ^ (v0[k] & cv[j])) & 1) result.set(j, k);
+        }
+        auto rank = result.to_echelon_form().count_ones();
+        if (rank == 0) return BitMatrix<Word>{};
+        return result.sub_matrix(0, rank, 0, n);
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Sparse matrix products ...
+// -------------------------------------------------------------------------------------------------------------------
+
+/// Sparse bit-matrix, bit-store multiplication, `A * v`, returning a new bit-vector.
+///
+/// Each element of the result is the parity of the elements of `v` picked out by the ones in a row of `A`.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible.
+///
+/// # Example
+/// ```
+/// auto A = SparseBitMatrix<u8>::random(50, 40, 6, 42);
+/// auto v = BitVector<u8>::random(40, 0.5, 7);
+/// assert_eq(dot(A, v), dot(A.to_dense(), v));
+/// assert_eq(A * v, dot(A, v));
+/// ```
+template<Unsigned Word, BitStore Rhs>
+    requires std::same_as<typename Rhs::word_type, Word>
+auto
+dot(SparseBitMatrix<Word> const& lhs, Rhs const& rhs) {
+    return dot(seq, lhs, rhs);
+}
+
+/// Operator form for sparse bit-matrix, bit-store multiplication, `A * v`, returning a new bit-vector.
+template<Unsigned Word, BitStore Rhs>
+    requires std::same_as<typename Rhs::word_type, Word>
+auto
+operator*(SparseBitMatrix<Word> const& lhs, Rhs const& rhs) {
+    return dot(lhs, rhs);
+}
+
+/// Sparse bit-matrix, bit-store multiplication, `A * v`, computed using the given executor.
+///
+/// The executor is either the `gf2::par` tag or a `gf2::ThreadPool`. The rows are split into blocks that line up with
+/// the words of the result.
+///
+/// # Example
+/// ```
+/// auto A = SparseBitMatrix<>::random(5000, 3000, 9, 42);
+/// auto v = BitVector<>::random(3000, 0.5, 7);
+/// ThreadPool pool{4};
+/// assert_eq(dot(pool, A, v), dot(A, v));
+/// assert_eq(dot(par, A, v), dot(A.to_dense(), v));
+/// ```
+template<Executor Exec, Unsigned Word, BitStore Rhs>
+    requires std::same_as<typename Rhs::word_type, Word>
+auto
+dot(Exec&& exec, SparseBitMatrix<Word> const& lhs, Rhs const& rhs) {
+    gf2_assert_eq(lhs.cols(), rhs.size(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.size());
+    auto result = BitVector<Word>::zeros(lhs.rows());
+    details::for_each_chunk(exec, lhs.rows(), 64 * BITS<Word>, [&](usize begin, usize end) {
+        for (auto i = begin; i < end; ++i) {
+            auto sum = false;
+            for (auto j : lhs.row(i)) sum ^= rhs.get(j);
+            if (sum) result.set(i, true);
+        }
+    });
+    return result;
+}
+
+/// Bit-store, sparse bit-matrix multiplication, `v * A`, returning a new bit-vector.
+///
+/// Each one of `v` flips the elements of the result picked out by the matching row of `A`.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible.
+///
+/// # Example
+/// ```
+/// auto A = SparseBitMatrix<>::random(50, 40, 6, 42);
+/// auto v = BitVector<>::random(50, 0.5, 7);
+/// assert_eq(dot(v, A), dot(v, A.to_dense()));
+/// assert_eq(v * A, dot(A.transposed(), v));
+/// ```
+template<Unsigned Word, BitStore Lhs>
+    requires std::same_as<typename Lhs::word_type, Word>
+auto
+dot(Lhs const& lhs, SparseBitMatrix<Word> const& rhs) {
+    gf2_assert_eq(lhs.size(), rhs.rows(), "Incompatible dimensions: {} != {}", lhs.size(), rhs.rows());
+    auto result = BitVector<Word>::zeros(rhs.cols());
+    for (auto i : lhs.set_bits())
+        for (auto j : rhs.row(i)) result.flip(j);
+    return result;
+}
+
+/// Operator form for bit-store, sparse bit-matrix multiplication, `v * A`, returning a new bit-vector.
+template<Unsigned Word, BitStore Lhs>
+    requires std::same_as<typename Lhs::word_type, Word>
+auto
+operator*(Lhs const& lhs, SparseBitMatrix<Word> const& rhs) {
+    return dot(lhs, rhs);
+}
+
+/// Sparse bit-matrix, dense bit-matrix multiplication, `A * M`, returning a new dense bit-matrix.
+///
+/// Row `i` of the product is the sum of the rows of `M` picked out by the ones in row `i` of `A`, so a product with a
+/// block of vectors costs one word-level row addition per one of `A`.
+///
+/// # Panics
+/// This method panics if the dimensions are not compatible.
+///
+/// # Example
+/// ```
+/// auto A = SparseBitMatrix<>::random(60, 50, 5, 42);
+/// auto M = BitMatrix<>::random(50, 130, 0.5, 7);
+/// assert_eq(dot(A, M), dot(A.to_dense(), M));
+/// assert_eq(A * M, dot(A, M));
+/// ```
+template<Unsigned Word>
+auto
+dot(SparseBitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs) {
+    return dot(seq, lhs, rhs);
+}
+
+/// Operator form for sparse bit-matrix, dense bit-matrix multiplication, `A * M`, returning a new dense bit-matrix.
+template<Unsigned Word>
+auto
+operator*(SparseBitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs) {
+    return dot(lhs, rhs);
+}
+
+/// Sparse bit-matrix, dense bit-matrix multiplication, `A * M`, computed using the given executor.
+///
+/// The executor is either the `gf2::par` tag or a `gf2::ThreadPool` and the rows of the product are spread over its
+/// threads.
+///
+/// # Example
+/// ```
+/// auto A = SparseBitMatrix<>::random(3000, 2000, 9, 42);
+/// auto M = BitMatrix<>::random(2000, 64, 0.5, 7);
+/// ThreadPool pool{4};
+/// assert_eq(dot(pool, A, M), dot(A, M));
+/// assert_eq(dot(par, A, M), dot(A.to_dense(), M));
+/// ```
+template<Executor Exec, Unsigned Word>
+auto
+dot(Exec&& exec, SparseBitMatrix<Word> const& lhs, BitMatrix<Word> const& rhs) {
+    gf2_assert_eq(lhs.cols(), rhs.rows(), "Incompatible dimensions: {} != {}", lhs.cols(), rhs.rows());
+    auto result = BitMatrix<Word>::zeros(lhs.rows(), rhs.cols());
+    if (result.is_empty()) return result;
+    auto grain = std::max(1uz, 4096 / std::max(1uz, words_needed<Word>(rhs.cols())));
+    details::for_each_chunk(exec, lhs.rows(), grain, [&](usize begin, usize end) {
+        for (auto i = begin; i < end; ++i) {
+            auto row = result.row(i);
+            for (auto j : lhs.row(i)) row ^= rhs.row(j);
+        }
+    });
+    return result;
+}
+
+} // namespace gf2
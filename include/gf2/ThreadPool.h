@@ -0,0 +1,247 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// A small thread pool & the `Executor` concept used to spread the big bit-matrix computations over several cores. <br>
+/// See the [ThreadPool](docs/pages/ThreadPool.md) page for more details.
+
+#include <gf2/Unsigned.h>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gf2 {
+
+/// A fixed-size pool of worker threads that runs loops over index ranges in parallel.
+///
+/// The only real method is `parallel_for(n, grain, fn)` which splits `[0, n)` into chunks of `grain` indices and
+/// calls `fn(begin, end)` once per chunk. The calling thread joins in the work and the workers grab the next chunk
+/// from a shared counter once they are done with the previous one, so uneven chunks balance out across the threads.
+///
+/// The library uses a single global pool, `ThreadPool::global()`, when you pass the `gf2::par` tag to the parallel
+/// overloads of the bit-matrix methods. You can also pass your own pool (or anything else that satisfies the
+/// `gf2::Executor` concept) to those methods to control the number of threads used.
+///
+/// # Note
+/// A `parallel_for` call made from inside a running chunk just runs serially on the calling thread.
+///
+/// # Example
+/// ```
+/// ThreadPool pool{4};
+/// assert_eq(pool.size(), 4);
+/// std::vector<int> v(1000, 0);
+/// pool.parallel_for(v.size(), 10, [&](usize begin, usize end) {
+///     for (auto i = begin; i < end; ++i) v[i] = static_cast<int>(i);
+/// });
+/// for (auto i = 0uz; i < v.size(); ++i) assert_eq(v[i], static_cast<int>(i));
+/// ```
+class ThreadPool {
+public:
+    /// Constructs a pool that uses `n_threads` threads in total (the calling thread is one of them).
+    ///
+    /// The default uses all the hardware threads. A pool of size one runs everything on the calling thread.
+    explicit ThreadPool(usize n_threads = std::thread::hardware_concurrency()) {
+        for (auto i = 1uz; i < n_threads; ++i) m_workers.emplace_back([this] { work(); });
+    }
+
+    // The workers hold a pointer back to the pool so it cannot be copied or moved.
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    /// Stops the worker threads, waiting for them to finish.
+    ~ThreadPool() {
+        {
+            std::scoped_lock lock{m_mutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers) worker.join();
+    }
+
+    /// Returns the number of threads in the pool including the calling thread.
+    usize size() const { return m_workers.size() + 1; }
+
+    /// Calls `fn(begin, end)` on the chunks `[0, grain)`, `[grain, 2 * grain)`, ... which cover `[0, n)`.
+    ///
+    /// The chunks run in parallel on the pool threads and the call returns once they are all done.
+    /// The chunks all start on multiples of `grain` which lets callers line them up with word boundaries.
+    ///
+    /// # Panics
+    /// If `fn` throws then the chunks that have not started yet are skipped, and the first exception is rethrown on the
+    /// calling thread once all the pool threads are done. The pool can be used again after that.
+    ///
+    /// # Example
+    /// ```
+    /// ThreadPool pool{4};
+    /// std::string message;
+    /// try {
+    ///     pool.parallel_for(1000, 10, [&](usize begin, usize) {
+    ///         if (begin == 500) throw std::runtime_error("chunk failed");
+    ///     });
+    /// } catch (std::runtime_error const& e) { message = e.what(); }
+    /// assert_eq(message, "chunk failed");
+    /// auto sum = std::atomic<usize>{0};
+    /// pool.parallel_for(1000, 10, [&](usize begin, usize end) { sum += end - begin; });
+    /// assert_eq(sum.load(), 1000);
+    /// ```
+    void parallel_for(usize n, usize grain, std::function<void(usize, usize)> const& fn) {
+        if (n == 0) return;
+        grain = std::max(grain, 1uz);
+
+        // Not worth waking anyone up? Or are we already inside a parallel loop?
+        if (m_workers.empty() || n <= grain || t_busy) {
+            fn(0, n);
+            return;
+        }
+
+        // Only one loop at a time can use the pool.
+        std::scoped_lock submit{m_submit};
+        m_fn = &fn;
+        m_n = n;
+        m_grain = grain;
+        m_next.store(0);
+        {
+            std::scoped_lock lock{m_mutex};
+            m_pending = m_workers.size();
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        // The calling thread does its share of the chunks and then waits for the workers to finish theirs.
+        run_chunks();
+        std::unique_lock lock{m_mutex};
+        m_done.wait(lock, [this] { return m_pending == 0; });
+        m_fn = nullptr;
+        if (auto error = std::exchange(m_error, nullptr)) std::rethrow_exception(error);
+    }
+
+    /// Returns the pool used when the `gf2::par` tag is passed to the library methods.
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+private:
+    std::vector<std::thread>                 m_workers;
+    std::mutex                               m_submit;       // Serializes calls to `parallel_for`.
+    std::mutex                               m_mutex;        // Guards the fields below that the workers wait on.
+    std::condition_variable                  m_wake;         // Signals the workers that there is a new loop.
+    std::condition_variable                  m_done;         // Signals the caller that the workers are done.
+    usize                                    m_generation = 0;
+    usize                                    m_pending = 0;
+    bool                                     m_stop = false;
+    std::exception_ptr                       m_error;        // The first exception thrown by the current loop body.
+    std::function<void(usize, usize)> const* m_fn = nullptr; // The current loop body and its range.
+    usize                                    m_n = 0;
+    usize                                    m_grain = 1;
+    std::atomic<usize>                       m_next = 0;     // The start of the next unclaimed chunk.
+
+    // Set on any thread that is running chunks so nested loops run serially instead of deadlocking.
+    static inline thread_local bool t_busy = false;
+
+    // Marks the current thread as busy for as long as it lives.
+    struct BusyGuard {
+        BusyGuard() { t_busy = true; }
+        ~BusyGuard() { t_busy = false; }
+    };
+
+    // Keeps claiming and running chunks of the current loop until there are none left.
+    // An exception ends the loop early: it is kept for `parallel_for` to rethrow and the unclaimed chunks are dropped.
+    void run_chunks() noexcept {
+        BusyGuard busy;
+        try {
+            for (auto begin = m_next.fetch_add(m_grain); begin < m_n; begin = m_next.fetch_add(m_grain))
+                (*m_fn)(begin, std::min(begin + m_grain, m_n));
+        } catch (...) {
+            m_next.store(m_n);
+            std::scoped_lock lock{m_mutex};
+            if (!m_error) m_error = std::current_exception();
+        }
+    }
+
+    // The worker threads sleep until there is a new loop to help with (or the pool is shutting down).
+    void work() {
+        auto seen = 0uz;
+        while (true) {
+            {
+                std::unique_lock lock{m_mutex};
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+            }
+            run_chunks();
+            std::scoped_lock lock{m_mutex};
+            if (--m_pending == 0) m_done.notify_one();
+        }
+    }
+};
+
+/// The type of the `gf2::seq` tag that asks for a computation to run serially on the calling thread.
+struct Sequential {};
+
+/// The type of the `gf2::par` tag that asks for a computation to run on the threads of `ThreadPool::global()`.
+struct Parallel {};
+
+/// Pass `gf2::seq` as the executor of a bit-matrix method to have it run serially on the calling thread.
+inline constexpr Sequential seq{};
+
+/// Pass `gf2::par` as the executor of a bit-matrix method to have it run on the threads of `ThreadPool::global()`.
+///
+/// **Note:** We use our own tags instead of the `std::execution` policies because including `<execution>` drags in
+/// a link time dependency on TBB for some standard library builds.
+inline constexpr Parallel par{};
+
+/// The `Executor` concept covers the ways you can ask for a bit-matrix computation to run in parallel.
+///
+/// It is satisfied by the `gf2::seq` and `gf2::par` tags and by any type with `size()` and `parallel_for(n, grain, fn)`
+/// methods that work like those in `gf2::ThreadPool`.
+template<typename Exec>
+concept Executor = std::same_as<std::remove_cvref_t<Exec>, Sequential> ||
+                   std::same_as<std::remove_cvref_t<Exec>, Parallel> || requires(Exec& exec, usize n) {
+                       { exec.size() } -> std::convertible_to<usize>;
+                       exec.parallel_for(n, n, [](usize, usize) {});
+                   };
+
+} // namespace gf2
+
+namespace gf2::details {
+
+// Returns the number of threads that an executor will use.
+template<Executor Exec>
+inline usize
+concurrency(Exec const& exec) {
+    using tag = std::remove_cvref_t<Exec>;
+    if constexpr (std::same_as<tag, Sequential>) {
+        return 1;
+    } else if constexpr (std::same_as<tag, Parallel>) {
+        return ThreadPool::global().size();
+    } else {
+        return static_cast<usize>(exec.size());
+    }
+}
+
+// Runs `fn(begin, end)` over chunks of `[0, n)` that start on multiples of `grain` using the given executor.
+template<Executor Exec, typename Fn>
+inline void
+for_each_chunk(Exec&& exec, usize n, usize grain, Fn&& fn) {
+    using tag = std::remove_cvref_t<Exec>;
+    if constexpr (std::same_as<tag, Sequential>) {
+        if (n > 0) fn(0uz, n);
+    } else if constexpr (std::same_as<tag, Parallel>) {
+        ThreadPool::global().parallel_for(n, grain, fn);
+    } else {
+        exec.parallel_for(n, grain, fn);
+    }
+}
+
+} // namespace gf2::details
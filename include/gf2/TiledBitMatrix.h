@@ -0,0 +1,723 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Out-of-core bit-matrices kept on disk in square tiles that are eliminated a tile column at a time. <br>
+/// See the [TiledBitMatrix](docs/pages/TiledBitMatrix.md) page for more details.
+
+#include <gf2/BinaryIO.h>
+#include <gf2/BitMatrix.h>
+#include <gf2/BitVector.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gf2 {
+
+/// The I/O counters kept by a `gf2::TiledBitMatrix`.
+///
+/// The read times cover the reads on the background prefetch thread too, while `wait_seconds` is the time the calling
+/// thread actually spent blocked on reads. If prefetching hides the I/O then `wait_seconds` is much less than
+/// `read_seconds`.
+struct TiledIOStats {
+    /// The number of tiles read from disk.
+    usize tiles_read = 0;
+
+    /// The number of tiles written to disk.
+    usize tiles_written = 0;
+
+    /// The number of bytes read from disk.
+    usize bytes_read = 0;
+
+    /// The number of bytes written to disk.
+    usize bytes_written = 0;
+
+    /// The number of tile columns that were read ahead on a background thread.
+    usize prefetches = 0;
+
+    /// The total time in seconds spent reading from disk.
+    double read_seconds = 0;
+
+    /// The total time in seconds spent writing to disk.
+    double write_seconds = 0;
+
+    /// The time in seconds that the calling thread spent waiting for reads to finish.
+    double wait_seconds = 0;
+
+    /// Adds the counters from `rhs` to these.
+    TiledIOStats& operator+=(TiledIOStats const& rhs) {
+        tiles_read += rhs.tiles_read;
+        tiles_written += rhs.tiles_written;
+        bytes_read += rhs.bytes_read;
+        bytes_written += rhs.bytes_written;
+        prefetches += rhs.prefetches;
+        read_seconds += rhs.read_seconds;
+        write_seconds += rhs.write_seconds;
+        wait_seconds += rhs.wait_seconds;
+        return *this;
+    }
+};
+
+/// The row swaps and rank from factoring a `gf2::TiledBitMatrix` in place with `TiledBitMatrix::LU`.
+///
+/// The swaps are in the same LAPACK format as `BitLU::swaps`: row `j` was swapped with row `swaps[j]`.
+struct TiledLU {
+    /// The row swap instructions.
+    std::vector<usize> swaps;
+
+    /// The rank of the matrix as counted by the factorisation (the same as `BitLU::rank`).
+    usize rank = 0;
+
+    /// Returns `true` if the factored matrix is singular.
+    bool is_singular() const { return rank < swaps.size(); }
+
+    /// Returns the determinant of the factored matrix.
+    bool determinant() const { return !is_singular(); }
+};
+
+/// A dense bit-matrix that lives in a scratch file on disk so it can be larger than the available memory.
+///
+/// The matrix is cut into square `tile_size() x tile_size()` tiles of whole words. A tile column --- all the tiles in
+/// a run of `tile_size()` columns --- is a single contiguous run of the file, so it is read or written in one go.
+///
+/// The eliminations work a tile column at a time: the current column is factored in memory, then the row operations
+/// are applied to the tile columns to its right. Each of those is read on a background thread while the previous one
+/// is updated, so the disk and the processor are kept busy together. Only a few tile columns are in memory at once,
+/// which for an `m x n` matrix is about `4 * m * tile_size() / 8` bytes.
+///
+/// The scratch file is created (or truncated) by the constructor and removed by the destructor. Import and export go
+/// through the `gf2` binary file format, see `from_binary` and `write_binary`.
+///
+/// # Example
+/// ```
+/// auto path = std::filesystem::temp_directory_path() / "gf2_tiled_doc.tiles";
+/// auto A = BitMatrix<>::random(300, 200);
+/// auto T = TiledBitMatrix<>::from(A, path, 64);
+/// auto pivots = T.to_echelon_form();
+/// assert_eq(pivots, A.to_echelon_form());
+/// assert(T.stats().tiles_read > 0);
+/// ```
+template<Unsigned Word = usize>
+class TiledBitMatrix {
+public:
+    /// The default number of rows and columns in a tile.
+    static constexpr usize DEFAULT_TILE = 2048;
+
+    /// @name Constructors
+    /// @{
+
+    /// Creates the `m x n` zero matrix in a scratch file at `path` cut into tiles of `tile` rows and columns.
+    ///
+    /// As with a `gf2::BitMatrix`, a zero in either dimension gives the empty matrix.
+    ///
+    /// # Panics
+    /// Panics if `tile` is not a power of two that is at least `BITS<Word>`. Throws a `std::runtime_error` if the
+    /// scratch file can't be created.
+    ///
+    /// # Example
+    /// ```
+    /// auto path = std::filesystem::temp_directory_path() / "gf2_tiled_zeros_doc.tiles";
+    /// TiledBitMatrix<u32> T{path, 100, 150, 64};
+    /// assert_eq(T.rows(), 100);
+    /// assert_eq(T.cols(), 150);
+    /// assert_eq(T.to_matrix(), BitMatrix<u32>::zeros(100, 150));
+    /// assert(std::filesystem::exists(path));
+    /// ```
+    TiledBitMatrix(std::filesystem::path path, usize m, usize n, usize tile = DEFAULT_TILE) :
+        TiledBitMatrix(std::move(path), m, n, tile, true) {}
+
+    /// Returns a tiled copy of the bit-matrix `src` in a scratch file at `path`.
+    ///
+    /// # Example
+    /// ```
+    /// auto path = std::filesystem::temp_directory_path() / "gf2_tiled_from_doc.tiles";
+    /// auto A = BitMatrix<u8>::random(70, 90);
+    /// auto T = TiledBitMatrix<u8>::from(A, path, 32);
+    /// assert_eq(T.to_matrix(), A);
+    /// assert_eq(T.get(5, 80), A.get(5, 80));
+    /// ```
+    static TiledBitMatrix from(BitMatrix<Word> const& src, std::filesystem::path path, usize tile = DEFAULT_TILE) {
+        TiledBitMatrix result{std::move(path), src.rows(), src.cols(), tile};
+        result.fill_from(src);
+        return result;
+    }
+
+    /// Returns a tiled copy of the bit-matrix in the `gf2` binary file `binary` in a scratch file at `path`.
+    ///
+    /// The binary file is memory-mapped and copied over a band of `tile` rows at a time, so neither the source nor the
+    /// copy ever has to fit in memory. The binary file must have the native word layout for `Word`.
+    ///
+    /// # Panics
+    /// Throws a `std::runtime_error` if the binary file can't be mapped (see `gf2::MappedBitMatrix`) or the scratch
+    /// file can't be written.
+    ///
+    /// # Example
+    /// ```
+    /// auto dir = std::filesystem::temp_directory_path();
+    /// auto A = BitMatrix<>::random(200, 130);
+    /// {
+    ///     std::ofstream file{dir / "gf2_tiled_src_doc.bin", std::ios::binary};
+    ///     write_binary(file, A);
+    /// }
+    /// auto T = TiledBitMatrix<>::from_binary(dir / "gf2_tiled_src_doc.bin", dir / "gf2_tiled_bin_doc.tiles", 64);
+    /// assert_eq(T.to_matrix(), A);
+    /// std::filesystem::remove(dir / "gf2_tiled_src_doc.bin");
+    /// ```
+    static TiledBitMatrix from_binary(std::filesystem::path const& binary, std::filesystem::path path,
+                                      usize tile = DEFAULT_TILE) {
+        MappedBitMatrix<Word> view{binary};
+        TiledBitMatrix        result{std::move(path), view.rows(), view.cols(), tile};
+        result.fill_from(view);
+        return result;
+    }
+
+    /// Move constructor takes over the scratch file of `other`.
+    TiledBitMatrix(TiledBitMatrix&& other) noexcept :
+        m_path{std::exchange(other.m_path, {})},
+        m_file{std::move(other.m_file)},
+        m_rows{other.m_rows},
+        m_cols{other.m_cols},
+        m_tile{other.m_tile},
+        m_tile_rows{other.m_tile_rows},
+        m_tile_cols{other.m_tile_cols},
+        m_stats{other.m_stats} {}
+
+    /// Move assignment removes our own scratch file and takes over the one from `other`.
+    TiledBitMatrix& operator=(TiledBitMatrix&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_path = std::exchange(other.m_path, {});
+            m_file = std::move(other.m_file);
+            m_rows = other.m_rows;
+            m_cols = other.m_cols;
+            m_tile = other.m_tile;
+            m_tile_rows = other.m_tile_rows;
+            m_tile_cols = other.m_tile_cols;
+            m_stats = other.m_stats;
+        }
+        return *this;
+    }
+
+    TiledBitMatrix(TiledBitMatrix const&) = delete;
+    TiledBitMatrix& operator=(TiledBitMatrix const&) = delete;
+
+    /// The destructor closes and removes the scratch file.
+    ~TiledBitMatrix() { release(); }
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the number of rows in the bit-matrix.
+    usize rows() const { return m_rows; }
+
+    /// Returns the number of columns in the bit-matrix.
+    usize cols() const { return m_cols; }
+
+    /// Is this an empty bit-matrix?
+    bool is_empty() const { return m_rows == 0; }
+
+    /// Returns the number of rows and columns in each tile.
+    usize tile_size() const { return m_tile; }
+
+    /// Returns the path of the scratch file.
+    std::filesystem::path const& path() const { return m_path; }
+
+    /// Returns the I/O counters accumulated so far.
+    TiledIOStats const& stats() const { return m_stats; }
+
+    /// Resets the I/O counters.
+    void reset_stats() { m_stats = {}; }
+
+    /// Returns the element at row `i` and column `j`, which is read straight from the file.
+    ///
+    /// # Panics
+    /// In debug mode, this method panics if either index is out of bounds.
+    bool get(usize i, usize j) const {
+        gf2_debug_assert(i < m_rows, "Row index {} out of bounds [0,{})", i, m_rows);
+        gf2_debug_assert(j < m_cols, "Column index {} out of bounds [0,{})", j, m_cols);
+        auto [w, mask] = index_and_mask<Word>(j % m_tile);
+        auto at = offset(i / m_tile, j / m_tile) + std::streamoff(((i % m_tile) * row_words() + w) * sizeof(Word));
+        Word word = 0;
+        read_words(m_file, at, &word, 1, m_stats);
+        return word & mask;
+    }
+
+    /// @}
+    /// @name Conversions
+    /// @{
+
+    /// Returns an in-memory copy of the bit-matrix.
+    BitMatrix<Word> to_matrix() const {
+        auto result = BitMatrix<Word>::zeros(m_rows, m_cols);
+        auto n_words = words_needed<Word>(m_cols);
+        for (auto J = 0uz; J < m_tile_cols; ++J) {
+            auto block = read_column(m_file, J, 0, m_stats);
+            auto w0 = J * row_words();
+            auto len = std::min(row_words(), n_words - w0);
+            for (auto i = 0uz; i < m_rows; ++i)
+                std::copy_n(block.data() + i * row_words(), len, result.row(i).store() + w0);
+        }
+        return result;
+    }
+
+    /// @}
+    /// @name Elimination
+    /// @{
+
+    /// Transforms the bit-matrix to row-echelon form in place and returns a bit-vector showing the pivot columns.
+    ///
+    /// The elimination is blocked by tile column. The pivots of each tile column are found in memory working eight
+    /// columns at a time, and the resulting row operations are applied to each tile column to its right with one
+    /// Gray-code table lookup per row for each group of eight pivots. That needs one pass over the trailing tile
+    /// columns from the first non-pivot row down for each tile column. The echelon form is not unique.
+    ///
+    /// # Panics
+    /// Panics if the matrix is empty. Throws a `std::runtime_error` if the scratch file can't be read or written.
+    ///
+    /// # Example
+    /// ```
+    /// auto path = std::filesystem::temp_directory_path() / "gf2_tiled_echelon_doc.tiles";
+    /// auto A = BitMatrix<u16>::random(250, 300);
+    /// A.row(7).set_all(false);
+    /// auto T = TiledBitMatrix<u16>::from(A, path, 64);
+    /// auto pivots = T.to_echelon_form();
+    /// auto E = T.to_matrix();
+    /// assert_eq(pivots, A.to_echelon_form());
+    /// assert_eq(E.to_reduced_echelon_form(), A.to_reduced_echelon_form());
+    /// assert_eq(E, A);
+    /// ```
+    BitVector<Word> to_echelon_form() {
+        gf2_assert(!is_empty(), "Bit-matrix must not be empty");
+        return eliminate(false).first;
+    }
+
+    /// Returns the rank of the bit-matrix.
+    ///
+    /// The echelon form is worked out in a temporary copy of the scratch file next to it, so this needs the disk space
+    /// for a second copy of the matrix. The I/O for that is added to our counters. An empty bit-matrix has rank 0.
+    ///
+    /// # Example
+    /// ```
+    /// auto path = std::filesystem::temp_directory_path() / "gf2_tiled_rank_doc.tiles";
+    /// auto A = BitMatrix<u64>::random(200, 200);
+    /// A.row(3) = A.row(5);
+    /// auto T = TiledBitMatrix<u64>::from(A, path, 64);
+    /// assert_eq(T.rank(), A.rank());
+    /// assert_eq(T.to_matrix(), A);
+    /// ```
+    usize rank() const {
+        if (is_empty()) return 0;
+        m_file.flush();
+        auto copy_path = m_path;
+        copy_path += ".rank";
+        std::filesystem::copy_file(m_path, copy_path, std::filesystem::copy_options::overwrite_existing);
+        TiledBitMatrix copy{copy_path, m_rows, m_cols, m_tile, false};
+        auto           result = copy.to_echelon_form().count_ones();
+        m_stats += copy.m_stats;
+        return result;
+    }
+
+    /// Factors this square bit-matrix in place into the packed `[L\U]` form of its LU decomposition.
+    ///
+    /// Afterwards the matrix holds the same packed matrix as `BitLU::LU()` and the returned `TiledLU` has the same row
+    /// swaps and rank as the `BitLU` constructor. Each tile column is factored in memory, then its row swaps are
+    /// applied to the tile columns to its left and its eliminations to those on its right.
+    ///
+    /// # Panics
+    /// Panics if the matrix is not square. Throws a `std::runtime_error` if the scratch file can't be read or written.
+    ///
+    /// # Example
+    /// ```
+    /// auto path = std::filesystem::temp_directory_path() / "gf2_tiled_lu_doc.tiles";
+    /// auto A = BitMatrix<u8>::random(150, 150);
+    /// A.row(100).set_all(false);
+    /// auto T = TiledBitMatrix<u8>::from(A, path, 32);
+    /// auto lu = T.LU();
+    /// auto expected = A.LU();
+    /// assert_eq(T.to_matrix(), expected.LU());
+    /// assert_eq(lu.swaps, expected.swaps());
+    /// assert_eq(lu.rank, expected.rank());
+    /// assert(lu.is_singular());
+    /// ```
+    TiledLU LU() {
+        gf2_assert(!is_empty() && m_rows == m_cols, "Matrix is {} x {} but it should be square!", m_rows, m_cols);
+        auto [pivots, swaps] = eliminate(true);
+        return TiledLU{std::move(swaps), pivots.count_ones()};
+    }
+
+    /// @}
+
+    // The binary writer reads the tiles a band at a time.
+    template<Unsigned W>
+    friend void write_binary(std::ostream& os, TiledBitMatrix<W> const& m);
+
+private:
+    std::filesystem::path m_path;
+    mutable std::fstream  m_file;
+
+    // The dimensions of the bit-matrix, the side of a tile in bits, and the size of the grid of tiles.
+    usize m_rows = 0;
+    usize m_cols = 0;
+    usize m_tile = 0;
+    usize m_tile_rows = 0;
+    usize m_tile_cols = 0;
+
+    // The reads are counted by the const methods too.
+    mutable TiledIOStats m_stats;
+
+    // A tile column read on the background thread together with the counters for the read.
+    using column_read = std::pair<BitMatrix<Word>, TiledIOStats>;
+
+    // The row operations from factoring one tile column: the rows swapped in for each slot and the multipliers.
+    struct panel_ops {
+        usize              first = 0;
+        usize              slots = 0;
+        std::vector<usize> swaps;
+        BitMatrix<Word>    L;
+    };
+
+    // Sets up the tile grid & opens the scratch file at `path`, creating a zero filled one if `create` is set.
+    TiledBitMatrix(std::filesystem::path path, usize m, usize n, usize tile, bool create) :
+        m_path{std::move(path)}, m_tile{tile} {
+        gf2_assert(std::has_single_bit(tile) && tile >= BITS<Word>,
+                   "Tile size {} must be a power of two that is at least {}", tile, BITS<Word>);
+        if (m == 0 || n == 0) m = n = 0;
+        m_rows = m;
+        m_cols = n;
+        m_tile_rows = (m + tile - 1) / tile;
+        m_tile_cols = (n + tile - 1) / tile;
+        auto mode = std::ios::in | std::ios::out | std::ios::binary;
+        if (create) {
+            std::ofstream{m_path, std::ios::binary | std::ios::trunc};
+            std::filesystem::resize_file(m_path, m_tile_rows * m_tile_cols * tile_words() * sizeof(Word));
+        }
+        m_file.open(m_path, mode);
+        if (!m_file) throw std::runtime_error("Failed to open the scratch file '" + m_path.string() + "'.");
+    }
+
+    // Closes & removes the scratch file.
+    void release() {
+        if (m_path.empty()) return;
+        m_file.close();
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+        m_path.clear();
+    }
+
+    // The number of words in a row of a tile and in a whole tile.
+    usize row_words() const { return m_tile / BITS<Word>; }
+    usize tile_words() const { return m_tile * row_words(); }
+
+    // The position of tile `(I, J)` in the file. The tiles are stored a tile column at a time.
+    std::streamoff offset(usize I, usize J) const {
+        return std::streamoff((J * m_tile_rows + I) * tile_words() * sizeof(Word));
+    }
+
+    // Reads `n` words at position `at` of a stream, adding to the counters.
+    static void read_words(std::istream& is, std::streamoff at, Word* dst, usize n, TiledIOStats& stats) {
+        auto start = std::chrono::steady_clock::now();
+        is.seekg(at);
+        if (!is.read(reinterpret_cast<char*>(dst), std::streamsize(n * sizeof(Word))))
+            throw std::runtime_error("Failed to read from a gf2 tiled scratch file.");
+        stats.bytes_read += n * sizeof(Word);
+        stats.read_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Writes `n` words at position `at` of the scratch file, adding to the counters.
+    void write_words(std::streamoff at, Word const* src, usize n) {
+        auto start = std::chrono::steady_clock::now();
+        m_file.seekp(at);
+        if (!m_file.write(reinterpret_cast<char const*>(src), std::streamsize(n * sizeof(Word))))
+            throw std::runtime_error("Failed to write to the gf2 tiled scratch file '" + m_path.string() + "'.");
+        m_stats.bytes_written += n * sizeof(Word);
+        m_stats.write_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Reads the tiles in tile column `J` from tile row `I0` down as a block of whole tiles. Rows and columns past the
+    // end of the matrix are zero. The rows of the block are contiguous as the tile size is a power of two.
+    BitMatrix<Word> read_column(std::istream& is, usize J, usize I0, TiledIOStats& stats) const {
+        auto block = BitMatrix<Word>::zeros((m_tile_rows - I0) * m_tile, m_tile);
+        gf2_debug_assert_eq(block.stride(), row_words(), "Tile rows must be contiguous");
+        read_words(is, offset(I0, J), block.row(0).store(), block.rows() * row_words(), stats);
+        stats.tiles_read += m_tile_rows - I0;
+        return block;
+    }
+
+    // Writes a block read by `read_column` back to its place in the file.
+    void write_column(usize J, usize I0, BitMatrix<Word> const& block) {
+        write_words(offset(I0, J), block.data(), block.rows() * row_words());
+        m_stats.tiles_written += block.rows() / m_tile;
+    }
+
+    // Starts reading tile column `J` from tile row `I0` down on a background thread with a stream of its own.
+    std::future<column_read> prefetch(usize J, usize I0) const {
+        m_file.flush();
+        return std::async(std::launch::async, [this, J, I0] {
+            std::ifstream is{m_path, std::ios::binary};
+            TiledIOStats  stats;
+            auto          block = read_column(is, J, I0, stats);
+            stats.prefetches = 1;
+            return column_read{std::move(block), stats};
+        });
+    }
+
+    // Waits for a prefetched tile column, adding its counters & the time spent waiting.
+    BitMatrix<Word> collect(std::future<column_read>& pending) {
+        auto start = std::chrono::steady_clock::now();
+        auto [block, stats] = pending.get();
+        m_stats += stats;
+        m_stats.wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return std::move(block);
+    }
+
+    // Copies any source of rows with `Word` stores into the tiles a band of `m_tile` rows at a time.
+    template<typename Src>
+    void fill_from(Src const& src) {
+        auto n_words = words_needed<Word>(m_cols);
+        auto tile = std::pmr::vector<Word>(tile_words(), memory_resource());
+        for (auto I = 0uz; I < m_tile_rows; ++I) {
+            auto i1 = std::min(m_rows, (I + 1) * m_tile);
+            for (auto J = 0uz; J < m_tile_cols; ++J) {
+                std::fill(tile.begin(), tile.end(), Word{0});
+                auto w0 = J * row_words();
+                auto len = std::min(row_words(), n_words - w0);
+                for (auto i = I * m_tile; i < i1; ++i)
+                    std::copy_n(src.row(i).store() + w0, len, tile.data() + (i - I * m_tile) * row_words());
+                write_words(offset(I, J), tile.data(), tile.size());
+                m_stats.tiles_written++;
+            }
+        }
+        m_file.flush();
+    }
+
+    // Drops the top tiles of a block that starts at tile row `I0` so that it starts at tile row `I1` instead, writing
+    // the dropped tiles back to tile column `J` first.
+    BitMatrix<Word> trim(BitMatrix<Word>&& block, usize J, usize I0, usize I1) {
+        if (I1 == I0) return std::move(block);
+        auto top = (I1 - I0) * m_tile;
+        write_words(offset(I0, J), block.data(), top * row_words());
+        m_stats.tiles_written += I1 - I0;
+        auto result = BitMatrix<Word>::zeros(block.rows() - top, m_tile);
+        std::copy_n(block.data() + top * row_words(), result.rows() * row_words(), result.row(0).store());
+        return result;
+    }
+
+    // Applies the eliminations for the slots `[g0, g1)` (at most eight) of a factored tile column to the columns
+    // `[c0, m_tile)` of a block. The rows of the block from `first` hold the slots, and row `first + i` of the block
+    // has the multipliers in row `i` of `L`. Within the group the slot rows are brought up to date in order; after that
+    // each row below the group picks up its combination of the group rows with one Gray-code table lookup.
+    void apply_group(BitMatrix<Word>& block, usize h, usize first, BitMatrix<Word> const& L, usize g0, usize g1,
+                     usize c0) const {
+        auto k = g1 - g0;
+        if (k == 0 || c0 >= m_tile) return;
+        auto [w0, b0] = index_and_offset<Word>(c0);
+        auto lead = with_set_bits<Word>(b0, BITS<Word>);
+        auto len = row_words() - w0;
+        auto data = block.row(0).store();
+        auto row = [&](usize i) { return data + i * row_words() + w0; };
+        auto code_of = [&](usize i) { return static_cast<usize>(L.row(i - first).span(g0, g1).word(0)); };
+
+        // Bring the rows of the group up to date working down through it.
+        for (auto t = g0 + 1; t < g1; ++t) {
+            auto code = code_of(first + t);
+            for (auto s = g0; s < t; ++s) {
+                if (!((code >> (s - g0)) & 1)) continue;
+                auto src = row(first + s);
+                auto dst = row(first + t);
+                dst[0] ^= src[0] & lead;
+                for (auto l = 1uz; l < len; ++l) dst[l] ^= src[l];
+            }
+        }
+
+        // Gray-code table of all the combinations of the group rows.
+        auto table = std::pmr::vector<Word>((1uz << k) * len, Word{0}, memory_resource());
+        for (auto g = 1uz; g < (1uz << k); ++g) {
+            auto code = g ^ (g >> 1);
+            auto prev = (g - 1) ^ ((g - 1) >> 1);
+            auto src = row(first + g0 + static_cast<usize>(std::countr_zero(g)));
+            auto dst = table.data() + code * len;
+            auto old = table.data() + prev * len;
+            dst[0] = old[0] ^ (src[0] & lead);
+            for (auto l = 1uz; l < len; ++l) dst[l] = old[l] ^ src[l];
+        }
+
+        // Every row below the group needs just one table lookup.
+        auto index_mask = (1uz << k) - 1;
+        for (auto i = first + g1; i < h; ++i) {
+            auto code = code_of(i) & index_mask;
+            if (code == 0) continue;
+            auto src = table.data() + code * len;
+            auto dst = row(i);
+            for (auto l = 0uz; l < len; ++l) dst[l] ^= src[l];
+        }
+    }
+
+    // Factors the tile column `J` held in `block`, whose first `h` rows are rows of the matrix, from row `first` down.
+    //
+    // The columns are taken eight at a time. Within a group the pivot rows are swapped into place and eliminated in
+    // the group's word only, then `apply_group` brings the rest of the tile column up to date. For `lu` every column
+    // uses up a slot (a row) and the multipliers stay below the diagonal; otherwise only pivot columns use a slot and
+    // the rows below each pivot are cleared.
+    panel_ops factor(BitMatrix<Word>& block, usize h, usize first, usize J, bool lu, BitVector<Word>& pivots) const {
+        panel_ops ops{first, 0, {}, BitMatrix<Word>::zeros(h - first, m_tile)};
+        if (h == first) return ops;
+        auto ncols = std::min(m_tile, m_cols - J * m_tile);
+        auto data = block.row(0).store();
+        auto row = [&](usize i) { return data + i * row_words(); };
+        auto r = first;
+        for (auto c0 = 0uz; c0 < ncols && r < h; c0 += 8) {
+            auto c1 = std::min(c0 + 8, ncols);
+            auto g0 = ops.slots;
+            for (auto j = c0; j < c1 && r < h; ++j) {
+                auto [w, mask] = index_and_mask<Word>(j);
+                auto p = r;
+                while (p < h && !(row(p)[w] & mask)) ++p;
+                if (p == h) {
+                    if (lu) {
+                        ops.swaps.push_back(r);
+                        ops.slots++;
+                        r++;
+                    }
+                    continue;
+                }
+                pivots.set(J * m_tile + j);
+                block.swap_rows(r, p);
+                ops.L.swap_rows(r - first, p - first);
+                ops.swaps.push_back(p);
+
+                // Eliminate below the pivot in the rest of this group's columns (bits past the group are deferred).
+                auto end_bit = static_cast<u8>(bit_offset<Word>(c1 - 1) + 1);
+                auto lo = static_cast<u8>(bit_offset<Word>(j) + (lu ? 1 : 0));
+                auto clear = lo < end_bit ? with_set_bits<Word>(lo, end_bit) : Word{0};
+                auto pivot = row(r)[w] & clear;
+                for (auto i = r + 1; i < h; ++i) {
+                    if (!(row(i)[w] & mask)) continue;
+                    row(i)[w] = static_cast<Word>(row(i)[w] ^ pivot);
+                    ops.L.set(i - first, ops.slots);
+                }
+                ops.slots++;
+                r++;
+            }
+            apply_group(block, h, first, ops.L, g0, ops.slots, c1);
+        }
+        return ops;
+    }
+
+    // Applies the row swaps and then the eliminations of a factored tile column to another tile column.
+    void apply(BitMatrix<Word>& block, usize h, panel_ops const& ops, bool swaps_only) const {
+        for (auto t = 0uz; t < ops.swaps.size(); ++t) block.swap_rows(ops.first + t, ops.swaps[t]);
+        if (swaps_only) return;
+        for (auto g0 = 0uz; g0 < ops.slots; g0 += 8)
+            apply_group(block, h, ops.first, ops.L, g0, std::min(g0 + 8, ops.slots), 0);
+    }
+
+    // The blocked elimination shared by `to_echelon_form` & `LU`. Returns the pivot columns and, for `lu`, the swaps.
+    //
+    // Each pass factors one tile column and then updates the others it reaches, reading each one ahead on a background
+    // thread. The tile column to the right of the current one is updated last and kept in memory for the next pass.
+    std::pair<BitVector<Word>, std::vector<usize>> eliminate(bool lu) {
+        auto pivots = BitVector<Word>::zeros(m_cols);
+        auto swaps = std::vector<usize>{};
+        auto r = 0uz;
+
+        BitMatrix<Word> panel;
+        auto            base = 0uz;
+        auto            have_panel = false;
+        auto            panel_col = 0uz;
+        for (auto J = 0uz; J < m_tile_cols && r < m_rows; ++J) {
+            // Get this pass's tile column from row `r` down, reusing the one updated at the end of the last pass.
+            auto I0 = r / m_tile;
+            if (have_panel) {
+                panel = trim(std::move(panel), J, base, I0);
+            } else {
+                auto start = std::chrono::steady_clock::now();
+                panel = read_column(m_file, J, I0, m_stats);
+                m_stats.wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+            base = I0;
+            auto h = m_rows - base * m_tile;
+            auto ops = factor(panel, h, r - base * m_tile, J, lu, pivots);
+            for (auto p : ops.swaps) swaps.push_back(base * m_tile + p);
+            write_column(J, base, panel);
+
+            // The tile columns that the row operations reach: the swaps go left for LU, the eliminations go right.
+            std::vector<usize> todo;
+            if (lu)
+                for (auto c = 0uz; c < J; ++c) todo.push_back(c);
+            for (auto c = J + 2; c < m_tile_cols; ++c) todo.push_back(c);
+            if (J + 1 < m_tile_cols) todo.push_back(J + 1);
+
+            std::future<column_read> pending;
+            if (!todo.empty()) pending = prefetch(todo[0], base);
+            for (auto n = 0uz; n < todo.size(); ++n) {
+                auto c = todo[n];
+                auto block = collect(pending);
+                if (n + 1 < todo.size()) pending = prefetch(todo[n + 1], base);
+                apply(block, h, ops, c < J);
+                if (c == J + 1) {
+                    panel = std::move(block);
+                } else {
+                    write_column(c, base, block);
+                }
+            }
+            have_panel = J + 1 < m_tile_cols;
+            panel_col = J + 1;
+            r += ops.slots;
+        }
+        // If the elimination ran out of rows early, the updated next tile column still has to go back to disk.
+        if (have_panel) write_column(panel_col, base, panel);
+        m_file.flush();
+        return {std::move(pivots), std::move(swaps)};
+    }
+};
+
+/// Writes a tiled bit-matrix to a binary stream in the `gf2` binary format.
+///
+/// The tiles are read a band of `tile_size()` rows at a time and written out row by row, so the result is the same
+/// as writing the matrix with `write_binary(os, m.to_matrix())` but the whole matrix never has to be in memory.
+///
+/// # Panics
+/// This method throws a `std::runtime_error` if the stream fails or the scratch file can't be read.
+///
+/// # Example
+/// ```
+/// auto path = std::filesystem::temp_directory_path() / "gf2_tiled_write_doc.tiles";
+/// auto A = BitMatrix<u32>::random(100, 90);
+/// auto T = TiledBitMatrix<u32>::from(A, path, 32);
+/// std::stringstream ss;
+/// write_binary(ss, T);
+/// assert_eq(read_binary_matrix<u32>(ss), A);
+/// ```
+template<Unsigned Word>
+void
+write_binary(std::ostream& os, TiledBitMatrix<Word> const& m) {
+    BitMatrixWriter<Word> writer{os, m.rows(), m.cols()};
+    if (m.is_empty()) return;
+    auto n_words = words_needed<Word>(m.cols());
+    auto band = BitMatrix<Word>::zeros(m.m_tile, m.cols());
+    auto tile = std::pmr::vector<Word>(m.tile_words(), memory_resource());
+    for (auto I = 0uz; I < m.m_tile_rows; ++I) {
+        for (auto J = 0uz; J < m.m_tile_cols; ++J) {
+            TiledBitMatrix<Word>::read_words(m.m_file, m.offset(I, J), tile.data(), tile.size(), m.m_stats);
+            m.m_stats.tiles_read++;
+            auto w0 = J * m.row_words();
+            auto len = std::min(m.row_words(), n_words - w0);
+            for (auto i = 0uz; i < m.m_tile; ++i)
+                std::copy_n(tile.data() + i * m.row_words(), len, band.row(i).store() + w0);
+        }
+        auto i1 = std::min(m.rows(), (I + 1) * m.m_tile);
+        for (auto i = I * m.m_tile; i < i1; ++i) writer.write_row(band.row(i - I * m.m_tile));
+    }
+}
+
+} // namespace gf2
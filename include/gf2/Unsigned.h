@@ -8,6 +8,7 @@
 
 #include <gf2/assert.h>
 
+#include <array>
 #include <bit>
 #include <concepts>
 #include <cstdint>
@@ -16,6 +17,18 @@
 #include <utility>
 #include <type_traits>
 
+// Use the hardware carry-less multiply instructions if the target has them (see `gf2::clmul`).
+#if defined(__PCLMUL__)
+    #include <wmmintrin.h>
+#elif defined(__ARM_FEATURE_AES)
+    #include <arm_neon.h>
+#endif
+
+// Use the BMI2 bit-deposit instruction to riffle words if the target has it (see `gf2::riffle`).
+#if defined(__BMI2__)
+    #include <immintrin.h>
+#endif
+
 namespace gf2 {
 
 /// The `Unsigned` concept is the same as `std::unsigned_integral`.
@@ -233,6 +246,10 @@ reset_except_bits(Word& word, u8 begin, u8 end) {
 /// Reverses the order of bits in `word`. The least significant bit becomes the most significant bit, second
 /// least-significant bit becomes second most-significant bit, etc.
 ///
+/// Compilers that have the `__builtin_bitreverse` family (Clang) use it, which is a single `RBIT` instruction on ARM.
+/// Otherwise we reverse the bytes with `std::byteswap` and then the bits within every byte at once with three
+/// swap-and-mask steps (nibbles, then pairs, then single bits), so the cost doesn't grow with the number of bits.
+///
 /// # Example
 /// ```
 /// u32  n32 = 0x12345678;
@@ -247,9 +264,22 @@ reset_except_bits(Word& word, u8 begin, u8 end) {
 template<Unsigned Word>
 constexpr Word
 reverse_bits(Word word) {
-    Word result = 0;
-    for (u8 i = 0; i < BITS<Word>; ++i, word >>= 1) { result = static_cast<Word>((result << 1) | (word & 1)); }
-    return result;
+#if defined(__has_builtin)
+    #if __has_builtin(__builtin_bitreverse64)
+    if constexpr (BITS<Word> == 8) return __builtin_bitreverse8(word);
+    if constexpr (BITS<Word> == 16) return __builtin_bitreverse16(word);
+    if constexpr (BITS<Word> == 32) return __builtin_bitreverse32(word);
+    if constexpr (BITS<Word> == 64) return __builtin_bitreverse64(word);
+    #endif
+#endif
+    constexpr auto nibbles = static_cast<Word>(0x0F0F'0F0F'0F0F'0F0Full);
+    constexpr auto pairs = static_cast<Word>(0x3333'3333'3333'3333ull);
+    constexpr auto bits = static_cast<Word>(0x5555'5555'5555'5555ull);
+    if constexpr (BITS<Word> > 8) word = std::byteswap(word);
+    word = static_cast<Word>(((word >> 4) & nibbles) | ((word & nibbles) << 4));
+    word = static_cast<Word>(((word >> 2) & pairs) | ((word & pairs) << 2));
+    word = static_cast<Word>(((word >> 1) & bits) | ((word & bits) << 1));
+    return word;
 }
 
 /// Replace the bits of `word` in the range `[begin, end)` with the bits from `other` leaving the rest unchanged.
@@ -290,33 +320,149 @@ replace_bits(Word& word, u8 begin, u8 end, Other other)
 /// For example, if `self` is a `u8` with the binary representation `abcdefgh`, then on return `lo` will have the
 /// bits `0a0b0c0d` and `hi` will have the bits `0e0f0g0h`. The `lo` and `hi` words are returned in a tuple.
 ///
+/// This is what squares a `gf2::BitPolynomial` so it is worth making fast. When the compiler targets BMI2 (e.g.
+/// `-mbmi2` or `-march=native` on x86) we use the `PDEP` instruction to deposit the bits into the even positions.
+/// Otherwise, and in constant expressions, we use a portable sequence of shift-and-mask steps.
+///
+/// **Note:** `PDEP` is microcoded and slow on AMD processors before Zen 3, so don't target BMI2 for those.
+///
 /// # Example
 /// ```
 /// u8 word = 0b1111'1111;
 /// auto [lo, hi] = riffle(word);
 /// assert_eq(lo, 0b0101'0101);
 /// assert_eq(hi, 0b0101'0101);
+/// u64 w64 = 0xFFFF'FFFF'0000'0003;
+/// auto [lo64, hi64] = riffle(w64);
+/// assert_eq(lo64, 0b0101);
+/// assert_eq(hi64, 0x5555'5555'5555'5555);
 /// ```
 template<Unsigned Word>
 constexpr std::pair<Word, Word>
 riffle(Word word) {
+#if defined(__BMI2__)
+    if !consteval {
+        if constexpr (BITS<Word> <= 64) {
+            constexpr std::uint64_t evens = 0x5555'5555'5555'5555ull;
+            if constexpr (BITS<Word> == 64) {
+                auto lo = _pdep_u64(word & 0xFFFF'FFFFull, evens);
+                auto hi = _pdep_u64(word >> 32, evens);
+                return std::pair{static_cast<Word>(lo), static_cast<Word>(hi)};
+            } else {
+                // Smaller words riffle into a single 64-bit result.
+                auto r = _pdep_u64(word, evens);
+                return std::pair{static_cast<Word>(r), static_cast<Word>(r >> BITS<Word>)};
+            }
+        }
+    }
+#endif
     auto half_bits = BITS<Word> / 2;
     Word lo = word & (MAX<Word> >> half_bits);
     Word hi = word >> half_bits;
 
     // Some magic to interleave the respective halves with zeros starting with half the bits in each half.
-    Word one = 1;
-    auto shift = BITS<Word> / 4;
-    while (shift > 0) {
-        Word div = Word(one << shift) | one;
-        Word mask = MAX<Word> / div;
-        lo = (lo ^ (lo << shift)) & mask;
-        hi = (hi ^ (hi << shift)) & mask;
-        shift /= 2;
+    // The mask for a shift `s` is `MAX / (2^s + 1)` and we work those out at compile time.
+    constexpr auto n_steps = std::bit_width(static_cast<usize>(BITS<Word> / 4));
+    constexpr auto masks = [] {
+        std::array<Word, n_steps> result{};
+        for (auto i = 0uz; i < n_steps; ++i) {
+            Word div = Word(Word{1} << ((BITS<Word> / 4) >> i)) | Word{1};
+            result[i] = MAX<Word> / div;
+        }
+        return result;
+    }();
+    for (auto i = 0uz; i < n_steps; ++i) {
+        auto shift = (BITS<Word> / 4) >> i;
+        lo = (lo ^ (lo << shift)) & masks[i];
+        hi = (hi ^ (hi << shift)) & masks[i];
+    }
+    return std::pair{lo, hi};
+}
+
+/// @}
+/// @name Carry-less Multiplication:
+/// @{
+
+namespace details {
+
+// Portable carry-less multiply of two 64-bit words returning the low and high words of the 128-bit product.
+// We look up the products of `a` with four bits of `b` at a time -- the top three bits of `a` are left out of the
+// table so that nothing gets shifted out of it & those bits are handled separately at the end.
+constexpr std::pair<std::uint64_t, std::uint64_t>
+clmul64(std::uint64_t a, std::uint64_t b) {
+    std::uint64_t a0 = a & (MAX<std::uint64_t> >> 3);
+    std::uint64_t tab[16] = {0, a0};
+    for (auto i = 2uz; i < 16; ++i) tab[i] = (i & 1) ? tab[i - 1] ^ a0 : tab[i / 2] << 1;
+
+    std::uint64_t lo = tab[b & 15];
+    std::uint64_t hi = 0;
+    for (auto i = 4; i < 64; i += 4) {
+        auto t = tab[(b >> i) & 15];
+        lo ^= t << i;
+        hi ^= t >> (64 - i);
+    }
+    for (auto k = 61; k < 64; ++k) {
+        std::uint64_t mask = 0 - ((a >> k) & 1);
+        lo ^= (b << k) & mask;
+        hi ^= (b >> (64 - k)) & mask;
     }
     return std::pair{lo, hi};
 }
 
+} // namespace details
+
+/// Returns the carry-less product of two `Unsigned` words as a pair of words `lo` and `hi`.
+///
+/// Carry-less multiplication is ordinary long multiplication with the additions replaced by `XOR` -- it is the product
+/// of the two words seen as polynomials over GF(2). The product of two `n` bit words has up to `2n - 1` bits and is
+/// returned as the low and high `n` bits.
+///
+/// The method uses the `PCLMULQDQ` instruction on x86 and `PMULL` on ARM when the compiler targets those, and a small
+/// table based method otherwise.
+///
+/// # Example
+/// ```
+/// auto [lo, hi] = clmul(u8{0b0000'0011}, u8{0b0000'0011});
+/// assert_eq(lo, 0b0000'0101);
+/// assert_eq(hi, 0);
+/// auto [lo8, hi8] = clmul(u8{0b1000'0001}, u8{0b1000'0000});
+/// assert_eq(lo8, 0b1000'0000);
+/// assert_eq(hi8, 0b0100'0000);
+/// auto [lo64, hi64] = clmul(u64{0xFFFF'FFFF'FFFF'FFFF}, u64{2});
+/// assert_eq(lo64, 0xFFFF'FFFF'FFFF'FFFE);
+/// assert_eq(hi64, 1);
+/// ```
+template<Unsigned Word>
+constexpr std::pair<Word, Word>
+clmul(Word a, Word b) {
+    std::pair<std::uint64_t, std::uint64_t> product;
+    if consteval {
+        product = details::clmul64(a, b);
+    } else {
+#if defined(__PCLMUL__)
+        auto x = _mm_cvtsi64_si128(static_cast<long long>(a));
+        auto y = _mm_cvtsi64_si128(static_cast<long long>(b));
+        auto p = _mm_clmulepi64_si128(x, y, 0);
+        product.first = static_cast<std::uint64_t>(_mm_cvtsi128_si64(p));
+        product.second = static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(p, p)));
+#elif defined(__ARM_FEATURE_AES)
+        auto p = vreinterpretq_u64_p128(vmull_p64(static_cast<poly64_t>(a), static_cast<poly64_t>(b)));
+        product.first = vgetq_lane_u64(p, 0);
+        product.second = vgetq_lane_u64(p, 1);
+#else
+        product = details::clmul64(a, b);
+#endif
+    }
+    auto [lo, hi] = product;
+
+    // Smaller words have the whole product in `lo`.
+    if constexpr (BITS<Word> == 64) {
+        return std::pair{static_cast<Word>(lo), static_cast<Word>(hi)};
+    } else {
+        return std::pair{static_cast<Word>(lo), static_cast<Word>(lo >> BITS<Word>)};
+    }
+}
+
 /// @}
 /// @name Bit Counts:
 /// @{
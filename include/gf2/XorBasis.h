@@ -0,0 +1,328 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// An incremental basis for the linear span of a stream of bit-vectors. <br>
+/// See the [XorBasis](docs/pages/XorBasis.md) page for more details.
+
+#include <gf2/BitMatrix.h>
+#include <gf2/MemoryScope.h>
+
+#include <algorithm>
+#include <bit>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace gf2 {
+
+/// An incremental basis for the span of all the bit-vectors of a fixed size that have been inserted into it.
+///
+/// This is the data structure behind questions like "is this new vector a combination of the ones we've already seen,
+/// and if not, add it". Rebuilding a bit-matrix and running Gaussian elimination for each new vector costs a full
+/// elimination every time. Here each basis vector is stored with its _leading bit_ (its first set bit) as its pivot and
+/// no two basis vectors share a pivot. That is exactly the row echelon form, one row at a time.
+///
+/// Reducing a vector against the basis then walks through its set bits from the left. Whenever a bit is the pivot of a
+/// basis vector, that vector is added in. As a basis vector is zero before its pivot, only the words from the one
+/// holding the pivot onwards are touched. So `reduce`, `contains`, and `insert` each cost at most `rank()` word-level
+/// row additions, and an insertion just appends one row to the store.
+///
+/// Insertions only ever append, so `rank()` doubles as a cheap snapshot: `rollback(r)` drops every vector that was
+/// added after the rank was `r`. The class also has the usual value semantics so a full copy is another snapshot.
+///
+/// # Example
+/// ```
+/// XorBasis<> basis{4};
+/// assert(basis.insert(BitVector<>::from_string("1100").value()));
+/// assert(basis.insert(BitVector<>::from_string("0110").value()));
+/// assert(!basis.insert(BitVector<>::from_string("1010").value()));
+/// assert_eq(basis.rank(), 2);
+/// assert(basis.contains(BitVector<>::from_string("0000").value()));
+/// assert(!basis.contains(BitVector<>::from_string("0001").value()));
+/// assert_eq(basis.reduce(BitVector<>::from_string("1111").value()).to_string(), "0011");
+/// ```
+template<Unsigned Word = usize>
+class XorBasis {
+private:
+    // Every vector has this many elements.
+    usize m_dim = 0;
+
+    // The number of words per basis vector.
+    usize m_stride = 0;
+
+    // Basis vector `k` occupies the words `[k * m_stride, (k + 1) * m_stride)` & has its leading bit at `m_pivots[k]`.
+    std::pmr::vector<Word>  m_words{memory_resource()};
+    std::pmr::vector<usize> m_pivots{memory_resource()};
+
+    // `m_row_for[j]` is the basis vector whose leading bit is `j` or `npos` if there isn't one.
+    std::pmr::vector<usize> m_row_for{memory_resource()};
+
+    static constexpr usize npos = static_cast<usize>(-1);
+
+public:
+    /// The underlying unsigned word type used to store the bits.
+    using word_type = Word;
+
+    /// @name Constructors
+    /// @{
+
+    /// The default constructor creates a basis for the trivial space of vectors with no elements.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis;
+    /// assert_eq(basis.dim(), 0);
+    /// assert_eq(basis.rank(), 0);
+    /// ```
+    XorBasis() = default;
+
+    /// Constructs an empty basis for vectors with `n` elements.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<u8> basis{10};
+    /// assert_eq(basis.dim(), 10);
+    /// assert_eq(basis.is_empty(), true);
+    /// ```
+    explicit XorBasis(usize n) : m_dim{n}, m_stride{words_needed<Word>(n)} { m_row_for.assign(n, npos); }
+
+    /// Constructs the basis for the span of the rows of a bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<>::random(30, 50);
+    /// XorBasis<> basis{m};
+    /// assert_eq(basis.dim(), 50);
+    /// assert_eq(basis.rank(), m.rank());
+    /// ```
+    explicit XorBasis(BitMatrix<Word> const& m) : XorBasis(m.cols()) {
+        for (auto i = 0uz; i < m.rows(); ++i) insert(m.row(i));
+    }
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// Returns the number of elements in the vectors that the basis works with.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{7};
+    /// assert_eq(basis.dim(), 7);
+    /// ```
+    constexpr usize dim() const { return m_dim; }
+
+    /// Returns the number of vectors in the basis which is the dimension of the span of everything inserted so far.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{3};
+    /// basis.insert(BitVector<>::ones(3));
+    /// basis.insert(BitVector<>::ones(3));
+    /// assert_eq(basis.rank(), 1);
+    /// ```
+    constexpr usize rank() const { return m_pivots.size(); }
+
+    /// Returns `true` if the basis has no vectors so it spans just the zero vector.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{3};
+    /// assert(basis.is_empty());
+    /// basis.insert(BitVector<>::zeros(3));
+    /// assert(basis.is_empty());
+    /// ```
+    constexpr bool is_empty() const { return m_pivots.empty(); }
+
+    /// Returns `true` if the basis spans every vector of its dimension.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{BitMatrix<>::identity(5)};
+    /// assert(basis.is_full());
+    /// ```
+    constexpr bool is_full() const { return rank() == m_dim; }
+
+    /// Returns the leading bits of the basis vectors in the order that the vectors were added.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{4};
+    /// basis.insert(BitVector<>::from_string("0011").value());
+    /// basis.insert(BitVector<>::from_string("1100").value());
+    /// assert_eq(basis.pivots()[0], 2);
+    /// assert_eq(basis.pivots()[1], 0);
+    /// ```
+    constexpr std::span<usize const> pivots() const { return m_pivots; }
+
+    /// Returns a read-only view of basis vector `k`.
+    ///
+    /// # Panics
+    /// In debug mode, this method panics if `k` is out of bounds.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{4};
+    /// basis.insert(BitVector<>::from_string("0110").value());
+    /// assert_eq(basis.vector(0).to_string(), "0110");
+    /// ```
+    BitSpan<Word const> vector(usize k) const {
+        gf2_debug_assert(k < rank(), "Basis vector index {} out of bounds [0,{})", k, rank());
+        return BitSpan<Word const>{m_words.data() + k * m_stride, 0, m_dim};
+    }
+
+    /// Returns a bit-matrix whose rows are the basis vectors in the order that they were added.
+    ///
+    /// The rows are in row echelon form once they are sorted by their leading bits. If the basis is empty so is the
+    /// bit-matrix.
+    ///
+    /// # Example
+    /// ```
+    /// auto m = BitMatrix<u32>::random(20, 40);
+    /// XorBasis<u32> basis{m};
+    /// auto b = basis.basis();
+    /// assert_eq(b.rows(), m.rank());
+    /// assert_eq(b.rank(), b.rows());
+    /// for (auto i = 0uz; i < m.rows(); ++i) assert(basis.contains(m.row(i)));
+    /// ```
+    BitMatrix<Word> basis() const {
+        auto result = BitMatrix<Word>::zeros(rank(), m_dim);
+        for (auto k = 0uz; k < rank(); ++k) result.row(k).copy(vector(k));
+        return result;
+    }
+
+    /// @}
+    /// @name Reduction & Insertion
+    /// @{
+
+    /// Returns what is left of `v` after adding in the basis vectors that clear its bits at their leading positions.
+    ///
+    /// The result is zero exactly when `v` is in the span of the basis. Otherwise its first set bit is not the leading
+    /// bit of any basis vector.
+    ///
+    /// # Panics
+    /// We check that `v` has `dim()` elements unless `NDEBUG` is defined.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{5};
+    /// basis.insert(BitVector<>::from_string("11000").value());
+    /// basis.insert(BitVector<>::from_string("00110").value());
+    /// assert_eq(basis.reduce(BitVector<>::from_string("11110").value()).to_string(), "00000");
+    /// assert_eq(basis.reduce(BitVector<>::from_string("10101").value()).to_string(), "01011");
+    /// ```
+    template<BitStore Store>
+        requires std::same_as<typename Store::word_type, Word>
+    BitVector<Word> reduce(Store const& v) const {
+        gf2_assert_eq(v.size(), m_dim, "Vector has {} elements but the basis is for {} elements.", v.size(), m_dim);
+        auto result = BitVector<Word>::from(v);
+        reduce_words(result.store());
+        return result;
+    }
+
+    /// Returns `true` if `v` is in the span of the basis vectors.
+    ///
+    /// # Panics
+    /// We check that `v` has `dim()` elements unless `NDEBUG` is defined.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{3};
+    /// basis.insert(BitVector<>::from_string("110").value());
+    /// assert(basis.contains(BitVector<>::from_string("110").value()));
+    /// assert(basis.contains(BitVector<>::from_string("000").value()));
+    /// assert(!basis.contains(BitVector<>::from_string("011").value()));
+    /// ```
+    template<BitStore Store>
+        requires std::same_as<typename Store::word_type, Word>
+    bool contains(Store const& v) const {
+        return reduce(v).none();
+    }
+
+    /// Adds `v` to the basis if it is not already in the span and returns `true` if it was added.
+    ///
+    /// What gets stored is the reduced form of `v` so the basis stays in echelon form.
+    ///
+    /// # Panics
+    /// We check that `v` has `dim()` elements unless `NDEBUG` is defined.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<u16> basis{20};
+    /// auto n_added = 0uz;
+    /// for (auto i = 0; i < 100; ++i) n_added += basis.insert(BitVector<u16>::random(20));
+    /// assert_eq(n_added, basis.rank());
+    /// assert(basis.rank() <= 20);
+    /// ```
+    template<BitStore Store>
+        requires std::same_as<typename Store::word_type, Word>
+    bool insert(Store const& v) {
+        auto reduced = reduce(v);
+        auto pivot = reduced.first_set();
+        if (!pivot) return false;
+        m_row_for[*pivot] = rank();
+        m_pivots.push_back(*pivot);
+        m_words.insert(m_words.end(), reduced.store(), reduced.store() + m_stride);
+        return true;
+    }
+
+    /// @}
+    /// @name Snapshots
+    /// @{
+
+    /// Drops every basis vector that was added after the rank was `r` so the basis is back to what it was then.
+    ///
+    /// Does nothing if `r` is at least the current rank.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{3};
+    /// basis.insert(BitVector<>::from_string("100").value());
+    /// auto snapshot = basis.rank();
+    /// basis.insert(BitVector<>::from_string("010").value());
+    /// assert(basis.contains(BitVector<>::from_string("110").value()));
+    /// basis.rollback(snapshot);
+    /// assert_eq(basis.rank(), 1);
+    /// assert(!basis.contains(BitVector<>::from_string("110").value()));
+    /// ```
+    void rollback(usize r) {
+        if (r >= rank()) return;
+        for (auto k = r; k < rank(); ++k) m_row_for[m_pivots[k]] = npos;
+        m_pivots.resize(r);
+        m_words.resize(r * m_stride);
+    }
+
+    /// Removes all the vectors from the basis.
+    ///
+    /// # Example
+    /// ```
+    /// XorBasis<> basis{BitMatrix<>::identity(3)};
+    /// basis.clear();
+    /// assert(basis.is_empty());
+    /// assert_eq(basis.dim(), 3);
+    /// ```
+    void clear() { rollback(0); }
+
+    /// @}
+
+private:
+    // Reduces the `m_stride` words at `x` against the basis vectors in-place.
+    // We run through the set bits of each word from the right. Adding in the basis vector with that leading bit clears
+    // it and can only change the bits after it, so we keep track of which bits in the word we have already dealt with.
+    void reduce_words(Word* x) const {
+        for (auto w = 0uz; w < m_stride; ++w) {
+            auto done = Word{0};
+            while (auto pending = static_cast<Word>(x[w] & ~done)) {
+                auto bit = static_cast<usize>(std::countr_zero(pending));
+                auto low = static_cast<Word>(ONE<Word> << bit);
+                done = static_cast<Word>(done | low | (low - 1));
+                if (auto k = m_row_for[w * BITS<Word> + bit]; k != npos)
+                    details::simd::xor_into(x + w, m_words.data() + k * m_stride + w, m_stride - w);
+            }
+        }
+    }
+};
+
+} // namespace gf2
@@ -9,6 +9,7 @@
 
 // Utilities.
 #include <gf2/assert.h>
+#include <gf2/instrument.h>
 #include <gf2/Unsigned.h>
 
 // The vector-like types & the bit-store concept they all satisfy.
@@ -30,3 +31,45 @@
 #include <gf2/BitMatrix.h>
 #include <gf2/BitLU.h>
 #include <gf2/BitGauss.h>
+
+// Fixed-size bit-matrices that never allocate
+#include <gf2/BitMatrixN.h>
+
+// Batched inverses, solves, ranks & products for many small bit-matrices
+#include <gf2/Batch.h>
+
+// Bit-matrices resident on an offload device such as a GPU
+#include <gf2/DeviceMatrix.h>
+
+// Column-major bit-matrices for column-heavy algorithms
+#include <gf2/ColMatrix.h>
+
+// Sparse bit-matrices & their Block Lanczos solver
+#include <gf2/SparseBitMatrix.h>
+
+// Incremental bases for the span of a stream of bit-vectors
+#include <gf2/XorBasis.h>
+
+// Word-parallel linear feedback shift registers with jump-ahead
+#include <gf2/Lfsr.h>
+
+// Arithmetic in the extension fields GF(2^m) with one word per element
+#include <gf2/GF2m.h>
+
+// Cyclic redundancy checks for any generator polynomial of degree up to 64
+#include <gf2/CrcEngine.h>
+
+// The thread pool used by the parallel versions of the bit-matrix algorithms
+#include <gf2/ThreadPool.h>
+
+// The random number engines used for random fills
+#include <gf2/RNG.h>
+
+// The binary file format, streaming writers & memory-mapped views
+#include <gf2/BinaryIO.h>
+
+// Out-of-core bit-matrices kept on disk in tiles
+#include <gf2/TiledBitMatrix.h>
+
+// Per-thread memory resource selection for the library's allocations
+#include <gf2/MemoryScope.h>
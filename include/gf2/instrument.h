@@ -0,0 +1,359 @@
+#pragma once
+// SPDX-FileCopyrightText: 2026 Nessan Fitzmaurice <nzznfitz+gh@icloud.com>
+// SPDX-License-Identifier: MIT
+
+/// @file
+/// Macros that instrument the hot paths of the library when the `GF2_INSTRUMENT` flag is set. <br>
+/// See the [Instrumentation](docs/pages/instrument.md) page for all the details.
+
+#include <gf2/Unsigned.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Avoid macro redefinition warnings ...
+#ifdef gf2_probe
+    #undef gf2_probe
+#endif
+#ifdef gf2_count_words
+    #undef gf2_count_words
+#endif
+#ifdef gf2_count_allocation
+    #undef gf2_count_allocation
+#endif
+
+/// A macro that opens a probe named `name` which lasts until the end of the enclosing block. <br>
+/// The probe records the wall time of the block along with everything counted on this thread while it is open.
+///
+/// @note The `gf2_probe` macro expands to a no-op **unless** the `GF2_INSTRUMENT` flag is set.
+///
+/// The name must be a string literal (or anything else that lives for the whole program). There can be at most one
+/// probe per block.
+#ifdef GF2_INSTRUMENT
+    #define gf2_probe(name)                                               \
+        static gf2::instrument::details::Site gf2_probe_site_{name};      \
+        gf2::instrument::details::Probe       gf2_probe_{gf2_probe_site_}
+#else
+    #define gf2_probe(name) void(0)
+#endif
+
+/// A macro that adds `ops` word operations touching `bytes` bytes of memory to the innermost open probe. <br>
+///
+/// @note The `gf2_count_words` macro expands to a no-op **unless** the `GF2_INSTRUMENT` flag is set, in which case
+/// the arguments are not evaluated at all.
+#ifdef GF2_INSTRUMENT
+    #define gf2_count_words(ops, bytes)                                              \
+        do {                                                                         \
+            if !consteval { gf2::instrument::details::count_words((ops), (bytes)); } \
+        } while (0)
+#else
+    #define gf2_count_words(ops, bytes) void(0)
+#endif
+
+/// A macro that adds one heap allocation of `bytes` bytes to the innermost open probe. <br>
+///
+/// @note The `gf2_count_allocation` macro expands to a no-op **unless** the `GF2_INSTRUMENT` flag is set.
+#ifdef GF2_INSTRUMENT
+    #define gf2_count_allocation(bytes)                                          \
+        do {                                                                     \
+            if !consteval { gf2::instrument::details::count_allocation(bytes); } \
+        } while (0)
+#else
+    #define gf2_count_allocation(bytes) void(0)
+#endif
+
+namespace gf2::instrument {
+
+/// Is the instrumentation compiled in? That is the case if the `GF2_INSTRUMENT` flag is set.
+#ifdef GF2_INSTRUMENT
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+/// The running totals kept for each probe name.
+///
+/// The counts include everything done inside nested probes. A probe that is opened again inside itself, as in a
+/// recursive algorithm, is folded into the outer one, so `calls` and `time` count the outermost calls only.
+struct Counters {
+    /// The number of calls.
+    u64 calls = 0;
+
+    /// The number of word operations in the bulk kernels (each `XOR`, `AND`, carry-less product, etc. of a word).
+    u64 word_ops = 0;
+
+    /// The number of bytes those word operations read or wrote.
+    u64 bytes = 0;
+
+    /// The number of heap allocations made for the words of bit-vectors, bit-matrices and bit-polynomials.
+    u64 allocations = 0;
+
+    /// The total size in bytes of those heap allocations.
+    u64 allocated_bytes = 0;
+
+    /// The total wall time.
+    std::chrono::nanoseconds time{0};
+
+    /// Adds another set of counters to this one.
+    constexpr Counters& operator+=(Counters const& rhs) {
+        calls += rhs.calls;
+        word_ops += rhs.word_ops;
+        bytes += rhs.bytes;
+        allocations += rhs.allocations;
+        allocated_bytes += rhs.allocated_bytes;
+        time += rhs.time;
+        return *this;
+    }
+};
+
+/// The totals for one probe name returned by `gf2::instrument::snapshot`.
+struct Record {
+    /// The name of the probe.
+    std::string_view name;
+
+    /// The totals for all the probes with that name.
+    Counters counters;
+};
+
+/// A `Tracer` gets a callback as each probe opens and closes, which is the hook for tools like Perfetto or
+/// OpenTelemetry.
+///
+/// The callbacks run on the thread that opened the probe, in properly nested order on each thread. The `exit`
+/// callback gets the counts for that one call.
+///
+/// # Example
+/// ```
+/// struct Depth : instrument::Tracer {
+///     int depth = 0, max_depth = 0;
+///     void enter(std::string_view) override { max_depth = std::max(max_depth, ++depth); }
+///     void exit(std::string_view, instrument::Counters const&) override { --depth; }
+/// };
+/// Depth tracer;
+/// instrument::set_tracer(&tracer);
+/// auto A = BitMatrix<>::random(100, 100);
+/// auto B = dot(A, A);
+/// instrument::set_tracer(nullptr);
+/// assert_eq(tracer.depth, 0);
+/// assert_eq(tracer.max_depth > 0, instrument::enabled);
+/// ```
+class Tracer {
+public:
+    virtual ~Tracer() = default;
+
+    /// Called as a probe named `name` opens.
+    virtual void enter(std::string_view name) { (void)name; }
+
+    /// Called as a probe named `name` closes with the counts for the call.
+    virtual void exit(std::string_view name, Counters const& counters) {
+        (void)name;
+        (void)counters;
+    }
+};
+
+namespace details {
+
+// The tracer that gets the callbacks (null if there isn't one).
+inline std::atomic<Tracer*>&
+current_tracer() noexcept {
+    static std::atomic<Tracer*> tracer = nullptr;
+    return tracer;
+}
+
+// Each `gf2_probe` site has one of these static records. They are kept in a lock-free list that is never shrunk.
+struct Site {
+    std::string_view name;
+    std::atomic<u64> calls = 0;
+    std::atomic<u64> word_ops = 0;
+    std::atomic<u64> bytes = 0;
+    std::atomic<u64> allocations = 0;
+    std::atomic<u64> allocated_bytes = 0;
+    std::atomic<u64> nanoseconds = 0;
+    Site*            next = nullptr;
+
+    static std::atomic<Site*>& head() noexcept {
+        static std::atomic<Site*> head = nullptr;
+        return head;
+    }
+
+    explicit Site(std::string_view site_name) noexcept : name(site_name) {
+        next = head().load(std::memory_order_relaxed);
+        while (!head().compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    void add(Counters const& c) noexcept {
+        calls.fetch_add(c.calls, std::memory_order_relaxed);
+        word_ops.fetch_add(c.word_ops, std::memory_order_relaxed);
+        bytes.fetch_add(c.bytes, std::memory_order_relaxed);
+        allocations.fetch_add(c.allocations, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(c.allocated_bytes, std::memory_order_relaxed);
+        nanoseconds.fetch_add(static_cast<u64>(c.time.count()), std::memory_order_relaxed);
+    }
+
+    Counters counters() const noexcept {
+        Counters result;
+        result.calls = calls.load(std::memory_order_relaxed);
+        result.word_ops = word_ops.load(std::memory_order_relaxed);
+        result.bytes = bytes.load(std::memory_order_relaxed);
+        result.allocations = allocations.load(std::memory_order_relaxed);
+        result.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+        result.time = std::chrono::nanoseconds{nanoseconds.load(std::memory_order_relaxed)};
+        return result;
+    }
+
+    void reset() noexcept {
+        for (auto* a : {&calls, &word_ops, &bytes, &allocations, &allocated_bytes, &nanoseconds})
+            a->store(0, std::memory_order_relaxed);
+    }
+};
+
+class Probe;
+
+// The innermost open probe on this thread (null if there isn't one).
+inline Probe*&
+current_probe() noexcept {
+    static thread_local Probe* probe = nullptr;
+    return probe;
+}
+
+// The RAII object behind the `gf2_probe` macro. It counts for the innermost probe & hands its counts to the enclosing
+// one when it closes, so the totals are inclusive.
+class Probe {
+public:
+    explicit Probe(Site& site) noexcept : m_site(site), m_parent(current_probe()) {
+        // A probe nested inside another one for the same site is folded into that outer one.
+        for (auto p = m_parent; p != nullptr; p = p->m_parent)
+            if (&p->m_site == &site) m_nested = true;
+        current_probe() = this;
+        if (auto tracer = current_tracer().load(std::memory_order_acquire)) tracer->enter(site.name);
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    ~Probe() {
+        m_counters.calls = 1;
+        m_counters.time = std::chrono::steady_clock::now() - m_start;
+        if (auto tracer = current_tracer().load(std::memory_order_acquire)) tracer->exit(m_site.name, m_counters);
+        if (!m_nested) m_site.add(m_counters);
+        current_probe() = m_parent;
+        if (m_parent != nullptr) {
+            m_counters.calls = 0;
+            m_counters.time = {};
+            m_parent->m_counters += m_counters;
+        }
+    }
+
+    // A probe is tied to the stack frame that opened it.
+    Probe(Probe const&) = delete;
+    Probe& operator=(Probe const&) = delete;
+
+    Counters& counters() noexcept { return m_counters; }
+
+private:
+    Site&                                 m_site;
+    Probe*                                m_parent;
+    bool                                  m_nested = false;
+    Counters                              m_counters;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Adds `ops` word operations on `bytes` bytes to the innermost open probe on this thread.
+inline void
+count_words(u64 ops, u64 bytes) noexcept {
+    if (auto probe = current_probe()) {
+        probe->counters().word_ops += ops;
+        probe->counters().bytes += bytes;
+    }
+}
+
+// Adds a heap allocation of `bytes` bytes to the innermost open probe on this thread.
+inline void
+count_allocation(u64 bytes) noexcept {
+    if (auto probe = current_probe()) {
+        probe->counters().allocations += 1;
+        probe->counters().allocated_bytes += bytes;
+    }
+}
+
+} // namespace details
+
+/// Installs a tracer that gets a callback as each probe opens and closes (pass `nullptr` to remove it).
+///
+/// The tracer must outlive its installation. It is shared by all threads so its callbacks must be thread-safe if
+/// probes can open on several threads at once.
+inline void
+set_tracer(Tracer* tracer) noexcept {
+    details::current_tracer().store(tracer, std::memory_order_release);
+}
+
+/// Returns the totals for each probe name that has been hit since the last `reset()`, sorted by name.
+///
+/// Without the `GF2_INSTRUMENT` flag there are no probes and the result is always empty.
+///
+/// # Example
+/// ```
+/// instrument::reset();
+/// auto A = BitMatrix<>::random(200, 200);
+/// auto pivots = A.to_echelon_form();
+/// auto stats = instrument::snapshot();
+/// if (instrument::enabled) {
+///     auto it = std::ranges::find(stats, "BitMatrix::to_echelon_form", &instrument::Record::name);
+///     assert(it != stats.end());
+///     assert_eq(it->counters.calls, 1);
+///     assert(it->counters.word_ops > 0);
+/// } else {
+///     assert(stats.empty());
+/// }
+/// ```
+inline std::vector<Record>
+snapshot() {
+    std::vector<Record> result;
+    for (auto site = details::Site::head().load(std::memory_order_acquire); site != nullptr; site = site->next) {
+        auto counters = site->counters();
+        if (counters.calls == 0) continue;
+        auto it = std::ranges::find(result, site->name, &Record::name);
+        if (it == result.end()) {
+            result.push_back(Record{site->name, counters});
+        } else {
+            it->counters += counters;
+        }
+    }
+    std::ranges::sort(result, {}, &Record::name);
+    return result;
+}
+
+/// Zeros the totals for all the probes.
+///
+/// Counts being gathered by probes that are open at the time are still added when those probes close.
+inline void
+reset() noexcept {
+    for (auto site = details::Site::head().load(std::memory_order_acquire); site != nullptr; site = site->next)
+        site->reset();
+}
+
+/// Returns a table of the totals from `snapshot()` with one line per probe name.
+///
+/// # Example
+/// ```
+/// instrument::reset();
+/// auto p = BitPolynomial<>::random(100);
+/// auto r = p.reduce_x_to_the(1'000'000);
+/// auto table = instrument::report();
+/// assert_eq(table.contains("BitPolynomial::reduce_x_to_the"), instrument::enabled);
+/// ```
+inline std::string
+report() {
+    auto result = std::format("{:<40} {:>10} {:>14} {:>14} {:>10} {:>14} {:>12}\n", "probe", "calls", "word ops",
+                              "bytes", "allocs", "alloc bytes", "time (ms)");
+    for (auto const& [name, c] : snapshot()) {
+        auto ms = std::chrono::duration<double, std::milli>(c.time).count();
+        result += std::format("{:<40} {:>10} {:>14} {:>14} {:>10} {:>14} {:>12.3f}\n", name, c.calls, c.word_ops,
+                              c.bytes, c.allocations, c.allocated_bytes, ms);
+    }
+    return result;
+}
+
+} // namespace gf2::instrument
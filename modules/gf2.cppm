@@ -8,25 +8,59 @@ module;
 
 #include <gf2/gf2.h>
 #include <gf2/RNG.h>
+#include <gf2/MemoryScope.h>
 
 export module gf2;
 
 export namespace gf2 {
+using gf2::BerlekampMassey;
 using gf2::BitArray;
+using gf2::BitBinaryExpr;
+using gf2::BitExpression;
+using gf2::BitExpressionMethods;
 using gf2::BitGauss;
 using gf2::BitLU;
 using gf2::BitMatrix;
+using gf2::BitMatrixBinaryExpr;
+using gf2::BitMatrixN;
+using gf2::BitMatrixNotExpr;
+using gf2::BitMatrixWriter;
+using gf2::BitNotExpr;
 using gf2::BitPolynomial;
 using gf2::BitRef;
 using gf2::Bits;
+using gf2::BitShiftExpr;
 using gf2::BitSpan;
 using gf2::BitStore;
 using gf2::BitVector;
+using gf2::ColMatrix;
+using gf2::CrcEngine;
+using gf2::CrcOptions;
+using gf2::DeviceMatrix;
+using gf2::Executor;
+using gf2::GF2m;
+using gf2::Lfsr;
+using gf2::MappedBitMatrix;
+using gf2::MappedBitVector;
+using gf2::MatrixPowers;
+using gf2::MemoryScope;
+using gf2::ModContext;
+using gf2::Parallel;
+using gf2::Philox4x32;
+using gf2::RandomEngine;
 using gf2::RNG;
+using gf2::Sequential;
+using gf2::SparseBitMatrix;
 using gf2::SetBits;
+using gf2::ThreadPool;
+using gf2::TiledBitMatrix;
+using gf2::TiledIOStats;
+using gf2::TiledLU;
 using gf2::UnsetBits;
 using gf2::Unsigned;
 using gf2::Words;
+using gf2::XorBasis;
+using gf2::Xoshiro256pp;
 
 using gf2::u16;
 using gf2::u32;
@@ -39,43 +73,59 @@ using gf2::any;
 using gf2::back;
 using gf2::bit_offset;
 using gf2::bits;
+using gf2::clmul;
 using gf2::convolve;
 using gf2::copy;
 using gf2::count_ones;
 using gf2::count_zeros;
 using gf2::describe;
+using gf2::distances;
 using gf2::dot;
 using gf2::fill_random;
+using gf2::find_irreducible;
 using gf2::first_set;
 using gf2::first_unset;
 using gf2::flip;
 using gf2::flip_all;
+using gf2::for_each_set_bit;
+using gf2::format_binary_to;
+using gf2::format_hex_to;
 using gf2::front;
+using gf2::gcd;
 using gf2::get;
+using gf2::hamming_distance;
 using gf2::highest_set_bit;
 using gf2::highest_unset_bit;
 using gf2::index_and_mask;
 using gf2::index_and_offset;
 using gf2::is_empty;
 using gf2::join;
+using gf2::k_nearest;
 using gf2::last_set;
 using gf2::last_unset;
 using gf2::leading_ones;
 using gf2::leading_zeros;
+using gf2::m4rm_dot;
+using gf2::memory_resource;
 using gf2::lowest_set_bit;
 ;
 using gf2::lowest_unset_bit;
 using gf2::next_set;
 using gf2::next_unset;
 using gf2::none;
+using gf2::par;
+using gf2::power_apply;
 using gf2::previous_set;
 using gf2::previous_unset;
+using gf2::read_binary_matrix;
+using gf2::read_binary_vector;
 using gf2::ref;
 using gf2::replace_bits;
 using gf2::reset_bits;
 using gf2::reset_except_bits;
 using gf2::reverse_bits;
 using gf2::riffle;
+using gf2::seq;
 using gf2::set;
 using gf2::set_all;
 using gf2::set_bits;
@@ -83,10 +133,12 @@ using gf2::set_except_bits;
 using gf2::span;
 using gf2::split;
 using gf2::store_words;
+using gf2::strassen_dot;
 using gf2::sub;
 using gf2::swap;
 using gf2::to_binary_string;
 using gf2::to_hex_string;
+using gf2::to_indices;
 using gf2::to_pretty_string;
 using gf2::to_string;
 using gf2::to_words;
@@ -95,13 +147,25 @@ using gf2::trailing_zeros;
 using gf2::unset_bits;
 using gf2::with_set_bits;
 using gf2::with_unset_bits;
+using gf2::write_binary;
 using gf2::word_index;
 using gf2::words_needed;
+using gf2::xgcd;
 
 using gf2::ALTERNATING;
+using gf2::BINARY_HEADER_BYTES;
 using gf2::BITS;
+using gf2::BLOCK_LANCZOS_THRESHOLD;
+using gf2::FAST_DIVISION_THRESHOLD;
+using gf2::FAST_MINIMAL_POLYNOMIAL_THRESHOLD;
+using gf2::FAST_REDUCTION_THRESHOLD;
+using gf2::GF2M_TABLE_THRESHOLD;
+using gf2::HALF_GCD_THRESHOLD;
+using gf2::KARATSUBA_THRESHOLD;
+using gf2::M4RM_THRESHOLD;
 using gf2::MAX;
 using gf2::ONE;
+using gf2::STRASSEN_THRESHOLD;
 using gf2::ZERO;
 
 using gf2::assert_eq_failed;
@@ -124,6 +188,25 @@ using gf2::operator^=;
 using gf2::operator|;
 using gf2::operator|=;
 using gf2::operator~;
+
+namespace batch {
+using gf2::batch::dot;
+using gf2::batch::inverse;
+using gf2::batch::LANES;
+using gf2::batch::rank;
+using gf2::batch::x_for;
+} // namespace batch
+
+namespace instrument {
+using gf2::instrument::Counters;
+using gf2::instrument::enabled;
+using gf2::instrument::Record;
+using gf2::instrument::report;
+using gf2::instrument::reset;
+using gf2::instrument::set_tracer;
+using gf2::instrument::snapshot;
+using gf2::instrument::Tracer;
+} // namespace instrument
 } // namespace gf2
 
 export namespace std {